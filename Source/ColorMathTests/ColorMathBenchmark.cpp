@@ -0,0 +1,184 @@
+// Copyright kevin791129
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+#include "ColorMath/ColorMath.h"
+#include "ColorMath/ColorMathHex.h"
+#include "ColorMath/ColorMathLab.h"
+#include "ColorMath/ColorMathSRGB.h"
+
+/**
+ * Headless microbenchmarks of the ColorMath core, the engine independent counterpart of ColorPicker.Benchmark.
+ *
+ * Usage: ColorMathBenchmark [--count=1000000] [--samples=15] [--output=<File>]
+ * Every case converts count random colors per sample. Reported per case are min and median ns per color and colors per second of
+ * the median, written as JSON to the output file or stdout.
+ */
+namespace
+{
+	using namespace ColorMath;
+
+	struct FInputs
+	{
+		std::vector<TRGBA<uint8_t>> RGB8;
+		std::vector<float> H, S, V, L;
+		std::vector<float> LinearR, LinearG, LinearB;
+		std::vector<TLab<float>> Lab;
+		std::vector<char> Hex;
+
+		explicit FInputs(const size_t Num)
+		{
+			std::mt19937 Random(0x5EED);
+			RGB8.resize(Num);
+			H.resize(Num);
+			S.resize(Num);
+			V.resize(Num);
+			L.resize(Num);
+			LinearR.resize(Num);
+			LinearG.resize(Num);
+			LinearB.resize(Num);
+			Lab.resize(Num);
+			Hex.resize(Num * 6);
+			for (size_t Index = 0; Index < Num; ++Index)
+			{
+				const uint32_t Bits = Random();
+				RGB8[Index] = TRGBA<uint8_t>{ (uint8_t)Bits, (uint8_t)(Bits >> 8), (uint8_t)(Bits >> 16), 255 };
+				RGBToHSV(RGB8[Index].R, RGB8[Index].G, RGB8[Index].B, H[Index], S[Index], V[Index]);
+				float HSLH, HSLS;
+				RGBToHSL(RGB8[Index].R, RGB8[Index].G, RGB8[Index].B, HSLH, HSLS, L[Index]);
+				LinearR[Index] = SRGB::Decode(RGB8[Index].R);
+				LinearG[Index] = SRGB::Decode(RGB8[Index].G);
+				LinearB[Index] = SRGB::Decode(RGB8[Index].B);
+				Lab[Index] = LinearRGBToLab(LinearR[Index], LinearG[Index], LinearB[Index]);
+				Hex::EncodeRGB(RGB8[Index], Hex.data() + Index * 6);
+			}
+		}
+	};
+
+	/** Sink written by every case, so conversions cannot be optimized away. */
+	volatile uint32_t Sink;
+
+	struct FCase
+	{
+		const char* Name;
+		/** Convert Num inputs, returning a checksum of the outputs. */
+		uint32_t (*Function)(const FInputs& Inputs, size_t Num);
+	};
+
+	uint32_t FloatBits(const float Value)
+	{
+		uint32_t Bits;
+		std::memcpy(&Bits, &Value, sizeof(Bits));
+		return Bits;
+	}
+
+	const SRGB::FEncodeTable& GetEncodeTable()
+	{
+		static const SRGB::FEncodeTable Table([](const float Value) { return SRGB::ReferenceEncode(Value); });
+		return Table;
+	}
+
+	const FCase Cases[] = {
+		{ "RGBToHSV", [](const FInputs& In, const size_t Num) { uint32_t Sum = 0; for (size_t I = 0; I < Num; ++I) { float H, S, V; RGBToHSV(In.RGB8[I].R, In.RGB8[I].G, In.RGB8[I].B, H, S, V); Sum += FloatBits(H + S + V); } return Sum; } },
+		{ "RGBToHSL", [](const FInputs& In, const size_t Num) { uint32_t Sum = 0; for (size_t I = 0; I < Num; ++I) { float H, S, L; RGBToHSL(In.RGB8[I].R, In.RGB8[I].G, In.RGB8[I].B, H, S, L); Sum += FloatBits(H + S + L); } return Sum; } },
+		{ "RGBToCMYK", [](const FInputs& In, const size_t Num) { uint32_t Sum = 0; for (size_t I = 0; I < Num; ++I) { float C, M, Y, K; RGBToCMYK(In.RGB8[I].R, In.RGB8[I].G, In.RGB8[I].B, C, M, Y, K); Sum += FloatBits(C + M + Y + K); } return Sum; } },
+		{ "HSVToRGB", [](const FInputs& In, const size_t Num) { uint32_t Sum = 0; for (size_t I = 0; I < Num; ++I) { const TRGBA<uint8_t> C = HSVToRGB<uint8_t>(In.H[I], In.S[I], In.V[I]); Sum += C.R + C.G + C.B; } return Sum; } },
+		{ "HSLToRGB", [](const FInputs& In, const size_t Num) { uint32_t Sum = 0; for (size_t I = 0; I < Num; ++I) { const TRGBA<uint8_t> C = HSLToRGB<uint8_t>(In.H[I], In.S[I], In.L[I]); Sum += C.R + C.G + C.B; } return Sum; } },
+		{ "CMYKToRGB", [](const FInputs& In, const size_t Num) { uint32_t Sum = 0; for (size_t I = 0; I < Num; ++I) { const TRGBA<uint8_t> C = CMYKToRGB<uint8_t>(In.S[I], In.V[I], In.L[I], In.S[Num - 1 - I]); Sum += C.R + C.G + C.B; } return Sum; } },
+		{ "HSVToHSL", [](const FInputs& In, const size_t Num) { uint32_t Sum = 0; for (size_t I = 0; I < Num; ++I) { float H, S, L; HSVToHSL(In.H[I], In.S[I], In.V[I], H, S, L); Sum += FloatBits(H + S + L); } return Sum; } },
+		{ "HexEncode", [](const FInputs& In, const size_t Num) { uint32_t Sum = 0; char Buffer[6]; for (size_t I = 0; I < Num; ++I) { Hex::EncodeRGB(In.RGB8[I], Buffer); Sum += (uint32_t)Buffer[0] + (uint32_t)Buffer[5]; } return Sum; } },
+		{ "HexParse", [](const FInputs& In, const size_t Num) { uint32_t Sum = 0; for (size_t I = 0; I < Num; ++I) { TRGBA<uint8_t> C; Sum += Hex::Parse(In.Hex.data() + I * 6, 6, C) ? C.R + C.G + C.B : 0u; } return Sum; } },
+		{ "SRGBEncode", [](const FInputs& In, const size_t Num) { const SRGB::FEncodeTable& Table = GetEncodeTable(); uint32_t Sum = 0; for (size_t I = 0; I < Num; ++I) { Sum += Table.Encode(In.LinearR[I]) + Table.Encode(In.LinearG[I]) + Table.Encode(In.LinearB[I]); } return Sum; } },
+		{ "SRGBEncodeReference", [](const FInputs& In, const size_t Num) { uint32_t Sum = 0; for (size_t I = 0; I < Num; ++I) { Sum += SRGB::ReferenceEncode(In.LinearR[I]) + SRGB::ReferenceEncode(In.LinearG[I]) + SRGB::ReferenceEncode(In.LinearB[I]); } return Sum; } },
+		{ "SRGBDecode", [](const FInputs& In, const size_t Num) { uint32_t Sum = 0; for (size_t I = 0; I < Num; ++I) { Sum += FloatBits(SRGB::Decode(In.RGB8[I].R) + SRGB::Decode(In.RGB8[I].G) + SRGB::Decode(In.RGB8[I].B)); } return Sum; } },
+		{ "LinearRGBToLab", [](const FInputs& In, const size_t Num) { uint32_t Sum = 0; for (size_t I = 0; I < Num; ++I) { const TLab<float> Lab = LinearRGBToLab(In.LinearR[I], In.LinearG[I], In.LinearB[I]); Sum += FloatBits(Lab.L + Lab.A + Lab.B); } return Sum; } },
+		{ "LabToLinearRGB", [](const FInputs& In, const size_t Num) { uint32_t Sum = 0; for (size_t I = 0; I < Num; ++I) { const TRGBA<float> C = LabToLinearRGB(In.Lab[I]); Sum += FloatBits(C.R + C.G + C.B); } return Sum; } },
+		{ "LinearRGBToOKLab", [](const FInputs& In, const size_t Num) { uint32_t Sum = 0; for (size_t I = 0; I < Num; ++I) { const TLab<float> Lab = LinearRGBToOKLab(In.LinearR[I], In.LinearG[I], In.LinearB[I]); Sum += FloatBits(Lab.L + Lab.A + Lab.B); } return Sum; } },
+		{ "DeltaE76", [](const FInputs& In, const size_t Num) { uint32_t Sum = 0; for (size_t I = 0; I < Num; ++I) { Sum += FloatBits(DeltaE76(In.Lab[I], In.Lab[Num - 1 - I])); } return Sum; } },
+		{ "DeltaE94", [](const FInputs& In, const size_t Num) { uint32_t Sum = 0; for (size_t I = 0; I < Num; ++I) { Sum += FloatBits(DeltaE94(In.Lab[I], In.Lab[Num - 1 - I])); } return Sum; } },
+		{ "DeltaE2000", [](const FInputs& In, const size_t Num) { uint32_t Sum = 0; for (size_t I = 0; I < Num; ++I) { Sum += FloatBits(DeltaE2000(In.Lab[I], In.Lab[Num - 1 - I])); } return Sum; } },
+	};
+
+	bool ParseOption(const char* Arg, const char* Name, std::string& OutValue)
+	{
+		const size_t Length = std::strlen(Name);
+		if (std::strncmp(Arg, Name, Length) != 0)
+			return false;
+
+		OutValue = Arg + Length;
+		return true;
+	}
+}
+
+int main(int Argc, char** Argv)
+{
+	size_t Count = 1000000;
+	int Samples = 15;
+	std::string OutputFile;
+	for (int Arg = 1; Arg < Argc; ++Arg)
+	{
+		std::string Value;
+		if (ParseOption(Argv[Arg], "--count=", Value))
+			Count = std::max<size_t>(1, std::strtoull(Value.c_str(), nullptr, 10));
+		else if (ParseOption(Argv[Arg], "--samples=", Value))
+			Samples = std::max(1, std::atoi(Value.c_str()));
+		else if (ParseOption(Argv[Arg], "--output=", Value))
+			OutputFile = Value;
+		else
+		{
+			std::fprintf(stderr, "Usage: %s [--count=1000000] [--samples=15] [--output=<File>]\n", Argv[0]);
+			return 1;
+		}
+	}
+
+	const FInputs Inputs(Count);
+	std::string Json = "{\n\t\"Count\": " + std::to_string(Count) + ",\n\t\"Samples\": " + std::to_string(Samples) + ",\n\t\"Results\": [";
+	bool bFirst = true;
+	for (const FCase& Case : Cases)
+	{
+		// First run warms up caches and lazily built tables, not measured.
+		Sink = Case.Function(Inputs, Count);
+
+		std::vector<double> NsPerColor;
+		for (int Sample = 0; Sample < Samples; ++Sample)
+		{
+			const auto Start = std::chrono::steady_clock::now();
+			Sink = Case.Function(Inputs, Count);
+			NsPerColor.push_back(std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - Start).count() / Count);
+		}
+		std::sort(NsPerColor.begin(), NsPerColor.end());
+		const double Median = NsPerColor[NsPerColor.size() / 2];
+
+		char Line[256];
+		std::snprintf(Line, sizeof(Line), "%s\n\t\t{ \"Function\": \"%s\", \"MinNsPerColor\": %.4f, \"MedianNsPerColor\": %.4f, \"ColorsPerSecond\": %.6g }",
+			bFirst ? "" : ",", Case.Name, NsPerColor.front(), Median, 1.0e9 / Median);
+		Json += Line;
+		bFirst = false;
+
+		std::fprintf(stderr, "%-20s %8.3f ns/color %10.4g colors/s\n", Case.Name, Median, 1.0e9 / Median);
+	}
+	Json += "\n\t]\n}\n";
+
+	if (OutputFile.empty())
+	{
+		std::fputs(Json.c_str(), stdout);
+		return 0;
+	}
+
+	FILE* File = std::fopen(OutputFile.c_str(), "w");
+	if (!File)
+	{
+		std::fprintf(stderr, "Failed to write %s\n", OutputFile.c_str());
+		return 1;
+	}
+	std::fputs(Json.c_str(), File);
+	std::fclose(File);
+	return 0;
+}
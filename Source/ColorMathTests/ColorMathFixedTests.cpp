@@ -0,0 +1,210 @@
+// Copyright kevin791129
+
+#include <cmath>
+#include <cstdint>
+#include "ColorMathTest.h"
+#include "ColorMath/ColorMath.h"
+#include "ColorMath/ColorMathFixed.h"
+
+using namespace ColorMath;
+using namespace ColorMath::Fixed;
+using ColorMathTest::ForEachRGB8;
+
+/**
+ * Exhaustive checks of the error bounds documented in ColorMathFixed.h, against the float and double ColorMath conversions.
+ */
+namespace
+{
+	/** Slack for exact rational results computed in double, ties land within it of 0.5. */
+	constexpr double RoundingTolerance = 0.5 + 1.e-9;
+
+	/** Degrees per fixed-point hue unit, 15 / 64 is exact in float. */
+	constexpr double DegreesPerHueStep = 360.0 / HueSteps;
+
+	int32_t ChannelDistance(const uint8_t A, const uint8_t B)
+	{
+		return A > B ? A - B : B - A;
+	}
+
+	int32_t ColorDistance(const TRGBA<uint8_t>& A, const TRGBA<uint8_t>& B)
+	{
+		const int32_t DR = ChannelDistance(A.R, B.R);
+		const int32_t DG = ChannelDistance(A.G, B.G);
+		const int32_t DB = ChannelDistance(A.B, B.B);
+		return DR > DG ? (DR > DB ? DR : DB) : (DG > DB ? DG : DB);
+	}
+
+	/** Largest channel distance to a double color in [0, 1], in 8-bit units. */
+	double ColorDistance(const TRGBA<uint8_t>& A, const TRGBA<double>& B)
+	{
+		const double DR = std::abs(A.R - B.R * 255.0);
+		const double DG = std::abs(A.G - B.G * 255.0);
+		const double DB = std::abs(A.B - B.B * 255.0);
+		return DR > DG ? (DR > DB ? DR : DB) : (DG > DB ? DG : DB);
+	}
+
+	/** Distance of fixed-point hue to a hue in degrees along the hue circle, in hue units. */
+	double HueDistance(const uint16_t H, const double Degrees)
+	{
+		const double Distance = std::abs(H - Degrees / DegreesPerHueStep);
+		return Distance < HueSteps - Distance ? Distance : HueSteps - Distance;
+	}
+
+	bool IsGray(const uint8_t R, const uint8_t G, const uint8_t B)
+	{
+		return R == G && G == B;
+	}
+
+	/**
+	 * Iterate every fixed-point hue, saturation and value or lightness.
+	 */
+	template<typename FunctionType>
+	void ForEachHue8(FunctionType Function)
+	{
+		for (uint32_t H = 0; H < HueSteps; ++H)
+		{
+			for (uint32_t S = 0; S < 256; ++S)
+			{
+				for (uint32_t X = 0; X < 256; ++X)
+				{
+					Function((uint16_t)H, (uint8_t)S, (uint8_t)X);
+				}
+			}
+		}
+	}
+}
+
+//~ Begin Arithmetic
+COLORMATH_TEST(FixedArithmetic)
+{
+	for (uint32_t Divisor = 1; Divisor < 256; ++Divisor)
+	{
+		for (uint32_t X = 0; X <= Divisor; ++X)
+		{
+			// Round to nearest with ties up: floor((2 X N + D) / 2 D).
+			const uint32_t Expected255 = (2 * X * 255 + Divisor) / (2 * Divisor);
+			const uint32_t ExpectedHue = (2 * X * HueSectorSteps + Divisor) / (2 * Divisor);
+			Context.Check(MulDivRound(X, Reciprocal255.Values[Divisor]) == Expected255, "MulDivRound(%u, 255 / %u) is not %u", X, Divisor, Expected255);
+			Context.Check(MulDivRound(X, ReciprocalHue.Values[Divisor]) == ExpectedHue, "MulDivRound(%u, 256 / %u) is not %u", X, Divisor, ExpectedHue);
+		}
+	}
+	Context.Check(MulDivRound(0, Reciprocal255.Values[0]) == 0 && MulDivRound(0, ReciprocalHue.Values[0]) == 0, "Division by 0 is not 0");
+
+	for (uint32_t X = 0; X < (1u << 16); ++X)
+	{
+		Context.Check(Divide255(X) == X / 255, "Divide255(%u) is not %u", X, X / 255);
+	}
+
+	for (uint32_t X = 0; X < (1u << 24); ++X)
+	{
+		const uint32_t Expected = (X + 32640) / 65280;
+		Context.Check(Divide65280Round(X) == Expected, "Divide65280Round(%u) is not %u", X, Expected);
+	}
+
+	for (uint32_t H = 0; H < HueSteps; ++H)
+	{
+		const uint32_t Expected = ((H + 3) / 6) % 256;
+		Context.Check(HueToByte((uint16_t)H) == Expected, "HueToByte(%u) is not %u", H, Expected);
+	}
+	for (uint32_t Byte = 0; Byte < 256; ++Byte)
+	{
+		Context.Check(HueToByte(ByteToHue((uint8_t)Byte)) == Byte, "Hue byte %u does not round trip", Byte);
+	}
+}
+//~ End Arithmetic
+
+//~ Begin RGB To
+COLORMATH_TEST(FixedRGBToHSV8)
+{
+	ForEachRGB8([&Context](const uint8_t R, const uint8_t G, const uint8_t B)
+	{
+		const FHSV8 Color = RGBToHSV8(R, G, B);
+		double H, S, V;
+		RGBToHSV(R, G, B, H, S, V);
+
+		Context.Check(Color.H < HueSteps && HueDistance(Color.H, H) <= RoundingTolerance,
+			"RGBToHSV8(%u, %u, %u) hue %u, expected %f", R, G, B, Color.H, H / DegreesPerHueStep);
+		Context.Check(std::abs(Color.S - S * 255.0) <= RoundingTolerance,
+			"RGBToHSV8(%u, %u, %u) saturation %u, expected %f", R, G, B, Color.S, S * 255.0);
+		Context.Check(Color.V == Max3(R, G, B), "RGBToHSV8(%u, %u, %u) value %u", R, G, B, Color.V);
+		if (IsGray(R, G, B))
+			Context.Check(Color.H == 0 && Color.S == 0, "RGBToHSV8(%u, %u, %u) gray has hue or saturation", R, G, B);
+	});
+}
+
+COLORMATH_TEST(FixedRGBToHSL8)
+{
+	ForEachRGB8([&Context](const uint8_t R, const uint8_t G, const uint8_t B)
+	{
+		const FHSL8 Color = RGBToHSL8(R, G, B);
+		double H, S, L;
+		RGBToHSL(R, G, B, H, S, L);
+
+		Context.Check(Color.H < HueSteps && HueDistance(Color.H, H) <= RoundingTolerance,
+			"RGBToHSL8(%u, %u, %u) hue %u, expected %f", R, G, B, Color.H, H / DegreesPerHueStep);
+		Context.Check(std::abs(Color.L - L * 255.0) <= RoundingTolerance,
+			"RGBToHSL8(%u, %u, %u) lightness %u, expected %f", R, G, B, Color.L, L * 255.0);
+		if (IsGray(R, G, B))
+		{
+			// Float saturation of white is NaN, fixed-point gives 0 for every gray.
+			Context.Check(Color.H == 0 && Color.S == 0, "RGBToHSL8(%u, %u, %u) gray has hue or saturation", R, G, B);
+			return;
+		}
+		Context.Check(std::abs(Color.S - S * 255.0) <= RoundingTolerance,
+			"RGBToHSL8(%u, %u, %u) saturation %u, expected %f", R, G, B, Color.S, S * 255.0);
+	});
+}
+//~ End RGB To
+
+//~ Begin To RGB
+COLORMATH_TEST(FixedHSV8ToRGB)
+{
+	ForEachHue8([&Context](const uint16_t H, const uint8_t S, const uint8_t V)
+	{
+		const TRGBA<uint8_t> Color = HSV8ToRGB(FHSV8{ H, S, V });
+		const double Degrees = H * DegreesPerHueStep;
+
+		Context.Check(ColorDistance(Color, HSVToRGB<double>(Degrees, S / 255.0, V / 255.0)) <= RoundingTolerance && Color.A == 255,
+			"HSV8ToRGB(%u, %u, %u) = (%u, %u, %u) is not correctly rounded", H, S, V, Color.R, Color.G, Color.B);
+		Context.Check(ColorDistance(Color, HSVToRGB<uint8_t>((float)Degrees, S / 255.f, V / 255.f)) <= 1,
+			"HSV8ToRGB(%u, %u, %u) = (%u, %u, %u) differs from float by more than 1", H, S, V, Color.R, Color.G, Color.B);
+	});
+
+	const TRGBA<uint8_t> Red = HSV8ToRGB(FHSV8{ (uint16_t)HueSteps, 255, 255 });
+	Context.Check(Red.R == 255 && Red.G == 0 && Red.B == 0, "HSV8ToRGB hue outside a turn is not treated as 0");
+}
+
+COLORMATH_TEST(FixedHSL8ToRGB)
+{
+	ForEachHue8([&Context](const uint16_t H, const uint8_t S, const uint8_t L)
+	{
+		const TRGBA<uint8_t> Color = HSL8ToRGB(FHSL8{ H, S, L });
+		const double Degrees = H * DegreesPerHueStep;
+
+		Context.Check(ColorDistance(Color, HSLToRGB<double>(Degrees, S / 255.0, L / 255.0)) <= RoundingTolerance && Color.A == 255,
+			"HSL8ToRGB(%u, %u, %u) = (%u, %u, %u) is not correctly rounded", H, S, L, Color.R, Color.G, Color.B);
+		Context.Check(ColorDistance(Color, HSLToRGB<uint8_t>((float)Degrees, S / 255.f, L / 255.f)) <= 1,
+			"HSL8ToRGB(%u, %u, %u) = (%u, %u, %u) differs from float by more than 1", H, S, L, Color.R, Color.G, Color.B);
+	});
+}
+//~ End To RGB
+
+//~ Begin Round Trip
+COLORMATH_TEST(FixedRoundTrip)
+{
+	ForEachRGB8([&Context](const uint8_t R, const uint8_t G, const uint8_t B)
+	{
+		const TRGBA<uint8_t> Original{ R, G, B, 255 };
+		const bool bExact = IsGray(R, G, B);
+
+		const TRGBA<uint8_t> FromHSV = HSV8ToRGB(RGBToHSV8(R, G, B));
+		const bool bFullySaturated = Min3(R, G, B) == 0;
+		Context.Check(ColorDistance(FromHSV, Original) <= ((bExact || bFullySaturated) ? 0 : 1),
+			"HSV8 round trip of (%u, %u, %u) gave (%u, %u, %u)", R, G, B, FromHSV.R, FromHSV.G, FromHSV.B);
+
+		const TRGBA<uint8_t> FromHSL = HSL8ToRGB(RGBToHSL8(R, G, B));
+		Context.Check(ColorDistance(FromHSL, Original) <= (bExact ? 0 : 2),
+			"HSL8 round trip of (%u, %u, %u) gave (%u, %u, %u)", R, G, B, FromHSL.R, FromHSL.G, FromHSL.B);
+	});
+}
+//~ End Round Trip
@@ -0,0 +1,96 @@
+// Copyright kevin791129
+
+#pragma once
+
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+/**
+ * Minimal test registry for the headless ColorMath tests, so they build with nothing but a C++ compiler.
+ *
+ * COLORMATH_TEST(Name) defines a test function taking FContext& Context. Checks report through Context.Check, which prints the first
+ * failures of a test and counts the rest, and a test fails if any check failed.
+ */
+namespace ColorMathTest
+{
+	/**
+	 * Failure reporting of a running test.
+	 */
+	class FContext
+	{
+	public:
+		/** Failures printed in full before the rest are only counted. */
+		static constexpr uint32_t MaxReportedFailures = 16;
+
+		/**
+		 * Record a failure if Condition is false.
+		 *
+		 * @param Condition : Checked condition.
+		 * @param Format : printf style description of the failure.
+		 * @return Condition.
+		 */
+		bool Check(const bool Condition, const char* Format, ...)
+		{
+			if (Condition)
+				return true;
+
+			if (Failures++ < MaxReportedFailures)
+			{
+				va_list Args;
+				va_start(Args, Format);
+				std::printf("    ");
+				std::vprintf(Format, Args);
+				std::printf("\n");
+				va_end(Args);
+			}
+			return false;
+		}
+
+		uint32_t GetFailures() const { return Failures; }
+
+	private:
+		uint32_t Failures = 0;
+	};
+
+	typedef void (*FTestFunction)(FContext& Context);
+
+	struct FTest
+	{
+		const char* Name;
+		FTestFunction Function;
+	};
+
+	/** Tests registered by COLORMATH_TEST, in static initialization order. */
+	inline std::vector<FTest>& GetTests()
+	{
+		static std::vector<FTest> Tests;
+		return Tests;
+	}
+
+	struct FRegistrar
+	{
+		FRegistrar(const char* Name, const FTestFunction Function)
+		{
+			GetTests().push_back(FTest{ Name, Function });
+		}
+	};
+
+	/**
+	 * Iterate every 8-bit RGB color.
+	 */
+	template<typename FunctionType>
+	inline void ForEachRGB8(FunctionType Function)
+	{
+		for (uint32_t Color = 0; Color < (1u << 24); ++Color)
+		{
+			Function((uint8_t)(Color >> 16), (uint8_t)(Color >> 8), (uint8_t)Color);
+		}
+	}
+}
+
+#define COLORMATH_TEST(Name) \
+	static void Name##Test(ColorMathTest::FContext& Context); \
+	static const ColorMathTest::FRegistrar Name##Registrar(#Name, &Name##Test); \
+	static void Name##Test(ColorMathTest::FContext& Context)
@@ -0,0 +1,50 @@
+// Copyright kevin791129
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include "ColorMathTest.h"
+
+/**
+ * Run registered tests.
+ *
+ * Usage: ColorMathTests [Filter ...]
+ * Only tests whose name starts with one of the filters run, all tests run without filters. Exit code is the number of failed tests.
+ */
+int main(int Argc, char** Argv)
+{
+	int Failed = 0;
+	int Run = 0;
+	for (const ColorMathTest::FTest& Test : ColorMathTest::GetTests())
+	{
+		bool bSelected = Argc < 2;
+		for (int Arg = 1; Arg < Argc; ++Arg)
+		{
+			bSelected |= std::strncmp(Test.Name, Argv[Arg], std::strlen(Argv[Arg])) == 0;
+		}
+		if (!bSelected)
+			continue;
+
+		std::printf("[ RUN  ] %s\n", Test.Name);
+		std::fflush(stdout);
+
+		ColorMathTest::FContext Context;
+		const auto Start = std::chrono::steady_clock::now();
+		Test.Function(Context);
+		const double Ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - Start).count();
+
+		++Run;
+		if (Context.GetFailures() > 0)
+		{
+			++Failed;
+			std::printf("[ FAIL ] %s, %u failed checks (%.0f ms)\n", Test.Name, Context.GetFailures(), Ms);
+		}
+		else
+		{
+			std::printf("[  OK  ] %s (%.0f ms)\n", Test.Name, Ms);
+		}
+	}
+
+	std::printf("%d of %d tests passed.\n", Run - Failed, Run);
+	return Run > 0 ? Failed : 1;
+}
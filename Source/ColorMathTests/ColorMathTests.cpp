@@ -0,0 +1,307 @@
+// Copyright kevin791129
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include "ColorMathTest.h"
+#include "ColorMath/ColorMath.h"
+#include "ColorMath/ColorMathHex.h"
+#include "ColorMath/ColorMathLab.h"
+#include "ColorMath/ColorMathSRGB.h"
+
+using namespace ColorMath;
+using ColorMathTest::ForEachRGB8;
+
+namespace
+{
+	/** Tolerance of exact math done in double. */
+	constexpr double DoubleTolerance = 1.e-12;
+
+	int32_t ChannelDistance(const uint8_t A, const uint8_t B)
+	{
+		return A > B ? A - B : B - A;
+	}
+
+	int32_t ColorDistance(const TRGBA<uint8_t>& Color, const uint8_t R, const uint8_t G, const uint8_t B)
+	{
+		const int32_t DR = ChannelDistance(Color.R, R);
+		const int32_t DG = ChannelDistance(Color.G, G);
+		const int32_t DB = ChannelDistance(Color.B, B);
+		return DR > DG ? (DR > DB ? DR : DB) : (DG > DB ? DG : DB);
+	}
+
+	double ColorDistance(const TRGBA<double>& Color, const uint8_t R, const uint8_t G, const uint8_t B)
+	{
+		const double DR = std::abs(Color.R - R / 255.0);
+		const double DG = std::abs(Color.G - G / 255.0);
+		const double DB = std::abs(Color.B - B / 255.0);
+		return DR > DG ? (DR > DB ? DR : DB) : (DG > DB ? DG : DB);
+	}
+
+	float BitsToFloat(const uint32_t Bits)
+	{
+		float Value;
+		std::memcpy(&Value, &Bits, sizeof(Value));
+		return Value;
+	}
+
+	uint32_t FloatToBits(const float Value)
+	{
+		uint32_t Bits;
+		std::memcpy(&Bits, &Value, sizeof(Bits));
+		return Bits;
+	}
+}
+
+//~ Begin Hue Models
+COLORMATH_TEST(HSV)
+{
+	// Double math reconstructs every color, the 8-bit path truncates so channels may drop by 1.
+	ForEachRGB8([&Context](const uint8_t R, const uint8_t G, const uint8_t B)
+	{
+		double H, S, V;
+		RGBToHSV(R, G, B, H, S, V);
+		Context.Check(H >= 0.0 && H < 360.0 && S >= 0.0 && S <= 1.0 && V >= 0.0 && V <= 1.0,
+			"RGBToHSV(%u, %u, %u) = (%f, %f, %f) out of range", R, G, B, H, S, V);
+		Context.Check(ColorDistance(HSVToRGB<double>(H, S, V), R, G, B) < DoubleTolerance,
+			"RGBToHSV(%u, %u, %u) does not round trip in double", R, G, B);
+
+		float HF, SF, VF;
+		RGBToHSV(R, G, B, HF, SF, VF);
+		const TRGBA<uint8_t> Color = HSVToRGB<uint8_t>(HF, SF, VF);
+		Context.Check(ColorDistance(Color, R, G, B) <= 1 && Color.R <= R && Color.G <= G && Color.B <= B && Color.A == 255,
+			"RGBToHSV(%u, %u, %u) round trips to (%u, %u, %u)", R, G, B, Color.R, Color.G, Color.B);
+	});
+
+	// Out of range inputs are clamped, hue 360 wraps to red.
+	const TRGBA<uint8_t> Red = HSVToRGB<uint8_t>(360.0f, 2.0f, 2.0f);
+	Context.Check(Red.R == 255 && Red.G == 0 && Red.B == 0, "HSVToRGB(360, 2, 2) is not red");
+	const TRGBA<uint8_t> Black = HSVToRGB<uint8_t>(-10.0f, -1.0f, -1.0f);
+	Context.Check(Black.R == 0 && Black.G == 0 && Black.B == 0, "HSVToRGB(-10, -1, -1) is not black");
+}
+
+COLORMATH_TEST(HSL)
+{
+	ForEachRGB8([&Context](const uint8_t R, const uint8_t G, const uint8_t B)
+	{
+		double H, S, L;
+		RGBToHSL(R, G, B, H, S, L);
+		if (R == 255 && G == 255 && B == 255)
+		{
+			// Documented: white has no defined saturation.
+			Context.Check(H == 0.0 && std::isnan(S) && L == 1.0, "RGBToHSL(255, 255, 255) changed");
+			return;
+		}
+
+		Context.Check(H >= 0.0 && H < 360.0 && S >= 0.0 && S <= 1.0 + DoubleTolerance && L >= 0.0 && L <= 1.0,
+			"RGBToHSL(%u, %u, %u) = (%f, %f, %f) out of range", R, G, B, H, S, L);
+		Context.Check(ColorDistance(HSLToRGB<double>(H, S, L), R, G, B) < DoubleTolerance,
+			"RGBToHSL(%u, %u, %u) does not round trip in double", R, G, B);
+
+		float HF, SF, LF;
+		RGBToHSL(R, G, B, HF, SF, LF);
+		const TRGBA<uint8_t> Color = HSLToRGB<uint8_t>(HF, SF, LF);
+		Context.Check(ColorDistance(Color, R, G, B) <= 1 && Color.A == 255,
+			"RGBToHSL(%u, %u, %u) round trips to (%u, %u, %u)", R, G, B, Color.R, Color.G, Color.B);
+	});
+}
+
+COLORMATH_TEST(CMYK)
+{
+	ForEachRGB8([&Context](const uint8_t R, const uint8_t G, const uint8_t B)
+	{
+		double C, M, Y, K;
+		RGBToCMYK(R, G, B, C, M, Y, K);
+		if (R == 0 && G == 0 && B == 0)
+		{
+			// Documented: black has no defined C, M and Y.
+			Context.Check(std::isnan(C) && std::isnan(M) && std::isnan(Y) && K == 1.0, "RGBToCMYK(0, 0, 0) changed");
+			return;
+		}
+
+		Context.Check(ColorDistance(CMYKToRGB<double>(C, M, Y, K), R, G, B) < DoubleTolerance,
+			"RGBToCMYK(%u, %u, %u) does not round trip in double", R, G, B);
+
+		float CF, MF, YF, KF;
+		RGBToCMYK(R, G, B, CF, MF, YF, KF);
+		const TRGBA<uint8_t> Color = CMYKToRGB<uint8_t>(CF, MF, YF, KF);
+		Context.Check(ColorDistance(Color, R, G, B) <= 1 && Color.A == 255,
+			"RGBToCMYK(%u, %u, %u) round trips to (%u, %u, %u)", R, G, B, Color.R, Color.G, Color.B);
+	});
+}
+
+COLORMATH_TEST(HueModels)
+{
+	// Direct HSV and HSL conversions agree with going through RGB, hue is carried over unchanged.
+	ForEachRGB8([&Context](const uint8_t R, const uint8_t G, const uint8_t B)
+	{
+		if (R == 255 && G == 255 && B == 255)
+			return;
+
+		double HSVH, HSVS, HSVV, HSLH, HSLS, HSLL;
+		RGBToHSV(R, G, B, HSVH, HSVS, HSVV);
+		RGBToHSL(R, G, B, HSLH, HSLS, HSLL);
+
+		double H, S, L;
+		HSVToHSL(HSVH, HSVS, HSVV, H, S, L);
+		Context.Check(H == HSLH && std::abs(S - HSLS) < 1.e-9 && std::abs(L - HSLL) < DoubleTolerance,
+			"HSVToHSL of (%u, %u, %u) differs from RGBToHSL", R, G, B);
+
+		double V;
+		HSLToHSV(HSLH, HSLS, HSLL, H, S, V);
+		Context.Check(H == HSVH && std::abs(S - HSVS) < 1.e-9 && std::abs(V - HSVV) < DoubleTolerance,
+			"HSLToHSV of (%u, %u, %u) differs from RGBToHSV", R, G, B);
+	});
+}
+//~ End Hue Models
+
+//~ Begin Hex
+COLORMATH_TEST(Hex)
+{
+	ForEachRGB8([&Context](const uint8_t R, const uint8_t G, const uint8_t B)
+	{
+		char Buffer[8] = { '#' };
+		Hex::EncodeRGB(TRGBA<uint8_t>{ R, G, B, 255 }, Buffer + 1);
+
+		TRGBA<uint8_t> Color;
+		Context.Check(Hex::Parse(Buffer, 7, Color) && Color.R == R && Color.G == G && Color.B == B && Color.A == 255,
+			"Hex %.7s does not round trip", Buffer);
+		Context.Check(Hex::Parse(Buffer + 1, 6, Color) && Color.R == R && Color.G == G && Color.B == B && Color.A == 255,
+			"Hex %.6s without # does not round trip", Buffer + 1);
+	});
+
+	TRGBA<uint8_t> Color;
+	Context.Check(Hex::Parse(u"#abc", 4, Color) && Color.R == 0xAA && Color.G == 0xBB && Color.B == 0xCC && Color.A == 255,
+		"Short lower case hex #abc");
+	Context.Check(Hex::Parse("12345678", 8, Color) && Color.R == 0x12 && Color.G == 0x34 && Color.B == 0x56 && Color.A == 0x78,
+		"Hex with alpha 12345678");
+	Context.Check(!Hex::Parse("#12G456", 7, Color) && Color.R == 0x12 && Color.G == 0x04 && Color.B == 0x56,
+		"Invalid digit parses as 0 and fails");
+
+	for (const int32_t Length : { 0, 1, 2, 4, 5, 7, 9 })
+	{
+		Context.Check(!Hex::Parse("123456789", Length, Color) && Color.R == 0 && Color.G == 0 && Color.B == 0 && Color.A == 0,
+			"Hex of length %d is not rejected", Length);
+	}
+}
+//~ End Hex
+
+//~ Begin SRGB
+COLORMATH_TEST(SRGBEncode)
+{
+	const SRGB::FEncodeTable ColorTable([](const float Value) { return SRGB::ReferenceEncode(Value); });
+	const SRGB::FEncodeTable AlphaTable([](const float Value) { return SRGB::ReferenceEncodeLinear(Value); });
+
+	auto CheckValue = [&Context, &ColorTable, &AlphaTable](const float Value)
+	{
+		Context.Check(ColorTable.Encode(Value) == SRGB::ReferenceEncode(Value), "Color encode of %.9g (0x%08X) gave %u, reference %u",
+			Value, FloatToBits(Value), ColorTable.Encode(Value), SRGB::ReferenceEncode(Value));
+		Context.Check(AlphaTable.Encode(Value) == SRGB::ReferenceEncodeLinear(Value), "Alpha encode of %.9g (0x%08X) gave %u, reference %u",
+			Value, FloatToBits(Value), AlphaTable.Encode(Value), SRGB::ReferenceEncodeLinear(Value));
+	};
+	auto CheckNeighborhood = [&CheckValue](const uint32_t Bits)
+	{
+		for (uint32_t Neighbor = Bits > 0 ? Bits - 1 : 0; Neighbor <= Bits + 1 && Neighbor <= 0x3F800000; ++Neighbor)
+		{
+			CheckValue(BitsToFloat(Neighbor));
+		}
+	};
+
+	// Both sides of every code threshold and bucket boundary, where the tables can change code.
+	for (uint32_t Code = 1; Code < 256; ++Code)
+	{
+		CheckNeighborhood(FloatToBits(ColorTable.Thresholds[Code]));
+		CheckNeighborhood(FloatToBits(AlphaTable.Thresholds[Code]));
+	}
+	for (uint32_t Bucket = 0; Bucket < SRGB::EncodeBucketCount; ++Bucket)
+	{
+		CheckNeighborhood(Bucket << SRGB::EncodeBucketShift);
+	}
+	// A sample of everything in between, stride is odd so every bucket offset is visited.
+	for (uint32_t Bits = 0; Bits <= 0x3F800000; Bits += 61)
+	{
+		CheckValue(BitsToFloat(Bits));
+	}
+	for (const float Value : { -0.0f, -1.0f, 1.5f, std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity(),
+		std::numeric_limits<float>::quiet_NaN() })
+	{
+		CheckValue(Value);
+	}
+}
+
+COLORMATH_TEST(SRGBDecode)
+{
+	for (uint32_t Code = 0; Code < 256; ++Code)
+	{
+		const float Value = SRGB::Decode((uint8_t)Code);
+		const double Exact = SRGB::DecodeReal(Code / 255.0);
+		Context.Check(std::abs(Value - Exact) <= 1.e-6, "Decode(%u) = %.9g, exact %.9g", Code, Value, Exact);
+		Context.Check(SRGB::ReferenceEncode(Value) == Code, "Decode(%u) encodes to %u", Code, SRGB::ReferenceEncode(Value));
+		Context.Check(SRGB::ReferenceEncodeLinear(SRGB::DecodeLinear((uint8_t)Code)) == Code, "DecodeLinear(%u) does not round trip", Code);
+		Context.Check(Code == 0 || Value > SRGB::Decode((uint8_t)(Code - 1)), "Decode is not increasing at %u", Code);
+	}
+}
+//~ End SRGB
+
+//~ Begin Lab
+COLORMATH_TEST(Lab)
+{
+	const TLab<double> White = LinearRGBToLab(1.0, 1.0, 1.0);
+	Context.Check(std::abs(White.L - 100.0) < 1.e-3 && std::abs(White.A) < 1.e-3 && std::abs(White.B) < 1.e-3,
+		"CIELAB white is (%f, %f, %f)", White.L, White.A, White.B);
+	const TLab<double> OKWhite = LinearRGBToOKLab(1.0, 1.0, 1.0);
+	Context.Check(std::abs(OKWhite.L - 1.0) < 1.e-4 && std::abs(OKWhite.A) < 1.e-4 && std::abs(OKWhite.B) < 1.e-4,
+		"OKLab white is (%f, %f, %f)", OKWhite.L, OKWhite.A, OKWhite.B);
+
+	const int32_t Steps = 32;
+	for (int32_t R = 0; R <= Steps; ++R)
+	{
+		for (int32_t G = 0; G <= Steps; ++G)
+		{
+			for (int32_t B = 0; B <= Steps; ++B)
+			{
+				const double RD = (double)R / Steps, GD = (double)G / Steps, BD = (double)B / Steps;
+				// Matrices are published to 7 and 10 digits, so are inverses of each other to about that precision.
+				const TRGBA<double> Lab = LabToLinearRGB(LinearRGBToLab(RD, GD, BD));
+				Context.Check(std::abs(Lab.R - RD) < 1.e-6 && std::abs(Lab.G - GD) < 1.e-6 && std::abs(Lab.B - BD) < 1.e-6,
+					"CIELAB of (%f, %f, %f) does not round trip", RD, GD, BD);
+				const TRGBA<double> OKLab = OKLabToLinearRGB(LinearRGBToOKLab(RD, GD, BD));
+				Context.Check(std::abs(OKLab.R - RD) < 1.e-6 && std::abs(OKLab.G - GD) < 1.e-6 && std::abs(OKLab.B - BD) < 1.e-6,
+					"OKLab of (%f, %f, %f) does not round trip", RD, GD, BD);
+
+				const float RF = (float)RD, GF = (float)GD, BF = (float)BD;
+				const TRGBA<float> LabF = LabToLinearRGB(LinearRGBToLab(RF, GF, BF));
+				Context.Check(std::abs(LabF.R - RF) < 1.e-5f && std::abs(LabF.G - GF) < 1.e-5f && std::abs(LabF.B - BF) < 1.e-5f,
+					"Float CIELAB of (%f, %f, %f) does not round trip", RD, GD, BD);
+			}
+		}
+	}
+}
+
+COLORMATH_TEST(ColorDifference)
+{
+	const TLab<double> Colors[] = {
+		{ 50.0, 2.6772, -79.7751 }, { 50.0, 0.0, -82.7485 }, { 60.2574, -34.0099, 36.2677 }, { 63.0109, -31.0961, -5.8663 },
+		{ 0.0, 0.0, 0.0 }, { 100.0, 0.0, 0.0 }, { 22.7233, 20.0904, -46.694 }, { 90.9257, -0.5406, -0.9208 }
+	};
+
+	for (const TLab<double>& A : Colors)
+	{
+		Context.Check(DeltaE76(A, A) == 0.0 && DeltaE94(A, A) == 0.0 && DeltaE2000(A, A) == 0.0,
+			"Difference of (%f, %f, %f) to itself is not 0", A.L, A.A, A.B);
+
+		for (const TLab<double>& B : Colors)
+		{
+			const double D76 = DeltaE76(A, B);
+			const double D2000 = DeltaE2000(A, B);
+			Context.Check(D76 >= 0.0 && std::abs(D76 - DeltaE76(B, A)) < DoubleTolerance, "DeltaE76 is not symmetric");
+			Context.Check(D2000 >= 0.0 && std::abs(D2000 - DeltaE2000(B, A)) < 1.e-9, "DeltaE2000 is not symmetric");
+		}
+	}
+
+	// Lightness only differences, DeltaE76 is the lightness difference.
+	Context.Check(std::abs(DeltaE76(TLab<double>{ 0.0, 0.0, 0.0 }, TLab<double>{ 100.0, 0.0, 0.0 }) - 100.0) < DoubleTolerance,
+		"DeltaE76 of black and white is not 100");
+}
+//~ End Lab
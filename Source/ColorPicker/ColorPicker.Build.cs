@@ -36,6 +36,7 @@ public class ColorPicker : ModuleRules
 			{
 				"CoreUObject",
 				"Engine",
+				"Json",
 				"Slate",
 				"SlateCore",
 				"UMG"
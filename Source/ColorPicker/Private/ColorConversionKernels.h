@@ -0,0 +1,309 @@
+// Copyright kevin791129
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ColorMath/ColorMath.h"
+#include "ColorMath/ColorMathSRGB.h"
+#include "ColorMath/ColorMathLab.h"
+
+/**
+ * Conversion math shared by the single color and batch conversion functions.
+ * Scalar kernels wrap the engine independent ColorMath core, vector kernels work on 4 colors at a time and produce bit-identical results.
+ */
+namespace ColorConversionKernels
+{
+	/** Number of colors processed by each vector kernel call. */
+	static constexpr int32 VectorWidth = 4;
+
+#pragma region Scalar
+	FORCEINLINE FColor ToFColor(const ColorMath::TRGBA<uint8>& Color)
+	{
+		return FColor(Color.R, Color.G, Color.B, Color.A);
+	}
+
+	FORCEINLINE ColorMath::TRGBA<uint8> ToRGBA(const FColor& Color)
+	{
+		return ColorMath::TRGBA<uint8>{ Color.R, Color.G, Color.B, Color.A };
+	}
+
+	FORCEINLINE void ColorToHSV(const FColor& Color, float& OutH, float& OutS, float& OutV)
+	{
+		ColorMath::RGBToHSV(Color.R, Color.G, Color.B, OutH, OutS, OutV);
+	}
+
+	FORCEINLINE void ColorToCMYK(const FColor& Color, float& OutC, float& OutM, float& OutY, float& OutK)
+	{
+		ColorMath::RGBToCMYK(Color.R, Color.G, Color.B, OutC, OutM, OutY, OutK);
+	}
+
+	FORCEINLINE void ColorToHSL(const FColor& Color, float& OutH, float& OutS, float& OutL)
+	{
+		ColorMath::RGBToHSL(Color.R, Color.G, Color.B, OutH, OutS, OutL);
+	}
+
+	FORCEINLINE FColor HSVToColor(const float H, const float S, const float V)
+	{
+		return ToFColor(ColorMath::HSVToRGB<uint8>(H, S, V));
+	}
+
+	FORCEINLINE FColor CMYKToColor(const float C, const float M, const float Y, const float K)
+	{
+		return ToFColor(ColorMath::CMYKToRGB<uint8>(C, M, Y, K));
+	}
+
+	FORCEINLINE FColor HSLToColor(const float H, const float S, const float L)
+	{
+		return ToFColor(ColorMath::HSLToRGB<uint8>(H, S, L));
+	}
+#pragma endregion
+
+#pragma region Float
+	/** Float kernels skip the 8-bit stage, working on unquantized sRGB floats. */
+	FORCEINLINE ColorMath::TRGBA<float> LinearToSRGBFloat(const FLinearColor& Color)
+	{
+		return ColorMath::TRGBA<float>{ ColorMath::SRGB::EncodeReal(Color.R), ColorMath::SRGB::EncodeReal(Color.G), ColorMath::SRGB::EncodeReal(Color.B), Color.A };
+	}
+
+	FORCEINLINE FLinearColor SRGBFloatToLinear(const ColorMath::TRGBA<float>& Color)
+	{
+		return FLinearColor(ColorMath::SRGB::DecodeReal(Color.R), ColorMath::SRGB::DecodeReal(Color.G), ColorMath::SRGB::DecodeReal(Color.B), Color.A);
+	}
+
+	FORCEINLINE void LinearToHSVFloat(const FLinearColor& Color, float& OutH, float& OutS, float& OutV)
+	{
+		const ColorMath::TRGBA<float> SRGB = LinearToSRGBFloat(Color);
+		ColorMath::RGBToHSV(SRGB.R, SRGB.G, SRGB.B, OutH, OutS, OutV);
+	}
+
+	FORCEINLINE void LinearToCMYKFloat(const FLinearColor& Color, float& OutC, float& OutM, float& OutY, float& OutK)
+	{
+		const ColorMath::TRGBA<float> SRGB = LinearToSRGBFloat(Color);
+		ColorMath::RGBToCMYK(SRGB.R, SRGB.G, SRGB.B, OutC, OutM, OutY, OutK);
+	}
+
+	FORCEINLINE void LinearToHSLFloat(const FLinearColor& Color, float& OutH, float& OutS, float& OutL)
+	{
+		const ColorMath::TRGBA<float> SRGB = LinearToSRGBFloat(Color);
+		ColorMath::RGBToHSL(SRGB.R, SRGB.G, SRGB.B, OutH, OutS, OutL);
+	}
+
+	FORCEINLINE FLinearColor HSVToLinearFloat(const float H, const float S, const float V)
+	{
+		return SRGBFloatToLinear(ColorMath::HSVToRGB<float>(H, S, V));
+	}
+
+	FORCEINLINE FLinearColor CMYKToLinearFloat(const float C, const float M, const float Y, const float K)
+	{
+		return SRGBFloatToLinear(ColorMath::CMYKToRGB<float>(C, M, Y, K));
+	}
+
+	FORCEINLINE FLinearColor HSLToLinearFloat(const float H, const float S, const float L)
+	{
+		return SRGBFloatToLinear(ColorMath::HSLToRGB<float>(H, S, L));
+	}
+#pragma endregion
+
+#pragma region Perceptual
+	/** Perceptual colors are stored in FVector as (L, a, b) and computed from linear channels directly. */
+	FORCEINLINE FVector LinearToLab(const FLinearColor& Color)
+	{
+		const ColorMath::TLab<float> Lab = ColorMath::LinearRGBToLab(Color.R, Color.G, Color.B);
+		return FVector(Lab.L, Lab.A, Lab.B);
+	}
+
+	FORCEINLINE FVector LinearToOKLab(const FLinearColor& Color)
+	{
+		const ColorMath::TLab<float> Lab = ColorMath::LinearRGBToOKLab(Color.R, Color.G, Color.B);
+		return FVector(Lab.L, Lab.A, Lab.B);
+	}
+
+	/** Out of gamut results are clipped to [0, 1]. */
+	FORCEINLINE FLinearColor ClipToGamut(const ColorMath::TRGBA<float>& Color)
+	{
+		return FLinearColor(FMath::Clamp(Color.R, 0.f, 1.f), FMath::Clamp(Color.G, 0.f, 1.f), FMath::Clamp(Color.B, 0.f, 1.f), 1.f);
+	}
+
+	FORCEINLINE FLinearColor LabToLinear(const float L, const float A, const float B)
+	{
+		return ClipToGamut(ColorMath::LabToLinearRGB(ColorMath::TLab<float>{ L, A, B }));
+	}
+
+	FORCEINLINE FLinearColor OKLabToLinear(const float L, const float A, const float B)
+	{
+		return ClipToGamut(ColorMath::OKLabToLinearRGB(ColorMath::TLab<float>{ L, A, B }));
+	}
+
+	FORCEINLINE ColorMath::TLab<float> ToLab(const FVector& Lab)
+	{
+		return ColorMath::TLab<float>{ Lab.X, Lab.Y, Lab.Z };
+	}
+#pragma endregion
+
+#pragma region Vector
+	/**
+	 * Vector registers map to SSE or NEON when vector intrinsics are enabled and fall back to FPU math otherwise.
+	 * Only operations that are exact per lane (add, sub, mul, div, compare, select) are used so results match the scalar kernels.
+	 */
+	FORCEINLINE void LoadChannels(const FColor* Colors, VectorRegister& OutR, VectorRegister& OutG, VectorRegister& OutB)
+	{
+		OutR = MakeVectorRegister((float)Colors[0].R, (float)Colors[1].R, (float)Colors[2].R, (float)Colors[3].R);
+		OutG = MakeVectorRegister((float)Colors[0].G, (float)Colors[1].G, (float)Colors[2].G, (float)Colors[3].G);
+		OutB = MakeVectorRegister((float)Colors[0].B, (float)Colors[1].B, (float)Colors[2].B, (float)Colors[3].B);
+	}
+
+	/**
+	 * Clamp selecting in the order of 'ColorMath::Clamp', so NaN clamps to Max as in the scalar kernels.
+	 */
+	FORCEINLINE VectorRegister VectorClamp(const VectorRegister& X, const float Min, const float Max)
+	{
+		const VectorRegister MinValue = VectorSetFloat1(Min);
+		const VectorRegister MaxValue = VectorSetFloat1(Max);
+		return VectorSelect(VectorCompareLT(X, MinValue), MinValue, VectorSelect(VectorCompareLT(X, MaxValue), X, MaxValue));
+	}
+
+	FORCEINLINE VectorRegister VectorHueFromRGB(const VectorRegister& R, const VectorRegister& G, const VectorRegister& B, const VectorRegister& RGBMin, const VectorRegister& RGBMax, const VectorRegister& RGBRange)
+	{
+		const VectorRegister Sixty = VectorSetFloat1(60.0f);
+		const VectorRegister ThreeSixty = VectorSetFloat1(360.0f);
+
+		// Red hue lies in [300, 420], so Fmod reduces to a single exact subtraction.
+		const VectorRegister HueR_Wrapped = VectorAdd(VectorMultiply(VectorDivide(VectorSubtract(G, B), RGBRange), Sixty), ThreeSixty);
+		const VectorRegister HueR = VectorSelect(VectorCompareGE(HueR_Wrapped, ThreeSixty), VectorSubtract(HueR_Wrapped, ThreeSixty), HueR_Wrapped);
+		const VectorRegister HueG = VectorAdd(VectorMultiply(VectorDivide(VectorSubtract(B, R), RGBRange), Sixty), VectorSetFloat1(120.0f));
+		const VectorRegister HueB = VectorAdd(VectorMultiply(VectorDivide(VectorSubtract(R, G), RGBRange), Sixty), VectorSetFloat1(240.0f));
+
+		// Select in reverse priority of the scalar branches.
+		VectorRegister Hue = VectorSelect(VectorCompareEQ(RGBMax, B), HueB, VectorZero());
+		Hue = VectorSelect(VectorCompareEQ(RGBMax, G), HueG, Hue);
+		Hue = VectorSelect(VectorCompareEQ(RGBMax, R), HueR, Hue);
+		return VectorSelect(VectorCompareEQ(RGBMax, RGBMin), VectorZero(), Hue);
+	}
+
+	FORCEINLINE void VectorColorToHSV(const FColor* Colors, float* OutH, float* OutS, float* OutV)
+	{
+		VectorRegister R, G, B;
+		LoadChannels(Colors, R, G, B);
+		const VectorRegister RGBMin = VectorMin(VectorMin(R, G), B);
+		const VectorRegister RGBMax = VectorMax(VectorMax(R, G), B);
+		const VectorRegister RGBRange = VectorSubtract(RGBMax, RGBMin);
+
+		VectorStore(VectorHueFromRGB(R, G, B, RGBMin, RGBMax, RGBRange), OutH);
+		VectorStore(VectorSelect(VectorCompareEQ(RGBMax, VectorZero()), VectorZero(), VectorDivide(RGBRange, RGBMax)), OutS);
+		VectorStore(VectorDivide(RGBMax, VectorSetFloat1(255.f)), OutV);
+	}
+
+	FORCEINLINE void VectorColorToCMYK(const FColor* Colors, float* OutC, float* OutM, float* OutY, float* OutK)
+	{
+		VectorRegister R, G, B;
+		LoadChannels(Colors, R, G, B);
+		const VectorRegister Max = VectorMax(VectorMax(R, G), B);
+
+		VectorStore(VectorDivide(VectorSubtract(Max, R), Max), OutC);
+		VectorStore(VectorDivide(VectorSubtract(Max, G), Max), OutM);
+		VectorStore(VectorDivide(VectorSubtract(Max, B), Max), OutY);
+		VectorStore(VectorSubtract(VectorOne(), VectorDivide(Max, VectorSetFloat1(255.f))), OutK);
+	}
+
+	FORCEINLINE void VectorColorToHSL(const FColor* Colors, float* OutH, float* OutS, float* OutL)
+	{
+		VectorRegister R, G, B;
+		LoadChannels(Colors, R, G, B);
+		const VectorRegister RGBMin = VectorMin(VectorMin(R, G), B);
+		const VectorRegister RGBMax = VectorMax(VectorMax(R, G), B);
+		const VectorRegister RGBRange = VectorSubtract(RGBMax, RGBMin);
+		const VectorRegister RGBSum = VectorAdd(RGBMax, RGBMin);
+		const VectorRegister Full = VectorSetFloat1(255.0f);
+
+		VectorStore(VectorHueFromRGB(R, G, B, RGBMin, RGBMax, RGBRange), OutH);
+		VectorStore(VectorSelect(VectorCompareEQ(RGBMax, VectorZero()), VectorZero(), VectorDivide(RGBRange, VectorSubtract(Full, VectorAbs(VectorSubtract(RGBSum, Full))))), OutS);
+		VectorStore(VectorDivide(RGBSum, VectorSetFloat1(510.0f)), OutL);
+	}
+
+	FORCEINLINE VectorRegister VectorSwizzleSector(const VectorRegister& Sector, const VectorRegister RGBValues[4], const int32 Channel)
+	{
+		// Sector 6 (hue of 360) wraps around to sector 0, which is the default.
+		VectorRegister Result = RGBValues[ColorMath::HueSectorSwizzle[0][Channel]];
+		for (uint32 SectorIndex = 1; SectorIndex < 6; ++SectorIndex)
+		{
+			Result = VectorSelect(VectorCompareEQ(Sector, VectorSetFloat1((float)SectorIndex)), RGBValues[ColorMath::HueSectorSwizzle[SectorIndex][Channel]], Result);
+		}
+		return Result;
+	}
+
+	FORCEINLINE void StoreColors(const VectorRegister& R, const VectorRegister& G, const VectorRegister& B, FColor* OutColors)
+	{
+		float RValues[VectorWidth], GValues[VectorWidth], BValues[VectorWidth];
+		VectorStore(R, RValues);
+		VectorStore(G, GValues);
+		VectorStore(B, BValues);
+
+		for (int32 Lane = 0; Lane < VectorWidth; ++Lane)
+		{
+			OutColors[Lane] = FColor(RValues[Lane], GValues[Lane], BValues[Lane]);
+		}
+	}
+
+	FORCEINLINE void VectorHSVToColor(const float* H, const float* S, const float* V, FColor* OutColors)
+	{
+		const VectorRegister HClamp = VectorClamp(VectorLoad(H), 0.0f, 360.0f);
+		const VectorRegister SClamp = VectorClamp(VectorLoad(S), 0.0f, 1.0f);
+		const VectorRegister VClamp = VectorClamp(VectorLoad(V), 0.0f, 1.0f);
+		const VectorRegister One = VectorOne();
+		const VectorRegister Full = VectorSetFloat1(255.f);
+		const VectorRegister HDiv60 = VectorDivide(HClamp, VectorSetFloat1(60.0f));
+		// Hue is clamped to be positive so truncation equals floor.
+		const VectorRegister HDiv60_Floor = VectorTruncate(HDiv60);
+		const VectorRegister HDiv60_Fraction = VectorSubtract(HDiv60, HDiv60_Floor);
+		const VectorRegister RGBValues[4] = {
+			VectorMultiply(VClamp, Full),
+			VectorMultiply(VectorMultiply(VClamp, VectorSubtract(One, SClamp)), Full),
+			VectorMultiply(VectorMultiply(VClamp, VectorSubtract(One, VectorMultiply(HDiv60_Fraction, SClamp))), Full),
+			VectorMultiply(VectorMultiply(VClamp, VectorSubtract(One, VectorMultiply(VectorSubtract(One, HDiv60_Fraction), SClamp))), Full)
+		};
+
+		StoreColors(VectorSwizzleSector(HDiv60_Floor, RGBValues, 0),
+			VectorSwizzleSector(HDiv60_Floor, RGBValues, 1),
+			VectorSwizzleSector(HDiv60_Floor, RGBValues, 2),
+			OutColors);
+	}
+
+	FORCEINLINE void VectorCMYKToColor(const float* C, const float* M, const float* Y, const float* K, FColor* OutColors)
+	{
+		const VectorRegister One = VectorOne();
+		const VectorRegister Full = VectorSetFloat1(255.f);
+		const VectorRegister KInverse = VectorSubtract(One, VectorClamp(VectorLoad(K), 0.0f, 1.0f));
+
+		StoreColors(VectorMultiply(VectorMultiply(Full, VectorSubtract(One, VectorClamp(VectorLoad(C), 0.0f, 1.0f))), KInverse),
+			VectorMultiply(VectorMultiply(Full, VectorSubtract(One, VectorClamp(VectorLoad(M), 0.0f, 1.0f))), KInverse),
+			VectorMultiply(VectorMultiply(Full, VectorSubtract(One, VectorClamp(VectorLoad(Y), 0.0f, 1.0f))), KInverse),
+			OutColors);
+	}
+
+	FORCEINLINE void VectorHSLToColor(const float* H, const float* S, const float* L, FColor* OutColors)
+	{
+		const VectorRegister HClamp = VectorClamp(VectorLoad(H), 0.0f, 360.0f);
+		const VectorRegister SClamp = VectorClamp(VectorLoad(S), 0.0f, 1.0f);
+		const VectorRegister LClamp = VectorClamp(VectorLoad(L), 0.0f, 1.0f);
+		const VectorRegister One = VectorOne();
+		const VectorRegister Two = VectorSetFloat1(2.0f);
+		const VectorRegister Full = VectorSetFloat1(255.f);
+		const VectorRegister CHalf = VectorDivide(VectorMultiply(VectorSubtract(One, VectorAbs(VectorSubtract(VectorMultiply(Two, LClamp), One))), SClamp), Two);
+		const VectorRegister HDiv60 = VectorDivide(HClamp, VectorSetFloat1(60.0f));
+		// Hue is clamped to be positive so truncation equals floor.
+		const VectorRegister HDiv60_Floor = VectorTruncate(HDiv60);
+		const VectorRegister HDiv60_Fraction_Double = VectorMultiply(VectorSubtract(HDiv60, HDiv60_Floor), Two);
+		const VectorRegister RGBValues[4] = {
+			VectorMultiply(VectorAdd(LClamp, CHalf), Full),
+			VectorMultiply(VectorSubtract(LClamp, CHalf), Full),
+			VectorMultiply(VectorAdd(LClamp, VectorMultiply(CHalf, VectorSubtract(One, HDiv60_Fraction_Double))), Full),
+			VectorMultiply(VectorAdd(LClamp, VectorMultiply(CHalf, VectorSubtract(HDiv60_Fraction_Double, One))), Full)
+		};
+
+		StoreColors(VectorSwizzleSector(HDiv60_Floor, RGBValues, 0),
+			VectorSwizzleSector(HDiv60_Floor, RGBValues, 1),
+			VectorSwizzleSector(HDiv60_Floor, RGBValues, 2),
+			OutColors);
+	}
+#pragma endregion
+}
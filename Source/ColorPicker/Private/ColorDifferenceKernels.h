@@ -0,0 +1,176 @@
+// Copyright kevin791129
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ColorMath/ColorMathLab.h"
+#include "ColorConversionKernels.h"
+
+/**
+ * Color difference math shared by the single color and batch functions.
+ * Vector kernels compute 4 color pairs at a time. Unlike the conversion kernels they rely on vector square root and trigonometry,
+ * so results agree with the scalar ColorMath functions to float rounding rather than bit for bit.
+ */
+namespace ColorDifferenceKernels
+{
+	using ColorConversionKernels::VectorWidth;
+
+#pragma region Scalar
+	FORCEINLINE float DeltaE76(const FVector& Lab1, const FVector& Lab2)
+	{
+		return ColorMath::DeltaE76(ColorConversionKernels::ToLab(Lab1), ColorConversionKernels::ToLab(Lab2));
+	}
+
+	FORCEINLINE float DeltaE94(const FVector& Lab1, const FVector& Lab2)
+	{
+		return ColorMath::DeltaE94(ColorConversionKernels::ToLab(Lab1), ColorConversionKernels::ToLab(Lab2));
+	}
+
+	FORCEINLINE float DeltaE2000(const FVector& Lab1, const FVector& Lab2)
+	{
+		return ColorMath::DeltaE2000(ColorConversionKernels::ToLab(Lab1), ColorConversionKernels::ToLab(Lab2));
+	}
+#pragma endregion
+
+#pragma region Vector
+	/**
+	 * Lab colors of 4 pairs, one lane per pair.
+	 */
+	struct FLabRegisters
+	{
+		VectorRegister L;
+		VectorRegister A;
+		VectorRegister B;
+	};
+
+	FORCEINLINE FLabRegisters LoadLab(const FVector* Colors)
+	{
+		return {
+			MakeVectorRegister(Colors[0].X, Colors[1].X, Colors[2].X, Colors[3].X),
+			MakeVectorRegister(Colors[0].Y, Colors[1].Y, Colors[2].Y, Colors[3].Y),
+			MakeVectorRegister(Colors[0].Z, Colors[1].Z, Colors[2].Z, Colors[3].Z)
+		};
+	}
+
+	FORCEINLINE FLabRegisters SplatLab(const FVector& Color)
+	{
+		return { VectorSetFloat1(Color.X), VectorSetFloat1(Color.Y), VectorSetFloat1(Color.Z) };
+	}
+
+	/** Square root that is zero for non-positive lanes, where the reciprocal square root would be infinite. */
+	FORCEINLINE VectorRegister VectorSafeSqrt(const VectorRegister& X)
+	{
+		return VectorSelect(VectorCompareGT(X, VectorZero()), VectorMultiply(X, VectorReciprocalSqrtAccurate(X)), VectorZero());
+	}
+
+	FORCEINLINE VectorRegister VectorSquare(const VectorRegister& X)
+	{
+		return VectorMultiply(X, X);
+	}
+
+	FORCEINLINE VectorRegister VectorPow7(const VectorRegister& X)
+	{
+		const VectorRegister X2 = VectorSquare(X);
+		return VectorMultiply(VectorMultiply(X2, X2), VectorMultiply(X2, X));
+	}
+
+	FORCEINLINE VectorRegister VectorDeltaE76(const FLabRegisters& Lab1, const FLabRegisters& Lab2)
+	{
+		const VectorRegister DL = VectorSubtract(Lab1.L, Lab2.L);
+		const VectorRegister DA = VectorSubtract(Lab1.A, Lab2.A);
+		const VectorRegister DB = VectorSubtract(Lab1.B, Lab2.B);
+		return VectorSafeSqrt(VectorAdd(VectorAdd(VectorSquare(DL), VectorSquare(DA)), VectorSquare(DB)));
+	}
+
+	FORCEINLINE VectorRegister VectorDeltaE94(const FLabRegisters& Lab1, const FLabRegisters& Lab2)
+	{
+		const VectorRegister One = VectorOne();
+		const VectorRegister C1 = VectorSafeSqrt(VectorAdd(VectorSquare(Lab1.A), VectorSquare(Lab1.B)));
+		const VectorRegister C2 = VectorSafeSqrt(VectorAdd(VectorSquare(Lab2.A), VectorSquare(Lab2.B)));
+		const VectorRegister DL = VectorSubtract(Lab1.L, Lab2.L);
+		const VectorRegister DC = VectorSubtract(C1, C2);
+		const VectorRegister DA = VectorSubtract(Lab1.A, Lab2.A);
+		const VectorRegister DB = VectorSubtract(Lab1.B, Lab2.B);
+		const VectorRegister DH2 = VectorMax(VectorSubtract(VectorAdd(VectorSquare(DA), VectorSquare(DB)), VectorSquare(DC)), VectorZero());
+		const VectorRegister SC = VectorAdd(One, VectorMultiply(VectorSetFloat1(0.045f), C1));
+		const VectorRegister SH = VectorAdd(One, VectorMultiply(VectorSetFloat1(0.015f), C1));
+
+		return VectorSafeSqrt(VectorAdd(VectorAdd(VectorSquare(DL), VectorSquare(VectorDivide(DC, SC))), VectorDivide(DH2, VectorSquare(SH))));
+	}
+
+	/**
+	 * Same branches as 'ColorMath::DeltaE2000' expressed as selects, hue angles are kept in radians.
+	 */
+	FORCEINLINE VectorRegister VectorDeltaE2000(const FLabRegisters& Lab1, const FLabRegisters& Lab2)
+	{
+		const VectorRegister Zero = VectorZero();
+		const VectorRegister One = VectorOne();
+		const VectorRegister Half = VectorSetFloat1(0.5f);
+		const VectorRegister Pi = VectorSetFloat1(PI);
+		const VectorRegister TwoPi = VectorSetFloat1(2.f * PI);
+		const VectorRegister DegToRad = VectorSetFloat1(PI / 180.f);
+		const VectorRegister Pow25_7 = VectorSetFloat1(6103515625.f);
+
+		const VectorRegister C1 = VectorSafeSqrt(VectorAdd(VectorSquare(Lab1.A), VectorSquare(Lab1.B)));
+		const VectorRegister C2 = VectorSafeSqrt(VectorAdd(VectorSquare(Lab2.A), VectorSquare(Lab2.B)));
+		const VectorRegister CMean7 = VectorPow7(VectorMultiply(VectorAdd(C1, C2), Half));
+		const VectorRegister GPlusOne = VectorAdd(One, VectorMultiply(Half, VectorSubtract(One, VectorSafeSqrt(VectorDivide(CMean7, VectorAdd(CMean7, Pow25_7))))));
+
+		const VectorRegister A1 = VectorMultiply(GPlusOne, Lab1.A);
+		const VectorRegister A2 = VectorMultiply(GPlusOne, Lab2.A);
+		const VectorRegister C1Prime = VectorSafeSqrt(VectorAdd(VectorSquare(A1), VectorSquare(Lab1.B)));
+		const VectorRegister C2Prime = VectorSafeSqrt(VectorAdd(VectorSquare(A2), VectorSquare(Lab2.B)));
+
+		// Hue is zero for neutral colors, not left to how atan2 treats two zeros.
+		VectorRegister H1Prime = VectorATan2(Lab1.B, A1);
+		VectorRegister H2Prime = VectorATan2(Lab2.B, A2);
+		H1Prime = VectorSelect(VectorCompareLT(H1Prime, Zero), VectorAdd(H1Prime, TwoPi), H1Prime);
+		H2Prime = VectorSelect(VectorCompareLT(H2Prime, Zero), VectorAdd(H2Prime, TwoPi), H2Prime);
+		H1Prime = VectorSelect(VectorCompareEQ(C1Prime, Zero), Zero, H1Prime);
+		H2Prime = VectorSelect(VectorCompareEQ(C2Prime, Zero), Zero, H2Prime);
+
+		const VectorRegister CProduct = VectorMultiply(C1Prime, C2Prime);
+		const VectorRegister Chromatic = VectorCompareNE(CProduct, Zero);
+		const VectorRegister HDifference = VectorSubtract(H2Prime, H1Prime);
+		const VectorRegister HSum = VectorAdd(H1Prime, H2Prime);
+		// Same tie handling as the scalar function, hues half a turn apart within tolerance are not wrapped.
+		const VectorRegister HalfTurn = VectorSetFloat1(PI + (float)ColorMath::HueTieTolerance * PI / 180.f);
+		const VectorRegister bHueWraps = VectorCompareGT(VectorAbs(HDifference), HalfTurn);
+
+		VectorRegister DHPrime = VectorSelect(VectorCompareGT(HDifference, HalfTurn), VectorSubtract(HDifference, TwoPi), HDifference);
+		DHPrime = VectorSelect(VectorCompareLT(HDifference, VectorNegate(HalfTurn)), VectorAdd(HDifference, TwoPi), DHPrime);
+		DHPrime = VectorSelect(Chromatic, DHPrime, Zero);
+
+		const VectorRegister HSumWrapped = VectorSelect(VectorCompareLT(HSum, TwoPi), VectorAdd(HSum, TwoPi), VectorSubtract(HSum, TwoPi));
+		VectorRegister HMean = VectorMultiply(VectorSelect(bHueWraps, HSumWrapped, HSum), Half);
+		HMean = VectorSelect(Chromatic, HMean, HSum);
+
+		const VectorRegister DLPrime = VectorSubtract(Lab2.L, Lab1.L);
+		const VectorRegister DCPrime = VectorSubtract(C2Prime, C1Prime);
+		const VectorRegister DHPrimeBig = VectorMultiply(VectorMultiply(VectorSetFloat1(2.f), VectorSafeSqrt(CProduct)), VectorSin(VectorMultiply(DHPrime, Half)));
+
+		const VectorRegister LMean = VectorMultiply(VectorAdd(Lab1.L, Lab2.L), Half);
+		const VectorRegister CPrimeMean = VectorMultiply(VectorAdd(C1Prime, C2Prime), Half);
+		VectorRegister T = VectorSubtract(One, VectorMultiply(VectorSetFloat1(0.17f), VectorCos(VectorSubtract(HMean, VectorSetFloat1(30.f * PI / 180.f)))));
+		T = VectorAdd(T, VectorMultiply(VectorSetFloat1(0.24f), VectorCos(VectorMultiply(VectorSetFloat1(2.f), HMean))));
+		T = VectorAdd(T, VectorMultiply(VectorSetFloat1(0.32f), VectorCos(VectorAdd(VectorMultiply(VectorSetFloat1(3.f), HMean), VectorSetFloat1(6.f * PI / 180.f)))));
+		T = VectorSubtract(T, VectorMultiply(VectorSetFloat1(0.20f), VectorCos(VectorSubtract(VectorMultiply(VectorSetFloat1(4.f), HMean), VectorSetFloat1(63.f * PI / 180.f)))));
+
+		const VectorRegister HExponent = VectorDivide(VectorSubtract(VectorDivide(HMean, DegToRad), VectorSetFloat1(275.f)), VectorSetFloat1(25.f));
+		const VectorRegister DTheta = VectorMultiply(VectorSetFloat1(30.f * PI / 180.f), VectorExp(VectorNegate(VectorSquare(HExponent))));
+		const VectorRegister CPrimeMean7 = VectorPow7(CPrimeMean);
+		const VectorRegister RC = VectorMultiply(VectorSetFloat1(2.f), VectorSafeSqrt(VectorDivide(CPrimeMean7, VectorAdd(CPrimeMean7, Pow25_7))));
+		const VectorRegister LOffset2 = VectorSquare(VectorSubtract(LMean, VectorSetFloat1(50.f)));
+		const VectorRegister SL = VectorAdd(One, VectorDivide(VectorMultiply(VectorSetFloat1(0.015f), LOffset2), VectorSafeSqrt(VectorAdd(VectorSetFloat1(20.f), LOffset2))));
+		const VectorRegister SC = VectorAdd(One, VectorMultiply(VectorSetFloat1(0.045f), CPrimeMean));
+		const VectorRegister SH = VectorAdd(One, VectorMultiply(VectorMultiply(VectorSetFloat1(0.015f), CPrimeMean), T));
+		const VectorRegister RT = VectorNegate(VectorMultiply(VectorSin(VectorMultiply(VectorSetFloat1(2.f), DTheta)), RC));
+
+		const VectorRegister LTerm = VectorDivide(DLPrime, SL);
+		const VectorRegister CTerm = VectorDivide(DCPrime, SC);
+		const VectorRegister HTerm = VectorDivide(DHPrimeBig, SH);
+		const VectorRegister Sum = VectorAdd(VectorAdd(VectorSquare(LTerm), VectorSquare(CTerm)), VectorAdd(VectorSquare(HTerm), VectorMultiply(RT, VectorMultiply(CTerm, HTerm))));
+		return VectorSafeSqrt(Sum);
+	}
+#pragma endregion
+}
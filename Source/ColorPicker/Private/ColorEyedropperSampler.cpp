@@ -0,0 +1,152 @@
+// Copyright kevin791129
+
+#include "ColorEyedropperSampler.h"
+#include "SRGBTransfer.h"
+#include "Async/ParallelFor.h"
+
+namespace
+{
+	/** Fixed point scale of a full linear channel. */
+	constexpr float FixedScale = 65535.f;
+
+	FORCEINLINE uint32 ToFixed(const float Value)
+	{
+		return (uint32)(FMath::Clamp(Value, 0.f, 1.f) * FixedScale + 0.5f);
+	}
+
+	/** Fixed point linear value of every sRGB code. */
+	struct FDecodeTable
+	{
+		FDecodeTable()
+		{
+			for (int32 Code = 0; Code < 256; ++Code)
+			{
+				Values[Code] = ToFixed(SRGBTransfer::Decode((uint8)Code));
+			}
+		}
+
+		uint32 Values[256];
+	};
+}
+
+void FColorEyedropperSampler::Build(TArrayView<const FColor> Pixels, const FIntPoint& InSize)
+{
+	check(Pixels.Num() == InSize.X * InSize.Y);
+
+	static const FDecodeTable DecodeTable;
+	BuildTable(Pixels.GetData(), InSize, [](const FColor& Pixel, FSum& OutSum)
+	{
+		OutSum.R = DecodeTable.Values[Pixel.R];
+		OutSum.G = DecodeTable.Values[Pixel.G];
+		OutSum.B = DecodeTable.Values[Pixel.B];
+		// Alpha is linear, 257 maps 255 to a full 16-bit channel exactly.
+		OutSum.A = (uint32)Pixel.A * 257;
+	});
+}
+
+void FColorEyedropperSampler::Build(TArrayView<const FLinearColor> Pixels, const FIntPoint& InSize)
+{
+	check(Pixels.Num() == InSize.X * InSize.Y);
+
+	BuildTable(Pixels.GetData(), InSize, [](const FLinearColor& Pixel, FSum& OutSum)
+	{
+		OutSum.R = ToFixed(Pixel.R);
+		OutSum.G = ToFixed(Pixel.G);
+		OutSum.B = ToFixed(Pixel.B);
+		OutSum.A = ToFixed(Pixel.A);
+	});
+}
+
+template<typename PixelType, typename PixelToFixedType>
+void FColorEyedropperSampler::BuildTable(const PixelType* Pixels, const FIntPoint& InSize, PixelToFixedType PixelToFixed)
+{
+	Size = FIntPoint(FMath::Max(InSize.X, 0), FMath::Max(InSize.Y, 0));
+	if (Size.X == 0 || Size.Y == 0)
+	{
+		Reset();
+		return;
+	}
+
+	const int32 Stride = Size.X + 1;
+	Table.SetNumUninitialized(Stride * (Size.Y + 1));
+	FMemory::Memzero(Table.GetData(), Stride * sizeof(FSum));
+
+	// Prefix sums along rows, every row is independent.
+	const int32 NumRowTasks = FMath::DivideAndRoundUp(Size.Y, LinesPerTask);
+	ParallelFor(NumRowTasks, [this, Pixels, Stride, &PixelToFixed](const int32 Task)
+	{
+		const int32 EndY = FMath::Min((Task + 1) * LinesPerTask, Size.Y);
+		for (int32 Y = Task * LinesPerTask; Y < EndY; ++Y)
+		{
+			const PixelType* Row = Pixels + Y * Size.X;
+			FSum* TableRow = Table.GetData() + (Y + 1) * Stride;
+			FSum Running = { 0, 0, 0, 0 };
+			TableRow[0] = Running;
+			for (int32 X = 0; X < Size.X; ++X)
+			{
+				FSum Pixel;
+				PixelToFixed(Row[X], Pixel);
+				Running.R += Pixel.R;
+				Running.G += Pixel.G;
+				Running.B += Pixel.B;
+				Running.A += Pixel.A;
+				TableRow[X + 1] = Running;
+			}
+		}
+	}, NumRowTasks <= 1);
+
+	// Prefix sums down columns, tasks own column strips and walk rows in order so reads stay sequential.
+	const int32 NumColumnTasks = FMath::DivideAndRoundUp(Stride, LinesPerTask);
+	ParallelFor(NumColumnTasks, [this, Stride](const int32 Task)
+	{
+		const int32 BeginX = Task * LinesPerTask;
+		const int32 EndX = FMath::Min(BeginX + LinesPerTask, Stride);
+		for (int32 Y = 2; Y <= Size.Y; ++Y)
+		{
+			const FSum* Above = Table.GetData() + (Y - 1) * Stride;
+			FSum* Row = Table.GetData() + Y * Stride;
+			for (int32 X = BeginX; X < EndX; ++X)
+			{
+				Row[X].R += Above[X].R;
+				Row[X].G += Above[X].G;
+				Row[X].B += Above[X].B;
+				Row[X].A += Above[X].A;
+			}
+		}
+	}, NumColumnTasks <= 1);
+}
+
+void FColorEyedropperSampler::Reset()
+{
+	Table.Empty();
+	Size = FIntPoint::ZeroValue;
+}
+
+bool FColorEyedropperSampler::Sample(const FIntPoint& Center, const int32 Radius, FLinearColor& OutColor) const
+{
+	if (IsEmpty())
+		return false;
+
+	const int32 ClampedRadius = FMath::Clamp(Radius, 0, MaxRadius);
+	const int32 MinX = FMath::Max(Center.X - ClampedRadius, 0);
+	const int32 MinY = FMath::Max(Center.Y - ClampedRadius, 0);
+	const int32 MaxX = FMath::Min(Center.X + ClampedRadius + 1, Size.X);
+	const int32 MaxY = FMath::Min(Center.Y + ClampedRadius + 1, Size.Y);
+	if (MinX >= MaxX || MinY >= MaxY)
+		return false;
+
+	// Wrapping subtraction gives the exact area sum since it fits in 32 bits.
+	const int32 Stride = Size.X + 1;
+	const FSum& TopLeft = Table[MinY * Stride + MinX];
+	const FSum& TopRight = Table[MinY * Stride + MaxX];
+	const FSum& BottomLeft = Table[MaxY * Stride + MinX];
+	const FSum& BottomRight = Table[MaxY * Stride + MaxX];
+
+	const float Scale = 1.f / (FixedScale * (float)((MaxX - MinX) * (MaxY - MinY)));
+	OutColor = FLinearColor(
+		(float)(BottomRight.R - TopRight.R - BottomLeft.R + TopLeft.R) * Scale,
+		(float)(BottomRight.G - TopRight.G - BottomLeft.G + TopLeft.G) * Scale,
+		(float)(BottomRight.B - TopRight.B - BottomLeft.B + TopLeft.B) * Scale,
+		(float)(BottomRight.A - TopRight.A - BottomLeft.A + TopLeft.A) * Scale);
+	return true;
+}
@@ -0,0 +1,45 @@
+// Copyright kevin791129
+
+#include "ColorFormatConverter.h"
+
+namespace ColorFormatConverter
+{
+	namespace
+	{
+		template<EColorFormat From, EColorFormat To>
+		FColorChannels ConvertEntry(const FColorChannels& Value)
+		{
+			return TConverter<From, To>::Convert(Value);
+		}
+
+#define COLOR_FORMAT_CONVERTER(From, To) { &ConvertEntry<From, EColorFormat::To>, &ConvertBatch<From, EColorFormat::To> }
+#define COLOR_FORMAT_CONVERTER_ROW(From) { \
+			COLOR_FORMAT_CONVERTER(From, CF_HEX), \
+			COLOR_FORMAT_CONVERTER(From, CF_RBG), \
+			COLOR_FORMAT_CONVERTER(From, CF_HSV), \
+			COLOR_FORMAT_CONVERTER(From, CF_CMYK), \
+			COLOR_FORMAT_CONVERTER(From, CF_HSL), \
+			COLOR_FORMAT_CONVERTER(From, CF_LAB), \
+			COLOR_FORMAT_CONVERTER(From, CF_OKLAB) }
+
+		/** Converters indexed by source then destination format, rows and columns follow EColorFormat order. */
+		const FConverter Converters[NumFormats][NumFormats] = {
+			COLOR_FORMAT_CONVERTER_ROW(EColorFormat::CF_HEX),
+			COLOR_FORMAT_CONVERTER_ROW(EColorFormat::CF_RBG),
+			COLOR_FORMAT_CONVERTER_ROW(EColorFormat::CF_HSV),
+			COLOR_FORMAT_CONVERTER_ROW(EColorFormat::CF_CMYK),
+			COLOR_FORMAT_CONVERTER_ROW(EColorFormat::CF_HSL),
+			COLOR_FORMAT_CONVERTER_ROW(EColorFormat::CF_LAB),
+			COLOR_FORMAT_CONVERTER_ROW(EColorFormat::CF_OKLAB)
+		};
+
+#undef COLOR_FORMAT_CONVERTER_ROW
+#undef COLOR_FORMAT_CONVERTER
+	}
+
+	const FConverter& GetConverter(const EColorFormat From, const EColorFormat To)
+	{
+		check((int32)From < NumFormats && (int32)To < NumFormats);
+		return Converters[(int32)From][(int32)To];
+	}
+}
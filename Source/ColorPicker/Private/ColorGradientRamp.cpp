@@ -0,0 +1,313 @@
+// Copyright kevin791129
+
+#include "ColorGradientRamp.h"
+#include "ColorConversionKernels.h"
+#include "ColorPickerStats.h"
+#include "SRGBTransfer.h"
+#include "Algo/BinarySearch.h"
+#include "Algo/StableSort.h"
+#include "Async/ParallelFor.h"
+
+DECLARE_CYCLE_STAT(TEXT("Gradient Ramp Bake"), STAT_ColorPickerRampBake, STATGROUP_ColorPicker);
+DECLARE_CYCLE_STAT(TEXT("Gradient Ramp Batch Sample"), STAT_ColorPickerRampBatchSample, STATGROUP_ColorPicker);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Gradient Ramp Samples"), STAT_ColorPickerRampSamples, STATGROUP_ColorPicker);
+
+namespace
+{
+	/**
+	 * Stop color in the interpolation space, hue first for HSV and HSL.
+	 */
+	struct FSpaceColor
+	{
+		float X;
+		float Y;
+		float Z;
+		float A;
+	};
+
+	FSpaceColor ToSpace(const EColorRampInterpolation Interpolation, const FLinearColor& Color)
+	{
+		FSpaceColor Result = { Color.R, Color.G, Color.B, Color.A };
+		switch (Interpolation)
+		{
+		case EColorRampInterpolation::CRI_SRGB:
+		{
+			const ColorMath::TRGBA<float> Encoded = ColorConversionKernels::LinearToSRGBFloat(Color);
+			Result.X = Encoded.R;
+			Result.Y = Encoded.G;
+			Result.Z = Encoded.B;
+			break;
+		}
+		case EColorRampInterpolation::CRI_HSV:
+			ColorConversionKernels::LinearToHSVFloat(Color, Result.X, Result.Y, Result.Z);
+			break;
+		case EColorRampInterpolation::CRI_HSL:
+			ColorConversionKernels::LinearToHSLFloat(Color, Result.X, Result.Y, Result.Z);
+			break;
+		case EColorRampInterpolation::CRI_OKLAB:
+		{
+			const FVector Lab = ColorConversionKernels::LinearToOKLab(Color);
+			Result.X = Lab.X;
+			Result.Y = Lab.Y;
+			Result.Z = Lab.Z;
+			break;
+		}
+		default:
+			break;
+		}
+		return Result;
+	}
+
+	FLinearColor FromSpace(const EColorRampInterpolation Interpolation, const FSpaceColor& Value)
+	{
+		FLinearColor Result;
+		switch (Interpolation)
+		{
+		case EColorRampInterpolation::CRI_SRGB:
+			Result = ColorConversionKernels::SRGBFloatToLinear(ColorMath::TRGBA<float>{ Value.X, Value.Y, Value.Z, Value.A });
+			break;
+		case EColorRampInterpolation::CRI_HSV:
+			Result = ColorConversionKernels::HSVToLinearFloat(Value.X, Value.Y, Value.Z);
+			break;
+		case EColorRampInterpolation::CRI_HSL:
+			Result = ColorConversionKernels::HSLToLinearFloat(Value.X, Value.Y, Value.Z);
+			break;
+		case EColorRampInterpolation::CRI_OKLAB:
+			Result = ColorConversionKernels::OKLabToLinear(Value.X, Value.Y, Value.Z);
+			break;
+		default:
+			Result = FLinearColor(Value.X, Value.Y, Value.Z);
+			break;
+		}
+		Result.A = Value.A;
+		return Result;
+	}
+
+	/**
+	 * Interpolate two stops in their interpolation space.
+	 *
+	 * @param From, To : Stop colors in interpolation space.
+	 * @param Alpha : Fraction of the way from From to To, range: [0, 1].
+	 * @return Linear color.
+	 */
+	FLinearColor InterpolateSpace(const EColorRampInterpolation Interpolation, const FSpaceColor& From, const FSpaceColor& To, const float Alpha)
+	{
+		FSpaceColor Result = {
+			FMath::Lerp(From.X, To.X, Alpha),
+			FMath::Lerp(From.Y, To.Y, Alpha),
+			FMath::Lerp(From.Z, To.Z, Alpha),
+			FMath::Lerp(From.A, To.A, Alpha)
+		};
+
+		if (Interpolation == EColorRampInterpolation::CRI_HSV || Interpolation == EColorRampInterpolation::CRI_HSL)
+		{
+			// Grays have no hue, take the other stop's hue so fading to gray does not sweep through other hues.
+			float FromHue = From.X;
+			float ToHue = To.X;
+			if (From.Y == 0.f)
+				FromHue = ToHue;
+			else if (To.Y == 0.f)
+				ToHue = FromHue;
+
+			float Delta = ToHue - FromHue;
+			if (Delta > 180.f)
+				Delta -= 360.f;
+			else if (Delta < -180.f)
+				Delta += 360.f;
+
+			float Hue = FromHue + Delta * Alpha;
+			if (Hue < 0.f)
+				Hue += 360.f;
+			else if (Hue >= 360.f)
+				Hue -= 360.f;
+			Result.X = Hue;
+		}
+
+		return FromSpace(Interpolation, Result);
+	}
+
+	/**
+	 * Index of the stop ending the segment containing a time, first stop strictly after it.
+	 */
+	FORCEINLINE int32 FindSegmentEnd(const TArray<FColorRampStop>& Stops, const float Time)
+	{
+		return Algo::UpperBoundBy(Stops, Time, [](const FColorRampStop& Stop) { return Stop.Time; });
+	}
+
+	FORCEINLINE float ClampTime(const float Time)
+	{
+		// Comparisons are false for NaN, which clamps to 0.
+		return Time > 0.f ? (Time < 1.f ? Time : 1.f) : 0.f;
+	}
+}
+
+FColorGradientRamp::FColorGradientRamp(const EColorRampInterpolation InInterpolation, const int32 InResolution)
+	: Interpolation(InInterpolation)
+	, Resolution(FMath::Max(InResolution, 2))
+{
+}
+
+#pragma region Stops
+void FColorGradientRamp::SetStops(TArrayView<const FColorRampStop> InStops)
+{
+	Stops = InStops;
+	for (FColorRampStop& Stop : Stops)
+	{
+		Stop.Time = ClampTime(Stop.Time);
+	}
+	Algo::StableSortBy(Stops, [](const FColorRampStop& Stop) { return Stop.Time; });
+	Invalidate();
+}
+
+void FColorGradientRamp::AddStop(const float Time, const FLinearColor& Color)
+{
+	const float Clamped = ClampTime(Time);
+	Stops.Insert({ Clamped, Color }, FindSegmentEnd(Stops, Clamped));
+	Invalidate();
+}
+
+void FColorGradientRamp::ClearStops()
+{
+	Stops.Reset();
+	Invalidate();
+}
+
+void FColorGradientRamp::SetInterpolation(const EColorRampInterpolation InInterpolation)
+{
+	if (Interpolation == InInterpolation)
+		return;
+
+	Interpolation = InInterpolation;
+	Invalidate();
+}
+
+void FColorGradientRamp::SetResolution(const int32 InResolution)
+{
+	const int32 Clamped = FMath::Max(InResolution, 2);
+	if (Resolution == Clamped)
+		return;
+
+	Resolution = Clamped;
+	Invalidate();
+}
+#pragma endregion
+
+#pragma region Sampling
+void FColorGradientRamp::Bake() const
+{
+	if (!bTableDirty)
+		return;
+
+	COLORPICKER_SCOPE_CYCLE_COUNTER(STAT_ColorPickerRampBake, GradientRampBake);
+
+	Table.SetNumUninitialized(Resolution);
+	ColorTable.SetNumUninitialized(Resolution);
+
+	if (Stops.Num() == 0)
+	{
+		for (int32 Index = 0; Index < Resolution; ++Index)
+		{
+			Table[Index] = FLinearColor::Transparent;
+			ColorTable[Index] = FColor::Transparent;
+		}
+		bTableDirty = false;
+		return;
+	}
+
+	// Convert every stop once, then walk table entries and segments together.
+	TArray<FSpaceColor, TInlineAllocator<16>> SpaceColors;
+	SpaceColors.Reserve(Stops.Num());
+	for (const FColorRampStop& Stop : Stops)
+	{
+		SpaceColors.Add(ToSpace(Interpolation, Stop.Color));
+	}
+
+	int32 SegmentEnd = 0;
+	for (int32 Index = 0; Index < Resolution; ++Index)
+	{
+		const float Time = (float)Index / (float)(Resolution - 1);
+		while (SegmentEnd < Stops.Num() && Stops[SegmentEnd].Time <= Time)
+		{
+			++SegmentEnd;
+		}
+
+		FLinearColor& Entry = Table[Index];
+		if (SegmentEnd == 0)
+		{
+			Entry = Stops[0].Color;
+		}
+		else if (SegmentEnd == Stops.Num())
+		{
+			Entry = Stops.Last().Color;
+		}
+		else
+		{
+			const FColorRampStop& From = Stops[SegmentEnd - 1];
+			const FColorRampStop& To = Stops[SegmentEnd];
+			const float Alpha = (Time - From.Time) / (To.Time - From.Time);
+			Entry = InterpolateSpace(Interpolation, SpaceColors[SegmentEnd - 1], SpaceColors[SegmentEnd], Alpha);
+		}
+		ColorTable[Index] = SRGBTransfer::ToFColor(Entry);
+	}
+
+	bTableDirty = false;
+}
+
+FLinearColor FColorGradientRamp::Evaluate(const float Time) const
+{
+	if (Stops.Num() == 0)
+		return FLinearColor::Transparent;
+
+	const float Clamped = ClampTime(Time);
+	const int32 SegmentEnd = FindSegmentEnd(Stops, Clamped);
+	if (SegmentEnd == 0)
+		return Stops[0].Color;
+	if (SegmentEnd == Stops.Num())
+		return Stops.Last().Color;
+
+	const FColorRampStop& From = Stops[SegmentEnd - 1];
+	const FColorRampStop& To = Stops[SegmentEnd];
+	const float Alpha = (Clamped - From.Time) / (To.Time - From.Time);
+	return InterpolateSpace(Interpolation, ToSpace(Interpolation, From.Color), ToSpace(Interpolation, To.Color), Alpha);
+}
+
+void FColorGradientRamp::SampleBatch(TArrayView<const float> Times, TArrayView<FLinearColor> OutColors) const
+{
+	check(Times.Num() == OutColors.Num());
+
+	COLORPICKER_SCOPE_CYCLE_COUNTER(STAT_ColorPickerRampBatchSample, GradientRampBatchSample);
+	COLORPICKER_INC_COUNTER(STAT_ColorPickerRampSamples, GradientRampSamples, Times.Num());
+
+	Bake();
+
+	const int32 NumChunks = FMath::DivideAndRoundUp(Times.Num(), BatchChunkSize);
+	ParallelFor(NumChunks, [this, &Times, &OutColors](const int32 Chunk)
+	{
+		const int32 End = FMath::Min((Chunk + 1) * BatchChunkSize, Times.Num());
+		for (int32 Index = Chunk * BatchChunkSize; Index < End; ++Index)
+		{
+			OutColors[Index] = SampleBaked(Times[Index]);
+		}
+	}, NumChunks <= 1);
+}
+
+void FColorGradientRamp::SampleBatch(TArrayView<const float> Times, TArrayView<FColor> OutColors) const
+{
+	check(Times.Num() == OutColors.Num());
+
+	COLORPICKER_SCOPE_CYCLE_COUNTER(STAT_ColorPickerRampBatchSample, GradientRampBatchSample);
+	COLORPICKER_INC_COUNTER(STAT_ColorPickerRampSamples, GradientRampSamples, Times.Num());
+
+	Bake();
+
+	const int32 NumChunks = FMath::DivideAndRoundUp(Times.Num(), BatchChunkSize);
+	ParallelFor(NumChunks, [this, &Times, &OutColors](const int32 Chunk)
+	{
+		const int32 End = FMath::Min((Chunk + 1) * BatchChunkSize, Times.Num());
+		for (int32 Index = Chunk * BatchChunkSize; Index < End; ++Index)
+		{
+			OutColors[Index] = SampleBakedNearest(Times[Index]);
+		}
+	}, NumChunks <= 1);
+}
+#pragma endregion
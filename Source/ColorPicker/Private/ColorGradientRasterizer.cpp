@@ -0,0 +1,122 @@
+// Copyright kevin791129
+
+#include "ColorGradientRasterizer.h"
+#include "ColorConversionKernels.h"
+#include "Async/ParallelFor.h"
+
+using namespace ColorConversionKernels;
+
+namespace ColorGradientRasterizer
+{
+	/**
+	 * Run Body(FirstRow, EndRow) over row tiles in parallel.
+	 */
+	template<typename BodyType>
+	static void ForEachTile(const int32 Height, const BodyType& Body)
+	{
+		const int32 TileCount = FMath::DivideAndRoundUp(Height, RowsPerTile);
+		ParallelFor(TileCount, [Height, &Body](const int32 TileIndex)
+		{
+			const int32 FirstRow = TileIndex * RowsPerTile;
+			Body(FirstRow, FMath::Min(FirstRow + RowsPerTile, Height));
+		}, TileCount == 1);
+	}
+
+	void FillHueStrip(FColor* OutPixels, const int32 Width, const int32 Height)
+	{
+		if (!OutPixels || Width <= 0 || Height <= 0)
+			return;
+
+		ForEachTile(Height, [OutPixels, Width, Height](const int32 FirstRow, const int32 EndRow)
+		{
+			const float RowToHue = 360.f / Height;
+			const float S[VectorWidth] = { 1.f, 1.f, 1.f, 1.f };
+			const float V[VectorWidth] = { 1.f, 1.f, 1.f, 1.f };
+
+			// Rows are converted four at a time, then each row is a single color.
+			for (int32 Row = FirstRow; Row < EndRow; Row += VectorWidth)
+			{
+				float H[VectorWidth];
+				for (int32 Lane = 0; Lane < VectorWidth; ++Lane)
+				{
+					H[Lane] = (Row + Lane + 0.5f) * RowToHue;
+				}
+
+				FColor RowColors[VectorWidth];
+				VectorHSVToColor(H, S, V, RowColors);
+
+				const int32 LaneCount = FMath::Min(VectorWidth, EndRow - Row);
+				for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+				{
+					FColor* RowPixels = OutPixels + (int64)(Row + Lane) * Width;
+					for (int32 Column = 0; Column < Width; ++Column)
+					{
+						RowPixels[Column] = RowColors[Lane];
+					}
+				}
+			}
+		});
+	}
+
+	void FillSaturationValue(FColor* OutPixels, const int32 Width, const int32 Height, const float Hue)
+	{
+		if (!OutPixels || Width <= 0 || Height <= 0)
+			return;
+
+		// Saturation only depends on column, shared by every row.
+		const int32 VectorColumns = Width - Width % VectorWidth;
+		TArray<float> Saturation;
+		Saturation.SetNumUninitialized(Width);
+		for (int32 Column = 0; Column < Width; ++Column)
+		{
+			Saturation[Column] = (Column + 0.5f) / Width;
+		}
+
+		ForEachTile(Height, [OutPixels, Width, Height, Hue, VectorColumns, &Saturation](const int32 FirstRow, const int32 EndRow)
+		{
+			const float H[VectorWidth] = { Hue, Hue, Hue, Hue };
+
+			for (int32 Row = FirstRow; Row < EndRow; ++Row)
+			{
+				const float Value = 1.f - (Row + 0.5f) / Height;
+				const float V[VectorWidth] = { Value, Value, Value, Value };
+				FColor* RowPixels = OutPixels + (int64)Row * Width;
+
+				int32 Column = 0;
+				for (; Column < VectorColumns; Column += VectorWidth)
+				{
+					VectorHSVToColor(H, Saturation.GetData() + Column, V, RowPixels + Column);
+				}
+				for (; Column < Width; ++Column)
+				{
+					RowPixels[Column] = HSVToColor(Hue, Saturation[Column], Value);
+				}
+			}
+		});
+	}
+}
+
+bool FColorGradientBuffer::UpdateHueStrip(const FIntPoint& InSize)
+{
+	if (Gradient == EGradient::HueStrip && Size == InSize)
+		return false;
+
+	Gradient = EGradient::HueStrip;
+	Size = InSize;
+	Pixels.SetNumUninitialized(FMath::Max(0, Size.X * Size.Y), false);
+	ColorGradientRasterizer::FillHueStrip(Pixels.GetData(), Size.X, Size.Y);
+	return true;
+}
+
+bool FColorGradientBuffer::UpdateSaturationValue(const FIntPoint& InSize, const float InHue)
+{
+	if (Gradient == EGradient::SaturationValue && Size == InSize && Hue == InHue)
+		return false;
+
+	Gradient = EGradient::SaturationValue;
+	Size = InSize;
+	Hue = InHue;
+	Pixels.SetNumUninitialized(FMath::Max(0, Size.X * Size.Y), false);
+	ColorGradientRasterizer::FillSaturationValue(Pixels.GetData(), Size.X, Size.Y, Hue);
+	return true;
+}
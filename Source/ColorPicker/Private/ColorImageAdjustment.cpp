@@ -0,0 +1,388 @@
+// Copyright kevin791129
+
+#include "ColorImageAdjustment.h"
+#include "ColorConversionKernels.h"
+#include "ColorPickerStats.h"
+#include "Async/Async.h"
+#include "Async/ParallelFor.h"
+#include "Containers/Ticker.h"
+
+DECLARE_CYCLE_STAT(TEXT("Image Adjustment"), STAT_ColorPickerImageAdjustment, STATGROUP_ColorPicker);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Pixels Adjusted"), STAT_ColorPickerPixelsAdjusted, STATGROUP_ColorPicker);
+
+using ColorConversionKernels::VectorWidth;
+using FStage = FColorImageAdjustment::FStage;
+using EStageSpace = FColorImageAdjustment::EStageSpace;
+
+namespace
+{
+	FORCEINLINE bool IsCancelled(const FColorPaletteProgress* Progress)
+	{
+		return Progress && Progress->IsCancelled();
+	}
+
+	FORCEINLINE void AddCompletedWork(FColorPaletteProgress* Progress, const int32 Work)
+	{
+		if (Progress)
+			Progress->AddCompletedWork(Work);
+	}
+
+	/**
+	 * Compose channel mapping with a following scale.
+	 */
+	void ComposeScale(FColorImageAdjustment::FChannelScale& Channel, const float Scale)
+	{
+		// min(min(x * S, M) * A, 1) == min(x * S * A, min(M * A, 1)) for A >= 0.
+		Channel.Scale *= Scale;
+		Channel.Max = FMath::Min(Channel.Max * Scale, 1.f);
+	}
+
+#pragma region Pixel Access
+	/** Channels are loaded as sRGB encoded values in [0, 1]. */
+	FORCEINLINE void LoadUnitChannels(const FColor* Pixels, VectorRegister& OutR, VectorRegister& OutG, VectorRegister& OutB)
+	{
+		ColorConversionKernels::LoadChannels(Pixels, OutR, OutG, OutB);
+		const VectorRegister Scale = VectorSetFloat1(1.f / 255.f);
+		OutR = VectorMultiply(OutR, Scale);
+		OutG = VectorMultiply(OutG, Scale);
+		OutB = VectorMultiply(OutB, Scale);
+	}
+
+	FORCEINLINE void LoadUnitChannels(const FLinearColor* Pixels, VectorRegister& OutR, VectorRegister& OutG, VectorRegister& OutB)
+	{
+		using ColorMath::SRGB::EncodeReal;
+		OutR = MakeVectorRegister(EncodeReal(Pixels[0].R), EncodeReal(Pixels[1].R), EncodeReal(Pixels[2].R), EncodeReal(Pixels[3].R));
+		OutG = MakeVectorRegister(EncodeReal(Pixels[0].G), EncodeReal(Pixels[1].G), EncodeReal(Pixels[2].G), EncodeReal(Pixels[3].G));
+		OutB = MakeVectorRegister(EncodeReal(Pixels[0].B), EncodeReal(Pixels[1].B), EncodeReal(Pixels[2].B), EncodeReal(Pixels[3].B));
+	}
+
+	/** Alpha is taken from source, which may be the destination. */
+	FORCEINLINE void StoreUnitChannels(const VectorRegister& R, const VectorRegister& G, const VectorRegister& B, const FColor* Source, FColor* Dest)
+	{
+		// Rounded so unadjusted channels are stored unchanged.
+		const VectorRegister Full = VectorSetFloat1(255.f);
+		const VectorRegister Half = VectorSetFloat1(0.5f);
+		float RValues[VectorWidth], GValues[VectorWidth], BValues[VectorWidth];
+		VectorStore(VectorMultiplyAdd(ColorConversionKernels::VectorClamp(R, 0.f, 1.f), Full, Half), RValues);
+		VectorStore(VectorMultiplyAdd(ColorConversionKernels::VectorClamp(G, 0.f, 1.f), Full, Half), GValues);
+		VectorStore(VectorMultiplyAdd(ColorConversionKernels::VectorClamp(B, 0.f, 1.f), Full, Half), BValues);
+
+		for (int32 Lane = 0; Lane < VectorWidth; ++Lane)
+		{
+			Dest[Lane] = FColor((uint8)RValues[Lane], (uint8)GValues[Lane], (uint8)BValues[Lane], Source[Lane].A);
+		}
+	}
+
+	FORCEINLINE void StoreUnitChannels(const VectorRegister& R, const VectorRegister& G, const VectorRegister& B, const FLinearColor* Source, FLinearColor* Dest)
+	{
+		using ColorMath::SRGB::DecodeReal;
+		float RValues[VectorWidth], GValues[VectorWidth], BValues[VectorWidth];
+		VectorStore(ColorConversionKernels::VectorClamp(R, 0.f, 1.f), RValues);
+		VectorStore(ColorConversionKernels::VectorClamp(G, 0.f, 1.f), GValues);
+		VectorStore(ColorConversionKernels::VectorClamp(B, 0.f, 1.f), BValues);
+
+		for (int32 Lane = 0; Lane < VectorWidth; ++Lane)
+		{
+			Dest[Lane] = FLinearColor(DecodeReal(RValues[Lane]), DecodeReal(GValues[Lane]), DecodeReal(BValues[Lane]), Source[Lane].A);
+		}
+	}
+#pragma endregion
+
+#pragma region Stages
+	FORCEINLINE VectorRegister ShiftHue(const VectorRegister& Hue, const float Offset)
+	{
+		// Hue and offset lie in [0, 360), so wrapping is a single subtraction.
+		const VectorRegister ThreeSixty = VectorSetFloat1(360.f);
+		const VectorRegister Shifted = VectorAdd(Hue, VectorSetFloat1(Offset));
+		return VectorSelect(VectorCompareGE(Shifted, ThreeSixty), VectorSubtract(Shifted, ThreeSixty), Shifted);
+	}
+
+	FORCEINLINE VectorRegister ScaleChannel(const VectorRegister& Channel, const FColorImageAdjustment::FChannelScale& Scale)
+	{
+		return VectorMin(VectorMultiply(Channel, VectorSetFloat1(Scale.Scale)), VectorSetFloat1(Scale.Max));
+	}
+
+	FORCEINLINE void ApplyHSV(const FStage& Stage, VectorRegister& R, VectorRegister& G, VectorRegister& B)
+	{
+		const VectorRegister RGBMin = VectorMin(VectorMin(R, G), B);
+		const VectorRegister RGBMax = VectorMax(VectorMax(R, G), B);
+		const VectorRegister RGBRange = VectorSubtract(RGBMax, RGBMin);
+
+		const VectorRegister H = ShiftHue(ColorConversionKernels::VectorHueFromRGB(R, G, B, RGBMin, RGBMax, RGBRange), Stage.HueOffset);
+		const VectorRegister S = ScaleChannel(VectorSelect(VectorCompareEQ(RGBMax, VectorZero()), VectorZero(), VectorDivide(RGBRange, RGBMax)), Stage.Saturation);
+		const VectorRegister V = ScaleChannel(RGBMax, Stage.Brightness);
+
+		const VectorRegister One = VectorOne();
+		const VectorRegister HDiv60 = VectorDivide(H, VectorSetFloat1(60.f));
+		// Hue is positive so truncation equals floor.
+		const VectorRegister Sector = VectorTruncate(HDiv60);
+		const VectorRegister Fraction = VectorSubtract(HDiv60, Sector);
+		const VectorRegister RGBValues[4] = {
+			V,
+			VectorMultiply(V, VectorSubtract(One, S)),
+			VectorMultiply(V, VectorSubtract(One, VectorMultiply(Fraction, S))),
+			VectorMultiply(V, VectorSubtract(One, VectorMultiply(VectorSubtract(One, Fraction), S)))
+		};
+
+		R = ColorConversionKernels::VectorSwizzleSector(Sector, RGBValues, 0);
+		G = ColorConversionKernels::VectorSwizzleSector(Sector, RGBValues, 1);
+		B = ColorConversionKernels::VectorSwizzleSector(Sector, RGBValues, 2);
+	}
+
+	FORCEINLINE void ApplyHSL(const FStage& Stage, VectorRegister& R, VectorRegister& G, VectorRegister& B)
+	{
+		const VectorRegister One = VectorOne();
+		const VectorRegister Two = VectorSetFloat1(2.f);
+		const VectorRegister RGBMin = VectorMin(VectorMin(R, G), B);
+		const VectorRegister RGBMax = VectorMax(VectorMax(R, G), B);
+		const VectorRegister RGBRange = VectorSubtract(RGBMax, RGBMin);
+		const VectorRegister RGBSum = VectorAdd(RGBMax, RGBMin);
+
+		// Gray has no saturation, which also avoids dividing by zero for black and white.
+		const VectorRegister H = ShiftHue(ColorConversionKernels::VectorHueFromRGB(R, G, B, RGBMin, RGBMax, RGBRange), Stage.HueOffset);
+		const VectorRegister S = ScaleChannel(VectorSelect(VectorCompareEQ(RGBRange, VectorZero()), VectorZero(), VectorDivide(RGBRange, VectorSubtract(One, VectorAbs(VectorSubtract(RGBSum, One))))), Stage.Saturation);
+		const VectorRegister L = ScaleChannel(VectorMultiply(RGBSum, VectorSetFloat1(0.5f)), Stage.Brightness);
+
+		const VectorRegister CHalf = VectorMultiply(VectorMultiply(VectorSubtract(One, VectorAbs(VectorSubtract(VectorMultiply(Two, L), One))), S), VectorSetFloat1(0.5f));
+		const VectorRegister HDiv60 = VectorDivide(H, VectorSetFloat1(60.f));
+		const VectorRegister Sector = VectorTruncate(HDiv60);
+		const VectorRegister FractionDouble = VectorMultiply(VectorSubtract(HDiv60, Sector), Two);
+		const VectorRegister RGBValues[4] = {
+			VectorAdd(L, CHalf),
+			VectorSubtract(L, CHalf),
+			VectorAdd(L, VectorMultiply(CHalf, VectorSubtract(One, FractionDouble))),
+			VectorAdd(L, VectorMultiply(CHalf, VectorSubtract(FractionDouble, One)))
+		};
+
+		R = ColorConversionKernels::VectorSwizzleSector(Sector, RGBValues, 0);
+		G = ColorConversionKernels::VectorSwizzleSector(Sector, RGBValues, 1);
+		B = ColorConversionKernels::VectorSwizzleSector(Sector, RGBValues, 2);
+	}
+
+	FORCEINLINE void ApplyInkLimit(const FStage& Stage, VectorRegister& R, VectorRegister& G, VectorRegister& B)
+	{
+		const VectorRegister One = VectorOne();
+		const VectorRegister Zero = VectorZero();
+		const VectorRegister Limit = VectorSetFloat1(Stage.InkLimit);
+		const VectorRegister RGBMax = VectorMax(VectorMax(R, G), B);
+		const VectorRegister IsBlack = VectorCompareEQ(RGBMax, Zero);
+
+		// C, M and Y are relative to 1 - K, as in RGBToCMYK.
+		const VectorRegister C = VectorSelect(IsBlack, Zero, VectorDivide(VectorSubtract(RGBMax, R), RGBMax));
+		const VectorRegister M = VectorSelect(IsBlack, Zero, VectorDivide(VectorSubtract(RGBMax, G), RGBMax));
+		const VectorRegister Y = VectorSelect(IsBlack, Zero, VectorDivide(VectorSubtract(RGBMax, B), RGBMax));
+		const VectorRegister K = VectorSubtract(One, RGBMax);
+
+		// Coverage left for C, M and Y once K is laid down, over the limit they are scaled down together.
+		const VectorRegister Sum = VectorAdd(VectorAdd(C, M), Y);
+		const VectorRegister Allowed = VectorMax(VectorSubtract(Limit, K), Zero);
+		const VectorRegister Factor = VectorSelect(VectorCompareGT(Sum, Allowed), VectorDivide(Allowed, Sum), One);
+		const VectorRegister KInverse = VectorSubtract(One, VectorMin(K, Limit));
+
+		R = VectorMultiply(VectorSubtract(One, VectorMultiply(C, Factor)), KInverse);
+		G = VectorMultiply(VectorSubtract(One, VectorMultiply(M, Factor)), KInverse);
+		B = VectorMultiply(VectorSubtract(One, VectorMultiply(Y, Factor)), KInverse);
+	}
+
+	/**
+	 * Adjust VectorWidth pixels, converting once per stage.
+	 */
+	template<typename PixelType>
+	FORCEINLINE void AdjustPixels(const TArray<FStage>& Stages, const PixelType* Source, PixelType* Dest)
+	{
+		VectorRegister R, G, B;
+		LoadUnitChannels(Source, R, G, B);
+
+		for (const FStage& Stage : Stages)
+		{
+			switch (Stage.Space)
+			{
+			case EStageSpace::HSV:
+				ApplyHSV(Stage, R, G, B);
+				break;
+			case EStageSpace::HSL:
+				ApplyHSL(Stage, R, G, B);
+				break;
+			case EStageSpace::CMYK:
+				ApplyInkLimit(Stage, R, G, B);
+				break;
+			}
+		}
+
+		StoreUnitChannels(R, G, B, Source, Dest);
+	}
+#pragma endregion
+
+	template<typename PixelType>
+	bool ApplyStages(const TArray<FStage>& Stages, TArrayView<const PixelType> Source, TArrayView<PixelType> Dest, FColorPaletteProgress* Progress)
+	{
+		checkf(Source.Num() == Dest.Num(), TEXT("Image adjustment source has %d pixels, destination %d."), Source.Num(), Dest.Num());
+
+		const int32 NumPixels = Source.Num();
+		const int32 NumTiles = FMath::DivideAndRoundUp(NumPixels, FColorImageAdjustment::PixelsPerTile);
+		if (Progress)
+			Progress->Reset(NumTiles);
+
+		COLORPICKER_SCOPE_CYCLE_COUNTER(STAT_ColorPickerImageAdjustment, ImageAdjustment);
+		COLORPICKER_INC_COUNTER(STAT_ColorPickerPixelsAdjusted, PixelsAdjusted, NumPixels);
+
+		if (Stages.Num() == 0)
+		{
+			if (Dest.GetData() != Source.GetData())
+				FMemory::Memcpy(Dest.GetData(), Source.GetData(), NumPixels * sizeof(PixelType));
+			AddCompletedWork(Progress, NumTiles);
+			return !IsCancelled(Progress);
+		}
+
+		ParallelFor(NumTiles, [&Stages, Source, Dest, NumPixels, Progress](const int32 Tile)
+		{
+			if (IsCancelled(Progress))
+				return;
+
+			const int32 First = Tile * FColorImageAdjustment::PixelsPerTile;
+			const int32 End = FMath::Min(First + FColorImageAdjustment::PixelsPerTile, NumPixels);
+			const PixelType* SourcePixels = Source.GetData();
+			PixelType* DestPixels = Dest.GetData();
+
+			int32 Index = First;
+			for (; Index + VectorWidth <= End; Index += VectorWidth)
+			{
+				AdjustPixels(Stages, SourcePixels + Index, DestPixels + Index);
+			}
+
+			// Remaining pixels are padded to a full vector.
+			if (Index < End)
+			{
+				PixelType Tail[VectorWidth] = {};
+				FMemory::Memcpy(Tail, SourcePixels + Index, (End - Index) * sizeof(PixelType));
+				AdjustPixels(Stages, Tail, Tail);
+				FMemory::Memcpy(DestPixels + Index, Tail, (End - Index) * sizeof(PixelType));
+			}
+
+			AddCompletedWork(Progress, 1);
+		}, NumTiles == 1);
+
+		return !IsCancelled(Progress);
+	}
+}
+
+#pragma region Adjustment
+FColorImageAdjustment::FColorImageAdjustment(TArrayView<const FColorAdjustment> Adjustments)
+{
+	for (const FColorAdjustment& Adjustment : Adjustments)
+	{
+		Add(Adjustment);
+	}
+}
+
+void FColorImageAdjustment::Add(const FColorAdjustment& Adjustment)
+{
+	// Hue is the same in HSV and HSL, so a hue shift folds into either.
+	const bool bHueShift = Adjustment.Op == EColorAdjustmentOp::CAO_HUE_SHIFT;
+	EStageSpace Space = EStageSpace::HSV;
+	if (Adjustment.Op == EColorAdjustmentOp::CAO_LIGHTNESS_SCALE)
+		Space = EStageSpace::HSL;
+	else if (Adjustment.Op == EColorAdjustmentOp::CAO_INK_LIMIT)
+		Space = EStageSpace::CMYK;
+
+	const bool bFolds = Stages.Num() > 0 && (Stages.Last().Space == Space || (bHueShift && Stages.Last().Space != EStageSpace::CMYK));
+	if (!bFolds)
+		Stages.AddDefaulted_GetRef().Space = Space;
+
+	FStage& Stage = Stages.Last();
+	const float Amount = bHueShift ? Adjustment.Amount : FMath::Max(0.f, Adjustment.Amount);
+	switch (Adjustment.Op)
+	{
+	case EColorAdjustmentOp::CAO_HUE_SHIFT:
+	{
+		float Offset = FMath::Fmod(Stage.HueOffset + FMath::Fmod(Amount, 360.f), 360.f);
+		if (Offset < 0.f)
+			Offset += 360.f;
+		// Tiny negative offsets round up to 360.
+		Stage.HueOffset = Offset < 360.f ? Offset : 0.f;
+		break;
+	}
+	case EColorAdjustmentOp::CAO_SATURATION_SCALE:
+		ComposeScale(Stage.Saturation, Amount);
+		break;
+	case EColorAdjustmentOp::CAO_VALUE_SCALE:
+	case EColorAdjustmentOp::CAO_LIGHTNESS_SCALE:
+		ComposeScale(Stage.Brightness, Amount);
+		break;
+	case EColorAdjustmentOp::CAO_INK_LIMIT:
+		Stage.InkLimit = FMath::Min(Stage.InkLimit, Amount);
+		break;
+	}
+}
+
+bool FColorImageAdjustment::Apply(TArrayView<const FColor> Source, TArrayView<FColor> Dest, FColorPaletteProgress* Progress) const
+{
+	return ApplyStages(Stages, Source, Dest, Progress);
+}
+
+bool FColorImageAdjustment::Apply(TArrayView<const FLinearColor> Source, TArrayView<FLinearColor> Dest, FColorPaletteProgress* Progress) const
+{
+	return ApplyStages(Stages, Source, Dest, Progress);
+}
+#pragma endregion
+
+#pragma region Task
+FColorImageAdjustmentTask::FColorImageAdjustmentTask(TArray<FColor>&& InPixels, const FColorImageAdjustment& InAdjustment, FOnColorImageAdjusted InOnAdjusted, FOnColorPaletteProgress InOnProgress)
+	: Pixels(MoveTemp(InPixels))
+	, Adjustment(InAdjustment)
+	, OnAdjusted(MoveTemp(InOnAdjusted))
+	, OnProgress(MoveTemp(InOnProgress))
+{
+}
+
+TSharedRef<FColorImageAdjustmentTask, ESPMode::ThreadSafe> FColorImageAdjustmentTask::Launch(TArray<FColor>&& Pixels, const FColorImageAdjustment& Adjustment, FOnColorImageAdjusted OnAdjusted, FOnColorPaletteProgress OnProgress)
+{
+	check(IsInGameThread());
+
+	TSharedRef<FColorImageAdjustmentTask, ESPMode::ThreadSafe> Task = MakeShareable(new FColorImageAdjustmentTask(MoveTemp(Pixels), Adjustment, MoveTemp(OnAdjusted), MoveTemp(OnProgress)));
+
+	// Ticker keeps the task alive until result is delivered, so callers may drop it.
+	Task->TickerHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([Task](float DeltaTime)
+	{
+		return Task->Tick(DeltaTime);
+	}), ProgressInterval);
+
+	// Worker keeps the task alive until adjustment finishes.
+	Async(EAsyncExecution::ThreadPool, [Task]()
+	{
+		Task->Adjustment.Apply(Task->Pixels, Task->Pixels, &Task->Progress);
+		Task->bDone = true;
+	});
+
+	return Task;
+}
+
+void FColorImageAdjustmentTask::Cancel()
+{
+	check(IsInGameThread());
+
+	Progress.Cancel();
+	if (TickerHandle.IsValid())
+	{
+		FTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+		TickerHandle.Reset();
+	}
+}
+
+bool FColorImageAdjustmentTask::Tick(float DeltaTime)
+{
+	if (Progress.IsCancelled())
+		return false;
+
+	if (!bDone)
+	{
+		OnProgress.ExecuteIfBound(Progress.GetProgress());
+		return true;
+	}
+
+	TickerHandle.Reset();
+	OnProgress.ExecuteIfBound(1.f);
+	OnAdjusted.ExecuteIfBound(Pixels);
+	return false;
+}
+#pragma endregion
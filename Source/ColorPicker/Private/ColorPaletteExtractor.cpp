@@ -0,0 +1,472 @@
+// Copyright kevin791129
+
+#include "ColorPaletteExtractor.h"
+#include "SRGBTransfer.h"
+#include "Async/Async.h"
+#include "Async/ParallelFor.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "Containers/Ticker.h"
+#include "Math/RandomStream.h"
+
+namespace
+{
+	constexpr int32 HistogramShift = 8 - FColorPaletteExtractor::HistogramBits;
+	constexpr int32 HistogramMask = (1 << FColorPaletteExtractor::HistogramBits) - 1;
+	constexpr int32 BinCount = 1 << (3 * FColorPaletteExtractor::HistogramBits);
+
+	/** Sampled pixels per work block, the unit of progress and cancellation. */
+	constexpr int32 PixelBlockSize = 64 * 1024;
+	/** Histogram bins per parallel clustering task. */
+	constexpr int32 BinChunkSize = 4096;
+
+	/** Non-empty histogram bin as a weighted point in sRGB space. */
+	struct FBinPoint
+	{
+		FVector Color;
+		float Weight;
+		int32 Bin;
+	};
+
+	/** Weighted sum of points assigned to a cluster. */
+	struct FClusterAccumulator
+	{
+		double R;
+		double G;
+		double B;
+		double Weight;
+	};
+
+	/** Sum of exact pixel colors assigned to a cluster. */
+	struct FPixelAccumulator
+	{
+		uint64 R;
+		uint64 G;
+		uint64 B;
+		uint64 Count;
+	};
+
+	FORCEINLINE FColor ToSRGB(const FColor& Pixel)
+	{
+		return Pixel;
+	}
+
+	FORCEINLINE FColor ToSRGB(const FLinearColor& Pixel)
+	{
+		return SRGBTransfer::ToFColor(Pixel);
+	}
+
+	FORCEINLINE int32 BinIndex(const FColor& Color)
+	{
+		return ((Color.R >> HistogramShift) << (2 * FColorPaletteExtractor::HistogramBits)) | ((Color.G >> HistogramShift) << FColorPaletteExtractor::HistogramBits) | (Color.B >> HistogramShift);
+	}
+
+	/** Bin center in sRGB space, range: [0, 1]. */
+	FORCEINLINE FVector BinCenter(const int32 Bin)
+	{
+		const float Scale = 1.f / 255.f;
+		const float HalfBin = (float)(1 << HistogramShift) * 0.5f;
+		return FVector(
+			(((Bin >> (2 * FColorPaletteExtractor::HistogramBits)) & HistogramMask) << HistogramShift) + HalfBin,
+			(((Bin >> FColorPaletteExtractor::HistogramBits) & HistogramMask) << HistogramShift) + HalfBin,
+			((Bin & HistogramMask) << HistogramShift) + HalfBin) * Scale;
+	}
+
+	FORCEINLINE bool IsCancelled(const FColorPaletteProgress* Progress)
+	{
+		return Progress && Progress->IsCancelled();
+	}
+
+	FORCEINLINE void AddCompletedWork(FColorPaletteProgress* Progress, const int32 Work)
+	{
+		if (Progress)
+			Progress->AddCompletedWork(Work);
+	}
+
+	/**
+	 * Index of nearest centroid.
+	 */
+	FORCEINLINE int32 NearestCentroid(const FVector& Color, const TArray<FVector>& Centroids)
+	{
+		int32 Nearest = 0;
+		float NearestDistance = FVector::DistSquared(Color, Centroids[0]);
+		for (int32 Index = 1; Index < Centroids.Num(); ++Index)
+		{
+			const float Distance = FVector::DistSquared(Color, Centroids[Index]);
+			if (Distance < NearestDistance)
+			{
+				NearestDistance = Distance;
+				Nearest = Index;
+			}
+		}
+		return Nearest;
+	}
+
+	/**
+	 * Weighted k-means++ initialization, first center is the heaviest point.
+	 */
+	TArray<FVector> SeedCentroids(const TArray<FBinPoint>& Points, const int32 NumColors, FRandomStream& Random)
+	{
+		TArray<FVector> Centroids;
+		Centroids.Reserve(NumColors);
+
+		int32 Heaviest = 0;
+		for (int32 Index = 1; Index < Points.Num(); ++Index)
+		{
+			if (Points[Index].Weight > Points[Heaviest].Weight)
+				Heaviest = Index;
+		}
+		Centroids.Add(Points[Heaviest].Color);
+
+		TArray<float> NearestDistance;
+		NearestDistance.SetNumUninitialized(Points.Num());
+		for (int32 Index = 0; Index < Points.Num(); ++Index)
+		{
+			NearestDistance[Index] = FVector::DistSquared(Points[Index].Color, Centroids[0]);
+		}
+
+		while (Centroids.Num() < NumColors)
+		{
+			double Total = 0.0;
+			for (int32 Index = 0; Index < Points.Num(); ++Index)
+			{
+				Total += (double)Points[Index].Weight * NearestDistance[Index];
+			}
+
+			// Every point coincides with a center.
+			if (Total <= 0.0)
+				break;
+
+			double Target = Random.FRand() * Total;
+			int32 Chosen = Points.Num() - 1;
+			for (int32 Index = 0; Index < Points.Num(); ++Index)
+			{
+				Target -= (double)Points[Index].Weight * NearestDistance[Index];
+				if (Target <= 0.0)
+				{
+					Chosen = Index;
+					break;
+				}
+			}
+
+			const FVector Centroid = Points[Chosen].Color;
+			Centroids.Add(Centroid);
+			for (int32 Index = 0; Index < Points.Num(); ++Index)
+			{
+				NearestDistance[Index] = FMath::Min(NearestDistance[Index], FVector::DistSquared(Points[Index].Color, Centroid));
+			}
+		}
+
+		return Centroids;
+	}
+
+	/**
+	 * Lloyd iterations over weighted bins, parallel over bin chunks with one accumulator set per chunk.
+	 *
+	 * @param[out] OutAssignment : Cluster of each point.
+	 * @return False if cancelled.
+	 */
+	bool ClusterPoints(const TArray<FBinPoint>& Points, TArray<FVector>& Centroids, const FColorPaletteSettings& Settings, TArray<int32>& OutAssignment, FColorPaletteProgress* Progress)
+	{
+		const int32 NumClusters = Centroids.Num();
+		const int32 NumChunks = FMath::DivideAndRoundUp(Points.Num(), BinChunkSize);
+		const int32 MaxIterations = FMath::Max(1, Settings.MaxIterations);
+		const float Threshold = FMath::Max(0.f, Settings.ConvergenceThreshold);
+
+		OutAssignment.SetNumUninitialized(Points.Num());
+		TArray<FClusterAccumulator> ChunkAccumulators;
+
+		for (int32 Iteration = 0; Iteration < MaxIterations; ++Iteration)
+		{
+			if (IsCancelled(Progress))
+				return false;
+
+			ChunkAccumulators.SetNumUninitialized(NumChunks * NumClusters, false);
+			FMemory::Memzero(ChunkAccumulators.GetData(), ChunkAccumulators.Num() * sizeof(FClusterAccumulator));
+			ParallelFor(NumChunks, [&](const int32 Chunk)
+			{
+				FClusterAccumulator* Accumulators = ChunkAccumulators.GetData() + Chunk * NumClusters;
+				const int32 End = FMath::Min((Chunk + 1) * BinChunkSize, Points.Num());
+				for (int32 Index = Chunk * BinChunkSize; Index < End; ++Index)
+				{
+					const FBinPoint& Point = Points[Index];
+					const int32 Cluster = NearestCentroid(Point.Color, Centroids);
+					OutAssignment[Index] = Cluster;
+
+					FClusterAccumulator& Accumulator = Accumulators[Cluster];
+					Accumulator.R += (double)Point.Color.X * Point.Weight;
+					Accumulator.G += (double)Point.Color.Y * Point.Weight;
+					Accumulator.B += (double)Point.Color.Z * Point.Weight;
+					Accumulator.Weight += Point.Weight;
+				}
+			}, NumChunks == 1);
+
+			float MaxShiftSquared = 0.f;
+			for (int32 Cluster = 0; Cluster < NumClusters; ++Cluster)
+			{
+				FClusterAccumulator Sum = {};
+				for (int32 Chunk = 0; Chunk < NumChunks; ++Chunk)
+				{
+					const FClusterAccumulator& Accumulator = ChunkAccumulators[Chunk * NumClusters + Cluster];
+					Sum.R += Accumulator.R;
+					Sum.G += Accumulator.G;
+					Sum.B += Accumulator.B;
+					Sum.Weight += Accumulator.Weight;
+				}
+
+				// Empty cluster keeps its center.
+				if (Sum.Weight <= 0.0)
+					continue;
+
+				const FVector Centroid((float)(Sum.R / Sum.Weight), (float)(Sum.G / Sum.Weight), (float)(Sum.B / Sum.Weight));
+				MaxShiftSquared = FMath::Max(MaxShiftSquared, FVector::DistSquared(Centroid, Centroids[Cluster]));
+				Centroids[Cluster] = Centroid;
+			}
+
+			AddCompletedWork(Progress, 1);
+
+			if (MaxShiftSquared <= Threshold * Threshold)
+			{
+				AddCompletedWork(Progress, MaxIterations - Iteration - 1);
+				break;
+			}
+		}
+
+		return true;
+	}
+
+	template<typename PixelType>
+	TArray<FColorPaletteEntry> ExtractPalette(TArrayView<const PixelType> Pixels, const FColorPaletteSettings& Settings, FColorPaletteProgress* Progress)
+	{
+		TArray<FColorPaletteEntry> Palette;
+
+		const int32 NumColors = FMath::Clamp(Settings.NumColors, 1, FColorPaletteExtractor::MaxColors);
+		const int32 Stride = FMath::Max(1, Settings.Stride);
+		const int32 NumSamples = FMath::DivideAndRoundUp(Pixels.Num(), Stride);
+		if (NumSamples <= 0)
+			return Palette;
+
+		const int32 NumBlocks = FMath::DivideAndRoundUp(NumSamples, PixelBlockSize);
+		const int32 MaxWorkers = Settings.NumThreads > 0 ? Settings.NumThreads : FTaskGraphInterface::Get().GetNumWorkerThreads() + 1;
+		const int32 NumWorkers = FMath::Clamp(MaxWorkers, 1, NumBlocks);
+		const int32 MaxIterations = FMath::Max(1, Settings.MaxIterations);
+
+		// Histogram pass, clustering iterations and final averaging pass.
+		if (Progress)
+			Progress->Reset(NumBlocks + MaxIterations + NumBlocks);
+
+		// Each worker walks its own blocks with a private histogram.
+		TArray<TArray<uint32>> Histograms;
+		Histograms.SetNum(NumWorkers);
+		ParallelFor(NumWorkers, [&](const int32 Worker)
+		{
+			TArray<uint32>& Histogram = Histograms[Worker];
+			Histogram.SetNumZeroed(BinCount);
+
+			for (int32 Block = Worker; Block < NumBlocks; Block += NumWorkers)
+			{
+				if (IsCancelled(Progress))
+					return;
+
+				const int32 End = FMath::Min((Block + 1) * PixelBlockSize, NumSamples);
+				for (int32 Sample = Block * PixelBlockSize; Sample < End; ++Sample)
+				{
+					++Histogram[BinIndex(ToSRGB(Pixels[Sample * Stride]))];
+				}
+				AddCompletedWork(Progress, 1);
+			}
+		}, NumWorkers == 1);
+
+		if (IsCancelled(Progress))
+			return Palette;
+
+		TArray<FBinPoint> Points;
+		for (int32 Bin = 0; Bin < BinCount; ++Bin)
+		{
+			uint32 Count = 0;
+			for (const TArray<uint32>& Histogram : Histograms)
+			{
+				Count += Histogram[Bin];
+			}
+
+			if (Count > 0)
+				Points.Add({ BinCenter(Bin), (float)Count, Bin });
+		}
+		Histograms.Empty();
+
+		// Cluster of every histogram bin, so the final pass is a lookup per pixel.
+		TArray<int32> BinCluster;
+		BinCluster.Init(INDEX_NONE, BinCount);
+
+		int32 NumClusters = 0;
+		if (Points.Num() <= NumColors)
+		{
+			// Few distinct colors, every bin is its own cluster.
+			for (const FBinPoint& Point : Points)
+			{
+				BinCluster[Point.Bin] = NumClusters++;
+			}
+			AddCompletedWork(Progress, MaxIterations);
+		}
+		else
+		{
+			FRandomStream Random(Settings.Seed);
+			TArray<FVector> Centroids = SeedCentroids(Points, NumColors, Random);
+			TArray<int32> Assignment;
+			if (!ClusterPoints(Points, Centroids, Settings, Assignment, Progress))
+				return Palette;
+
+			for (int32 Index = 0; Index < Points.Num(); ++Index)
+			{
+				BinCluster[Points[Index].Bin] = Assignment[Index];
+			}
+			NumClusters = Centroids.Num();
+		}
+
+		// Average exact pixel colors of each cluster, again with one accumulator set per worker.
+		TArray<FPixelAccumulator> WorkerAccumulators;
+		WorkerAccumulators.SetNumZeroed(NumWorkers * NumClusters);
+		ParallelFor(NumWorkers, [&](const int32 Worker)
+		{
+			FPixelAccumulator* Accumulators = WorkerAccumulators.GetData() + Worker * NumClusters;
+
+			for (int32 Block = Worker; Block < NumBlocks; Block += NumWorkers)
+			{
+				if (IsCancelled(Progress))
+					return;
+
+				const int32 End = FMath::Min((Block + 1) * PixelBlockSize, NumSamples);
+				for (int32 Sample = Block * PixelBlockSize; Sample < End; ++Sample)
+				{
+					const FColor Color = ToSRGB(Pixels[Sample * Stride]);
+					FPixelAccumulator& Accumulator = Accumulators[BinCluster[BinIndex(Color)]];
+					Accumulator.R += Color.R;
+					Accumulator.G += Color.G;
+					Accumulator.B += Color.B;
+					++Accumulator.Count;
+				}
+				AddCompletedWork(Progress, 1);
+			}
+		}, NumWorkers == 1);
+
+		if (IsCancelled(Progress))
+			return Palette;
+
+		Palette.Reserve(NumClusters);
+		for (int32 Cluster = 0; Cluster < NumClusters; ++Cluster)
+		{
+			FPixelAccumulator Sum = {};
+			for (int32 Worker = 0; Worker < NumWorkers; ++Worker)
+			{
+				const FPixelAccumulator& Accumulator = WorkerAccumulators[Worker * NumClusters + Cluster];
+				Sum.R += Accumulator.R;
+				Sum.G += Accumulator.G;
+				Sum.B += Accumulator.B;
+				Sum.Count += Accumulator.Count;
+			}
+
+			if (Sum.Count == 0)
+				continue;
+
+			// Averaged in sRGB space, same space as clustering.
+			const double Scale = 1.0 / (255.0 * Sum.Count);
+			FColorPaletteEntry& Entry = Palette.AddDefaulted_GetRef();
+			Entry.Color = FLinearColor(
+				ColorMath::SRGB::DecodeReal((float)(Sum.R * Scale)),
+				ColorMath::SRGB::DecodeReal((float)(Sum.G * Scale)),
+				ColorMath::SRGB::DecodeReal((float)(Sum.B * Scale)),
+				1.f);
+			Entry.Weight = (float)((double)Sum.Count / NumSamples);
+		}
+
+		Palette.Sort([](const FColorPaletteEntry& A, const FColorPaletteEntry& B) { return A.Weight > B.Weight; });
+		return Palette;
+	}
+}
+
+#pragma region Progress
+float FColorPaletteProgress::GetProgress() const
+{
+	const int32 Total = TotalWork.GetValue();
+	return Total > 0 ? FMath::Min(1.f, (float)CompletedWork.GetValue() / Total) : 0.f;
+}
+
+void FColorPaletteProgress::Reset(const int32 InTotalWork)
+{
+	CompletedWork.Reset();
+	TotalWork.Set(InTotalWork);
+}
+#pragma endregion
+
+#pragma region Extractor
+TArray<FColorPaletteEntry> FColorPaletteExtractor::Extract(TArrayView<const FColor> Pixels, const FColorPaletteSettings& Settings, FColorPaletteProgress* Progress)
+{
+	return ExtractPalette(Pixels, Settings, Progress);
+}
+
+TArray<FColorPaletteEntry> FColorPaletteExtractor::Extract(TArrayView<const FLinearColor> Pixels, const FColorPaletteSettings& Settings, FColorPaletteProgress* Progress)
+{
+	return ExtractPalette(Pixels, Settings, Progress);
+}
+#pragma endregion
+
+#pragma region Task
+FColorPaletteExtractionTask::FColorPaletteExtractionTask(TArray<FColor>&& InPixels, const FColorPaletteSettings& InSettings, FOnColorPaletteExtracted InOnExtracted, FOnColorPaletteProgress InOnProgress)
+	: Pixels(MoveTemp(InPixels))
+	, Settings(InSettings)
+	, OnExtracted(MoveTemp(InOnExtracted))
+	, OnProgress(MoveTemp(InOnProgress))
+{
+}
+
+TSharedRef<FColorPaletteExtractionTask, ESPMode::ThreadSafe> FColorPaletteExtractionTask::Launch(TArray<FColor>&& Pixels, const FColorPaletteSettings& Settings, FOnColorPaletteExtracted OnExtracted, FOnColorPaletteProgress OnProgress)
+{
+	check(IsInGameThread());
+
+	TSharedRef<FColorPaletteExtractionTask, ESPMode::ThreadSafe> Task = MakeShareable(new FColorPaletteExtractionTask(MoveTemp(Pixels), Settings, MoveTemp(OnExtracted), MoveTemp(OnProgress)));
+
+	// Ticker keeps the task alive until result is delivered, so callers may drop it.
+	Task->TickerHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([Task](float DeltaTime)
+	{
+		return Task->Tick(DeltaTime);
+	}), ProgressInterval);
+
+	// Worker keeps the task alive until extraction finishes.
+	Async(EAsyncExecution::ThreadPool, [Task]()
+	{
+		Task->Palette = FColorPaletteExtractor::Extract(Task->Pixels, Task->Settings, &Task->Progress);
+		Task->Pixels.Empty();
+		Task->bDone = true;
+	});
+
+	return Task;
+}
+
+void FColorPaletteExtractionTask::Cancel()
+{
+	check(IsInGameThread());
+
+	Progress.Cancel();
+	if (TickerHandle.IsValid())
+	{
+		FTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+		TickerHandle.Reset();
+	}
+}
+
+bool FColorPaletteExtractionTask::Tick(float DeltaTime)
+{
+	if (Progress.IsCancelled())
+		return false;
+
+	if (!bDone)
+	{
+		OnProgress.ExecuteIfBound(Progress.GetProgress());
+		return true;
+	}
+
+	TickerHandle.Reset();
+	OnProgress.ExecuteIfBound(1.f);
+	OnExtracted.ExecuteIfBound(Palette);
+	return false;
+}
+#pragma endregion
@@ -0,0 +1,196 @@
+// Copyright kevin791129
+
+#include "ColorPaletteIndex.h"
+#include "ColorConversionKernels.h"
+#include "Algo/Sort.h"
+#include "Async/ParallelFor.h"
+
+namespace
+{
+	/** Query point in the space of the index. */
+	FORCEINLINE FVector ToIndexSpace(const FLinearColor& Color)
+	{
+		const ColorMath::TRGBA<float> Encoded = ColorConversionKernels::LinearToSRGBFloat(Color);
+		return FVector(Encoded.R, Encoded.G, Encoded.B);
+	}
+}
+
+void FColorPaletteIndex::Build(TArrayView<const FLinearColor> InColors)
+{
+	Colors.Reset(InColors.Num());
+	Colors.Append(InColors.GetData(), InColors.Num());
+
+	Entries.SetNumUninitialized(Colors.Num());
+	for (int32 Index = 0; Index < Colors.Num(); ++Index)
+	{
+		Entries[Index] = { ToIndexSpace(Colors[Index]), Index, INDEX_NONE };
+	}
+
+	BuildRange(0, Entries.Num());
+}
+
+void FColorPaletteIndex::BuildRange(const int32 Begin, const int32 End)
+{
+	if (End - Begin <= LeafSize)
+		return;
+
+	// Split along axis of largest extent.
+	FVector Min = Entries[Begin].Point;
+	FVector Max = Min;
+	for (int32 Index = Begin + 1; Index < End; ++Index)
+	{
+		Min = Min.ComponentMin(Entries[Index].Point);
+		Max = Max.ComponentMax(Entries[Index].Point);
+	}
+	const FVector Extent = Max - Min;
+	const int32 Axis = Extent.X >= Extent.Y && Extent.X >= Extent.Z ? 0 : (Extent.Y >= Extent.Z ? 1 : 2);
+
+	Algo::Sort(MakeArrayView(Entries.GetData() + Begin, End - Begin), [Axis](const FEntry& A, const FEntry& B)
+	{
+		return A.Point[Axis] < B.Point[Axis];
+	});
+
+	const int32 Mid = (Begin + End) / 2;
+	Entries[Mid].SplitAxis = Axis;
+
+	BuildRange(Begin, Mid);
+	BuildRange(Mid + 1, End);
+}
+
+int32 FColorPaletteIndex::FindNearest(const FLinearColor& Color) const
+{
+	if (IsEmpty())
+		return INDEX_NONE;
+
+	FCandidate Best = { MAX_flt, INDEX_NONE };
+	SearchNearest(0, Entries.Num(), ToIndexSpace(Color), Best);
+	return Best.PaletteIndex;
+}
+
+void FColorPaletteIndex::SearchNearest(const int32 Begin, const int32 End, const FVector& Query, FCandidate& Best) const
+{
+	if (End - Begin <= LeafSize)
+	{
+		for (int32 Index = Begin; Index < End; ++Index)
+		{
+			const FCandidate Candidate = { FVector::DistSquared(Query, Entries[Index].Point), Entries[Index].PaletteIndex };
+			if (Candidate < Best)
+				Best = Candidate;
+		}
+		return;
+	}
+
+	const int32 Mid = (Begin + End) / 2;
+	const FEntry& Split = Entries[Mid];
+	const FCandidate Candidate = { FVector::DistSquared(Query, Split.Point), Split.PaletteIndex };
+	if (Candidate < Best)
+		Best = Candidate;
+
+	// Visit side containing query first, other side only if split plane is within best distance.
+	const float Delta = Query[Split.SplitAxis] - Split.Point[Split.SplitAxis];
+	if (Delta < 0.f)
+	{
+		SearchNearest(Begin, Mid, Query, Best);
+		if (Delta * Delta <= Best.DistanceSquared)
+			SearchNearest(Mid + 1, End, Query, Best);
+	}
+	else
+	{
+		SearchNearest(Mid + 1, End, Query, Best);
+		if (Delta * Delta <= Best.DistanceSquared)
+			SearchNearest(Begin, Mid, Query, Best);
+	}
+}
+
+void FColorPaletteIndex::FindKNearest(const FLinearColor& Color, const int32 K, TArray<int32>& OutIndices) const
+{
+	OutIndices.Reset();
+
+	const int32 Count = FMath::Min(K, Num());
+	if (Count <= 0)
+		return;
+
+	TArray<FCandidate, TInlineAllocator<16>> Best;
+	Best.Reserve(Count);
+	SearchKNearest(0, Entries.Num(), ToIndexSpace(Color), Count, Best);
+
+	OutIndices.Reserve(Count);
+	for (const FCandidate& Candidate : Best)
+	{
+		OutIndices.Add(Candidate.PaletteIndex);
+	}
+}
+
+void FColorPaletteIndex::SearchKNearest(const int32 Begin, const int32 End, const FVector& Query, const int32 K, TArray<FCandidate, TInlineAllocator<16>>& Best) const
+{
+	// Best is kept sorted, nearest first.
+	auto Consider = [&Best, K](const FCandidate& Candidate)
+	{
+		if (Best.Num() == K)
+		{
+			if (!(Candidate < Best.Last()))
+				return;
+			Best.Pop(false);
+		}
+
+		int32 Position = Best.Num();
+		while (Position > 0 && Candidate < Best[Position - 1])
+		{
+			--Position;
+		}
+		Best.Insert(Candidate, Position);
+	};
+
+	if (End - Begin <= LeafSize)
+	{
+		for (int32 Index = Begin; Index < End; ++Index)
+		{
+			Consider({ FVector::DistSquared(Query, Entries[Index].Point), Entries[Index].PaletteIndex });
+		}
+		return;
+	}
+
+	const int32 Mid = (Begin + End) / 2;
+	const FEntry& Split = Entries[Mid];
+	Consider({ FVector::DistSquared(Query, Split.Point), Split.PaletteIndex });
+
+	const float Delta = Query[Split.SplitAxis] - Split.Point[Split.SplitAxis];
+	const int32 NearBegin = Delta < 0.f ? Begin : Mid + 1;
+	const int32 NearEnd = Delta < 0.f ? Mid : End;
+	const int32 FarBegin = Delta < 0.f ? Mid + 1 : Begin;
+	const int32 FarEnd = Delta < 0.f ? End : Mid;
+
+	SearchKNearest(NearBegin, NearEnd, Query, K, Best);
+	if (Best.Num() < K || Delta * Delta <= Best.Last().DistanceSquared)
+		SearchKNearest(FarBegin, FarEnd, Query, K, Best);
+}
+
+void FColorPaletteIndex::FindNearestBatch(TArrayView<const FLinearColor> Queries, TArrayView<int32> OutIndices) const
+{
+	check(Queries.Num() == OutIndices.Num());
+
+	const int32 NumChunks = FMath::DivideAndRoundUp(Queries.Num(), BatchChunkSize);
+	ParallelFor(NumChunks, [this, &Queries, &OutIndices](const int32 Chunk)
+	{
+		const int32 End = FMath::Min((Chunk + 1) * BatchChunkSize, Queries.Num());
+		for (int32 Index = Chunk * BatchChunkSize; Index < End; ++Index)
+		{
+			OutIndices[Index] = FindNearest(Queries[Index]);
+		}
+	}, NumChunks <= 1);
+}
+
+int32 FColorPaletteIndex::FindNearestBruteForce(const FLinearColor& Color) const
+{
+	const FVector Query = ToIndexSpace(Color);
+
+	// Ties resolve to lowest palette index, same as the tree.
+	FCandidate Best = { MAX_flt, INDEX_NONE };
+	for (const FEntry& Entry : Entries)
+	{
+		const FCandidate Candidate = { FVector::DistSquared(Query, Entry.Point), Entry.PaletteIndex };
+		if (Candidate < Best)
+			Best = Candidate;
+	}
+	return Best.PaletteIndex;
+}
@@ -1,6 +1,8 @@
 // Copyright kevin791129
 
 #include "ColorPicker.h"
+#include "ColorPickerResourceCache.h"
+#include "ColorPickerStats.h"
 
 #define LOCTEXT_NAMESPACE "FColorPickerModule"
 
@@ -8,17 +10,19 @@ DEFINE_LOG_CATEGORY(LogColorPicker);
 DEFINE_LOG_CATEGORY(LogColorPickerWarning);
 DEFINE_LOG_CATEGORY(LogColorPickerError);
 
+CSV_DEFINE_CATEGORY(ColorPicker, true);
+
 void FColorPickerModule::StartupModule()
 {
 	// This code will execute after your module is loaded into memory; the exact timing is specified in the .uplugin file per-module
-	
+	FColorPickerResourceCache::Startup();
 }
 
 void FColorPickerModule::ShutdownModule()
 {
 	// This function may be called during shutdown to clean up your module.  For modules that support dynamic reloading,
 	// we call this function before unloading the module.
-	
+	FColorPickerResourceCache::Shutdown();
 }
 
 #undef LOCTEXT_NAMESPACE
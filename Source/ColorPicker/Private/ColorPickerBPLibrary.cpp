@@ -2,6 +2,23 @@
 
 #include "ColorPickerBPLibrary.h"
 #include "ColorPicker.h"
+#include "ColorPickerStats.h"
+#include "ColorConversionKernels.h"
+#include "ColorDifferenceKernels.h"
+#include "ColorFormatConverter.h"
+#include "SRGBTransfer.h"
+#include "ColorMath/ColorMathHex.h"
+
+using namespace ColorConversionKernels;
+
+DECLARE_CYCLE_STAT(TEXT("Batch Conversion"), STAT_ColorPickerBatchConversion, STATGROUP_ColorPicker);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Batch Colors Converted"), STAT_ColorPickerBatchColorsConverted, STATGROUP_ColorPicker);
+DECLARE_CYCLE_STAT(TEXT("Batch Color Difference"), STAT_ColorPickerBatchColorDifference, STATGROUP_ColorPicker);
+
+/** Instrument a batch conversion of Num colors, single color conversions are too short to time without distorting them. */
+#define COLORPICKER_BATCH_CONVERSION_SCOPE(Num) \
+	COLORPICKER_SCOPE_CYCLE_COUNTER(STAT_ColorPickerBatchConversion, BatchConversion); \
+	COLORPICKER_INC_COUNTER(STAT_ColorPickerBatchColorsConverted, BatchColorsConverted, Num)
 
 UColorPickerBPLibrary::UColorPickerBPLibrary(const FObjectInitializer& ObjectInitializer)
 : Super(ObjectInitializer)
@@ -12,140 +29,658 @@ UColorPickerBPLibrary::UColorPickerBPLibrary(const FObjectInitializer& ObjectIni
 #pragma region Color Conversion
 void UColorPickerBPLibrary::LinearColorToHex(const FLinearColor& Color, FString& OutHex)
 {
-	OutHex =  "#" + Color.ToFColor(true).ToHex().LeftChop(2);
+	TCHAR Buffer[HexBufferSize];
+	OutHex = FString(LinearColorToHex(Color, Buffer), Buffer);
 }
 
 void UColorPickerBPLibrary::LinearColorToRGB(const FLinearColor& Color, int& OutR, int& OutG, int& OutB)
 {
-	FColor ConvertColor = Color.ToFColor(true);
+	FColor ConvertColor = SRGBTransfer::ToFColor(Color);
 
 	OutR = ConvertColor.R;
 	OutG = ConvertColor.G;
 	OutB = ConvertColor.B;
 }
 
-void UColorPickerBPLibrary::LinearColorToHSV(const FLinearColor& Color, float& OutH, float& OutS, float& OutV)
+void UColorPickerBPLibrary::LinearColorToHSV(const FLinearColor& Color, float& OutH, float& OutS, float& OutV, const EColorPrecision Precision)
 {
-	FColor ConvertColor = Color.ToFColor(true);
-	const float RGBMin = FMath::Min3(ConvertColor.R, ConvertColor.G, ConvertColor.B);
-	const float RGBMax = FMath::Max3(ConvertColor.R, ConvertColor.G, ConvertColor.B);
-	const float RGBRange = RGBMax - RGBMin;
+	if (Precision == EColorPrecision::CP_FLOAT)
+		LinearToHSVFloat(Color, OutH, OutS, OutV);
+	else
+		ColorToHSV(SRGBTransfer::ToFColor(Color), OutH, OutS, OutV);
+}
 
-	OutH = (RGBMax == RGBMin ? 0.0f :
-		RGBMax == (float)ConvertColor.R ? FMath::Fmod((((float)(ConvertColor.G - ConvertColor.B) / RGBRange) * 60.0f) + 360.0f, 360.0f) :
-		RGBMax == (float)ConvertColor.G ? (((float)(ConvertColor.B - ConvertColor.R) / RGBRange) * 60.0f) + 120.0f :
-		RGBMax == (float)ConvertColor.B ? (((float)(ConvertColor.R - ConvertColor.G) / RGBRange) * 60.0f) + 240.0f :
-		0.0f);
-	OutS = (RGBMax == 0.0f ? 0.0f : RGBRange / RGBMax);
-	OutV = RGBMax / 255.f;
+void UColorPickerBPLibrary::LinearColorToCMYK(const FLinearColor& Color, float& OutC, float& OutM, float& OutY, float& OutK, const EColorPrecision Precision)
+{
+	if (Precision == EColorPrecision::CP_FLOAT)
+		LinearToCMYKFloat(Color, OutC, OutM, OutY, OutK);
+	else
+		ColorToCMYK(SRGBTransfer::ToFColor(Color), OutC, OutM, OutY, OutK);
 }
 
-void UColorPickerBPLibrary::LinearColorToCMYK(const FLinearColor& Color, float& OutC, float& OutM, float& OutY, float& OutK)
+void UColorPickerBPLibrary::LinearColorToHSL(const FLinearColor& Color, float& OutH, float& OutS, float& OutL, const EColorPrecision Precision)
 {
-	FColor ConvertColor = Color.ToFColor(true);
-	const float Max = FMath::Max3(ConvertColor.R, ConvertColor.G, ConvertColor.B);
+	if (Precision == EColorPrecision::CP_FLOAT)
+		LinearToHSLFloat(Color, OutH, OutS, OutL);
+	else
+		ColorToHSL(SRGBTransfer::ToFColor(Color), OutH, OutS, OutL);
+}
 
-	OutC = (Max - (float)ConvertColor.R) / Max;
-	OutM = (Max - (float)ConvertColor.G) / Max;
-	OutY = (Max - (float)ConvertColor.B) / Max;
-	OutK = 1.f - Max / 255.f;
+void UColorPickerBPLibrary::HexToLinearColor(const FString& Hex, FLinearColor& OutColor)
+{
+	ColorMath::TRGBA<uint8> ParsedColor;
+	ColorMath::Hex::Parse(*Hex, Hex.Len(), ParsedColor);
+	OutColor = SRGBTransfer::FromFColor(ToFColor(ParsedColor));
 }
 
-void UColorPickerBPLibrary::LinearColorToHSL(const FLinearColor& Color, float& OutH, float& OutS, float& OutL)
+void UColorPickerBPLibrary::RGBToLinearColor(const int R, const int G, const int B, FLinearColor& OutColor)
 {
-	FColor ConvertColor = Color.ToFColor(true);
-	const float RGBMin = FMath::Min3(ConvertColor.R, ConvertColor.G, ConvertColor.B);
-	const float RGBMax = FMath::Max3(ConvertColor.R, ConvertColor.G, ConvertColor.B);
-	const float RGBRange = RGBMax - RGBMin;
-	const float RGBSum = RGBMax + RGBMin;
+	OutColor = SRGBTransfer::FromFColor(FColor(FMath::Clamp(R, 0, 255), FMath::Clamp(G, 0, 255), FMath::Clamp(B, 0, 255)));
+}
 
-	OutH = (RGBMax == RGBMin ? 0.0f :
-		RGBMax == (float)ConvertColor.R ? FMath::Fmod((((float)(ConvertColor.G - ConvertColor.B) / RGBRange) * 60.0f) + 360.0f, 360.0f) :
-		RGBMax == (float)ConvertColor.G ? (((float)(ConvertColor.B - ConvertColor.R) / RGBRange) * 60.0f) + 120.0f :
-		RGBMax == (float)ConvertColor.B ? (((float)(ConvertColor.R - ConvertColor.G) / RGBRange) * 60.0f) + 240.0f :
-		0.0f);
-	OutS = RGBMax == 0.0f ? 0.0f : RGBRange / (255.0f - FMath::Abs(RGBSum - 255.0f));
-	OutL = RGBSum / 510.0f;
+void UColorPickerBPLibrary::HSVToLinearColor(const float H, const float S, const float V, FLinearColor& OutColor, const EColorPrecision Precision)
+{
+	OutColor = Precision == EColorPrecision::CP_FLOAT ? HSVToLinearFloat(H, S, V) : SRGBTransfer::FromFColor(HSVToColor(H, S, V));
 }
 
-void UColorPickerBPLibrary::HexToLinearColor(const FString& Hex, FLinearColor& OutColor)
+void UColorPickerBPLibrary::CMYKToLinearColor(const float C, const float M, const float Y, const float K, FLinearColor& OutColor, const EColorPrecision Precision)
 {
-	OutColor = FLinearColor::FromSRGBColor(FColor::FromHex(Hex));
+	OutColor = Precision == EColorPrecision::CP_FLOAT ? CMYKToLinearFloat(C, M, Y, K) : SRGBTransfer::FromFColor(CMYKToColor(C, M, Y, K));
 }
 
-void UColorPickerBPLibrary::RGBToLinearColor(const int R, const int G, const int B, FLinearColor& OutColor)
+void UColorPickerBPLibrary::HSLToLinearColor(const float H, const float S, const float L, FLinearColor& OutColor, const EColorPrecision Precision)
+{
+	OutColor = Precision == EColorPrecision::CP_FLOAT ? HSLToLinearFloat(H, S, L) : SRGBTransfer::FromFColor(HSLToColor(H, S, L));
+}
+
+void UColorPickerBPLibrary::LinearColorToLab(const FLinearColor& Color, float& OutL, float& OutA, float& OutB)
+{
+	const FVector Lab = LinearToLab(Color);
+	OutL = Lab.X;
+	OutA = Lab.Y;
+	OutB = Lab.Z;
+}
+
+void UColorPickerBPLibrary::LinearColorToOKLab(const FLinearColor& Color, float& OutL, float& OutA, float& OutB)
+{
+	const FVector Lab = LinearToOKLab(Color);
+	OutL = Lab.X;
+	OutA = Lab.Y;
+	OutB = Lab.Z;
+}
+
+void UColorPickerBPLibrary::LabToLinearColor(const float L, const float A, const float B, FLinearColor& OutColor)
+{
+	OutColor = LabToLinear(L, A, B);
+}
+
+void UColorPickerBPLibrary::OKLabToLinearColor(const float L, const float A, const float B, FLinearColor& OutColor)
+{
+	OutColor = OKLabToLinear(L, A, B);
+}
+
+FColorChannels UColorPickerBPLibrary::ConvertColorFormat(const FColorChannels& Value, const EColorFormat From, const EColorFormat To)
+{
+	return ColorFormatConverter::GetConverter(From, To).Convert(Value);
+}
+#pragma endregion
+
+#pragma region Color Difference
+namespace
+{
+	/** Runs a color difference over pairs, vector kernel on full lanes and scalar kernel on the remainder. */
+	template<typename VectorKernelType, typename ScalarKernelType>
+	void DeltaEPairs(const FVector* Lab1, const FVector* Lab2, float* OutDifferences, const int32 Num, VectorKernelType VectorKernel, ScalarKernelType ScalarKernel)
+	{
+		const int32 VectorNum = Num - Num % VectorWidth;
+
+		int32 Index = 0;
+		for (; Index < VectorNum; Index += VectorWidth)
+		{
+			VectorStore(VectorKernel(ColorDifferenceKernels::LoadLab(Lab1 + Index), ColorDifferenceKernels::LoadLab(Lab2 + Index)), OutDifferences + Index);
+		}
+		for (; Index < Num; ++Index)
+		{
+			OutDifferences[Index] = ScalarKernel(Lab1[Index], Lab2[Index]);
+		}
+	}
+
+	/** Same as 'DeltaEPairs' with the first color of every pair being Reference, which is splatted once. */
+	template<typename VectorKernelType, typename ScalarKernelType>
+	void DeltaEOneToMany(const FVector& Reference, const FVector* Lab, float* OutDifferences, const int32 Num, VectorKernelType VectorKernel, ScalarKernelType ScalarKernel)
+	{
+		const int32 VectorNum = Num - Num % VectorWidth;
+		const ColorDifferenceKernels::FLabRegisters ReferenceLab = ColorDifferenceKernels::SplatLab(Reference);
+
+		int32 Index = 0;
+		for (; Index < VectorNum; Index += VectorWidth)
+		{
+			VectorStore(VectorKernel(ReferenceLab, ColorDifferenceKernels::LoadLab(Lab + Index)), OutDifferences + Index);
+		}
+		for (; Index < Num; ++Index)
+		{
+			OutDifferences[Index] = ScalarKernel(Reference, Lab[Index]);
+		}
+	}
+}
+
+float UColorPickerBPLibrary::ColorDifference(const FLinearColor& A, const FLinearColor& B, const EColorDifference Method)
+{
+	const FVector Lab1 = LinearToLab(A);
+	const FVector Lab2 = LinearToLab(B);
+
+	switch (Method)
+	{
+	case EColorDifference::CD_CIE76:
+		return ColorDifferenceKernels::DeltaE76(Lab1, Lab2);
+	case EColorDifference::CD_CIE94:
+		return ColorDifferenceKernels::DeltaE94(Lab1, Lab2);
+	default:
+		return ColorDifferenceKernels::DeltaE2000(Lab1, Lab2);
+	}
+}
+
+void UColorPickerBPLibrary::DeltaEBatch(const EColorDifference Method, TArrayView<const FVector> Lab1, TArrayView<const FVector> Lab2, TArrayView<float> OutDifferences)
+{
+	COLORPICKER_SCOPE_CYCLE_COUNTER(STAT_ColorPickerBatchColorDifference, BatchColorDifference);
+
+	check(Lab2.Num() == Lab1.Num() && OutDifferences.Num() == Lab1.Num());
+
+	switch (Method)
+	{
+	case EColorDifference::CD_CIE76:
+		DeltaEPairs(Lab1.GetData(), Lab2.GetData(), OutDifferences.GetData(), Lab1.Num(), &ColorDifferenceKernels::VectorDeltaE76, &ColorDifferenceKernels::DeltaE76);
+		break;
+	case EColorDifference::CD_CIE94:
+		DeltaEPairs(Lab1.GetData(), Lab2.GetData(), OutDifferences.GetData(), Lab1.Num(), &ColorDifferenceKernels::VectorDeltaE94, &ColorDifferenceKernels::DeltaE94);
+		break;
+	default:
+		DeltaEPairs(Lab1.GetData(), Lab2.GetData(), OutDifferences.GetData(), Lab1.Num(), &ColorDifferenceKernels::VectorDeltaE2000, &ColorDifferenceKernels::DeltaE2000);
+		break;
+	}
+}
+
+void UColorPickerBPLibrary::DeltaEBatch(const EColorDifference Method, const FVector& Reference, TArrayView<const FVector> Lab, TArrayView<float> OutDifferences)
+{
+	COLORPICKER_SCOPE_CYCLE_COUNTER(STAT_ColorPickerBatchColorDifference, BatchColorDifference);
+
+	check(OutDifferences.Num() == Lab.Num());
+
+	switch (Method)
+	{
+	case EColorDifference::CD_CIE76:
+		DeltaEOneToMany(Reference, Lab.GetData(), OutDifferences.GetData(), Lab.Num(), &ColorDifferenceKernels::VectorDeltaE76, &ColorDifferenceKernels::DeltaE76);
+		break;
+	case EColorDifference::CD_CIE94:
+		DeltaEOneToMany(Reference, Lab.GetData(), OutDifferences.GetData(), Lab.Num(), &ColorDifferenceKernels::VectorDeltaE94, &ColorDifferenceKernels::DeltaE94);
+		break;
+	default:
+		DeltaEOneToMany(Reference, Lab.GetData(), OutDifferences.GetData(), Lab.Num(), &ColorDifferenceKernels::VectorDeltaE2000, &ColorDifferenceKernels::DeltaE2000);
+		break;
+	}
+}
+#pragma endregion
+
+#pragma region Batch Color Conversion
+namespace
+{
+	FORCEINLINE void QuantizeColors(const FLinearColor* Colors, FColor* OutColors)
+	{
+		for (int32 Lane = 0; Lane < VectorWidth; ++Lane)
+		{
+			OutColors[Lane] = SRGBTransfer::ToFColor(Colors[Lane]);
+		}
+	}
+
+	FORCEINLINE void DecodeColors(const FColor* Colors, FLinearColor* OutColors, const int32 Num)
+	{
+		for (int32 Index = 0; Index < Num; ++Index)
+		{
+			OutColors[Index] = SRGBTransfer::FromFColor(Colors[Index]);
+		}
+	}
+
+	/** Runs a linear color to 3 channel color conversion, vector kernel on full lanes and scalar kernel on the remainder. */
+	template<typename VectorKernelType, typename ScalarKernelType>
+	void LinearColorTo3ChannelBatch(TArrayView<const FLinearColor> Colors, float* OutX, float* OutY, float* OutZ, VectorKernelType VectorKernel, ScalarKernelType ScalarKernel)
+	{
+		const int32 Num = Colors.Num();
+		const int32 VectorNum = Num - Num % VectorWidth;
+		FColor Quantized[VectorWidth];
+
+		int32 Index = 0;
+		for (; Index < VectorNum; Index += VectorWidth)
+		{
+			QuantizeColors(Colors.GetData() + Index, Quantized);
+			VectorKernel(Quantized, OutX + Index, OutY + Index, OutZ + Index);
+		}
+		for (; Index < Num; ++Index)
+		{
+			ScalarKernel(SRGBTransfer::ToFColor(Colors[Index]), OutX[Index], OutY[Index], OutZ[Index]);
+		}
+	}
+
+	/** Same as 'LinearColorTo3ChannelBatch' but packs the results into R, G and B of the source colors. */
+	template<typename VectorKernelType, typename ScalarKernelType>
+	void LinearColorTo3ChannelInPlace(TArrayView<FLinearColor> Colors, VectorKernelType VectorKernel, ScalarKernelType ScalarKernel)
+	{
+		const int32 Num = Colors.Num();
+		const int32 VectorNum = Num - Num % VectorWidth;
+		FColor Quantized[VectorWidth];
+		float X[VectorWidth], Y[VectorWidth], Z[VectorWidth];
+
+		int32 Index = 0;
+		for (; Index < VectorNum; Index += VectorWidth)
+		{
+			QuantizeColors(Colors.GetData() + Index, Quantized);
+			VectorKernel(Quantized, X, Y, Z);
+			for (int32 Lane = 0; Lane < VectorWidth; ++Lane)
+			{
+				FLinearColor& Color = Colors[Index + Lane];
+				Color.R = X[Lane];
+				Color.G = Y[Lane];
+				Color.B = Z[Lane];
+			}
+		}
+		for (; Index < Num; ++Index)
+		{
+			FLinearColor& Color = Colors[Index];
+			ScalarKernel(SRGBTransfer::ToFColor(Color), Color.R, Color.G, Color.B);
+		}
+	}
+
+	/** Runs a 3 channel color to linear color conversion, vector kernel on full lanes and scalar kernel on the remainder. */
+	template<typename VectorKernelType, typename ScalarKernelType>
+	void ThreeChannelToLinearColorBatch(const float* X, const float* Y, const float* Z, TArrayView<FLinearColor> OutColors, VectorKernelType VectorKernel, ScalarKernelType ScalarKernel)
+	{
+		const int32 Num = OutColors.Num();
+		const int32 VectorNum = Num - Num % VectorWidth;
+		FColor Quantized[VectorWidth];
+
+		int32 Index = 0;
+		for (; Index < VectorNum; Index += VectorWidth)
+		{
+			VectorKernel(X + Index, Y + Index, Z + Index, Quantized);
+			DecodeColors(Quantized, OutColors.GetData() + Index, VectorWidth);
+		}
+		for (; Index < Num; ++Index)
+		{
+			OutColors[Index] = SRGBTransfer::FromFColor(ScalarKernel(X[Index], Y[Index], Z[Index]));
+		}
+	}
+
+	/** Same as 'ThreeChannelToLinearColorBatch' but reads the source values from R, G and B of the colors. Alpha is kept. */
+	template<typename VectorKernelType, typename ScalarKernelType>
+	void ThreeChannelToLinearColorInPlace(TArrayView<FLinearColor> Colors, VectorKernelType VectorKernel, ScalarKernelType ScalarKernel)
+	{
+		const int32 Num = Colors.Num();
+		const int32 VectorNum = Num - Num % VectorWidth;
+		FColor Quantized[VectorWidth];
+		float X[VectorWidth], Y[VectorWidth], Z[VectorWidth];
+
+		int32 Index = 0;
+		for (; Index < VectorNum; Index += VectorWidth)
+		{
+			for (int32 Lane = 0; Lane < VectorWidth; ++Lane)
+			{
+				const FLinearColor& Color = Colors[Index + Lane];
+				X[Lane] = Color.R;
+				Y[Lane] = Color.G;
+				Z[Lane] = Color.B;
+			}
+			VectorKernel(X, Y, Z, Quantized);
+			for (int32 Lane = 0; Lane < VectorWidth; ++Lane)
+			{
+				FLinearColor& Color = Colors[Index + Lane];
+				const float Alpha = Color.A;
+				Color = SRGBTransfer::FromFColor(Quantized[Lane]);
+				Color.A = Alpha;
+			}
+		}
+		for (; Index < Num; ++Index)
+		{
+			FLinearColor& Color = Colors[Index];
+			const float Alpha = Color.A;
+			Color = SRGBTransfer::FromFColor(ScalarKernel(Color.R, Color.G, Color.B));
+			Color.A = Alpha;
+		}
+	}
+}
+
+void UColorPickerBPLibrary::LinearColorToRGBBatch(TArrayView<const FLinearColor> Colors, TArrayView<FColor> OutColors)
+{
+	COLORPICKER_BATCH_CONVERSION_SCOPE(Colors.Num());
+
+	check(OutColors.Num() == Colors.Num());
+
+	for (int32 Index = 0; Index < Colors.Num(); ++Index)
+	{
+		OutColors[Index] = SRGBTransfer::ToFColor(Colors[Index]);
+	}
+}
+
+void UColorPickerBPLibrary::LinearColorToHSVBatch(TArrayView<const FLinearColor> Colors, TArrayView<float> OutH, TArrayView<float> OutS, TArrayView<float> OutV)
+{
+	COLORPICKER_BATCH_CONVERSION_SCOPE(Colors.Num());
+
+	check(OutH.Num() == Colors.Num() && OutS.Num() == Colors.Num() && OutV.Num() == Colors.Num());
+
+	LinearColorTo3ChannelBatch(Colors, OutH.GetData(), OutS.GetData(), OutV.GetData(), &VectorColorToHSV, &ColorToHSV);
+}
+
+void UColorPickerBPLibrary::LinearColorToHSVBatch(TArrayView<FLinearColor> Colors)
+{
+	COLORPICKER_BATCH_CONVERSION_SCOPE(Colors.Num());
+
+	LinearColorTo3ChannelInPlace(Colors, &VectorColorToHSV, &ColorToHSV);
+}
+
+void UColorPickerBPLibrary::LinearColorToCMYKBatch(TArrayView<const FLinearColor> Colors, TArrayView<float> OutC, TArrayView<float> OutM, TArrayView<float> OutY, TArrayView<float> OutK)
+{
+	COLORPICKER_BATCH_CONVERSION_SCOPE(Colors.Num());
+
+	check(OutC.Num() == Colors.Num() && OutM.Num() == Colors.Num() && OutY.Num() == Colors.Num() && OutK.Num() == Colors.Num());
+
+	const int32 Num = Colors.Num();
+	const int32 VectorNum = Num - Num % VectorWidth;
+	FColor Quantized[VectorWidth];
+
+	int32 Index = 0;
+	for (; Index < VectorNum; Index += VectorWidth)
+	{
+		QuantizeColors(Colors.GetData() + Index, Quantized);
+		VectorColorToCMYK(Quantized, OutC.GetData() + Index, OutM.GetData() + Index, OutY.GetData() + Index, OutK.GetData() + Index);
+	}
+	for (; Index < Num; ++Index)
+	{
+		ColorToCMYK(SRGBTransfer::ToFColor(Colors[Index]), OutC[Index], OutM[Index], OutY[Index], OutK[Index]);
+	}
+}
+
+void UColorPickerBPLibrary::LinearColorToHSLBatch(TArrayView<const FLinearColor> Colors, TArrayView<float> OutH, TArrayView<float> OutS, TArrayView<float> OutL)
+{
+	COLORPICKER_BATCH_CONVERSION_SCOPE(Colors.Num());
+
+	check(OutH.Num() == Colors.Num() && OutS.Num() == Colors.Num() && OutL.Num() == Colors.Num());
+
+	LinearColorTo3ChannelBatch(Colors, OutH.GetData(), OutS.GetData(), OutL.GetData(), &VectorColorToHSL, &ColorToHSL);
+}
+
+void UColorPickerBPLibrary::LinearColorToHSLBatch(TArrayView<FLinearColor> Colors)
+{
+	COLORPICKER_BATCH_CONVERSION_SCOPE(Colors.Num());
+
+	LinearColorTo3ChannelInPlace(Colors, &VectorColorToHSL, &ColorToHSL);
+}
+
+void UColorPickerBPLibrary::RGBToLinearColorBatch(TArrayView<const FColor> Colors, TArrayView<FLinearColor> OutColors)
+{
+	COLORPICKER_BATCH_CONVERSION_SCOPE(Colors.Num());
+
+	check(OutColors.Num() == Colors.Num());
+
+	for (int32 Index = 0; Index < Colors.Num(); ++Index)
+	{
+		const FColor& Color = Colors[Index];
+		OutColors[Index] = SRGBTransfer::FromFColor(FColor(Color.R, Color.G, Color.B));
+	}
+}
+
+void UColorPickerBPLibrary::HSVToLinearColorBatch(TArrayView<const float> H, TArrayView<const float> S, TArrayView<const float> V, TArrayView<FLinearColor> OutColors)
+{
+	COLORPICKER_BATCH_CONVERSION_SCOPE(OutColors.Num());
+
+	check(S.Num() == H.Num() && V.Num() == H.Num() && OutColors.Num() == H.Num());
+
+	ThreeChannelToLinearColorBatch(H.GetData(), S.GetData(), V.GetData(), OutColors, &VectorHSVToColor, &HSVToColor);
+}
+
+void UColorPickerBPLibrary::HSVToLinearColorBatch(TArrayView<FLinearColor> Colors)
+{
+	COLORPICKER_BATCH_CONVERSION_SCOPE(Colors.Num());
+
+	ThreeChannelToLinearColorInPlace(Colors, &VectorHSVToColor, &HSVToColor);
+}
+
+void UColorPickerBPLibrary::CMYKToLinearColorBatch(TArrayView<const float> C, TArrayView<const float> M, TArrayView<const float> Y, TArrayView<const float> K, TArrayView<FLinearColor> OutColors)
+{
+	COLORPICKER_BATCH_CONVERSION_SCOPE(OutColors.Num());
+
+	check(M.Num() == C.Num() && Y.Num() == C.Num() && K.Num() == C.Num() && OutColors.Num() == C.Num());
+
+	const int32 Num = OutColors.Num();
+	const int32 VectorNum = Num - Num % VectorWidth;
+	FColor Quantized[VectorWidth];
+
+	int32 Index = 0;
+	for (; Index < VectorNum; Index += VectorWidth)
+	{
+		VectorCMYKToColor(C.GetData() + Index, M.GetData() + Index, Y.GetData() + Index, K.GetData() + Index, Quantized);
+		DecodeColors(Quantized, OutColors.GetData() + Index, VectorWidth);
+	}
+	for (; Index < Num; ++Index)
+	{
+		OutColors[Index] = SRGBTransfer::FromFColor(CMYKToColor(C[Index], M[Index], Y[Index], K[Index]));
+	}
+}
+
+void UColorPickerBPLibrary::HSLToLinearColorBatch(TArrayView<const float> H, TArrayView<const float> S, TArrayView<const float> L, TArrayView<FLinearColor> OutColors)
 {
-	OutColor = FLinearColor::FromSRGBColor(FColor(FMath::Clamp(R, 0, 255), FMath::Clamp(G, 0, 255), FMath::Clamp(B, 0, 255)));
-}
-
-void UColorPickerBPLibrary::HSVToLinearColor(const float H, const float S, const float V, FLinearColor& OutColor)
-{
-	const float HClamp = FMath::Clamp(H, 0.0f, 360.0f);
-	const float SClamp = FMath::Clamp(S, 0.0f, 1.0f);
-	const float VClamp = FMath::Clamp(V, 0.0f, 1.0f);
-	const float HDiv60 = HClamp / 60.0f;
-	const float HDiv60_Floor = floorf(HDiv60);
-	const float HDiv60_Fraction = HDiv60 - HDiv60_Floor;
-	const float RGBValues[4] = {
-		VClamp * 255.f,
-		VClamp * (1.0f - SClamp) * 255.f,
-		VClamp * (1.0f - (HDiv60_Fraction * SClamp)) * 255.f,
-		VClamp * (1.0f - ((1.0f - HDiv60_Fraction) * SClamp)) * 255.f
-	};
-	const uint32 RGBSwizzle[6][3] = {
-		{0, 3, 1},
-		{2, 0, 1},
-		{1, 0, 3},
-		{1, 2, 0},
-		{3, 1, 0},
-		{0, 1, 2},
-	};
-	const uint32 SwizzleIndex = ((uint32)HDiv60_Floor) % 6;
-
-	OutColor = FLinearColor::FromSRGBColor(FColor(RGBValues[RGBSwizzle[SwizzleIndex][0]], 
-		RGBValues[RGBSwizzle[SwizzleIndex][1]], 
-		RGBValues[RGBSwizzle[SwizzleIndex][2]]));
-}
-
-void UColorPickerBPLibrary::CMYKToLinearColor(const float C, const float M, const float Y, const float K, FLinearColor& OutColor)
-{
-	const float R = 255.f * (1 - FMath::Clamp(C, 0.f, 1.0f)) * (1 - FMath::Clamp(K, 0.f, 1.0f));
-	const float G = 255.f * (1 - FMath::Clamp(M, 0.f, 1.0f)) * (1 - FMath::Clamp(K, 0.f, 1.0f));
-	const float B = 255.f * (1 - FMath::Clamp(Y, 0.f, 1.0f)) * (1 - FMath::Clamp(K, 0.f, 1.0f));
-
-	OutColor = FLinearColor::FromSRGBColor(FColor(R, G, B));
-}
-
-#pragma optimize("", off)
-void UColorPickerBPLibrary::HSLToLinearColor(const float H, const float S, const float L, FLinearColor& OutColor)
-{
-	const float HClamp = FMath::Clamp(H, 0.0f, 360.0f);
-	const float SClamp = FMath::Clamp(S, 0.0f, 1.0f);
-	const float LClamp = FMath::Clamp(L, 0.0f, 1.0f);
-	const float CHalf = (1.0f - FMath::Abs(2.0f * LClamp - 1.0f)) * SClamp / 2.0f;
-	const float HDiv60 = HClamp / 60.0f;
-	const float HDiv60_Floor = floorf(HDiv60);
-	const float HDiv60_Fraction_Double = (HDiv60 - HDiv60_Floor) * 2.0f;
-	const float RGBValues[4] = {
-		(LClamp + CHalf) * 255.f,
-		(LClamp - CHalf) * 255.f,
-		(LClamp + CHalf * (1.0f - HDiv60_Fraction_Double)) * 255.f,
-		(LClamp + CHalf * (HDiv60_Fraction_Double - 1.0f)) * 255.f
-	};
-	const uint32 RGBSwizzle[6][3] = {
-		{0, 3, 1},
-		{2, 0, 1},
-		{1, 0, 3},
-		{1, 2, 0},
-		{3, 1, 0},
-		{0, 1, 2},
-	};
-	const uint32 SwizzleIndex = ((uint32)HDiv60_Floor) % 6;
-
-	OutColor = FLinearColor::FromSRGBColor(FColor(RGBValues[RGBSwizzle[SwizzleIndex][0]],
-		RGBValues[RGBSwizzle[SwizzleIndex][1]],
-		RGBValues[RGBSwizzle[SwizzleIndex][2]]));
-}
-#pragma optimize("", on)
+	COLORPICKER_BATCH_CONVERSION_SCOPE(OutColors.Num());
+
+	check(S.Num() == H.Num() && L.Num() == H.Num() && OutColors.Num() == H.Num());
+
+	ThreeChannelToLinearColorBatch(H.GetData(), S.GetData(), L.GetData(), OutColors, &VectorHSLToColor, &HSLToColor);
+}
+
+void UColorPickerBPLibrary::HSLToLinearColorBatch(TArrayView<FLinearColor> Colors)
+{
+	COLORPICKER_BATCH_CONVERSION_SCOPE(Colors.Num());
+
+	ThreeChannelToLinearColorInPlace(Colors, &VectorHSLToColor, &HSLToColor);
+}
+
+void UColorPickerBPLibrary::LinearColorToLabBatch(TArrayView<const FLinearColor> Colors, TArrayView<FVector> OutLab)
+{
+	COLORPICKER_BATCH_CONVERSION_SCOPE(Colors.Num());
+
+	check(OutLab.Num() == Colors.Num());
+
+	// Vector registers have no cube root, so Lab conversion stays scalar.
+	for (int32 Index = 0; Index < Colors.Num(); ++Index)
+	{
+		OutLab[Index] = LinearToLab(Colors[Index]);
+	}
+}
+
+void UColorPickerBPLibrary::LinearColorToOKLabBatch(TArrayView<const FLinearColor> Colors, TArrayView<FVector> OutLab)
+{
+	COLORPICKER_BATCH_CONVERSION_SCOPE(Colors.Num());
+
+	check(OutLab.Num() == Colors.Num());
+
+	for (int32 Index = 0; Index < Colors.Num(); ++Index)
+	{
+		OutLab[Index] = LinearToOKLab(Colors[Index]);
+	}
+}
 #pragma endregion
 
+#pragma region Fixed-Point Color Conversion
+namespace
+{
+	FORCEINLINE uint32 PackHueColor(const ColorMath::Fixed::FHSV8& Color)
+	{
+		return (uint32)Color.H | ((uint32)Color.S << 16) | ((uint32)Color.V << 24);
+	}
+
+	FORCEINLINE uint32 PackHueColor(const ColorMath::Fixed::FHSL8& Color)
+	{
+		return (uint32)Color.H | ((uint32)Color.S << 16) | ((uint32)Color.L << 24);
+	}
+
+	/**
+	 * Store a packed hue color as one 32-bit word, compilers do not vectorize stores of its mixed size members.
+	 */
+	template<typename HueColorType>
+	FORCEINLINE void StoreHueColor(HueColorType* Out, const HueColorType& Color)
+	{
+		static_assert(sizeof(HueColorType) == sizeof(uint32), "Packed hue colors are 4 bytes.");
+#if PLATFORM_LITTLE_ENDIAN
+		const uint32 Packed = PackHueColor(Color);
+		FMemory::Memcpy(Out, &Packed, sizeof(uint32));
+#else
+		*Out = Color;
+#endif
+	}
+}
+
+void UColorPickerBPLibrary::RGBToHSV8Batch(TArrayView<const FColor> Colors, TArrayView<ColorMath::Fixed::FHSV8> OutHSV)
+{
+	COLORPICKER_BATCH_CONVERSION_SCOPE(Colors.Num());
+
+	check(OutHSV.Num() == Colors.Num());
+
+	const FColor* RESTRICT Source = Colors.GetData();
+	ColorMath::Fixed::FHSV8* RESTRICT Destination = OutHSV.GetData();
+	for (int32 Index = 0; Index < Colors.Num(); ++Index)
+	{
+		const FColor Color = Source[Index];
+		StoreHueColor(Destination + Index, ColorMath::Fixed::RGBToHSV8(Color.R, Color.G, Color.B));
+	}
+}
+
+void UColorPickerBPLibrary::HSV8ToRGBBatch(TArrayView<const ColorMath::Fixed::FHSV8> HSV, TArrayView<FColor> OutColors)
+{
+	COLORPICKER_BATCH_CONVERSION_SCOPE(HSV.Num());
+
+	check(OutColors.Num() == HSV.Num());
+
+	const ColorMath::Fixed::FHSV8* RESTRICT Source = HSV.GetData();
+	FColor* RESTRICT Destination = OutColors.GetData();
+	for (int32 Index = 0; Index < HSV.Num(); ++Index)
+	{
+		Destination[Index] = ToFColor(ColorMath::Fixed::HSV8ToRGB(Source[Index]));
+	}
+}
+
+void UColorPickerBPLibrary::RGBToHSL8Batch(TArrayView<const FColor> Colors, TArrayView<ColorMath::Fixed::FHSL8> OutHSL)
+{
+	COLORPICKER_BATCH_CONVERSION_SCOPE(Colors.Num());
+
+	check(OutHSL.Num() == Colors.Num());
+
+	const FColor* RESTRICT Source = Colors.GetData();
+	ColorMath::Fixed::FHSL8* RESTRICT Destination = OutHSL.GetData();
+	for (int32 Index = 0; Index < Colors.Num(); ++Index)
+	{
+		const FColor Color = Source[Index];
+		StoreHueColor(Destination + Index, ColorMath::Fixed::RGBToHSL8(Color.R, Color.G, Color.B));
+	}
+}
+
+void UColorPickerBPLibrary::HSL8ToRGBBatch(TArrayView<const ColorMath::Fixed::FHSL8> HSL, TArrayView<FColor> OutColors)
+{
+	COLORPICKER_BATCH_CONVERSION_SCOPE(HSL.Num());
+
+	check(OutColors.Num() == HSL.Num());
+
+	const ColorMath::Fixed::FHSL8* RESTRICT Source = HSL.GetData();
+	FColor* RESTRICT Destination = OutColors.GetData();
+	for (int32 Index = 0; Index < HSL.Num(); ++Index)
+	{
+		Destination[Index] = ToFColor(ColorMath::Fixed::HSL8ToRGB(Source[Index]));
+	}
+}
+#pragma endregion
+
+#pragma region Hex
+namespace
+{
+	template<typename CharType>
+	FORCEINLINE int32 WriteHex(const FLinearColor& Color, CharType* OutBuffer)
+	{
+		OutBuffer[0] = '#';
+		CharType* End = ColorMath::Hex::EncodeRGB(ToRGBA(SRGBTransfer::ToFColor(Color)), OutBuffer + 1);
+		*End = '\0';
+		return UColorPickerBPLibrary::HexLength;
+	}
+}
+
+int32 UColorPickerBPLibrary::LinearColorToHex(const FLinearColor& Color, TCHAR* OutBuffer)
+{
+	return WriteHex(Color, OutBuffer);
+}
+
+int32 UColorPickerBPLibrary::LinearColorToHex(const FLinearColor& Color, ANSICHAR* OutBuffer)
+{
+	return WriteHex(Color, OutBuffer);
+}
+
+void UColorPickerBPLibrary::AppendLinearColorToHex(const FLinearColor& Color, FString& OutHex)
+{
+	TCHAR Buffer[HexBufferSize];
+	OutHex.AppendChars(Buffer, WriteHex(Color, Buffer));
+}
+
+bool UColorPickerBPLibrary::ParseHex(FStringView Hex, FLinearColor& OutColor)
+{
+	ColorMath::TRGBA<uint8> ParsedColor;
+	if (!ColorMath::Hex::Parse(Hex.GetData(), Hex.Len(), ParsedColor))
+		return false;
+
+	OutColor = SRGBTransfer::FromFColor(ToFColor(ParsedColor));
+	return true;
+}
+
+void UColorPickerBPLibrary::PaletteToHex(TArrayView<const FLinearColor> Colors, FString& OutHex, TCHAR Separator)
+{
+	if (Colors.Num() == 0)
+	{
+		OutHex.Reset();
+		return;
+	}
+
+	// Write straight into the character array, sized once for every entry and the null terminator.
+	TArray<TCHAR>& CharArray = OutHex.GetCharArray();
+	CharArray.SetNumUninitialized(Colors.Num() * (HexLength + 1) + 1, false);
+
+	TCHAR* Out = CharArray.GetData();
+	for (const FLinearColor& Color : Colors)
+	{
+		Out += WriteHex(Color, Out);
+		*Out++ = Separator;
+	}
+	*Out = TEXT('\0');
+}
+
+bool UColorPickerBPLibrary::HexToPalette(FStringView Hex, TArray<FLinearColor>& OutColors, TCHAR Separator)
+{
+	int32 EntryCount = 1;
+	for (int32 Index = 0; Index < Hex.Len(); ++Index)
+	{
+		EntryCount += Hex[Index] == Separator ? 1 : 0;
+	}
+	OutColors.Reserve(OutColors.Num() + EntryCount);
+
+	while (!Hex.IsEmpty())
+	{
+		int32 SeparatorIndex;
+		if (!Hex.FindChar(Separator, SeparatorIndex))
+			SeparatorIndex = Hex.Len();
+
+		const FStringView Entry = Hex.Left(SeparatorIndex).TrimStartAndEnd();
+		Hex = Hex.RightChop(SeparatorIndex + 1);
+
+		if (Entry.IsEmpty())
+			continue;
+
+		FLinearColor Color;
+		if (!ParseHex(Entry, Color))
+			return false;
+		OutColors.Add(Color);
+	}
+
+	return true;
+}
+#pragma endregion
@@ -0,0 +1,1358 @@
+// Copyright kevin791129
+
+#include "CoreMinimal.h"
+
+#if !UE_BUILD_SHIPPING
+
+#include "ColorPicker.h"
+#include "ColorPickerBPLibrary.h"
+#include "ColorFormat.h"
+#include "ColorFormatConverter.h"
+#include "ColorDifferenceKernels.h"
+#include "ColorGradientRasterizer.h"
+#include "ColorGradientRamp.h"
+#include "ColorImageAdjustment.h"
+#include "ColorPaletteExtractor.h"
+#include "ColorPaletteIndex.h"
+#include "ColorEyedropperSampler.h"
+#include "ColorSwatchLibrary.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/FileManager.h"
+#include "HAL/MemoryBase.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/ThreadSafeBool.h"
+#include "HAL/ThreadSafeCounter64.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonWriter.h"
+
+/**
+ * Microbenchmarks for the conversion library.
+ *
+ * Usage: ColorPicker.Benchmark [MaxBatchSize=10000000] [OutputFile]
+ * Hex conversions are capped at 1000000 colors per batch since every hex string owns an allocation.
+ * Allocations per color and per palette extraction are counted in an untimed pass, on worker threads as well as the calling thread.
+ * Gradient rasterization is measured per fill at 1080p and 4K, palette extraction per image across image sizes and thread counts.
+ * Image adjustments are measured at 1080p and 4K on color and linear color buffers, HSV adjustments against per pixel picker conversions.
+ * Gradient ramps are sampled through their table for every interpolation space, against interpolating stops directly.
+ * Palette index queries are compared against brute force at 1K, 10K and 100K colors.
+ * Color differences are measured per pair for batch pairs, one-to-many and a scalar loop, with the largest deviation of the batch results.
+ * Direct format conversions are compared against converting to linear color and back for every pair of non hex formats.
+ * Eyedropper table builds are measured at 1080p and 4K, area queries against summing the area directly for several radii.
+ * Swatch libraries of 100K swatches are loaded from JSON and from binary files, with resident memory taken from process stats.
+ * Results are written as JSON, by default to Saved/ColorPicker/Benchmark-<time>.json.
+ */
+namespace ColorPickerBenchmark
+{
+	/**
+	 * Allocator forwarding to the allocator it wraps, counting allocations while counting is on.
+	 * Installed once on first use and never removed, blocks allocated through it can be freed at any later time.
+	 * Render and RHI thread allocations are left out, task graph workers are counted so parallel cases are attributed in full.
+	 */
+	class FCountingMalloc final : public FMalloc
+	{
+	public:
+		/**
+		 * Counting allocator, installed as GMalloc by the first call.
+		 */
+		static FCountingMalloc& Get()
+		{
+			// Created with the system allocator FMalloc derives from, never deleted since GMalloc keeps pointing at it.
+			static FCountingMalloc* Instance = []()
+			{
+				FCountingMalloc* Counting = new FCountingMalloc(GMalloc);
+				GMalloc = Counting;
+				return Counting;
+			}();
+			return *Instance;
+		}
+
+		virtual void* Malloc(SIZE_T Count, uint32 Alignment) override
+		{
+			Record(Count);
+			return Inner->Malloc(Count, Alignment);
+		}
+
+		virtual void* TryMalloc(SIZE_T Count, uint32 Alignment) override
+		{
+			Record(Count);
+			return Inner->TryMalloc(Count, Alignment);
+		}
+
+		virtual void* Realloc(void* Original, SIZE_T Count, uint32 Alignment) override
+		{
+			if (Count > 0)
+				Record(Count);
+			return Inner->Realloc(Original, Count, Alignment);
+		}
+
+		virtual void* TryRealloc(void* Original, SIZE_T Count, uint32 Alignment) override
+		{
+			if (Count > 0)
+				Record(Count);
+			return Inner->TryRealloc(Original, Count, Alignment);
+		}
+
+		virtual void Free(void* Original) override
+		{
+			Inner->Free(Original);
+		}
+
+		virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override
+		{
+			return Inner->QuantizeSize(Count, Alignment);
+		}
+
+		virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override
+		{
+			return Inner->GetAllocationSize(Original, SizeOut);
+		}
+
+		virtual void Trim(bool bTrimThreadCaches) override
+		{
+			Inner->Trim(bTrimThreadCaches);
+		}
+
+		virtual void SetupTLSCachesOnCurrentThread() override
+		{
+			Inner->SetupTLSCachesOnCurrentThread();
+		}
+
+		virtual void ClearAndDisableTLSCachesOnCurrentThread() override
+		{
+			Inner->ClearAndDisableTLSCachesOnCurrentThread();
+		}
+
+		virtual void InitializeStatsMetadata() override
+		{
+			Inner->InitializeStatsMetadata();
+		}
+
+		virtual void UpdateStats() override
+		{
+			Inner->UpdateStats();
+		}
+
+		virtual void GetAllocatorStats(FGenericMemoryStats& OutStats) override
+		{
+			Inner->GetAllocatorStats(OutStats);
+		}
+
+		virtual void DumpAllocatorStats(FOutputDevice& Ar) override
+		{
+			Inner->DumpAllocatorStats(Ar);
+		}
+
+		virtual bool IsInternallyThreadSafe() const override
+		{
+			return Inner->IsInternallyThreadSafe();
+		}
+
+		virtual bool ValidateHeap() override
+		{
+			return Inner->ValidateHeap();
+		}
+
+		virtual const TCHAR* GetDescriptiveName() override
+		{
+			return Inner->GetDescriptiveName();
+		}
+
+		/**
+		 * Reset counts and start counting.
+		 */
+		void Start()
+		{
+			Allocations.Reset();
+			Bytes.Reset();
+			bCounting = true;
+		}
+
+		void Stop()
+		{
+			bCounting = false;
+		}
+
+		int64 GetAllocations() const { return Allocations.GetValue(); }
+		int64 GetBytes() const { return Bytes.GetValue(); }
+
+	private:
+		explicit FCountingMalloc(FMalloc* InInner) : Inner(InInner) {}
+
+		void Record(const SIZE_T Count)
+		{
+			if (!bCounting || IsInActualRenderingThread() || IsInRHIThread())
+				return;
+
+			Allocations.Increment();
+			Bytes.Add((int64)Count);
+		}
+
+		FMalloc* Inner;
+		FThreadSafeBool bCounting;
+		FThreadSafeCounter64 Allocations;
+		FThreadSafeCounter64 Bytes;
+	};
+
+	/**
+	 * Allocations made by a call, counted by the call and by tasks it waits for.
+	 */
+	struct FAllocationCount
+	{
+		int64 Allocations = 0;
+		/** Requested bytes, allocator rounding and resized blocks are not accounted for. */
+		int64 Bytes = 0;
+	};
+
+	template<typename FunctionType>
+	static FAllocationCount CountAllocations(FunctionType&& Function)
+	{
+		FCountingMalloc& Counting = FCountingMalloc::Get();
+		Counting.Start();
+		Function();
+		Counting.Stop();
+		return { Counting.GetAllocations(), Counting.GetBytes() };
+	}
+
+	/**
+	 * Conversion inputs in every format, derived from the same source colors.
+	 */
+	struct FInputs
+	{
+		TArray<FLinearColor> Colors;
+		TArray<FString> Hex;
+		TArray<FColor> RGB;
+		TArray<float> HSV_H, HSV_S, HSV_V;
+		TArray<float> CMYK_C, CMYK_M, CMYK_Y, CMYK_K;
+		TArray<float> HSL_H, HSL_S, HSL_L;
+		TArray<FVector> Lab, OKLab;
+		TArray<ColorMath::Fixed::FHSV8> HSV8;
+		TArray<ColorMath::Fixed::FHSL8> HSL8;
+
+		/**
+		 * @param Source : Source colors, repeated to fill Num entries.
+		 * @param Num : Number of inputs for non hex formats.
+		 * @param HexNum : Number of hex string inputs, kept smaller since each one owns an allocation.
+		 */
+		void Build(const TArray<FLinearColor>& Source, const int32 Num, const int32 HexNum)
+		{
+			Colors.SetNumUninitialized(Num);
+			for (int32 Index = 0; Index < Num; ++Index)
+			{
+				Colors[Index] = Source[Index % Source.Num()];
+			}
+
+			Hex.SetNum(HexNum);
+			RGB.SetNumUninitialized(Num);
+			for (int32 Index = 0; Index < HexNum; ++Index)
+			{
+				UColorPickerBPLibrary::LinearColorToHex(Colors[Index], Hex[Index]);
+			}
+			UColorPickerBPLibrary::LinearColorToRGBBatch(Colors, RGB);
+
+			for (TArray<float>* Stream : { &HSV_H, &HSV_S, &HSV_V, &CMYK_C, &CMYK_M, &CMYK_Y, &CMYK_K, &HSL_H, &HSL_S, &HSL_L })
+			{
+				Stream->SetNumUninitialized(Num);
+			}
+			UColorPickerBPLibrary::LinearColorToHSVBatch(Colors, HSV_H, HSV_S, HSV_V);
+			UColorPickerBPLibrary::LinearColorToCMYKBatch(Colors, CMYK_C, CMYK_M, CMYK_Y, CMYK_K);
+			UColorPickerBPLibrary::LinearColorToHSLBatch(Colors, HSL_H, HSL_S, HSL_L);
+
+			Lab.SetNumUninitialized(Num);
+			OKLab.SetNumUninitialized(Num);
+			UColorPickerBPLibrary::LinearColorToLabBatch(Colors, Lab);
+			UColorPickerBPLibrary::LinearColorToOKLabBatch(Colors, OKLab);
+
+			HSV8.SetNumUninitialized(Num);
+			HSL8.SetNumUninitialized(Num);
+			UColorPickerBPLibrary::RGBToHSV8Batch(RGB, HSV8);
+			UColorPickerBPLibrary::RGBToHSL8Batch(RGB, HSL8);
+		}
+	};
+
+	/**
+	 * Preallocated conversion outputs, written by every case so work cannot be optimized away.
+	 */
+	struct FOutputs
+	{
+		TArray<FLinearColor> Colors;
+		TArray<FString> Hex;
+		TArray<FColor> RGB;
+		TArray<int32> R, G, B;
+		TArray<float> X, Y, Z, W;
+		TArray<FVector> Lab;
+		TArray<ColorMath::Fixed::FHSV8> HSV8;
+		TArray<ColorMath::Fixed::FHSL8> HSL8;
+
+		void Reserve(const int32 Num, const int32 HexNum)
+		{
+			Colors.SetNumUninitialized(Num);
+			Lab.SetNumUninitialized(Num);
+			HSV8.SetNumUninitialized(Num);
+			HSL8.SetNumUninitialized(Num);
+			Hex.SetNum(HexNum);
+			RGB.SetNumUninitialized(Num);
+			for (TArray<int32>* Stream : { &R, &G, &B })
+			{
+				Stream->SetNumUninitialized(Num);
+			}
+			for (TArray<float>* Stream : { &X, &Y, &Z, &W })
+			{
+				Stream->SetNumUninitialized(Num);
+			}
+		}
+	};
+
+	/** Run a case over the first Num inputs. */
+	typedef void (*FCaseFunction)(const FInputs& Inputs, FOutputs& Outputs, int32 Num);
+
+	/**
+	 * Benchmark case.
+	 */
+	struct FCase
+	{
+		const TCHAR* Name;
+		EColorFormat Format;
+		/** True if converting from linear color into Format. */
+		bool bFromLinear;
+		/** True if case calls a batch entry point, false if it loops over the Blueprint function. */
+		bool bBatch;
+		FCaseFunction Function;
+	};
+
+	template<typename ViewType, typename ArrayType>
+	FORCEINLINE ViewType Slice(ArrayType& Array, const int32 Num)
+	{
+		return ViewType(Array.GetData(), Num);
+	}
+
+#define COLOR_PICKER_BENCHMARK_LOOP(Body) [](const FInputs& In, FOutputs& Out, const int32 Num) { for (int32 Index = 0; Index < Num; ++Index) { Body; } }
+
+	static const FCase Cases[] = {
+		{ TEXT("LinearColorToHex"), EColorFormat::CF_HEX, true, false, COLOR_PICKER_BENCHMARK_LOOP(UColorPickerBPLibrary::LinearColorToHex(In.Colors[Index], Out.Hex[Index])) },
+		{ TEXT("LinearColorToRGB"), EColorFormat::CF_RBG, true, false, COLOR_PICKER_BENCHMARK_LOOP(UColorPickerBPLibrary::LinearColorToRGB(In.Colors[Index], Out.R[Index], Out.G[Index], Out.B[Index])) },
+		{ TEXT("LinearColorToHSV"), EColorFormat::CF_HSV, true, false, COLOR_PICKER_BENCHMARK_LOOP(UColorPickerBPLibrary::LinearColorToHSV(In.Colors[Index], Out.X[Index], Out.Y[Index], Out.Z[Index])) },
+		{ TEXT("LinearColorToCMYK"), EColorFormat::CF_CMYK, true, false, COLOR_PICKER_BENCHMARK_LOOP(UColorPickerBPLibrary::LinearColorToCMYK(In.Colors[Index], Out.X[Index], Out.Y[Index], Out.Z[Index], Out.W[Index])) },
+		{ TEXT("LinearColorToHSL"), EColorFormat::CF_HSL, true, false, COLOR_PICKER_BENCHMARK_LOOP(UColorPickerBPLibrary::LinearColorToHSL(In.Colors[Index], Out.X[Index], Out.Y[Index], Out.Z[Index])) },
+		{ TEXT("HexToLinearColor"), EColorFormat::CF_HEX, false, false, COLOR_PICKER_BENCHMARK_LOOP(UColorPickerBPLibrary::HexToLinearColor(In.Hex[Index], Out.Colors[Index])) },
+		{ TEXT("RGBToLinearColor"), EColorFormat::CF_RBG, false, false, COLOR_PICKER_BENCHMARK_LOOP(UColorPickerBPLibrary::RGBToLinearColor(In.RGB[Index].R, In.RGB[Index].G, In.RGB[Index].B, Out.Colors[Index])) },
+		{ TEXT("HSVToLinearColor"), EColorFormat::CF_HSV, false, false, COLOR_PICKER_BENCHMARK_LOOP(UColorPickerBPLibrary::HSVToLinearColor(In.HSV_H[Index], In.HSV_S[Index], In.HSV_V[Index], Out.Colors[Index])) },
+		{ TEXT("CMYKToLinearColor"), EColorFormat::CF_CMYK, false, false, COLOR_PICKER_BENCHMARK_LOOP(UColorPickerBPLibrary::CMYKToLinearColor(In.CMYK_C[Index], In.CMYK_M[Index], In.CMYK_Y[Index], In.CMYK_K[Index], Out.Colors[Index])) },
+		{ TEXT("HSLToLinearColor"), EColorFormat::CF_HSL, false, false, COLOR_PICKER_BENCHMARK_LOOP(UColorPickerBPLibrary::HSLToLinearColor(In.HSL_H[Index], In.HSL_S[Index], In.HSL_L[Index], Out.Colors[Index])) },
+		{ TEXT("LinearColorToLab"), EColorFormat::CF_LAB, true, false, COLOR_PICKER_BENCHMARK_LOOP(UColorPickerBPLibrary::LinearColorToLab(In.Colors[Index], Out.X[Index], Out.Y[Index], Out.Z[Index])) },
+		{ TEXT("LinearColorToOKLab"), EColorFormat::CF_OKLAB, true, false, COLOR_PICKER_BENCHMARK_LOOP(UColorPickerBPLibrary::LinearColorToOKLab(In.Colors[Index], Out.X[Index], Out.Y[Index], Out.Z[Index])) },
+		{ TEXT("LabToLinearColor"), EColorFormat::CF_LAB, false, false, COLOR_PICKER_BENCHMARK_LOOP(UColorPickerBPLibrary::LabToLinearColor(In.Lab[Index].X, In.Lab[Index].Y, In.Lab[Index].Z, Out.Colors[Index])) },
+		{ TEXT("OKLabToLinearColor"), EColorFormat::CF_OKLAB, false, false, COLOR_PICKER_BENCHMARK_LOOP(UColorPickerBPLibrary::OKLabToLinearColor(In.OKLab[Index].X, In.OKLab[Index].Y, In.OKLab[Index].Z, Out.Colors[Index])) },
+
+		{ TEXT("LinearColorToHSVFloat"), EColorFormat::CF_HSV, true, false, COLOR_PICKER_BENCHMARK_LOOP(UColorPickerBPLibrary::LinearColorToHSV(In.Colors[Index], Out.X[Index], Out.Y[Index], Out.Z[Index], EColorPrecision::CP_FLOAT)) },
+		{ TEXT("LinearColorToCMYKFloat"), EColorFormat::CF_CMYK, true, false, COLOR_PICKER_BENCHMARK_LOOP(UColorPickerBPLibrary::LinearColorToCMYK(In.Colors[Index], Out.X[Index], Out.Y[Index], Out.Z[Index], Out.W[Index], EColorPrecision::CP_FLOAT)) },
+		{ TEXT("LinearColorToHSLFloat"), EColorFormat::CF_HSL, true, false, COLOR_PICKER_BENCHMARK_LOOP(UColorPickerBPLibrary::LinearColorToHSL(In.Colors[Index], Out.X[Index], Out.Y[Index], Out.Z[Index], EColorPrecision::CP_FLOAT)) },
+		{ TEXT("HSVToLinearColorFloat"), EColorFormat::CF_HSV, false, false, COLOR_PICKER_BENCHMARK_LOOP(UColorPickerBPLibrary::HSVToLinearColor(In.HSV_H[Index], In.HSV_S[Index], In.HSV_V[Index], Out.Colors[Index], EColorPrecision::CP_FLOAT)) },
+		{ TEXT("CMYKToLinearColorFloat"), EColorFormat::CF_CMYK, false, false, COLOR_PICKER_BENCHMARK_LOOP(UColorPickerBPLibrary::CMYKToLinearColor(In.CMYK_C[Index], In.CMYK_M[Index], In.CMYK_Y[Index], In.CMYK_K[Index], Out.Colors[Index], EColorPrecision::CP_FLOAT)) },
+		{ TEXT("HSLToLinearColorFloat"), EColorFormat::CF_HSL, false, false, COLOR_PICKER_BENCHMARK_LOOP(UColorPickerBPLibrary::HSLToLinearColor(In.HSL_H[Index], In.HSL_S[Index], In.HSL_L[Index], Out.Colors[Index], EColorPrecision::CP_FLOAT)) },
+
+		{ TEXT("LinearColorToHexBuffer"), EColorFormat::CF_HEX, true, false, [](const FInputs& In, FOutputs& Out, const int32 Num)
+			{ TCHAR Buffer[UColorPickerBPLibrary::HexBufferSize]; for (int32 Index = 0; Index < Num; ++Index) { UColorPickerBPLibrary::LinearColorToHex(In.Colors[Index], Buffer); Out.R[Index] = Buffer[1]; } } },
+		{ TEXT("ParseHex"), EColorFormat::CF_HEX, false, false, COLOR_PICKER_BENCHMARK_LOOP(UColorPickerBPLibrary::ParseHex(In.Hex[Index], Out.Colors[Index])) },
+		{ TEXT("PaletteToHex"), EColorFormat::CF_HEX, true, true, [](const FInputs& In, FOutputs& Out, const int32 Num)
+			{ UColorPickerBPLibrary::PaletteToHex(Slice<TArrayView<const FLinearColor>>(In.Colors, Num), Out.Hex[0]); } },
+
+		{ TEXT("LinearColorToRGBBatch"), EColorFormat::CF_RBG, true, true, [](const FInputs& In, FOutputs& Out, const int32 Num)
+			{ UColorPickerBPLibrary::LinearColorToRGBBatch(Slice<TArrayView<const FLinearColor>>(In.Colors, Num), Slice<TArrayView<FColor>>(Out.RGB, Num)); } },
+		{ TEXT("LinearColorToHSVBatch"), EColorFormat::CF_HSV, true, true, [](const FInputs& In, FOutputs& Out, const int32 Num)
+			{ UColorPickerBPLibrary::LinearColorToHSVBatch(Slice<TArrayView<const FLinearColor>>(In.Colors, Num), Slice<TArrayView<float>>(Out.X, Num), Slice<TArrayView<float>>(Out.Y, Num), Slice<TArrayView<float>>(Out.Z, Num)); } },
+		{ TEXT("LinearColorToCMYKBatch"), EColorFormat::CF_CMYK, true, true, [](const FInputs& In, FOutputs& Out, const int32 Num)
+			{ UColorPickerBPLibrary::LinearColorToCMYKBatch(Slice<TArrayView<const FLinearColor>>(In.Colors, Num), Slice<TArrayView<float>>(Out.X, Num), Slice<TArrayView<float>>(Out.Y, Num), Slice<TArrayView<float>>(Out.Z, Num), Slice<TArrayView<float>>(Out.W, Num)); } },
+		{ TEXT("LinearColorToHSLBatch"), EColorFormat::CF_HSL, true, true, [](const FInputs& In, FOutputs& Out, const int32 Num)
+			{ UColorPickerBPLibrary::LinearColorToHSLBatch(Slice<TArrayView<const FLinearColor>>(In.Colors, Num), Slice<TArrayView<float>>(Out.X, Num), Slice<TArrayView<float>>(Out.Y, Num), Slice<TArrayView<float>>(Out.Z, Num)); } },
+		{ TEXT("RGBToLinearColorBatch"), EColorFormat::CF_RBG, false, true, [](const FInputs& In, FOutputs& Out, const int32 Num)
+			{ UColorPickerBPLibrary::RGBToLinearColorBatch(Slice<TArrayView<const FColor>>(In.RGB, Num), Slice<TArrayView<FLinearColor>>(Out.Colors, Num)); } },
+		{ TEXT("HSVToLinearColorBatch"), EColorFormat::CF_HSV, false, true, [](const FInputs& In, FOutputs& Out, const int32 Num)
+			{ UColorPickerBPLibrary::HSVToLinearColorBatch(Slice<TArrayView<const float>>(In.HSV_H, Num), Slice<TArrayView<const float>>(In.HSV_S, Num), Slice<TArrayView<const float>>(In.HSV_V, Num), Slice<TArrayView<FLinearColor>>(Out.Colors, Num)); } },
+		{ TEXT("CMYKToLinearColorBatch"), EColorFormat::CF_CMYK, false, true, [](const FInputs& In, FOutputs& Out, const int32 Num)
+			{ UColorPickerBPLibrary::CMYKToLinearColorBatch(Slice<TArrayView<const float>>(In.CMYK_C, Num), Slice<TArrayView<const float>>(In.CMYK_M, Num), Slice<TArrayView<const float>>(In.CMYK_Y, Num), Slice<TArrayView<const float>>(In.CMYK_K, Num), Slice<TArrayView<FLinearColor>>(Out.Colors, Num)); } },
+		{ TEXT("HSLToLinearColorBatch"), EColorFormat::CF_HSL, false, true, [](const FInputs& In, FOutputs& Out, const int32 Num)
+			{ UColorPickerBPLibrary::HSLToLinearColorBatch(Slice<TArrayView<const float>>(In.HSL_H, Num), Slice<TArrayView<const float>>(In.HSL_S, Num), Slice<TArrayView<const float>>(In.HSL_L, Num), Slice<TArrayView<FLinearColor>>(Out.Colors, Num)); } },
+		{ TEXT("LinearColorToLabBatch"), EColorFormat::CF_LAB, true, true, [](const FInputs& In, FOutputs& Out, const int32 Num)
+			{ UColorPickerBPLibrary::LinearColorToLabBatch(Slice<TArrayView<const FLinearColor>>(In.Colors, Num), Slice<TArrayView<FVector>>(Out.Lab, Num)); } },
+		{ TEXT("LinearColorToOKLabBatch"), EColorFormat::CF_OKLAB, true, true, [](const FInputs& In, FOutputs& Out, const int32 Num)
+			{ UColorPickerBPLibrary::LinearColorToOKLabBatch(Slice<TArrayView<const FLinearColor>>(In.Colors, Num), Slice<TArrayView<FVector>>(Out.Lab, Num)); } },
+
+		{ TEXT("RGBToHSV8Batch"), EColorFormat::CF_HSV, true, true, [](const FInputs& In, FOutputs& Out, const int32 Num)
+			{ UColorPickerBPLibrary::RGBToHSV8Batch(Slice<TArrayView<const FColor>>(In.RGB, Num), Slice<TArrayView<ColorMath::Fixed::FHSV8>>(Out.HSV8, Num)); } },
+		{ TEXT("RGBToHSL8Batch"), EColorFormat::CF_HSL, true, true, [](const FInputs& In, FOutputs& Out, const int32 Num)
+			{ UColorPickerBPLibrary::RGBToHSL8Batch(Slice<TArrayView<const FColor>>(In.RGB, Num), Slice<TArrayView<ColorMath::Fixed::FHSL8>>(Out.HSL8, Num)); } },
+		{ TEXT("HSV8ToRGBBatch"), EColorFormat::CF_HSV, false, true, [](const FInputs& In, FOutputs& Out, const int32 Num)
+			{ UColorPickerBPLibrary::HSV8ToRGBBatch(Slice<TArrayView<const ColorMath::Fixed::FHSV8>>(In.HSV8, Num), Slice<TArrayView<FColor>>(Out.RGB, Num)); } },
+		{ TEXT("HSL8ToRGBBatch"), EColorFormat::CF_HSL, false, true, [](const FInputs& In, FOutputs& Out, const int32 Num)
+			{ UColorPickerBPLibrary::HSL8ToRGBBatch(Slice<TArrayView<const ColorMath::Fixed::FHSL8>>(In.HSL8, Num), Slice<TArrayView<FColor>>(Out.RGB, Num)); } },
+	};
+
+#undef COLOR_PICKER_BENCHMARK_LOOP
+
+	/**
+	 * Representative source colors.
+	 */
+	struct FInputSet
+	{
+		const TCHAR* Name;
+		TArray<FLinearColor> Colors;
+	};
+
+	static TArray<FInputSet> MakeInputSets()
+	{
+		TArray<FInputSet> InputSets;
+
+		FInputSet& Grays = InputSets.Add_GetRef({ TEXT("Grays"), {} });
+		for (int32 Value = 0; Value < 256; ++Value)
+		{
+			Grays.Colors.Add(FLinearColor::FromSRGBColor(FColor(Value, Value, Value)));
+		}
+
+		FInputSet& Primaries = InputSets.Add_GetRef({ TEXT("SaturatedPrimaries"), {} });
+		Primaries.Colors = {
+			FLinearColor::Red, FLinearColor::Green, FLinearColor::Blue,
+			FLinearColor(0.0f, 1.0f, 1.0f), FLinearColor(1.0f, 0.0f, 1.0f), FLinearColor(1.0f, 1.0f, 0.0f)
+		};
+
+		FInputSet& Random = InputSets.Add_GetRef({ TEXT("Random"), {} });
+		FRandomStream RandomStream(0x5EED);
+		Random.Colors.SetNumUninitialized(1 << 16);
+		for (FLinearColor& Color : Random.Colors)
+		{
+			Color = FLinearColor(RandomStream.GetFraction(), RandomStream.GetFraction(), RandomStream.GetFraction());
+		}
+
+		return InputSets;
+	}
+
+	/**
+	 * Timing results for one case, input set and batch size.
+	 */
+	struct FResult
+	{
+		double MinNsPerColor = 0.0;
+		double MedianNsPerColor = 0.0;
+		double P90NsPerColor = 0.0;
+		double ColorsPerSecond = 0.0;
+		double AllocationsPerColor = 0.0;
+		/** Requested bytes of those allocations, whether or not they are freed before the call returns. */
+		double AllocatedBytesPerColor = 0.0;
+		int32 Samples = 0;
+	};
+
+	static FResult Measure(const FCase& Case, const FInputs& Inputs, FOutputs& Outputs, const int32 BatchSize)
+	{
+		// Each sample covers at least this many colors so timer overhead stays negligible for small batches.
+		const int64 MinColorsPerSample = 4096;
+		const int64 TargetColors = 4 * 1024 * 1024;
+		const int32 Iterations = (int32)FMath::Max<int64>(1, MinColorsPerSample / BatchSize);
+		const int32 SampleCount = (int32)FMath::Clamp<int64>(TargetColors / ((int64)BatchSize * Iterations), 3, 200);
+
+		FResult Result;
+		Result.Samples = SampleCount;
+
+		// Warm up and count allocations in an untimed pass. Hex strings are emptied first so their allocations are part of the pass.
+		if (Case.Format == EColorFormat::CF_HEX)
+		{
+			for (int32 Index = 0; Index < FMath::Min(BatchSize, Outputs.Hex.Num()); ++Index)
+			{
+				Outputs.Hex[Index].Empty();
+			}
+		}
+		const FAllocationCount Allocations = CountAllocations([&]() { Case.Function(Inputs, Outputs, BatchSize); });
+		Result.AllocationsPerColor = (double)Allocations.Allocations / BatchSize;
+		Result.AllocatedBytesPerColor = (double)Allocations.Bytes / BatchSize;
+
+		TArray<double> NsPerColor;
+		NsPerColor.Reserve(SampleCount);
+		for (int32 Sample = 0; Sample < SampleCount; ++Sample)
+		{
+			const uint64 StartCycles = FPlatformTime::Cycles64();
+			for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+			{
+				Case.Function(Inputs, Outputs, BatchSize);
+			}
+			const double Seconds = FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - StartCycles);
+			NsPerColor.Add(Seconds * 1.0e9 / ((double)BatchSize * Iterations));
+		}
+		NsPerColor.Sort();
+
+		Result.MinNsPerColor = NsPerColor[0];
+		Result.MedianNsPerColor = NsPerColor[SampleCount / 2];
+		Result.P90NsPerColor = NsPerColor[FMath::Min(SampleCount - 1, SampleCount * 9 / 10)];
+		Result.ColorsPerSecond = Result.MedianNsPerColor > 0.0 ? 1.0e9 / Result.MedianNsPerColor : 0.0;
+		return Result;
+	}
+
+	/** Timing of whole operations such as gradient fills, in milliseconds. */
+	struct FTimingResult
+	{
+		int32 Samples = 0;
+		double MinMs = 0.0;
+		double MedianMs = 0.0;
+		double P90Ms = 0.0;
+
+		/** Throughput for an operation over NumPixels pixels. */
+		double MegapixelsPerSecond(const int64 NumPixels) const
+		{
+			return MedianMs > 0.0 ? (double)NumPixels / (MedianMs * 1.0e3) : 0.0;
+		}
+	};
+
+	/**
+	 * Time Body(Sample) SampleCount times after an untimed warm up call with sample -1.
+	 */
+	static FTimingResult MeasureMs(const int32 SampleCount, TFunctionRef<void(int32)> Body)
+	{
+		FTimingResult Result;
+		Result.Samples = SampleCount;
+
+		TArray<double> Ms;
+		Ms.Reserve(SampleCount);
+		for (int32 Sample = -1; Sample < SampleCount; ++Sample)
+		{
+			const uint64 StartCycles = FPlatformTime::Cycles64();
+			Body(Sample);
+			const double Seconds = FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - StartCycles);
+
+			if (Sample >= 0)
+				Ms.Add(Seconds * 1.0e3);
+		}
+		Ms.Sort();
+
+		Result.MinMs = Ms[0];
+		Result.MedianMs = Ms[SampleCount / 2];
+		Result.P90Ms = Ms[SampleCount * 9 / 10];
+		return Result;
+	}
+
+	static void WriteTiming(const TSharedRef<TJsonWriter<>>& Writer, const FTimingResult& Result, const int64 NumPixels)
+	{
+		Writer->WriteValue(TEXT("Samples"), Result.Samples);
+		Writer->WriteValue(TEXT("MinMs"), Result.MinMs);
+		Writer->WriteValue(TEXT("MedianMs"), Result.MedianMs);
+		Writer->WriteValue(TEXT("P90Ms"), Result.P90Ms);
+		Writer->WriteValue(TEXT("MegapixelsPerSecond"), Result.MegapixelsPerSecond(NumPixels));
+	}
+
+	/**
+	 * Synthetic photo-like image, a few smooth color regions with noise.
+	 */
+	static TArray<FColor> MakeImage(const FIntPoint& Size)
+	{
+		FRandomStream RandomStream(0x1A6E);
+		const FColor Regions[] = { FColor(38, 70, 120), FColor(200, 170, 120), FColor(60, 120, 50), FColor(230, 230, 235), FColor(150, 40, 35) };
+		const int32 NumRegions = UE_ARRAY_COUNT(Regions);
+
+		TArray<FColor> Image;
+		Image.SetNumUninitialized(Size.X * Size.Y);
+		for (int32 Y = 0; Y < Size.Y; ++Y)
+		{
+			for (int32 X = 0; X < Size.X; ++X)
+			{
+				const int32 Region = (X * 3 / Size.X + Y * 2 / Size.Y * 3) % NumRegions;
+				const int32 Shade = (X + Y) * 32 / (Size.X + Size.Y) + RandomStream.RandRange(-12, 12);
+				const FColor& Base = Regions[Region];
+				Image[Y * Size.X + X] = FColor(
+					(uint8)FMath::Clamp(Base.R + Shade, 0, 255),
+					(uint8)FMath::Clamp(Base.G + Shade, 0, 255),
+					(uint8)FMath::Clamp(Base.B + Shade, 0, 255));
+			}
+		}
+		return Image;
+	}
+
+	static FString FormatName(const EColorFormat Format)
+	{
+		const UEnum* FormatEnum = StaticEnum<EColorFormat>();
+		return FormatEnum ? FormatEnum->GetDisplayNameTextByValue((int64)Format).ToString() : FString::FromInt((int32)Format);
+	}
+
+	/** First hop of the conversion path used before direct converters, through the default precision of the library. */
+	static FLinearColor TwoHopToLinear(const EColorFormat Format, const FColorChannels& Value)
+	{
+		FLinearColor Color;
+		switch (Format)
+		{
+		case EColorFormat::CF_HSV:
+			UColorPickerBPLibrary::HSVToLinearColor(Value.X, Value.Y, Value.Z, Color);
+			break;
+		case EColorFormat::CF_CMYK:
+			UColorPickerBPLibrary::CMYKToLinearColor(Value.X, Value.Y, Value.Z, Value.W, Color);
+			break;
+		case EColorFormat::CF_HSL:
+			UColorPickerBPLibrary::HSLToLinearColor(Value.X, Value.Y, Value.Z, Color);
+			break;
+		case EColorFormat::CF_LAB:
+			UColorPickerBPLibrary::LabToLinearColor(Value.X, Value.Y, Value.Z, Color);
+			break;
+		case EColorFormat::CF_OKLAB:
+			UColorPickerBPLibrary::OKLabToLinearColor(Value.X, Value.Y, Value.Z, Color);
+			break;
+		default:
+			UColorPickerBPLibrary::RGBToLinearColor((int)Value.X, (int)Value.Y, (int)Value.Z, Color);
+			break;
+		}
+		return Color;
+	}
+
+	/** Second hop of the conversion path used before direct converters. */
+	static FColorChannels TwoHopFromLinear(const EColorFormat Format, const FLinearColor& Color)
+	{
+		FColorChannels Value;
+		switch (Format)
+		{
+		case EColorFormat::CF_HSV:
+			UColorPickerBPLibrary::LinearColorToHSV(Color, Value.X, Value.Y, Value.Z);
+			break;
+		case EColorFormat::CF_CMYK:
+			UColorPickerBPLibrary::LinearColorToCMYK(Color, Value.X, Value.Y, Value.Z, Value.W);
+			break;
+		case EColorFormat::CF_HSL:
+			UColorPickerBPLibrary::LinearColorToHSL(Color, Value.X, Value.Y, Value.Z);
+			break;
+		case EColorFormat::CF_LAB:
+			UColorPickerBPLibrary::LinearColorToLab(Color, Value.X, Value.Y, Value.Z);
+			break;
+		case EColorFormat::CF_OKLAB:
+			UColorPickerBPLibrary::LinearColorToOKLab(Color, Value.X, Value.Y, Value.Z);
+			break;
+		default:
+		{
+			int32 R, G, B;
+			UColorPickerBPLibrary::LinearColorToRGB(Color, R, G, B);
+			Value = FColorChannels(R, G, B);
+			break;
+		}
+		}
+		return Value;
+	}
+
+	static void Run(const TArray<FString>& Args)
+	{
+		const int32 MaxBatchSize = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 10000000;
+		const int32 MaxHexBatchSize = FMath::Min(MaxBatchSize, 1000000);
+		const FString OutputFile = Args.Num() > 1 ? Args[1] :
+			FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("ColorPicker"), FString::Printf(TEXT("Benchmark-%s.json"), *FDateTime::Now().ToString()));
+
+		TArray<int32> BatchSizes;
+		for (int64 BatchSize = 1; BatchSize <= MaxBatchSize; BatchSize *= 10)
+		{
+			BatchSizes.Add((int32)BatchSize);
+		}
+
+		FString Json;
+		TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Json);
+		Writer->WriteObjectStart();
+		Writer->WriteValue(TEXT("Plugin"), TEXT("ColorPicker"));
+		Writer->WriteValue(TEXT("Timestamp"), FDateTime::UtcNow().ToIso8601());
+		Writer->WriteValue(TEXT("Platform"), ANSI_TO_TCHAR(FPlatformProperties::IniPlatformName()));
+		Writer->WriteValue(TEXT("MaxBatchSize"), MaxBatchSize);
+
+		FOutputs Outputs;
+		Outputs.Reserve(MaxBatchSize, MaxHexBatchSize);
+
+		// Hex conversions allocate FStrings, so they are reported in their own section.
+		for (const bool bHexSection : { false, true })
+		{
+			Writer->WriteArrayStart(bHexSection ? TEXT("Hex") : TEXT("Conversions"));
+
+			for (const FInputSet& InputSet : MakeInputSets())
+			{
+				FInputs Inputs;
+				Inputs.Build(InputSet.Colors, MaxBatchSize, MaxHexBatchSize);
+
+				for (const FCase& Case : Cases)
+				{
+					if ((Case.Format == EColorFormat::CF_HEX) != bHexSection)
+						continue;
+
+					for (const int32 BatchSize : BatchSizes)
+					{
+						if (bHexSection && BatchSize > MaxHexBatchSize)
+							break;
+
+						const FResult Result = Measure(Case, Inputs, Outputs, BatchSize);
+
+						Writer->WriteObjectStart();
+						Writer->WriteValue(TEXT("Function"), Case.Name);
+						Writer->WriteValue(TEXT("Format"), FormatName(Case.Format));
+						Writer->WriteValue(TEXT("Direction"), Case.bFromLinear ? TEXT("FromLinear") : TEXT("ToLinear"));
+						Writer->WriteValue(TEXT("Batch"), Case.bBatch);
+						Writer->WriteValue(TEXT("Input"), InputSet.Name);
+						Writer->WriteValue(TEXT("BatchSize"), BatchSize);
+						Writer->WriteValue(TEXT("Samples"), Result.Samples);
+						Writer->WriteValue(TEXT("MinNsPerColor"), Result.MinNsPerColor);
+						Writer->WriteValue(TEXT("MedianNsPerColor"), Result.MedianNsPerColor);
+						Writer->WriteValue(TEXT("P90NsPerColor"), Result.P90NsPerColor);
+						Writer->WriteValue(TEXT("ColorsPerSecond"), Result.ColorsPerSecond);
+						Writer->WriteValue(TEXT("AllocationsPerColor"), Result.AllocationsPerColor);
+						Writer->WriteValue(TEXT("AllocatedBytesPerColor"), Result.AllocatedBytesPerColor);
+						Writer->WriteObjectEnd();
+
+						UE_LOG(LogColorPicker, Log, TEXT("%s [%s, %d]: %.2f ns/color, %.3g colors/s, %.2f allocs/color (%.1f bytes)"),
+							Case.Name, InputSet.Name, BatchSize, Result.MedianNsPerColor, Result.ColorsPerSecond, Result.AllocationsPerColor, Result.AllocatedBytesPerColor);
+					}
+				}
+			}
+
+			Writer->WriteArrayEnd();
+		}
+
+		Writer->WriteArrayStart(TEXT("Gradients"));
+		{
+			TArray<FColor> Pixels;
+			for (const FIntPoint& Size : { FIntPoint(1920, 1080), FIntPoint(3840, 2160) })
+			{
+				Pixels.SetNumUninitialized(Size.X * Size.Y, false);
+
+				for (const bool bHueStrip : { true, false })
+				{
+					const TCHAR* Name = bHueStrip ? TEXT("FillHueStrip") : TEXT("FillSaturationValue");
+					const int32 SampleCount = 20;
+					const FTimingResult Result = MeasureMs(SampleCount, [&](const int32 Sample)
+					{
+						// Hue changes every fill, as it does while dragging the hue indicator.
+						if (bHueStrip)
+							ColorGradientRasterizer::FillHueStrip(Pixels.GetData(), Size.X, Size.Y);
+						else
+							ColorGradientRasterizer::FillSaturationValue(Pixels.GetData(), Size.X, Size.Y, (Sample + 1) * 360.f / SampleCount);
+					});
+
+					Writer->WriteObjectStart();
+					Writer->WriteValue(TEXT("Function"), Name);
+					Writer->WriteValue(TEXT("Width"), Size.X);
+					Writer->WriteValue(TEXT("Height"), Size.Y);
+					WriteTiming(Writer, Result, Pixels.Num());
+					Writer->WriteObjectEnd();
+
+					UE_LOG(LogColorPicker, Log, TEXT("%s [%dx%d]: %.3f ms/fill, %.1f MP/s"),
+						Name, Size.X, Size.Y, Result.MedianMs, Result.MegapixelsPerSecond(Pixels.Num()));
+				}
+			}
+		}
+		Writer->WriteArrayEnd();
+
+		Writer->WriteArrayStart(TEXT("ImageAdjustment"));
+		{
+			const FColorAdjustment TeamTint[] = { FColorAdjustment::HueShift(120.f), FColorAdjustment::SaturationScale(1.2f), FColorAdjustment::ValueScale(0.9f) };
+			const FColorAdjustment AllOps[] = {
+				FColorAdjustment::HueShift(45.f), FColorAdjustment::SaturationScale(0.8f), FColorAdjustment::ValueScale(1.1f),
+				FColorAdjustment::LightnessScale(0.9f), FColorAdjustment::InkLimit(2.5f)
+			};
+			struct FAdjustmentCase
+			{
+				const TCHAR* Name;
+				TArrayView<const FColorAdjustment> Adjustments;
+				/** Only HSV adjustments, compared against per pixel picker conversions. */
+				bool bHSV;
+			};
+			const FAdjustmentCase Cases[] = { { TEXT("TeamTint"), TeamTint, true }, { TEXT("AllOps"), AllOps, false } };
+
+			for (const FIntPoint& Size : { FIntPoint(1920, 1080), FIntPoint(3840, 2160) })
+			{
+				const TArray<FColor> Image = MakeImage(Size);
+				TArray<FColor> Adjusted;
+				Adjusted.SetNumUninitialized(Image.Num());
+
+				TArray<FLinearColor> LinearImage;
+				LinearImage.SetNumUninitialized(Image.Num());
+				for (int32 Index = 0; Index < Image.Num(); ++Index)
+				{
+					LinearImage[Index] = FLinearColor::FromSRGBColor(Image[Index]);
+				}
+				TArray<FLinearColor> LinearAdjusted;
+				LinearAdjusted.SetNumUninitialized(Image.Num());
+
+				for (const FAdjustmentCase& Case : Cases)
+				{
+					const FColorImageAdjustment Adjustment(Case.Adjustments);
+					const FTimingResult ColorResult = MeasureMs(10, [&](const int32 Sample) { Adjustment.Apply(Image, Adjusted); });
+					const FTimingResult LinearResult = MeasureMs(10, [&](const int32 Sample) { Adjustment.Apply(LinearImage, LinearAdjusted); });
+
+					Writer->WriteObjectStart();
+					Writer->WriteValue(TEXT("Adjustments"), Case.Name);
+					Writer->WriteValue(TEXT("Width"), Size.X);
+					Writer->WriteValue(TEXT("Height"), Size.Y);
+					Writer->WriteValue(TEXT("Stages"), Adjustment.NumStages());
+					Writer->WriteObjectStart(TEXT("Color"));
+					WriteTiming(Writer, ColorResult, Image.Num());
+					Writer->WriteObjectEnd();
+					Writer->WriteObjectStart(TEXT("LinearColor"));
+					WriteTiming(Writer, LinearResult, Image.Num());
+					Writer->WriteObjectEnd();
+
+					// Per pixel picker conversions, one round trip per adjustment as an editor script would do it.
+					double PerPixelMs = 0.0;
+					if (Case.bHSV)
+					{
+						const FTimingResult PerPixelResult = MeasureMs(3, [&](const int32 Sample)
+						{
+							for (int32 Index = 0; Index < LinearImage.Num(); ++Index)
+							{
+								FLinearColor Color = LinearImage[Index];
+								for (const FColorAdjustment& Step : Case.Adjustments)
+								{
+									float H, S, V;
+									UColorPickerBPLibrary::LinearColorToHSV(Color, H, S, V, EColorPrecision::CP_FLOAT);
+									if (Step.Op == EColorAdjustmentOp::CAO_HUE_SHIFT)
+										H = FMath::Fmod(H + Step.Amount, 360.f);
+									else if (Step.Op == EColorAdjustmentOp::CAO_SATURATION_SCALE)
+										S = FMath::Min(S * Step.Amount, 1.f);
+									else
+										V = FMath::Min(V * Step.Amount, 1.f);
+									UColorPickerBPLibrary::HSVToLinearColor(H, S, V, Color, EColorPrecision::CP_FLOAT);
+								}
+								LinearAdjusted[Index] = Color;
+							}
+						});
+						PerPixelMs = PerPixelResult.MedianMs;
+						Writer->WriteObjectStart(TEXT("PerPixel"));
+						WriteTiming(Writer, PerPixelResult, Image.Num());
+						Writer->WriteObjectEnd();
+						Writer->WriteValue(TEXT("Speedup"), LinearResult.MedianMs > 0.0 ? PerPixelMs / LinearResult.MedianMs : 0.0);
+					}
+					Writer->WriteObjectEnd();
+
+					UE_LOG(LogColorPicker, Log, TEXT("Adjust %s [%dx%d, %d stages]: color %.1f MP/s, linear %.1f MP/s, per pixel %.3f ms"),
+						Case.Name, Size.X, Size.Y, Adjustment.NumStages(), ColorResult.MegapixelsPerSecond(Image.Num()), LinearResult.MegapixelsPerSecond(Image.Num()), PerPixelMs);
+				}
+			}
+		}
+		Writer->WriteArrayEnd();
+
+		Writer->WriteArrayStart(TEXT("GradientRamp"));
+		{
+			const int32 NumSamples = FMath::Min(MaxBatchSize, 1000000);
+			FRandomStream RandomStream(0x4A3D);
+			TArray<float> Times;
+			Times.SetNumUninitialized(NumSamples);
+			for (float& Time : Times)
+			{
+				Time = RandomStream.GetFraction();
+			}
+			TArray<FLinearColor> Colors;
+			Colors.SetNumUninitialized(NumSamples);
+			TArray<FColor> VertexColors;
+			VertexColors.SetNumUninitialized(NumSamples);
+
+			const FColorRampStop Stops[] = {
+				{ 0.f, FLinearColor(0.02f, 0.05f, 0.4f) }, { 0.3f, FLinearColor(0.8f, 0.1f, 0.05f) }, { 0.55f, FLinearColor(1.f, 0.7f, 0.1f) },
+				{ 0.8f, FLinearColor(0.2f, 0.9f, 0.3f) }, { 1.f, FLinearColor(0.9f, 0.9f, 1.f, 0.f) }
+			};
+			const TPair<const TCHAR*, EColorRampInterpolation> Interpolations[] = {
+				{ TEXT("Linear"), EColorRampInterpolation::CRI_LINEAR }, { TEXT("SRGB"), EColorRampInterpolation::CRI_SRGB },
+				{ TEXT("HSV"), EColorRampInterpolation::CRI_HSV }, { TEXT("HSL"), EColorRampInterpolation::CRI_HSL }, { TEXT("OKLab"), EColorRampInterpolation::CRI_OKLAB }
+			};
+
+			for (const TPair<const TCHAR*, EColorRampInterpolation>& Interpolation : Interpolations)
+			{
+				FColorGradientRamp Ramp(Interpolation.Value);
+				Ramp.SetStops(Stops);
+
+				// Every sample invalidates the table, so the bake itself is timed.
+				const FTimingResult BakeResult = MeasureMs(20, [&](const int32 Sample)
+				{
+					Ramp.SetStops(Stops);
+					Ramp.Bake();
+				});
+				const FTimingResult ScalarResult = MeasureMs(5, [&](const int32 Sample)
+				{
+					for (int32 Index = 0; Index < NumSamples; ++Index)
+					{
+						Colors[Index] = Ramp.Sample(Times[Index]);
+					}
+				});
+				const FTimingResult BatchResult = MeasureMs(5, [&](const int32 Sample) { Ramp.SampleBatch(Times, Colors); });
+				const FTimingResult VertexColorResult = MeasureMs(5, [&](const int32 Sample) { Ramp.SampleBatch(Times, VertexColors); });
+				const FTimingResult EvaluateResult = MeasureMs(3, [&](const int32 Sample)
+				{
+					for (int32 Index = 0; Index < NumSamples; ++Index)
+					{
+						Colors[Index] = Ramp.Evaluate(Times[Index]);
+					}
+				});
+
+				const double NsPerSample = 1.0e6 / NumSamples;
+				Writer->WriteObjectStart();
+				Writer->WriteValue(TEXT("Interpolation"), Interpolation.Key);
+				Writer->WriteValue(TEXT("Samples"), NumSamples);
+				Writer->WriteValue(TEXT("BakeMs"), BakeResult.MedianMs);
+				Writer->WriteValue(TEXT("SampleNs"), ScalarResult.MedianMs * NsPerSample);
+				Writer->WriteValue(TEXT("BatchNs"), BatchResult.MedianMs * NsPerSample);
+				Writer->WriteValue(TEXT("VertexColorBatchNs"), VertexColorResult.MedianMs * NsPerSample);
+				Writer->WriteValue(TEXT("EvaluateNs"), EvaluateResult.MedianMs * NsPerSample);
+				Writer->WriteValue(TEXT("Speedup"), ScalarResult.MedianMs > 0.0 ? EvaluateResult.MedianMs / ScalarResult.MedianMs : 0.0);
+				Writer->WriteObjectEnd();
+
+				UE_LOG(LogColorPicker, Log, TEXT("Ramp %s [%d]: bake %.4f ms, sample %.2f ns, batch %.2f ns, vertex color batch %.2f ns, evaluate %.2f ns"),
+					Interpolation.Key, NumSamples, BakeResult.MedianMs, ScalarResult.MedianMs * NsPerSample, BatchResult.MedianMs * NsPerSample,
+					VertexColorResult.MedianMs * NsPerSample, EvaluateResult.MedianMs * NsPerSample);
+			}
+		}
+		Writer->WriteArrayEnd();
+
+		Writer->WriteArrayStart(TEXT("Palette"));
+		{
+			const int32 MaxThreads = FTaskGraphInterface::Get().GetNumWorkerThreads() + 1;
+			TArray<int32> ThreadCounts;
+			for (int32 Threads = 1; Threads < MaxThreads; Threads *= 2)
+			{
+				ThreadCounts.Add(Threads);
+			}
+			ThreadCounts.Add(MaxThreads);
+
+			for (const FIntPoint& Size : { FIntPoint(512, 512), FIntPoint(1920, 1080), FIntPoint(3840, 2160) })
+			{
+				const TArray<FColor> Image = MakeImage(Size);
+
+				for (const int32 Stride : { 1, 7 })
+				{
+					for (const int32 Threads : ThreadCounts)
+					{
+						FColorPaletteSettings Settings;
+						Settings.Stride = Stride;
+						Settings.NumThreads = Threads;
+
+						// Untimed extraction first, its allocations include those of the worker threads.
+						const FAllocationCount Allocations = CountAllocations([&]() { FColorPaletteExtractor::Extract(Image, Settings); });
+						const FTimingResult Result = MeasureMs(10, [&](const int32 Sample)
+						{
+							FColorPaletteExtractor::Extract(Image, Settings);
+						});
+
+						Writer->WriteObjectStart();
+						Writer->WriteValue(TEXT("Function"), TEXT("ExtractPalette"));
+						Writer->WriteValue(TEXT("Width"), Size.X);
+						Writer->WriteValue(TEXT("Height"), Size.Y);
+						Writer->WriteValue(TEXT("NumColors"), Settings.NumColors);
+						Writer->WriteValue(TEXT("Stride"), Stride);
+						Writer->WriteValue(TEXT("Threads"), Threads);
+						Writer->WriteValue(TEXT("Allocations"), Allocations.Allocations);
+						Writer->WriteValue(TEXT("AllocatedBytes"), Allocations.Bytes);
+						WriteTiming(Writer, Result, Image.Num());
+						Writer->WriteObjectEnd();
+
+						UE_LOG(LogColorPicker, Log, TEXT("ExtractPalette [%dx%d, stride %d, %d threads]: %.3f ms, %.1f MP/s, %lld allocs (%lld bytes)"),
+							Size.X, Size.Y, Stride, Threads, Result.MedianMs, Result.MegapixelsPerSecond(Image.Num()), Allocations.Allocations, Allocations.Bytes);
+					}
+				}
+			}
+		}
+		Writer->WriteArrayEnd();
+
+		Writer->WriteArrayStart(TEXT("PaletteIndex"));
+		{
+			FRandomStream RandomStream(0xC0105);
+			auto RandomColor = [&RandomStream]() { return FLinearColor(RandomStream.GetFraction(), RandomStream.GetFraction(), RandomStream.GetFraction()); };
+
+			const int32 NumQueries = 10000;
+			TArray<FLinearColor> Queries;
+			for (int32 Index = 0; Index < NumQueries; ++Index)
+			{
+				Queries.Add(RandomColor());
+			}
+			TArray<int32> Nearest;
+			Nearest.SetNumUninitialized(NumQueries);
+			TArray<int32> BruteForceNearest;
+			BruteForceNearest.SetNumUninitialized(NumQueries);
+
+			for (const int32 PaletteSize : { 1000, 10000, 100000 })
+			{
+				TArray<FLinearColor> Palette;
+				for (int32 Index = 0; Index < PaletteSize; ++Index)
+				{
+					Palette.Add(RandomColor());
+				}
+
+				FColorPaletteIndex PaletteIndex;
+				const FTimingResult BuildResult = MeasureMs(5, [&](const int32 Sample) { PaletteIndex.Build(Palette); });
+
+				const FTimingResult NearestResult = MeasureMs(5, [&](const int32 Sample)
+				{
+					for (int32 Index = 0; Index < NumQueries; ++Index)
+					{
+						Nearest[Index] = PaletteIndex.FindNearest(Queries[Index]);
+					}
+				});
+				const FTimingResult BatchResult = MeasureMs(5, [&](const int32 Sample) { PaletteIndex.FindNearestBatch(Queries, Nearest); });
+				const FTimingResult BruteForceResult = MeasureMs(3, [&](const int32 Sample)
+				{
+					for (int32 Index = 0; Index < NumQueries; ++Index)
+					{
+						BruteForceNearest[Index] = PaletteIndex.FindNearestBruteForce(Queries[Index]);
+					}
+				});
+
+				int32 Mismatches = 0;
+				for (int32 Index = 0; Index < NumQueries; ++Index)
+				{
+					Mismatches += Nearest[Index] != BruteForceNearest[Index] ? 1 : 0;
+				}
+
+				const double NsPerQuery = 1.0e6 / NumQueries;
+				Writer->WriteObjectStart();
+				Writer->WriteValue(TEXT("PaletteSize"), PaletteSize);
+				Writer->WriteValue(TEXT("Queries"), NumQueries);
+				Writer->WriteValue(TEXT("BuildMs"), BuildResult.MedianMs);
+				Writer->WriteValue(TEXT("NearestNsPerQuery"), NearestResult.MedianMs * NsPerQuery);
+				Writer->WriteValue(TEXT("BatchNsPerQuery"), BatchResult.MedianMs * NsPerQuery);
+				Writer->WriteValue(TEXT("BruteForceNsPerQuery"), BruteForceResult.MedianMs * NsPerQuery);
+				Writer->WriteValue(TEXT("Speedup"), NearestResult.MedianMs > 0.0 ? BruteForceResult.MedianMs / NearestResult.MedianMs : 0.0);
+				Writer->WriteValue(TEXT("Mismatches"), Mismatches);
+				Writer->WriteObjectEnd();
+
+				UE_LOG(LogColorPicker, Log, TEXT("PaletteIndex [%d]: build %.3f ms, nearest %.1f ns/query, batch %.1f ns/query, brute force %.1f ns/query, %d mismatches"),
+					PaletteSize, BuildResult.MedianMs, NearestResult.MedianMs * NsPerQuery, BatchResult.MedianMs * NsPerQuery, BruteForceResult.MedianMs * NsPerQuery, Mismatches);
+			}
+		}
+		Writer->WriteArrayEnd();
+
+		Writer->WriteArrayStart(TEXT("ColorDifference"));
+		{
+			const int32 NumPairs = FMath::Min(MaxBatchSize, 1000000);
+			FRandomStream RandomStream(0xDE1A);
+			TArray<FLinearColor> Colors;
+			Colors.SetNumUninitialized(NumPairs * 2);
+			for (FLinearColor& Color : Colors)
+			{
+				Color = FLinearColor(RandomStream.GetFraction(), RandomStream.GetFraction(), RandomStream.GetFraction());
+			}
+			TArray<FVector> Lab;
+			Lab.SetNumUninitialized(Colors.Num());
+			UColorPickerBPLibrary::LinearColorToLabBatch(Colors, Lab);
+
+			const TArrayView<const FVector> Lab1(Lab.GetData(), NumPairs);
+			const TArrayView<const FVector> Lab2(Lab.GetData() + NumPairs, NumPairs);
+			const FVector& Reference = Lab[0];
+			TArray<float> Differences;
+			Differences.SetNumUninitialized(NumPairs);
+			TArray<float> ScalarDifferences;
+			ScalarDifferences.SetNumUninitialized(NumPairs);
+
+			struct FMethod
+			{
+				const TCHAR* Name;
+				EColorDifference Method;
+				float (*Scalar)(const FVector&, const FVector&);
+			};
+			const FMethod Methods[] = {
+				{ TEXT("CIE76"), EColorDifference::CD_CIE76, &ColorDifferenceKernels::DeltaE76 },
+				{ TEXT("CIE94"), EColorDifference::CD_CIE94, &ColorDifferenceKernels::DeltaE94 },
+				{ TEXT("CIEDE2000"), EColorDifference::CD_CIEDE2000, &ColorDifferenceKernels::DeltaE2000 }
+			};
+
+			for (const FMethod& Method : Methods)
+			{
+				const FTimingResult ScalarResult = MeasureMs(5, [&](const int32 Sample)
+				{
+					for (int32 Index = 0; Index < NumPairs; ++Index)
+					{
+						ScalarDifferences[Index] = Method.Scalar(Lab1[Index], Lab2[Index]);
+					}
+				});
+				const FTimingResult PairsResult = MeasureMs(5, [&](const int32 Sample) { UColorPickerBPLibrary::DeltaEBatch(Method.Method, Lab1, Lab2, Differences); });
+
+				float MaxDeviation = 0.f;
+				for (int32 Index = 0; Index < NumPairs; ++Index)
+				{
+					MaxDeviation = FMath::Max(MaxDeviation, FMath::Abs(Differences[Index] - ScalarDifferences[Index]));
+				}
+
+				const FTimingResult OneToManyResult = MeasureMs(5, [&](const int32 Sample) { UColorPickerBPLibrary::DeltaEBatch(Method.Method, Reference, Lab2, Differences); });
+
+				const double NsPerPair = 1.0e6 / NumPairs;
+				Writer->WriteObjectStart();
+				Writer->WriteValue(TEXT("Method"), Method.Name);
+				Writer->WriteValue(TEXT("Pairs"), NumPairs);
+				Writer->WriteValue(TEXT("ScalarNsPerPair"), ScalarResult.MedianMs * NsPerPair);
+				Writer->WriteValue(TEXT("BatchNsPerPair"), PairsResult.MedianMs * NsPerPair);
+				Writer->WriteValue(TEXT("OneToManyNsPerPair"), OneToManyResult.MedianMs * NsPerPair);
+				Writer->WriteValue(TEXT("Speedup"), PairsResult.MedianMs > 0.0 ? ScalarResult.MedianMs / PairsResult.MedianMs : 0.0);
+				Writer->WriteValue(TEXT("MaxDeviation"), MaxDeviation);
+				Writer->WriteObjectEnd();
+
+				UE_LOG(LogColorPicker, Log, TEXT("DeltaE %s [%d]: scalar %.2f ns/pair, batch %.2f ns/pair, one-to-many %.2f ns/pair, max deviation %g"),
+					Method.Name, NumPairs, ScalarResult.MedianMs * NsPerPair, PairsResult.MedianMs * NsPerPair, OneToManyResult.MedianMs * NsPerPair, MaxDeviation);
+			}
+		}
+		Writer->WriteArrayEnd();
+
+		Writer->WriteArrayStart(TEXT("Eyedropper"));
+		{
+			const int32 NumQueries = 10000;
+			FColorEyedropperSampler Sampler;
+
+			for (const FIntPoint& Size : { FIntPoint(1920, 1080), FIntPoint(3840, 2160) })
+			{
+				const TArray<FColor> Image = MakeImage(Size);
+				const FTimingResult BuildResult = MeasureMs(10, [&](const int32 Sample) { Sampler.Build(Image, Size); });
+
+				FRandomStream RandomStream(0xE7ED);
+				TArray<FIntPoint> Centers;
+				for (int32 Index = 0; Index < NumQueries; ++Index)
+				{
+					Centers.Add(FIntPoint(RandomStream.RandHelper(Size.X), RandomStream.RandHelper(Size.Y)));
+				}
+
+				for (const int32 Radius : { 1, 8, 32, FColorEyedropperSampler::MaxRadius })
+				{
+					FLinearColor Average;
+					const FTimingResult SampleResult = MeasureMs(5, [&](const int32 Sample)
+					{
+						for (const FIntPoint& Center : Centers)
+						{
+							Sampler.Sample(Center, Radius, Average);
+						}
+					});
+
+					// Direct summing is what the table replaces, fewer queries keep large radii affordable.
+					const int32 NumDirectQueries = FMath::Max(10, NumQueries / (Radius * Radius));
+					const FTimingResult DirectResult = MeasureMs(3, [&](const int32 Sample)
+					{
+						for (int32 Index = 0; Index < NumDirectQueries; ++Index)
+						{
+							const FIntPoint& Center = Centers[Index];
+							FLinearColor Sum = FLinearColor::Transparent;
+							int32 Count = 0;
+							for (int32 Y = FMath::Max(Center.Y - Radius, 0); Y <= FMath::Min(Center.Y + Radius, Size.Y - 1); ++Y)
+							{
+								for (int32 X = FMath::Max(Center.X - Radius, 0); X <= FMath::Min(Center.X + Radius, Size.X - 1); ++X)
+								{
+									Sum += FLinearColor::FromSRGBColor(Image[Y * Size.X + X]);
+									++Count;
+								}
+							}
+							Average = Sum / (float)Count;
+						}
+					});
+
+					const double SampleNs = SampleResult.MedianMs * 1.0e6 / NumQueries;
+					const double DirectNs = DirectResult.MedianMs * 1.0e6 / NumDirectQueries;
+					Writer->WriteObjectStart();
+					Writer->WriteValue(TEXT("Width"), Size.X);
+					Writer->WriteValue(TEXT("Height"), Size.Y);
+					Writer->WriteValue(TEXT("BuildMs"), BuildResult.MedianMs);
+					Writer->WriteValue(TEXT("BuildMegapixelsPerSecond"), BuildResult.MegapixelsPerSecond(Image.Num()));
+					Writer->WriteValue(TEXT("Radius"), Radius);
+					Writer->WriteValue(TEXT("SampleNsPerQuery"), SampleNs);
+					Writer->WriteValue(TEXT("DirectNsPerQuery"), DirectNs);
+					Writer->WriteValue(TEXT("Speedup"), SampleNs > 0.0 ? DirectNs / SampleNs : 0.0);
+					Writer->WriteObjectEnd();
+
+					UE_LOG(LogColorPicker, Log, TEXT("Eyedropper [%dx%d, radius %d]: build %.3f ms, sample %.1f ns/query, direct %.1f ns/query"),
+						Size.X, Size.Y, Radius, BuildResult.MedianMs, SampleNs, DirectNs);
+				}
+			}
+		}
+		Writer->WriteArrayEnd();
+
+		// Hex is skipped, its channels are RGB and its direct converters are copies.
+		Writer->WriteArrayStart(TEXT("FormatConversion"));
+		{
+			const int32 NumValues = FMath::Min(MaxBatchSize, 100000);
+			const EColorFormat Formats[] = { EColorFormat::CF_RBG, EColorFormat::CF_HSV, EColorFormat::CF_CMYK, EColorFormat::CF_HSL, EColorFormat::CF_LAB, EColorFormat::CF_OKLAB };
+
+			FRandomStream RandomStream(0xF0A7);
+			TArray<FLinearColor> Colors;
+			Colors.SetNumUninitialized(NumValues);
+			for (FLinearColor& Color : Colors)
+			{
+				Color = FLinearColor(RandomStream.GetFraction(), RandomStream.GetFraction(), RandomStream.GetFraction());
+			}
+
+			TArray<FColorChannels> Values;
+			Values.SetNumUninitialized(NumValues);
+			TArray<FColorChannels> Converted;
+			Converted.SetNumUninitialized(NumValues);
+
+			for (const EColorFormat From : Formats)
+			{
+				for (int32 Index = 0; Index < NumValues; ++Index)
+				{
+					Values[Index] = TwoHopFromLinear(From, Colors[Index]);
+				}
+
+				for (const EColorFormat To : Formats)
+				{
+					if (From == To)
+						continue;
+
+					const ColorFormatConverter::FConverter& Converter = ColorFormatConverter::GetConverter(From, To);
+					const FTimingResult DirectResult = MeasureMs(5, [&](const int32 Sample) { Converter.ConvertBatch(Values, Converted); });
+					const FTimingResult TwoHopResult = MeasureMs(5, [&](const int32 Sample)
+					{
+						for (int32 Index = 0; Index < NumValues; ++Index)
+						{
+							Converted[Index] = TwoHopFromLinear(To, TwoHopToLinear(From, Values[Index]));
+						}
+					});
+
+					const double NsPerValue = 1.0e6 / NumValues;
+					Writer->WriteObjectStart();
+					Writer->WriteValue(TEXT("From"), FormatName(From));
+					Writer->WriteValue(TEXT("To"), FormatName(To));
+					Writer->WriteValue(TEXT("Values"), NumValues);
+					Writer->WriteValue(TEXT("DirectNsPerValue"), DirectResult.MedianMs * NsPerValue);
+					Writer->WriteValue(TEXT("TwoHopNsPerValue"), TwoHopResult.MedianMs * NsPerValue);
+					Writer->WriteValue(TEXT("Speedup"), DirectResult.MedianMs > 0.0 ? TwoHopResult.MedianMs / DirectResult.MedianMs : 0.0);
+					Writer->WriteObjectEnd();
+
+					UE_LOG(LogColorPicker, Log, TEXT("Convert %s to %s [%d]: direct %.2f ns/value, two hop %.2f ns/value"),
+						*FormatName(From), *FormatName(To), NumValues, DirectResult.MedianMs * NsPerValue, TwoHopResult.MedianMs * NsPerValue);
+				}
+			}
+		}
+		Writer->WriteArrayEnd();
+
+		Writer->WriteArrayStart(TEXT("SwatchLibrary"));
+		{
+			const int32 NumSwatches = 100000;
+			const int32 NumQueries = 10000;
+			const FString Directory = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("ColorPicker"));
+			const FString TextFile = FPaths::Combine(Directory, TEXT("BenchmarkSwatches.json"));
+			const FString BinaryFile = FPaths::Combine(Directory, TEXT("BenchmarkSwatches.cpsw"));
+
+			// Artist libraries repeat names across collections, every fourth swatch reuses an earlier name.
+			FRandomStream RandomStream(0x5A7C);
+			FColorSwatchLibraryWriter SourceLibrary;
+			SourceLibrary.Reserve(NumSwatches);
+			for (int32 Index = 0; Index < NumSwatches; ++Index)
+			{
+				const int32 NameIndex = Index % 4 == 3 ? RandomStream.RandHelper(Index) : Index;
+				const FColor Color((uint8)RandomStream.RandHelper(256), (uint8)RandomStream.RandHelper(256), (uint8)RandomStream.RandHelper(256));
+				SourceLibrary.Add(FString::Printf(TEXT("Collection %d/Swatch %d"), NameIndex / 1000, NameIndex), FLinearColor::FromSRGBColor(Color));
+			}
+			FFileHelper::SaveStringToFile(SourceLibrary.ExportJson(), *TextFile, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
+
+			TArray<int32> QueryIndices;
+			TArray<FString> QueryNames;
+			for (int32 Index = 0; Index < NumQueries; ++Index)
+			{
+				QueryIndices.Add(RandomStream.RandHelper(NumSwatches));
+			}
+
+			// Resident memory is sampled around one untimed load, while holding the loaded swatches.
+			auto ResidentBytes = []() { return (int64)FPlatformMemory::GetStats().UsedPhysical; };
+
+			int64 TextResidentBytes;
+			{
+				const int64 Before = ResidentBytes();
+				FString JsonText;
+				FString Error;
+				FColorSwatchLibraryWriter Loaded;
+				FFileHelper::LoadFileToString(JsonText, *TextFile);
+				Loaded.ImportJson(JsonText, Error);
+				JsonText.Empty();
+				TextResidentBytes = ResidentBytes() - Before;
+			}
+			const FTimingResult TextLoadResult = MeasureMs(3, [&](const int32 Sample)
+			{
+				FString JsonText;
+				FString Error;
+				FColorSwatchLibraryWriter Loaded;
+				FFileHelper::LoadFileToString(JsonText, *TextFile);
+				Loaded.ImportJson(JsonText, Error);
+			});
+
+			FColorSwatchWriteSettings Compact;
+			FColorSwatchWriteSettings Full;
+			Full.Storage = EColorSwatchStorage::CSS_FLOAT16;
+			Full.bIncludeHSV = true;
+			Full.bIncludeLab = true;
+
+			struct FSwatchCase
+			{
+				const TCHAR* Name;
+				FColorSwatchWriteSettings Settings;
+			};
+			for (const FSwatchCase& Case : { FSwatchCase{ TEXT("RGBA8"), Compact }, FSwatchCase{ TEXT("Float16 HSV Lab"), Full } })
+			{
+				SourceLibrary.Save(BinaryFile, Case.Settings);
+
+				FColorSwatchLibrary Library;
+				const FTimingResult OpenResult = MeasureMs(20, [&](const int32 Sample) { Library.Open(BinaryFile); });
+
+				const int64 Before = ResidentBytes();
+				Library.Open(BinaryFile);
+				const int64 OpenResidentBytes = ResidentBytes() - Before;
+
+				const ANSICHAR* Name;
+				int32 NameLength;
+				FLinearColor Color;
+				const FTimingResult ReadResult = MeasureMs(5, [&](const int32 Sample)
+				{
+					for (const int32 Index : QueryIndices)
+					{
+						Name = Library.GetNameUTF8(Index, NameLength);
+						Color = Library.GetColor(Index);
+					}
+				});
+				const int64 ReadResidentBytes = ResidentBytes() - Before;
+
+				if (QueryNames.Num() == 0)
+				{
+					for (const int32 Index : QueryIndices)
+					{
+						QueryNames.Add(Library.GetName(Index));
+					}
+				}
+				int32 Found;
+				const FTimingResult FindResult = MeasureMs(5, [&](const int32 Sample)
+				{
+					for (const FString& QueryName : QueryNames)
+					{
+						Found = Library.FindByName(QueryName);
+					}
+				});
+
+				const double NsPerQuery = 1.0e6 / NumQueries;
+				Writer->WriteObjectStart();
+				Writer->WriteValue(TEXT("Storage"), Case.Name);
+				Writer->WriteValue(TEXT("Swatches"), NumSwatches);
+				Writer->WriteValue(TEXT("UniqueNames"), Library.NumUniqueNames());
+				Writer->WriteValue(TEXT("TextFileBytes"), IFileManager::Get().FileSize(*TextFile));
+				Writer->WriteValue(TEXT("BinaryFileBytes"), Library.GetDataSize());
+				Writer->WriteValue(TEXT("TextLoadMs"), TextLoadResult.MedianMs);
+				Writer->WriteValue(TEXT("BinaryOpenMs"), OpenResult.MedianMs);
+				Writer->WriteValue(TEXT("TextResidentBytes"), TextResidentBytes);
+				Writer->WriteValue(TEXT("BinaryOpenResidentBytes"), OpenResidentBytes);
+				Writer->WriteValue(TEXT("BinaryResidentBytesAfterReads"), ReadResidentBytes);
+				Writer->WriteValue(TEXT("ReadNsPerSwatch"), ReadResult.MedianMs * NsPerQuery);
+				Writer->WriteValue(TEXT("FindByNameNsPerQuery"), FindResult.MedianMs * NsPerQuery);
+				Writer->WriteObjectEnd();
+
+				UE_LOG(LogColorPicker, Log, TEXT("Swatches %s [%d]: text load %.2f ms (%lld bytes resident), binary open %.4f ms (%lld bytes resident, %lld after %d reads), read %.1f ns, find %.1f ns"),
+					Case.Name, NumSwatches, TextLoadResult.MedianMs, TextResidentBytes, OpenResult.MedianMs, OpenResidentBytes, ReadResidentBytes, NumQueries,
+					ReadResult.MedianMs * NsPerQuery, FindResult.MedianMs * NsPerQuery);
+
+				Library.Close();
+			}
+
+			IFileManager::Get().Delete(*TextFile);
+			IFileManager::Get().Delete(*BinaryFile);
+		}
+		Writer->WriteArrayEnd();
+
+		Writer->WriteObjectEnd();
+		Writer->Close();
+
+		if (FFileHelper::SaveStringToFile(Json, *OutputFile))
+		{
+			UE_LOG(LogColorPicker, Log, TEXT("Benchmark results written to %s"), *OutputFile);
+		}
+		else
+		{
+			UE_LOG(LogColorPickerError, Error, TEXT("Failed to write benchmark results to %s"), *OutputFile);
+		}
+	}
+
+	static FAutoConsoleCommand BenchmarkCommand(
+		TEXT("ColorPicker.Benchmark"),
+		TEXT("Benchmark color conversions, gradient rasterization, image adjustment, gradient ramp sampling, palette extraction, palette queries, color differences, format conversions, eyedropper sampling and swatch library loading and write JSON results. Usage: ColorPicker.Benchmark [MaxBatchSize=10000000] [OutputFile]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&Run));
+}
+
+#endif // !UE_BUILD_SHIPPING
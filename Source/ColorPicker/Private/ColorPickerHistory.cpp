@@ -0,0 +1,147 @@
+// Copyright kevin791129
+
+#include "ColorPickerHistory.h"
+
+namespace
+{
+	FORCEINLINE uint16 PackUnit(const float Value)
+	{
+		return (uint16)(FMath::Clamp(Value, 0.f, 1.f) * 65535.f + 0.5f);
+	}
+
+	FORCEINLINE float UnpackUnit(const uint16 Value)
+	{
+		return (float)Value / 65535.f;
+	}
+}
+
+FColorPickerHistory::FState FColorPickerHistory::FState::Pack(const float H, const float S, const float V, const float A)
+{
+	return FState{ PackUnit(H / 360.f), PackUnit(S), PackUnit(V), PackUnit(A) };
+}
+
+void FColorPickerHistory::FState::Unpack(float& OutH, float& OutS, float& OutV, float& OutA) const
+{
+	OutH = UnpackUnit(Hue) * 360.f;
+	OutS = UnpackUnit(Saturation);
+	OutV = UnpackUnit(Value);
+	OutA = UnpackUnit(Alpha);
+}
+
+void FColorPickerHistory::SetCapacity(const int32 InCapacity, const int32 InMaxPathPoints)
+{
+	// A path needs both ends.
+	MaxPathPoints = InMaxPathPoints > 0 ? FMath::Max(InMaxPathPoints, 2) : 0;
+	Entries.SetNumUninitialized(FMath::Max(InCapacity, 1));
+	Paths.SetNumUninitialized(Entries.Num() * MaxPathPoints);
+	PathScratch.SetNumUninitialized(MaxPathPoints);
+	bChanging = false;
+	Clear();
+}
+
+void FColorPickerHistory::Clear()
+{
+	Start = 0;
+	Num = 0;
+	Cursor = 0;
+}
+
+void FColorPickerHistory::BeginChange(const FState& State)
+{
+	bChanging = true;
+	ChangeBefore = State;
+	NumScratchPoints = 0;
+	PathStride = 1;
+	NumRecorded = 0;
+	AddPathPoint(State);
+}
+
+void FColorPickerHistory::RecordChange(const FState& State)
+{
+	if (!bChanging || MaxPathPoints == 0)
+		return;
+
+	if (++NumRecorded % PathStride == 0)
+		AddPathPoint(State);
+}
+
+void FColorPickerHistory::AddPathPoint(const FState& State)
+{
+	if (MaxPathPoints == 0)
+		return;
+
+	// Once full keep every other point and record half as often, points stay evenly spaced in events without growing.
+	if (NumScratchPoints == MaxPathPoints)
+	{
+		for (int32 Index = 1; Index * 2 < NumScratchPoints; ++Index)
+		{
+			PathScratch[Index] = PathScratch[Index * 2];
+		}
+		NumScratchPoints = (NumScratchPoints + 1) / 2;
+		PathStride *= 2;
+	}
+	PathScratch[NumScratchPoints++] = State;
+}
+
+bool FColorPickerHistory::EndChange(const FState& State)
+{
+	if (!bChanging)
+		return false;
+
+	bChanging = false;
+	if (State == ChangeBefore)
+		return false;
+
+	// Adding drops redo entries, then the oldest entry once full.
+	const int32 Capacity = Entries.Num();
+	Num = Cursor;
+	if (Num == Capacity)
+	{
+		Start = (Start + 1) % Capacity;
+		--Num;
+	}
+
+	const int32 Slot = SlotIndex(Num);
+	FEntry& Entry = Entries[Slot];
+	Entry.Before = ChangeBefore;
+	Entry.After = State;
+	Entry.NumPathPoints = 0;
+	if (MaxPathPoints > 0)
+	{
+		if (PathScratch[NumScratchPoints - 1] != State)
+			AddPathPoint(State);
+
+		Entry.NumPathPoints = NumScratchPoints;
+		FMemory::Memcpy(Paths.GetData() + Slot * MaxPathPoints, PathScratch.GetData(), NumScratchPoints * sizeof(FState));
+	}
+
+	Cursor = ++Num;
+	return true;
+}
+
+bool FColorPickerHistory::Undo(FState& OutState)
+{
+	if (bChanging || !CanUndo())
+		return false;
+
+	OutState = Entries[SlotIndex(--Cursor)].Before;
+	return true;
+}
+
+bool FColorPickerHistory::Redo(FState& OutState)
+{
+	if (bChanging || !CanRedo())
+		return false;
+
+	OutState = Entries[SlotIndex(Cursor++)].After;
+	return true;
+}
+
+TArrayView<const FColorPickerHistory::FState> FColorPickerHistory::GetUndoPath(const int32 Depth) const
+{
+	if (MaxPathPoints == 0 || Depth < 0 || Depth >= Cursor)
+		return TArrayView<const FState>();
+
+	const int32 Slot = SlotIndex(Cursor - 1 - Depth);
+	return TArrayView<const FState>(Paths.GetData() + Slot * MaxPathPoints, Entries[Slot].NumPathPoints);
+}
@@ -0,0 +1,776 @@
+// Copyright kevin791129
+
+#include "CoreMinimal.h"
+
+#if !UE_BUILD_SHIPPING
+
+#include "ColorPickerInputReplay.h"
+#include "UMG/ColorPickerWidget.h"
+#include "ColorPicker.h"
+#include "ColorPickerBPLibrary.h"
+#include "SRGBTransfer.h"
+#include "Blueprint/UserWidget.h"
+#include "Dom/JsonObject.h"
+#include "Engine/World.h"
+#include "Framework/Application/SlateApplication.h"
+#include "HAL/IConsoleManager.h"
+#include "Input/HittestGrid.h"
+#include "InputCoreTypes.h"
+#include "Math/RandomStream.h"
+#include "Misc/App.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Rendering/DrawElements.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Layout/ArrangedChildren.h"
+#include "Widgets/SCompoundWidget.h"
+#include "Widgets/SInvalidationPanel.h"
+#include "Widgets/SVirtualWindow.h"
+
+const TCHAR* FColorPickerInputReplay::DefaultWidgetClass = TEXT("/ColorPicker/Widget/ColorPickerWidget_BP.ColorPickerWidget_BP_C");
+
+namespace
+{
+	/**
+	 * Percentile of sorted samples, nearest rank.
+	 */
+	double Percentile(const TArray<double>& Sorted, const double Fraction)
+	{
+		if (Sorted.Num() == 0)
+			return 0.0;
+
+		return Sorted[FMath::Clamp(FMath::CeilToInt(Fraction * Sorted.Num()) - 1, 0, Sorted.Num() - 1)];
+	}
+
+	void WritePercentiles(const TSharedRef<TJsonWriter<>>& Writer, const FString& Identifier, const TArray<double>& Us)
+	{
+		Writer->WriteObjectStart(Identifier);
+		Writer->WriteValue(TEXT("Count"), Us.Num());
+		Writer->WriteValue(TEXT("P50Us"), Percentile(Us, 0.5));
+		Writer->WriteValue(TEXT("P90Us"), Percentile(Us, 0.9));
+		Writer->WriteValue(TEXT("P99Us"), Percentile(Us, 0.99));
+		Writer->WriteValue(TEXT("MaxUs"), Us.Num() > 0 ? Us.Last() : 0.0);
+		Writer->WriteObjectEnd();
+	}
+}
+
+FString FColorPickerInputReplay::ToHex(const FColor& Color)
+{
+	return FString::Printf(TEXT("#%02X%02X%02X%02X"), Color.R, Color.G, Color.B, Color.A);
+}
+
+const TCHAR* FColorPickerInputReplay::EventTypeName(const EEventType Type)
+{
+	switch (Type)
+	{
+	case EEventType::Down: return TEXT("Down");
+	case EEventType::Move: return TEXT("Move");
+	case EEventType::Up: return TEXT("Up");
+	case EEventType::CaptureLost: return TEXT("CaptureLost");
+	case EEventType::Frame: return TEXT("Frame");
+	default: return TEXT("Unknown");
+	}
+}
+
+#pragma region Stream Files
+bool FColorPickerInputReplay::LoadStream(const FString& Filename, FStream& OutStream)
+{
+	FString JsonText;
+	if (!FFileHelper::LoadFileToString(JsonText, *Filename))
+	{
+		UE_LOG(LogColorPickerError, Error, TEXT("Failed to read input stream %s."), *Filename);
+		return false;
+	}
+
+	TSharedPtr<FJsonObject> Root;
+	const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonText);
+	const TArray<TSharedPtr<FJsonValue>>* Events;
+	if (!FJsonSerializer::Deserialize(Reader, Root) || !Root.IsValid() || !Root->TryGetArrayField(TEXT("Events"), Events))
+	{
+		UE_LOG(LogColorPickerError, Error, TEXT("Input stream %s is not a JSON object with an Events array."), *Filename);
+		return false;
+	}
+
+	OutStream = FStream();
+	if (!Root->TryGetStringField(TEXT("Name"), OutStream.Name))
+		OutStream.Name = FPaths::GetBaseFilename(Filename);
+
+	double Width, Height;
+	if (Root->TryGetNumberField(TEXT("Width"), Width) && Root->TryGetNumberField(TEXT("Height"), Height))
+		OutStream.Size = FVector2D((float)FMath::Max(1.0, Width), (float)FMath::Max(1.0, Height));
+
+	FString Hex;
+	if (Root->TryGetStringField(TEXT("InitialColor"), Hex) && !UColorPickerBPLibrary::ParseHex(Hex, OutStream.InitialColor))
+	{
+		UE_LOG(LogColorPickerError, Error, TEXT("Input stream %s has invalid InitialColor %s."), *Filename, *Hex);
+		return false;
+	}
+	Root->TryGetBoolField(TEXT("CoalesceInput"), OutStream.bCoalesceInput);
+
+	OutStream.Events.Reserve(Events->Num());
+	for (int32 Index = 0; Index < Events->Num(); ++Index)
+	{
+		const TSharedPtr<FJsonObject>* Object;
+		FString TypeName;
+		if (!(*Events)[Index]->TryGetObject(Object) || !(*Object)->TryGetStringField(TEXT("Type"), TypeName))
+		{
+			UE_LOG(LogColorPickerError, Error, TEXT("Input stream %s event %d has no Type."), *Filename, Index);
+			return false;
+		}
+
+		FEvent Event{ EEventType::Count, FVector2D::ZeroVector };
+		for (uint8 Type = 0; Type < (uint8)EEventType::Count; ++Type)
+		{
+			if (TypeName == EventTypeName((EEventType)Type))
+				Event.Type = (EEventType)Type;
+		}
+
+		double X = 0.0, Y = 0.0;
+		const bool bNeedsPosition = Event.Type == EEventType::Down || Event.Type == EEventType::Move || Event.Type == EEventType::Up;
+		if (Event.Type == EEventType::Count || (bNeedsPosition && (!(*Object)->TryGetNumberField(TEXT("X"), X) || !(*Object)->TryGetNumberField(TEXT("Y"), Y))))
+		{
+			UE_LOG(LogColorPickerError, Error, TEXT("Input stream %s event %d is invalid."), *Filename, Index);
+			return false;
+		}
+
+		Event.Position = FVector2D((float)X, (float)Y);
+		OutStream.Events.Add(Event);
+	}
+
+	const TSharedPtr<FJsonObject>* Expected;
+	if (Root->TryGetObjectField(TEXT("Expected"), Expected))
+	{
+		double Hue, Saturation, Value;
+		FLinearColor Color;
+		if (!(*Expected)->TryGetNumberField(TEXT("Hue"), Hue) || !(*Expected)->TryGetNumberField(TEXT("Saturation"), Saturation) ||
+			!(*Expected)->TryGetNumberField(TEXT("Value"), Value) || !(*Expected)->TryGetStringField(TEXT("Color"), Hex) ||
+			!UColorPickerBPLibrary::ParseHex(Hex, Color))
+		{
+			UE_LOG(LogColorPickerError, Error, TEXT("Input stream %s needs Hue, Saturation, Value and Color in Expected."), *Filename);
+			return false;
+		}
+
+		OutStream.bHasExpected = true;
+		OutStream.ExpectedHue = (float)Hue;
+		OutStream.ExpectedSaturation = (float)Saturation;
+		OutStream.ExpectedValue = (float)Value;
+		OutStream.ExpectedColor = SRGBTransfer::ToFColor(Color);
+
+		double Tolerance;
+		if ((*Expected)->TryGetNumberField(TEXT("Tolerance"), Tolerance))
+			OutStream.Tolerance = (float)Tolerance;
+	}
+
+	return true;
+}
+
+bool FColorPickerInputReplay::SaveStream(const FStream& Stream, const FString& Filename)
+{
+	FString Json;
+	const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Json);
+	Writer->WriteObjectStart();
+	Writer->WriteValue(TEXT("Name"), Stream.Name);
+	Writer->WriteValue(TEXT("Width"), Stream.Size.X);
+	Writer->WriteValue(TEXT("Height"), Stream.Size.Y);
+	Writer->WriteValue(TEXT("InitialColor"), ToHex(SRGBTransfer::ToFColor(Stream.InitialColor)));
+	Writer->WriteValue(TEXT("CoalesceInput"), Stream.bCoalesceInput);
+
+	Writer->WriteArrayStart(TEXT("Events"));
+	for (const FEvent& Event : Stream.Events)
+	{
+		Writer->WriteObjectStart();
+		Writer->WriteValue(TEXT("Type"), EventTypeName(Event.Type));
+		if (Event.Type == EEventType::Down || Event.Type == EEventType::Move || Event.Type == EEventType::Up)
+		{
+			Writer->WriteValue(TEXT("X"), Event.Position.X);
+			Writer->WriteValue(TEXT("Y"), Event.Position.Y);
+		}
+		Writer->WriteObjectEnd();
+	}
+	Writer->WriteArrayEnd();
+
+	if (Stream.bHasExpected)
+	{
+		Writer->WriteObjectStart(TEXT("Expected"));
+		Writer->WriteValue(TEXT("Hue"), Stream.ExpectedHue);
+		Writer->WriteValue(TEXT("Saturation"), Stream.ExpectedSaturation);
+		Writer->WriteValue(TEXT("Value"), Stream.ExpectedValue);
+		Writer->WriteValue(TEXT("Color"), ToHex(Stream.ExpectedColor));
+		Writer->WriteValue(TEXT("Tolerance"), Stream.Tolerance);
+		Writer->WriteObjectEnd();
+	}
+
+	Writer->WriteObjectEnd();
+	Writer->Close();
+	return FFileHelper::SaveStringToFile(Json, *Filename);
+}
+#pragma endregion
+
+#pragma region Harness
+/**
+ * Counts prepass and arrange work of the picker, a prepass computes the desired size of every widget below it.
+ */
+class SPickerLayoutCounter : public SCompoundWidget
+{
+public:
+	SLATE_BEGIN_ARGS(SPickerLayoutCounter) {}
+		SLATE_DEFAULT_SLOT(FArguments, Content)
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs)
+	{
+		ChildSlot
+		[
+			InArgs._Content.Widget
+		];
+	}
+
+	virtual FVector2D ComputeDesiredSize(float LayoutScaleMultiplier) const override
+	{
+		++NumPrepasses;
+		return SCompoundWidget::ComputeDesiredSize(LayoutScaleMultiplier);
+	}
+
+	virtual void OnArrangeChildren(const FGeometry& AllottedGeometry, FArrangedChildren& ArrangedChildren) const override
+	{
+		++NumArranges;
+		SCompoundWidget::OnArrangeChildren(AllottedGeometry, ArrangedChildren);
+	}
+
+	void ClearContent()
+	{
+		ChildSlot
+		[
+			SNullWidget::NullWidget
+		];
+	}
+
+	mutable int32 NumPrepasses = 0;
+	mutable int32 NumArranges = 0;
+};
+
+FColorPickerInputReplay::FColorPickerInputReplay(UColorPickerWidget* InWidget, const FVector2D& InSize, const bool bCachePaint)
+	: Widget(InWidget)
+	, Size(InSize)
+	, Window(SNew(SVirtualWindow).Size(InSize))
+	, LayoutCounter(SNew(SPickerLayoutCounter)[InWidget->TakeWidget()])
+	, HittestGrid(MakeShared<FHittestGrid>())
+{
+	if (bCachePaint)
+	{
+		InvalidationPanel = SNew(SInvalidationPanel)
+			[
+				LayoutCounter
+			];
+		Window->SetContent(InvalidationPanel.ToSharedRef());
+	}
+	else
+	{
+		Window->SetContent(LayoutCounter);
+	}
+	BroadcastHandle = Widget->OnColorChangedNative.AddLambda([this](const FLinearColor&)
+	{
+		if (NumBroadcasts++ == 0)
+			FirstBroadcastCycles = FPlatformTime::Cycles64();
+	});
+	Paint();
+}
+
+FColorPickerInputReplay::~FColorPickerInputReplay()
+{
+	ResetPicker(Widget->CurrentColor);
+	Widget->OnColorChangedNative.Remove(BroadcastHandle);
+	Window->SetContent(SNullWidget::NullWidget);
+	LayoutCounter->ClearContent();
+	Widget->ReleaseSlateResources(true);
+}
+
+void FColorPickerInputReplay::Paint()
+{
+	const FGeometry WindowGeometry = FGeometry::MakeRoot(Size, FSlateLayoutTransform());
+	HittestGrid->SetHittestArea(FVector2D::ZeroVector, Size);
+
+	Window->SlatePrepass(1.f);
+	FSlateWindowElementList ElementList(Window);
+	FPaintArgs PaintArgs(nullptr, HittestGrid.Get(), FVector2D::ZeroVector, FApp::GetCurrentTime(), (float)FApp::GetDeltaTime());
+	Window->Paint(PaintArgs, WindowGeometry, WindowGeometry.GetLayoutBoundingRect(), ElementList, 0, FWidgetStyle(), Window->IsEnabled());
+}
+
+bool FColorPickerInputReplay::IsPaintCached() const
+{
+	return InvalidationPanel.IsValid() && InvalidationPanel->GetCanCache();
+}
+
+int32 FColorPickerInputReplay::GetNumPaints() const
+{
+	return Widget->NumPaints;
+}
+
+int32 FColorPickerInputReplay::GetNumPrepasses() const
+{
+	return LayoutCounter->NumPrepasses;
+}
+
+int32 FColorPickerInputReplay::GetNumArranges() const
+{
+	return LayoutCounter->NumArranges;
+}
+
+FColorPickerInputReplay::FPickerWidgets FColorPickerInputReplay::GetPickerWidgets() const
+{
+	auto ToSlate = [](const UWidget* Part) -> const SWidget*
+	{
+		return Part ? Part->GetCachedWidget().Get() : nullptr;
+	};
+
+	const UWidget* Canvases[] = { Widget->GetRootWidget(), Widget->HuePicker, Widget->SaturationValuePicker };
+	FPickerWidgets Widgets;
+	for (const UWidget* Canvas : Canvases)
+	{
+		if (const SWidget* Slate = ToSlate(Canvas))
+			Widgets.Canvases.AddUnique(Slate);
+	}
+	Widgets.HueImage = ToSlate(Widget->ColorPicker_H);
+	Widgets.SaturationValueImage = ToSlate(Widget->ColorPicker_SV);
+	Widgets.HueIndicator = ToSlate(Widget->Indicator_H);
+	Widgets.SaturationValueIndicator = ToSlate(Widget->Indicator_SV);
+	return Widgets;
+}
+
+FVector2D FColorPickerInputReplay::HueToWidget(const float LocalY) const
+{
+	return Widget->ColorPicker_H->GetCachedGeometry().LocalToAbsolute(FVector2D(Widget->H_SizeX * 0.5f, LocalY));
+}
+
+FVector2D FColorPickerInputReplay::SaturationValueToWidget(const FVector2D& LocalPosition) const
+{
+	return Widget->ColorPicker_SV->GetCachedGeometry().LocalToAbsolute(LocalPosition);
+}
+
+void FColorPickerInputReplay::ExpectHue(FStream& Stream, const float LocalY) const
+{
+	Stream.ExpectedHue = FMath::Clamp(LocalY, 0.f, Widget->H_SizeY) / Widget->H_SizeY * 360.f;
+}
+
+void FColorPickerInputReplay::ExpectSaturationValue(FStream& Stream, const FVector2D& LocalPosition) const
+{
+	Stream.ExpectedSaturation = FMath::Clamp(LocalPosition.X, 0.f, Widget->SV_SizeX) / Widget->SV_SizeX;
+	Stream.ExpectedValue = 1.f - FMath::Clamp(LocalPosition.Y, 0.f, Widget->SV_SizeY) / Widget->SV_SizeY;
+}
+
+void FColorPickerInputReplay::ExpectColor(FStream& Stream) const
+{
+	FLinearColor Color;
+	UColorPickerBPLibrary::HSVToLinearColor(Stream.ExpectedHue, Stream.ExpectedSaturation, Stream.ExpectedValue, Color, Widget->Precision);
+	Stream.ExpectedColor = SRGBTransfer::ToFColor(Color);
+	Stream.bHasExpected = true;
+}
+
+const TArray<FString>& FColorPickerInputReplay::GetSyntheticStreamNames()
+{
+	static const TArray<FString> Names = {
+		TEXT("FastDragSaturationValue"),
+		TEXT("FastDragHue"),
+		TEXT("HueSaturationValueSwitch"),
+		TEXT("CaptureLoss"),
+		TEXT("PressOutside"),
+		TEXT("CoalescedDrag")
+	};
+	return Names;
+}
+
+bool FColorPickerInputReplay::MakeSyntheticStream(const FString& Name, FStream& OutStream) const
+{
+	const int32 StreamIndex = GetSyntheticStreamNames().IndexOfByKey(Name);
+	if (StreamIndex == INDEX_NONE)
+		return false;
+
+	// Seeded per stream, so streams do not depend on which others are generated.
+	FRandomStream Random(0x5EED + StreamIndex);
+	const FVector2D SVSize(Widget->SV_SizeX, Widget->SV_SizeY);
+	const float HueSize = Widget->H_SizeY;
+
+	// Positions overshoot the pickers by a quarter of their size, so clamping is exercised.
+	auto RandomSV = [&Random, &SVSize]() { return FVector2D(Random.FRandRange(-0.25f, 1.25f) * SVSize.X, Random.FRandRange(-0.25f, 1.25f) * SVSize.Y); };
+	auto RandomHue = [&Random, HueSize]() { return Random.FRandRange(-0.25f, 1.25f) * HueSize; };
+
+	auto AddSVDrag = [this, &Random, &RandomSV, &SVSize](FStream& Stream, const int32 NumMoves, const bool bRelease)
+	{
+		FVector2D Position = SVSize * Random.FRandRange(0.1f, 0.9f);
+		Stream.Events.Add({ EEventType::Down, SaturationValueToWidget(Position) });
+		for (int32 Move = 0; Move < NumMoves; ++Move)
+		{
+			Position = RandomSV();
+			Stream.Events.Add({ EEventType::Move, SaturationValueToWidget(Position) });
+		}
+		if (bRelease)
+			Stream.Events.Add({ EEventType::Up, SaturationValueToWidget(Position) });
+		ExpectSaturationValue(Stream, Position);
+	};
+
+	auto AddHueDrag = [this, &Random, &RandomHue, HueSize](FStream& Stream, const int32 NumMoves, const bool bRelease)
+	{
+		float Position = HueSize * Random.FRandRange(0.1f, 0.9f);
+		Stream.Events.Add({ EEventType::Down, HueToWidget(Position) });
+		for (int32 Move = 0; Move < NumMoves; ++Move)
+		{
+			Position = RandomHue();
+			Stream.Events.Add({ EEventType::Move, HueToWidget(Position) });
+		}
+		if (bRelease)
+			Stream.Events.Add({ EEventType::Up, HueToWidget(Position) });
+		ExpectHue(Stream, Position);
+	};
+
+	FStream& Stream = OutStream;
+	Stream = FStream();
+	Stream.Name = Name;
+	Stream.Size = Size;
+	// Initial color hue, saturation and value are all reached by the streams below.
+	Stream.InitialColor = FLinearColor::Red;
+	ExpectHue(Stream, 0.f);
+	ExpectSaturationValue(Stream, FVector2D(SVSize.X, 0.f));
+
+	if (Name == TEXT("FastDragSaturationValue"))
+	{
+		AddSVDrag(Stream, 5000, true);
+	}
+	else if (Name == TEXT("FastDragHue"))
+	{
+		AddHueDrag(Stream, 5000, true);
+	}
+	else if (Name == TEXT("HueSaturationValueSwitch"))
+	{
+		for (int32 Round = 0; Round < 40; ++Round)
+		{
+			AddHueDrag(Stream, 50, true);
+			AddSVDrag(Stream, 50, true);
+		}
+	}
+	else if (Name == TEXT("CaptureLoss"))
+	{
+		// Moves and release after capture is lost must not change the color.
+		AddHueDrag(Stream, 200, false);
+		Stream.Events.Add({ EEventType::CaptureLost, FVector2D::ZeroVector });
+		AddSVDrag(Stream, 500, false);
+		Stream.Events.Add({ EEventType::CaptureLost, FVector2D::ZeroVector });
+		for (int32 Move = 0; Move < 100; ++Move)
+		{
+			Stream.Events.Add({ EEventType::Move, SaturationValueToWidget(RandomSV()) });
+		}
+		Stream.Events.Add({ EEventType::Up, SaturationValueToWidget(RandomSV()) });
+	}
+	else if (Name == TEXT("PressOutside"))
+	{
+		// A press outside both pickers starts no interaction.
+		const FVector2D Outside = SaturationValueToWidget(FVector2D(-10.f, -10.f));
+		Stream.Events.Add({ EEventType::Down, Outside });
+		for (int32 Move = 0; Move < 100; ++Move)
+		{
+			Stream.Events.Add({ EEventType::Move, SaturationValueToWidget(RandomSV()) });
+		}
+		Stream.Events.Add({ EEventType::Up, Outside });
+	}
+	else if (Name == TEXT("CoalescedDrag"))
+	{
+		// Eight moves per frame, the last pending position is applied when released.
+		Stream.bCoalesceInput = true;
+		FVector2D Position = SVSize * 0.5f;
+		Stream.Events.Add({ EEventType::Down, SaturationValueToWidget(Position) });
+		for (int32 Move = 1; Move <= 4000; ++Move)
+		{
+			Position = RandomSV();
+			Stream.Events.Add({ EEventType::Move, SaturationValueToWidget(Position) });
+			if (Move % 8 == 0)
+				Stream.Events.Add({ EEventType::Frame, FVector2D::ZeroVector });
+		}
+		Position = RandomSV();
+		Stream.Events.Add({ EEventType::Move, SaturationValueToWidget(Position) });
+		Stream.Events.Add({ EEventType::Up, SaturationValueToWidget(Position) });
+		ExpectSaturationValue(Stream, Position);
+	}
+
+	ExpectColor(Stream);
+	return true;
+}
+
+void FColorPickerInputReplay::ResetPicker(const FLinearColor& InitialColor)
+{
+	if (Widget->bIsInteracting)
+		Widget->NativeOnMouseCaptureLost(FCaptureLostEvent(0, 0));
+
+	bButtonPressed = false;
+	Widget->SetPickerColor(InitialColor);
+	Widget->ClearHistory();
+}
+
+void FColorPickerInputReplay::Dispatch(const FEvent& Event)
+{
+	const FGeometry& Geometry = Widget->GetCachedGeometry();
+	TSet<FKey> PressedButtons;
+
+	switch (Event.Type)
+	{
+	case EEventType::Down:
+		PressedButtons.Add(EKeys::LeftMouseButton);
+		Widget->NativeOnMouseButtonDown(Geometry, FPointerEvent(0, Event.Position, LastPosition, PressedButtons, EKeys::LeftMouseButton, 0.f, FModifierKeysState()));
+		bButtonPressed = true;
+		LastPosition = Event.Position;
+		break;
+	case EEventType::Move:
+		if (bButtonPressed)
+			PressedButtons.Add(EKeys::LeftMouseButton);
+		Widget->NativeOnMouseMove(Geometry, FPointerEvent(0, Event.Position, LastPosition, PressedButtons, EKeys::Invalid, 0.f, FModifierKeysState()));
+		LastPosition = Event.Position;
+		break;
+	case EEventType::Up:
+		Widget->NativeOnMouseButtonUp(Geometry, FPointerEvent(0, Event.Position, LastPosition, PressedButtons, EKeys::LeftMouseButton, 0.f, FModifierKeysState()));
+		bButtonPressed = false;
+		LastPosition = Event.Position;
+		break;
+	case EEventType::CaptureLost:
+		Widget->NativeOnMouseCaptureLost(FCaptureLostEvent(0, 0));
+		break;
+	case EEventType::Frame:
+		Widget->FlushPendingInput();
+		break;
+	default:
+		break;
+	}
+}
+
+FColorPickerInputReplay::FReplayResult FColorPickerInputReplay::Replay(const FStream& Stream, const int32 Iterations)
+{
+	const bool bSavedCoalesceInput = Widget->bCoalesceInput;
+	Widget->bCoalesceInput = Stream.bCoalesceInput;
+
+	FReplayResult Result;
+	for (TArray<double>& Us : Result.EventUs)
+	{
+		Us.Reserve(Stream.Events.Num() * Iterations);
+	}
+	Result.BroadcastLatencyUs.Reserve(Stream.Events.Num() * Iterations);
+	Result.FinalStates.Reserve(Iterations);
+
+	for (int32 Iteration = -1; Iteration < Iterations; ++Iteration)
+	{
+		ResetPicker(Stream.InitialColor);
+
+		for (const FEvent& Event : Stream.Events)
+		{
+			NumBroadcasts = 0;
+			const uint64 StartCycles = FPlatformTime::Cycles64();
+			Dispatch(Event);
+			const uint64 EndCycles = FPlatformTime::Cycles64();
+
+			if (Iteration < 0)
+				continue;
+
+			Result.EventUs[(uint8)Event.Type].Add(FPlatformTime::ToSeconds64(EndCycles - StartCycles) * 1.0e6);
+			if (NumBroadcasts > 0)
+				Result.BroadcastLatencyUs.Add(FPlatformTime::ToSeconds64(FirstBroadcastCycles - StartCycles) * 1.0e6);
+		}
+
+		if (Iteration >= 0)
+			Result.FinalStates.Add({ Widget->CurrentHue, Widget->CurrentSaturation, Widget->CurrentValue, SRGBTransfer::ToFColor(Widget->CurrentColor) });
+	}
+
+	ResetPicker(Stream.InitialColor);
+	Widget->bCoalesceInput = bSavedCoalesceInput;
+
+	for (TArray<double>& Us : Result.EventUs)
+	{
+		Us.Sort();
+	}
+	Result.BroadcastLatencyUs.Sort();
+	return Result;
+}
+
+FString FColorPickerInputReplay::FindMismatch(const FStream& Stream, const FPickerState& State)
+{
+	if (!Stream.bHasExpected)
+		return FString();
+
+	if (FMath::IsNearlyEqual(State.Hue, Stream.ExpectedHue, Stream.Tolerance * 360.f) &&
+		FMath::IsNearlyEqual(State.Saturation, Stream.ExpectedSaturation, Stream.Tolerance) &&
+		FMath::IsNearlyEqual(State.Value, Stream.ExpectedValue, Stream.Tolerance) &&
+		State.Color == Stream.ExpectedColor)
+	{
+		return FString();
+	}
+
+	return FString::Printf(TEXT("ended at H %.4f S %.5f V %.5f %s, expected H %.4f S %.5f V %.5f %s"),
+		State.Hue, State.Saturation, State.Value, *ToHex(State.Color),
+		Stream.ExpectedHue, Stream.ExpectedSaturation, Stream.ExpectedValue, *ToHex(Stream.ExpectedColor));
+}
+
+FString FColorPickerInputReplay::DescribeTiming(const FStream& Stream, const FReplayResult& Result)
+{
+	const TArray<double>& MoveUs = Result.EventUs[(uint8)EEventType::Move];
+	return FString::Printf(TEXT("%s [%d events x %d]: move p50 %.2f us, p99 %.2f us, max %.2f us, event to broadcast p50 %.2f us, p99 %.2f us (%d broadcasts)"),
+		*Stream.Name, Stream.Events.Num(), Result.FinalStates.Num(), Percentile(MoveUs, 0.5), Percentile(MoveUs, 0.99), MoveUs.Num() > 0 ? MoveUs.Last() : 0.0,
+		Percentile(Result.BroadcastLatencyUs, 0.5), Percentile(Result.BroadcastLatencyUs, 0.99), Result.BroadcastLatencyUs.Num());
+}
+
+void FColorPickerInputReplay::WriteResult(const FStream& Stream, const FReplayResult& Result, const int32 Iterations, const FString& Failure, const TSharedRef<TJsonWriter<>>& Writer)
+{
+	Writer->WriteObjectStart();
+	Writer->WriteValue(TEXT("Name"), Stream.Name);
+	Writer->WriteValue(TEXT("Events"), Stream.Events.Num());
+	Writer->WriteValue(TEXT("Iterations"), Iterations);
+	Writer->WriteValue(TEXT("CoalesceInput"), Stream.bCoalesceInput);
+	Writer->WriteValue(TEXT("Checked"), Stream.bHasExpected);
+	Writer->WriteValue(TEXT("Passed"), Failure.IsEmpty());
+	if (!Failure.IsEmpty())
+		Writer->WriteValue(TEXT("Failure"), Failure);
+	if (Result.FinalStates.Num() > 0)
+		Writer->WriteValue(TEXT("FinalColor"), ToHex(Result.FinalStates.Last().Color));
+
+	Writer->WriteObjectStart(TEXT("EventProcessing"));
+	for (uint8 Type = 0; Type < (uint8)EEventType::Count; ++Type)
+	{
+		if (Result.EventUs[Type].Num() > 0)
+			WritePercentiles(Writer, EventTypeName((EEventType)Type), Result.EventUs[Type]);
+	}
+	Writer->WriteObjectEnd();
+	WritePercentiles(Writer, TEXT("EventToBroadcast"), Result.BroadcastLatencyUs);
+	Writer->WriteObjectEnd();
+}
+
+UColorPickerWidget* FColorPickerInputReplay::CreatePicker(UWorld* World, const FString& ClassPath, FString& OutError)
+{
+	if (!World)
+	{
+		OutError = TEXT("Input replay needs a world to create the picker in.");
+		return nullptr;
+	}
+
+	UClass* WidgetClass = LoadClass<UColorPickerWidget>(nullptr, *ClassPath);
+	if (!WidgetClass)
+	{
+		OutError = FString::Printf(TEXT("Input replay could not load picker class %s."), *ClassPath);
+		return nullptr;
+	}
+
+	UColorPickerWidget* Widget = CreateWidget<UColorPickerWidget>(World, WidgetClass);
+	if (!Widget)
+		OutError = FString::Printf(TEXT("Input replay could not create picker of class %s."), *ClassPath);
+	return Widget;
+}
+
+void FColorPickerInputReplay::Run(const TArray<FString>& Args, UWorld* World)
+{
+	int32 Iterations = 20;
+	FString ClassPath = DefaultWidgetClass;
+	FString OutputFile = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("ColorPicker"), FString::Printf(TEXT("InputReplay-%s.json"), *FDateTime::Now().ToString()));
+	FString SaveDir;
+	TArray<FString> StreamFiles;
+	for (const FString& Arg : Args)
+	{
+		if (!Arg.StartsWith(TEXT("-")))
+			StreamFiles.Add(Arg);
+		else if (FParse::Value(*Arg, TEXT("-Iterations="), Iterations))
+			Iterations = FMath::Max(1, Iterations);
+		else if (!FParse::Value(*Arg, TEXT("-Class="), ClassPath) && !FParse::Value(*Arg, TEXT("-Output="), OutputFile))
+			FParse::Value(*Arg, TEXT("-SaveStreams="), SaveDir);
+	}
+
+	TArray<FStream> Streams;
+	for (const FString& StreamFile : StreamFiles)
+	{
+		if (!LoadStream(StreamFile, Streams.AddDefaulted_GetRef()))
+			return;
+	}
+
+	FString Error;
+	UColorPickerWidget* Widget = CreatePicker(World, ClassPath, Error);
+	if (!Widget)
+	{
+		UE_LOG(LogColorPickerError, Error, TEXT("%s"), *Error);
+		return;
+	}
+
+	// Widget space is the window space of the harness, sized by the first stream.
+	const FVector2D Size = Streams.Num() > 0 ? Streams[0].Size : FStream().Size;
+
+	int32 NumFailed = 0;
+	FString Json;
+	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Json);
+	Writer->WriteObjectStart();
+	Writer->WriteValue(TEXT("Plugin"), TEXT("ColorPicker"));
+	Writer->WriteValue(TEXT("Timestamp"), FDateTime::UtcNow().ToIso8601());
+	Writer->WriteValue(TEXT("Platform"), ANSI_TO_TCHAR(FPlatformProperties::IniPlatformName()));
+	Writer->WriteValue(TEXT("WidgetClass"), Widget->GetClass()->GetPathName());
+	Writer->WriteArrayStart(TEXT("Streams"));
+	{
+		FColorPickerInputReplay Harness(Widget, Size);
+		if (Streams.Num() == 0)
+		{
+			for (const FString& Name : GetSyntheticStreamNames())
+			{
+				Harness.MakeSyntheticStream(Name, Streams.AddDefaulted_GetRef());
+			}
+		}
+
+		for (const FStream& Stream : Streams)
+		{
+			if (!SaveDir.IsEmpty() && !SaveStream(Stream, FPaths::Combine(SaveDir, Stream.Name + TEXT(".json"))))
+				UE_LOG(LogColorPickerWarning, Warning, TEXT("Failed to save input stream %s to %s."), *Stream.Name, *SaveDir);
+
+			// Coalesced input registers an active timer, which needs the slate application.
+			if (Stream.bCoalesceInput && !FSlateApplication::IsInitialized())
+			{
+				UE_LOG(LogColorPickerWarning, Warning, TEXT("Input replay skipped %s, coalesced input needs the slate application."), *Stream.Name);
+				continue;
+			}
+
+			if (Stream.Size != Size)
+				UE_LOG(LogColorPickerWarning, Warning, TEXT("Input replay %s was recorded at %s, replayed at %s."), *Stream.Name, *Stream.Size.ToString(), *Size.ToString());
+
+			const FReplayResult Result = Harness.Replay(Stream, Iterations);
+			FString Failure;
+			for (int32 Iteration = 0; Iteration < Result.FinalStates.Num() && Failure.IsEmpty(); ++Iteration)
+			{
+				const FString Mismatch = FindMismatch(Stream, Result.FinalStates[Iteration]);
+				if (!Mismatch.IsEmpty())
+					Failure = FString::Printf(TEXT("iteration %d %s"), Iteration, *Mismatch);
+			}
+			WriteResult(Stream, Result, Iterations, Failure, Writer);
+
+			UE_LOG(LogColorPicker, Log, TEXT("Input replay %s"), *DescribeTiming(Stream, Result));
+			if (!Failure.IsEmpty())
+			{
+				UE_LOG(LogColorPickerError, Error, TEXT("Input replay %s failed, %s."), *Stream.Name, *Failure);
+				++NumFailed;
+			}
+		}
+	}
+	Writer->WriteArrayEnd();
+	Writer->WriteValue(TEXT("Failed"), NumFailed);
+	Writer->WriteObjectEnd();
+	Writer->Close();
+
+	if (FFileHelper::SaveStringToFile(Json, *OutputFile))
+	{
+		UE_LOG(LogColorPicker, Log, TEXT("Input replay results written to %s"), *OutputFile);
+	}
+	else
+	{
+		UE_LOG(LogColorPickerError, Error, TEXT("Failed to write input replay results to %s"), *OutputFile);
+	}
+
+	if (NumFailed > 0)
+		UE_LOG(LogColorPickerError, Error, TEXT("Input replay failed %d of %d streams."), NumFailed, Streams.Num());
+}
+#pragma endregion
+
+namespace
+{
+	FAutoConsoleCommandWithWorldAndArgs InputReplayCommand(
+		TEXT("ColorPicker.InputReplay"),
+		TEXT("Replay pointer streams through an offscreen color picker, check the final color and write per event timing percentiles. The built-in streams also run as the ColorPicker.InputReplay automation tests. Usage: ColorPicker.InputReplay [StreamFile ...] [-Iterations=20] [-Class=<WidgetClass>] [-Output=<File>] [-SaveStreams=<Dir>]"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&FColorPickerInputReplay::Run));
+}
+
+#endif // !UE_BUILD_SHIPPING
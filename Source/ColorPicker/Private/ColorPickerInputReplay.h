@@ -0,0 +1,245 @@
+// Copyright kevin791129
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if !UE_BUILD_SHIPPING
+
+#include "Serialization/JsonWriter.h"
+
+class UColorPickerWidget;
+class UWorld;
+class SVirtualWindow;
+class SInvalidationPanel;
+class SPickerLayoutCounter;
+class SWidget;
+class FHittestGrid;
+
+/**
+ * Replays pointer streams through an offscreen color picker, checks the final color and reports per event processing time.
+ * The picker is laid out and painted into a virtual window without rendering, so it also runs with -nullrhi.
+ * Built-in streams run as the 'ColorPicker.InputReplay' automation tests, the console command of the same name writes timing as JSON.
+ *
+ * Usage: ColorPicker.InputReplay [StreamFile ...] [-Iterations=20] [-Class=<WidgetClass>] [-Output=<File>] [-SaveStreams=<Dir>]
+ * Without stream files, synthetic streams are generated from the picker layout: fast drags, hue and saturation value switches,
+ * capture loss mid drag and coalesced input. -SaveStreams writes them as stream files, a template for traces from field reports.
+ *
+ * Stream files are JSON, positions in slate units relative to the top left of the picker widget:
+ * { "Name": "...", "Width": 1920, "Height": 1080, "InitialColor": "#FF0000FF", "CoalesceInput": false,
+ *   "Events": [ { "Type": "Down", "X": 10, "Y": 20 }, { "Type": "Move", "X": 12, "Y": 24 }, { "Type": "Up", "X": 12, "Y": 24 },
+ *               { "Type": "CaptureLost" }, { "Type": "Frame" } ],
+ *   "Expected": { "Hue": 120, "Saturation": 0.5, "Value": 0.75, "Color": "#5FBF5FFF", "Tolerance": 0.001 } }
+ * "Frame" applies coalesced input as the per frame timer would, "Expected" is optional. Hue tolerance is scaled by 360.
+ * Results are written as JSON, by default to Saved/ColorPicker/InputReplay-<time>.json.
+ */
+class COLORPICKER_API FColorPickerInputReplay
+{
+public:
+	enum class EEventType : uint8
+	{
+		Down,
+		Move,
+		Up,
+		CaptureLost,
+		Frame,
+		Count
+	};
+
+	struct FEvent
+	{
+		EEventType Type;
+		FVector2D Position;
+	};
+
+	struct FStream
+	{
+		FString Name;
+		FVector2D Size = FVector2D(1920.f, 1080.f);
+		FLinearColor InitialColor = FLinearColor::Red;
+		bool bCoalesceInput = false;
+		TArray<FEvent> Events;
+
+		bool bHasExpected = false;
+		float ExpectedHue = 0.f;
+		float ExpectedSaturation = 0.f;
+		float ExpectedValue = 0.f;
+		FColor ExpectedColor;
+		float Tolerance = 1.e-3f;
+	};
+
+	/**
+	 * Picker state at the end of a replay.
+	 */
+	struct FPickerState
+	{
+		float Hue;
+		float Saturation;
+		float Value;
+		FColor Color;
+	};
+
+	/**
+	 * Final states and timing of replaying a stream, timing in microseconds and sorted ascending.
+	 */
+	struct FReplayResult
+	{
+		/** Final picker state of every timed iteration. */
+		TArray<FPickerState> FinalStates;
+		/** Processing time of every timed event, by event type. */
+		TArray<double> EventUs[(uint8)EEventType::Count];
+		/** Time from an event to the first broadcast it caused. */
+		TArray<double> BroadcastLatencyUs;
+	};
+
+	/**
+	 * Slate widgets of the picker parts, null where not constructed.
+	 */
+	struct FPickerWidgets
+	{
+		/** Root and picker canvases, which indicator moves must not lay out again. */
+		TArray<const SWidget*> Canvases;
+		const SWidget* HueImage = nullptr;
+		const SWidget* SaturationValueImage = nullptr;
+		const SWidget* HueIndicator = nullptr;
+		const SWidget* SaturationValueIndicator = nullptr;
+	};
+
+	/** Picker class replayed when none is given. */
+	static const TCHAR* DefaultWidgetClass;
+
+	/**
+	 * Console command entry point.
+	 */
+	static void Run(const TArray<FString>& Args, UWorld* World);
+
+	static const TCHAR* EventTypeName(const EEventType Type);
+	static bool LoadStream(const FString& Filename, FStream& OutStream);
+	static bool SaveStream(const FStream& Stream, const FString& Filename);
+
+	/**
+	 * Color as #RRGGBBAA, the format of stream files.
+	 */
+	static FString ToHex(const FColor& Color);
+
+	/**
+	 * Create picker to replay streams through.
+	 *
+	 * @param World : World owning the picker.
+	 * @param ClassPath : Picker class, a subclass of UColorPickerWidget.
+	 * @param[out] OutError : Reason if no picker was created.
+	 * @return Picker or null.
+	 */
+	static UColorPickerWidget* CreatePicker(UWorld* World, const FString& ClassPath, FString& OutError);
+
+	/**
+	 * Names of the streams 'MakeSyntheticStream' generates.
+	 */
+	static const TArray<FString>& GetSyntheticStreamNames();
+
+	/**
+	 * Describe how a final state differs from what the stream expects.
+	 *
+	 * @return Empty if the state matches or the stream has no expectation.
+	 */
+	static FString FindMismatch(const FStream& Stream, const FPickerState& State);
+
+	/**
+	 * One line summary of move and event to broadcast timing percentiles.
+	 */
+	static FString DescribeTiming(const FStream& Stream, const FReplayResult& Result);
+
+	/**
+	 * @param InWidget : Picker to replay streams through.
+	 * @param InSize : Virtual window size, widget space is window space.
+	 * @param bCachePaint : Place picker in an invalidation panel, so it is only painted again when invalidated.
+	 */
+	FColorPickerInputReplay(UColorPickerWidget* InWidget, const FVector2D& InSize, const bool bCachePaint = false);
+	~FColorPickerInputReplay();
+
+	/**
+	 * Lay out and paint picker into the virtual window, which caches the geometry input handlers hit test against.
+	 */
+	void Paint();
+
+	/**
+	 * If paint is cached by an invalidation panel, false if not requested or invalidation panels are disabled.
+	 */
+	bool IsPaintCached() const;
+
+	/**
+	 * Times the picker was painted, not counting cached paint.
+	 */
+	int32 GetNumPaints() const;
+
+	/**
+	 * Times the picker desired size was computed in a prepass and its children were arranged, not counting work an invalidation panel skipped.
+	 */
+	int32 GetNumPrepasses() const;
+	int32 GetNumArranges() const;
+
+	/**
+	 * Slate widgets of the picker canvases, gradient images and indicators, to count which of them are painted or laid out.
+	 */
+	FPickerWidgets GetPickerWidgets() const;
+
+	/**
+	 * Dispatch event to picker input handlers.
+	 */
+	void Dispatch(const FEvent& Event);
+
+	/**
+	 * Widget space position of a position in hue or saturation value picker space.
+	 */
+	FVector2D HueToWidget(const float LocalY) const;
+	FVector2D SaturationValueToWidget(const FVector2D& LocalPosition) const;
+
+	/**
+	 * Generate a synthetic stream from the current layout.
+	 *
+	 * @param Name : One of 'GetSyntheticStreamNames'.
+	 * @param[out] OutStream : Generated stream.
+	 * @return False if Name is not a synthetic stream.
+	 */
+	bool MakeSyntheticStream(const FString& Name, FStream& OutStream) const;
+
+	/**
+	 * Replay stream Iterations times after an untimed warm up.
+	 */
+	FReplayResult Replay(const FStream& Stream, const int32 Iterations);
+
+private:
+	/**
+	 * Picker state from position in hue or saturation value picker space, as the picker computes it.
+	 */
+	void ExpectHue(FStream& Stream, const float LocalY) const;
+	void ExpectSaturationValue(FStream& Stream, const FVector2D& LocalPosition) const;
+	void ExpectColor(FStream& Stream) const;
+
+	/**
+	 * Write replay result of a stream as a JSON object.
+	 */
+	static void WriteResult(const FStream& Stream, const FReplayResult& Result, const int32 Iterations, const FString& Failure, const TSharedRef<TJsonWriter<>>& Writer);
+
+	/**
+	 * End any interaction, then set initial color and clear history.
+	 */
+	void ResetPicker(const FLinearColor& InitialColor);
+
+	UColorPickerWidget* Widget;
+	FVector2D Size;
+	TSharedRef<SVirtualWindow> Window;
+	TSharedPtr<SInvalidationPanel> InvalidationPanel;
+	TSharedRef<SPickerLayoutCounter> LayoutCounter;
+	TSharedRef<FHittestGrid> HittestGrid;
+
+	FVector2D LastPosition = FVector2D::ZeroVector;
+	bool bButtonPressed = false;
+
+	/** Broadcasts seen by the bound listener and time of the first one since last reset. */
+	int32 NumBroadcasts = 0;
+	uint64 FirstBroadcastCycles = 0;
+	FDelegateHandle BroadcastHandle;
+};
+
+#endif // !UE_BUILD_SHIPPING
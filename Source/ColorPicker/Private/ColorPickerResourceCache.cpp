@@ -0,0 +1,158 @@
+// Copyright kevin791129
+
+#include "ColorPickerResourceCache.h"
+#include "ColorPicker.h"
+#include "ColorPickerStats.h"
+#include "Materials/MaterialInstance.h"
+#include "Materials/MaterialInstanceDynamic.h"
+#include "Misc/CoreDelegates.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectGlobals.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Material Instances Created"), STAT_ColorPickerMaterialInstancesCreated, STATGROUP_ColorPicker);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Material Instances Reused"), STAT_ColorPickerMaterialInstancesReused, STATGROUP_ColorPicker);
+DECLARE_CYCLE_STAT(TEXT("Create Material Instance"), STAT_ColorPickerCreateMaterialInstance, STATGROUP_ColorPicker);
+
+namespace
+{
+	TUniquePtr<FColorPickerResourceCache> ResourceCache;
+}
+
+void FColorPickerResourceCache::Startup()
+{
+	FColorPickerResourceCache& Cache = Get();
+
+	// Module loads before UObjects and plugin content are ready.
+	if (UObjectInitialized())
+	{
+		Cache.ResolveMaterials();
+	}
+	else if (!Cache.PostEngineInitHandle.IsValid())
+	{
+		Cache.PostEngineInitHandle = FCoreDelegates::OnPostEngineInit.AddLambda([]()
+		{
+			if (ResourceCache)
+				ResourceCache->ResolveMaterials();
+		});
+	}
+}
+
+void FColorPickerResourceCache::Shutdown()
+{
+	if (ResourceCache && ResourceCache->PostEngineInitHandle.IsValid())
+		FCoreDelegates::OnPostEngineInit.Remove(ResourceCache->PostEngineInitHandle);
+
+	ResourceCache.Reset();
+}
+
+FColorPickerResourceCache& FColorPickerResourceCache::Get()
+{
+	if (!ResourceCache)
+		ResourceCache = MakeUnique<FColorPickerResourceCache>();
+
+	return *ResourceCache;
+}
+
+FColorPickerResourceCache* FColorPickerResourceCache::TryGet()
+{
+	return ResourceCache.Get();
+}
+
+UMaterialInstance* FColorPickerResourceCache::GetSaturationValueMaterial()
+{
+	ResolveMaterials();
+	return SaturationValueMaterial;
+}
+
+UMaterialInstance* FColorPickerResourceCache::GetSaturationValueIndicatorMaterial()
+{
+	ResolveMaterials();
+	return SaturationValueIndicatorMaterial;
+}
+
+UMaterialInstanceDynamic* FColorPickerResourceCache::AcquireMaterialInstance(UMaterialInterface* Parent)
+{
+	if (!Parent)
+		return nullptr;
+
+	for (FMaterialInstancePool& Pool : Pools)
+	{
+		if (Pool.Parent == Parent && Pool.Instances.Num() > 0)
+		{
+			COLORPICKER_INC_COUNTER(STAT_ColorPickerMaterialInstancesReused, MaterialInstancesReused, 1);
+			return Pool.Instances.Pop(false);
+		}
+	}
+
+	// Outered to transient package so instance can outlive the widget that created it.
+	COLORPICKER_SCOPE_CYCLE_COUNTER(STAT_ColorPickerCreateMaterialInstance, CreateMaterialInstance);
+	COLORPICKER_INC_COUNTER(STAT_ColorPickerMaterialInstancesCreated, MaterialInstancesCreated, 1);
+	return UMaterialInstanceDynamic::Create(Parent, GetTransientPackage());
+}
+
+void FColorPickerResourceCache::ReleaseMaterialInstance(UMaterialInstanceDynamic* MaterialInstance)
+{
+	if (!MaterialInstance || MaterialInstance->IsPendingKillOrUnreachable())
+		return;
+
+	UMaterialInterface* Parent = MaterialInstance->Parent;
+	FMaterialInstancePool* Pool = Pools.FindByPredicate([Parent](const FMaterialInstancePool& Entry) { return Entry.Parent == Parent; });
+	if (!Pool)
+	{
+		Pool = &Pools.AddDefaulted_GetRef();
+		Pool->Parent = Parent;
+	}
+
+	if (Pool->Instances.Num() >= MaxPooledInstances)
+		return;
+
+	// Next owner starts from parent defaults.
+	MaterialInstance->ClearParameterValues();
+	Pool->Instances.Add(MaterialInstance);
+}
+
+void FColorPickerResourceCache::AddReferencedObjects(FReferenceCollector& Collector)
+{
+	Collector.AddReferencedObject(SaturationValueMaterial);
+	Collector.AddReferencedObject(SaturationValueIndicatorMaterial);
+
+	for (FMaterialInstancePool& Pool : Pools)
+	{
+		Collector.AddReferencedObject(Pool.Parent);
+		Collector.AddReferencedObjects(Pool.Instances);
+	}
+}
+
+FString FColorPickerResourceCache::GetReferencerName() const
+{
+	return TEXT("FColorPickerResourceCache");
+}
+
+void FColorPickerResourceCache::ResolveMaterials()
+{
+	if (bMaterialsResolved || !UObjectInitialized())
+		return;
+
+	bMaterialsResolved = true;
+
+	SaturationValueMaterial = FindPluginMaterial(TEXT("/ColorPicker/Material/MI_SV_Picker.MI_SV_Picker"));
+	if (!SaturationValueMaterial)
+	{
+		UE_LOG(LogColorPickerError, Error, TEXT("Saturation and value material not found in plugin."));
+	}
+
+	SaturationValueIndicatorMaterial = FindPluginMaterial(TEXT("/ColorPicker/Material/MI_SV_Indicator.MI_SV_Indicator"));
+	if (!SaturationValueIndicatorMaterial)
+	{
+		UE_LOG(LogColorPickerError, Error, TEXT("Saturation and value indicator material not found in plugin."));
+	}
+}
+
+UMaterialInstance* FColorPickerResourceCache::FindPluginMaterial(const TCHAR* ObjectPath)
+{
+	UMaterialInstance* Material = FindObject<UMaterialInstance>(ANY_PACKAGE, ObjectPath);
+	if (!Material)
+		Material = LoadObject<UMaterialInstance>(nullptr, ObjectPath, nullptr, LOAD_NoWarn);
+
+	return Material;
+}
@@ -0,0 +1,102 @@
+// Copyright kevin791129
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/GCObject.h"
+
+class UMaterialInterface;
+class UMaterialInstance;
+class UMaterialInstanceDynamic;
+
+/**
+ * Plugin materials shared by every color picker widget, resolved once and kept alive for the lifetime of the module.
+ * Also pools dynamic material instances released by widgets so screens creating and recycling many pickers do not create a new instance each time.
+ */
+class FColorPickerResourceCache : public FGCObject
+{
+public:
+	/** Maximum number of released instances kept per parent material. */
+	static constexpr int32 MaxPooledInstances = 64;
+
+	/**
+	 * Create the cache, resolving plugin materials now if UObjects are ready, otherwise after engine init.
+	 */
+	static void Startup();
+
+	/**
+	 * Destroy the cache, pooled instances are left to garbage collection.
+	 */
+	static void Shutdown();
+
+	/**
+	 * Get the cache, created on demand if module startup was skipped.
+	 */
+	static FColorPickerResourceCache& Get();
+
+	/**
+	 * Get the cache only if it exists.
+	 */
+	static FColorPickerResourceCache* TryGet();
+
+	/**
+	 * Saturation and value picker material, null if missing from plugin.
+	 */
+	UMaterialInstance* GetSaturationValueMaterial();
+
+	/**
+	 * Saturation and value indicator material, null if missing from plugin.
+	 */
+	UMaterialInstance* GetSaturationValueIndicatorMaterial();
+
+	/**
+	 * Take a dynamic material instance of parent from pool, or create one if pool is empty.
+	 *
+	 * @param Parent : Parent material.
+	 * @return Dynamic material instance with parent default parameters, null if parent is null.
+	 */
+	UMaterialInstanceDynamic* AcquireMaterialInstance(UMaterialInterface* Parent);
+
+	/**
+	 * Return a dynamic material instance to pool, parameters are reset to parent defaults.
+	 *
+	 * @param MaterialInstance : Instance previously acquired, may be null.
+	 */
+	void ReleaseMaterialInstance(UMaterialInstanceDynamic* MaterialInstance);
+
+	//~ Begin FGCObject Interface
+	virtual void AddReferencedObjects(FReferenceCollector& Collector) override;
+	virtual FString GetReferencerName() const override;
+	//~ End FGCObject Interface
+
+private:
+	/**
+	 * Resolve plugin materials, does nothing once resolved.
+	 */
+	void ResolveMaterials();
+
+	/**
+	 * Find plugin material, loading it if not in memory.
+	 */
+	static UMaterialInstance* FindPluginMaterial(const TCHAR* ObjectPath);
+
+	/** Released instances of one parent material. */
+	struct FMaterialInstancePool
+	{
+		UMaterialInterface* Parent;
+		TArray<UMaterialInstanceDynamic*> Instances;
+	};
+
+	/** Saturation and value picker material. */
+	UMaterialInstance* SaturationValueMaterial = nullptr;
+	/** Saturation and value indicator material. */
+	UMaterialInstance* SaturationValueIndicatorMaterial = nullptr;
+	/** If plugin materials have been resolved. */
+	bool bMaterialsResolved = false;
+
+	/** Released instances by parent material, only a couple of parents are ever used. */
+	TArray<FMaterialInstancePool> Pools;
+
+	/** Handle of deferred material resolution. */
+	FDelegateHandle PostEngineInitHandle;
+};
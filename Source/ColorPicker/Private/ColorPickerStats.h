@@ -0,0 +1,34 @@
+// Copyright kevin791129
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ColorPicker.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+/** CSV profiler category of the plugin, enable with -csvCategories=ColorPicker or csvprofile category ColorPicker. */
+CSV_DECLARE_CATEGORY_EXTERN(ColorPicker);
+
+/**
+ * Time a scope as a cycle stat of STATGROUP_ColorPicker, a CSV stat and an Unreal Insights CPU event.
+ * Stats are compiled out of test and shipping builds, CSV stats and trace events are not, so hitches can be attributed there too.
+ *
+ * @param Stat : Cycle stat declared with DECLARE_CYCLE_STAT.
+ * @param Name : CSV stat name, trace event is named ColorPicker_<Name>.
+ */
+#define COLORPICKER_SCOPE_CYCLE_COUNTER(Stat, Name) \
+	SCOPE_CYCLE_COUNTER(Stat); \
+	CSV_SCOPED_TIMING_STAT(ColorPicker, Name); \
+	TRACE_CPUPROFILER_EVENT_SCOPE(ColorPicker_##Name)
+
+/**
+ * Add to a per frame counter, both a counter stat of STATGROUP_ColorPicker and an accumulated CSV stat.
+ *
+ * @param Stat : Counter stat declared with DECLARE_DWORD_COUNTER_STAT.
+ * @param Name : CSV stat name.
+ * @param Amount : Amount added.
+ */
+#define COLORPICKER_INC_COUNTER(Stat, Name, Amount) \
+	INC_DWORD_STAT_BY(Stat, Amount); \
+	CSV_CUSTOM_STAT(ColorPicker, Name, (int32)(Amount), ECsvCustomStatOp::Accumulate)
@@ -0,0 +1,255 @@
+// Copyright kevin791129
+
+#include "CoreMinimal.h"
+
+#if !UE_BUILD_SHIPPING
+
+#include "UMG/ColorPickerWidget.h"
+#include "Slate/SColorPickerSurface.h"
+#include "ColorPicker.h"
+#include "Blueprint/UserWidget.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "Input/HittestGrid.h"
+#include "Misc/App.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Rendering/DrawElements.h"
+#include "Serialization/JsonWriter.h"
+#include "Widgets/Layout/SUniformGridPanel.h"
+#include "Widgets/SVirtualWindow.h"
+
+/**
+ * Compares many SColorPickerSurface widgets against as many UMG pickers, laid out in a grid and painted into a virtual window.
+ *
+ * Usage: ColorPicker.SurfaceBenchmark [-Count=100] [-Frames=100] [-Class=<WidgetClass>] [-Output=<File>]
+ * Each kind is measured idle and with every picker changing color every frame. Reported per frame are the widgets in the tree, the draw
+ * elements painted, which bound the render batches, and median and p99 prepass plus paint time. Nothing is rendered, so it also runs
+ * with -nullrhi and render batch counts are left to 'stat slate' in a running game.
+ * Results are written as JSON, by default to Saved/ColorPicker/SurfaceBenchmark-<time>.json.
+ */
+namespace ColorPickerSurfaceBenchmark
+{
+	const TCHAR* DefaultWidgetClass = TEXT("/ColorPicker/Widget/ColorPickerWidget_BP.ColorPickerWidget_BP_C");
+	constexpr int32 GridColumns = 10;
+
+	struct FFrameResult
+	{
+		double MedianMs = 0.0;
+		double P99Ms = 0.0;
+		int32 DrawElements = 0;
+	};
+
+	int32 CountWidgets(const TSharedRef<SWidget>& Widget)
+	{
+		int32 Count = 1;
+		FChildren* Children = Widget->GetChildren();
+		for (int32 Index = 0; Index < Children->Num(); ++Index)
+		{
+			Count += CountWidgets(Children->GetChildAt(Index));
+		}
+		return Count;
+	}
+
+	FLinearColor MakeFrameColor(const int32 Frame, const int32 Picker)
+	{
+		const float Hue = (float)((Frame * 7 + Picker * 13) % 360);
+		return FLinearColor(Hue, 0.75f, 0.75f).HSVToLinearRGB();
+	}
+
+	/**
+	 * Prepass and paint window for a number of frames.
+	 *
+	 * @param Window : Window holding the pickers.
+	 * @param Size : Window size.
+	 * @param Frames : Frames to measure.
+	 * @param SetColors : Optional, called before each frame with the frame index.
+	 * @return Frame times and draw elements of the last frame.
+	 */
+	FFrameResult MeasureFrames(const TSharedRef<SVirtualWindow>& Window, const FVector2D& Size, const int32 Frames, TFunctionRef<void(int32)> SetColors)
+	{
+		const FGeometry WindowGeometry = FGeometry::MakeRoot(Size, FSlateLayoutTransform());
+		FHittestGrid HittestGrid;
+		HittestGrid.SetHittestArea(FVector2D::ZeroVector, Size);
+
+		FFrameResult Result;
+		TArray<double> FrameMs;
+		FrameMs.Reserve(Frames);
+		// First frame warms up caches and text shaping, not measured.
+		for (int32 Frame = -1; Frame < Frames; ++Frame)
+		{
+			SetColors(Frame + 1);
+
+			const double Start = FPlatformTime::Seconds();
+			Window->SlatePrepass(1.f);
+			FSlateWindowElementList ElementList(Window);
+			FPaintArgs PaintArgs(nullptr, HittestGrid, FVector2D::ZeroVector, FApp::GetCurrentTime(), (float)FApp::GetDeltaTime());
+			Window->Paint(PaintArgs, WindowGeometry, WindowGeometry.GetLayoutBoundingRect(), ElementList, 0, FWidgetStyle(), Window->IsEnabled());
+			const double Elapsed = (FPlatformTime::Seconds() - Start) * 1000.0;
+
+			if (Frame >= 0)
+				FrameMs.Add(Elapsed);
+			Result.DrawElements = ElementList.GetUncachedDrawElements().Num();
+		}
+
+		FrameMs.Sort();
+		if (FrameMs.Num() > 0)
+		{
+			Result.MedianMs = FrameMs[FrameMs.Num() / 2];
+			Result.P99Ms = FrameMs[FMath::Min(FrameMs.Num() - 1, (int32)(FrameMs.Num() * 0.99))];
+		}
+		return Result;
+	}
+
+	void WriteFrameResult(const TCHAR* Name, const FFrameResult& Result, TSharedRef<TJsonWriter<>>& Writer)
+	{
+		Writer->WriteObjectStart(Name);
+		Writer->WriteValue(TEXT("DrawElements"), Result.DrawElements);
+		Writer->WriteValue(TEXT("MedianMs"), Result.MedianMs);
+		Writer->WriteValue(TEXT("P99Ms"), Result.P99Ms);
+		Writer->WriteObjectEnd();
+	}
+
+	/**
+	 * Measure a grid of pickers idle and changing color, then write results.
+	 *
+	 * @param Name : Picker kind.
+	 * @param Pickers : Picker slate widgets.
+	 * @param PickerSize : Size of a grid cell.
+	 * @param SetColor : Set color of a picker by index.
+	 */
+	void MeasurePickers(const TCHAR* Name, const TArray<TSharedRef<SWidget>>& Pickers, const FVector2D& PickerSize, const int32 Frames,
+		TFunctionRef<void(int32, const FLinearColor&)> SetColor, TSharedRef<TJsonWriter<>>& Writer)
+	{
+		TSharedRef<SUniformGridPanel> Grid = SNew(SUniformGridPanel);
+		for (int32 Index = 0; Index < Pickers.Num(); ++Index)
+		{
+			Grid->AddSlot(Index % GridColumns, Index / GridColumns)
+			[
+				Pickers[Index]
+			];
+		}
+
+		const int32 Rows = FMath::DivideAndRoundUp(Pickers.Num(), GridColumns);
+		const FVector2D Size(PickerSize.X * FMath::Min(Pickers.Num(), GridColumns), PickerSize.Y * Rows);
+		TSharedRef<SVirtualWindow> Window = SNew(SVirtualWindow).Size(Size);
+		Window->SetContent(Grid);
+
+		const int32 Widgets = CountWidgets(Grid);
+		const FFrameResult Idle = MeasureFrames(Window, Size, Frames, [](int32) {});
+		const FFrameResult Animated = MeasureFrames(Window, Size, Frames, [&Pickers, &SetColor](const int32 Frame)
+		{
+			for (int32 Index = 0; Index < Pickers.Num(); ++Index)
+			{
+				SetColor(Index, MakeFrameColor(Frame, Index));
+			}
+		});
+
+		Window->SetContent(SNullWidget::NullWidget);
+
+		UE_LOG(LogColorPicker, Log, TEXT("Surface benchmark %s [%d pickers]: %d widgets, idle %d draw elements %.3f ms, animated %d draw elements %.3f ms (p99 %.3f ms)"),
+			Name, Pickers.Num(), Widgets, Idle.DrawElements, Idle.MedianMs, Animated.DrawElements, Animated.MedianMs, Animated.P99Ms);
+
+		Writer->WriteObjectStart();
+		Writer->WriteValue(TEXT("Name"), Name);
+		Writer->WriteValue(TEXT("Pickers"), Pickers.Num());
+		Writer->WriteValue(TEXT("Widgets"), Widgets);
+		WriteFrameResult(TEXT("Idle"), Idle, Writer);
+		WriteFrameResult(TEXT("Animated"), Animated, Writer);
+		Writer->WriteObjectEnd();
+	}
+
+	void Run(const TArray<FString>& Args, UWorld* World)
+	{
+		int32 Count = 100;
+		int32 Frames = 100;
+		FString ClassPath = DefaultWidgetClass;
+		FString OutputFile = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("ColorPicker"), FString::Printf(TEXT("SurfaceBenchmark-%s.json"), *FDateTime::Now().ToString()));
+		for (const FString& Arg : Args)
+		{
+			if (FParse::Value(*Arg, TEXT("-Count="), Count))
+				Count = FMath::Max(1, Count);
+			else if (FParse::Value(*Arg, TEXT("-Frames="), Frames))
+				Frames = FMath::Max(1, Frames);
+			else if (!FParse::Value(*Arg, TEXT("-Class="), ClassPath))
+				FParse::Value(*Arg, TEXT("-Output="), OutputFile);
+		}
+
+		// Same layout as the default UMG picker: 400 x 300 saturation value picker, 20 spacing, 30 wide hue strip.
+		const FVector2D PickerSize(450.f, 300.f);
+
+		FString Json;
+		TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Json);
+		Writer->WriteObjectStart();
+		Writer->WriteValue(TEXT("Plugin"), TEXT("ColorPicker"));
+		Writer->WriteValue(TEXT("Timestamp"), FDateTime::UtcNow().ToIso8601());
+		Writer->WriteValue(TEXT("Platform"), ANSI_TO_TCHAR(FPlatformProperties::IniPlatformName()));
+		Writer->WriteValue(TEXT("Frames"), Frames);
+		Writer->WriteArrayStart(TEXT("Results"));
+		{
+			TArray<TSharedRef<SColorPickerSurface>> Surfaces;
+			TArray<TSharedRef<SWidget>> Pickers;
+			for (int32 Index = 0; Index < Count; ++Index)
+			{
+				TSharedRef<SColorPickerSurface> Surface = SNew(SColorPickerSurface)
+					.Color(MakeFrameColor(0, Index))
+					.DesiredSize(PickerSize);
+				Surfaces.Add(Surface);
+				Pickers.Add(Surface);
+			}
+			MeasurePickers(TEXT("Surface"), Pickers, PickerSize, Frames, [&Surfaces](const int32 Index, const FLinearColor& Color)
+			{
+				Surfaces[Index]->SetColor(Color);
+			}, Writer);
+		}
+
+		UClass* WidgetClass = World ? LoadClass<UColorPickerWidget>(nullptr, *ClassPath) : nullptr;
+		if (WidgetClass)
+		{
+			TArray<UColorPickerWidget*> Widgets;
+			TArray<TSharedRef<SWidget>> Pickers;
+			for (int32 Index = 0; Index < Count; ++Index)
+			{
+				UColorPickerWidget* Widget = CreateWidget<UColorPickerWidget>(World, WidgetClass);
+				if (!Widget)
+					break;
+
+				Widget->SetPickerColor(MakeFrameColor(0, Index));
+				Widgets.Add(Widget);
+				Pickers.Add(Widget->TakeWidget());
+			}
+			MeasurePickers(TEXT("UMG"), Pickers, PickerSize, Frames, [&Widgets](const int32 Index, const FLinearColor& Color)
+			{
+				Widgets[Index]->SetPickerColor(Color);
+			}, Writer);
+
+			for (UColorPickerWidget* Widget : Widgets)
+			{
+				Widget->ReleaseSlateResources(true);
+			}
+		}
+		else
+		{
+			UE_LOG(LogColorPickerWarning, Warning, TEXT("Surface benchmark could not create UMG pickers of %s, only surfaces were measured."), *ClassPath);
+		}
+		Writer->WriteArrayEnd();
+		Writer->WriteObjectEnd();
+		Writer->Close();
+
+		if (FFileHelper::SaveStringToFile(Json, *OutputFile))
+		{
+			UE_LOG(LogColorPicker, Log, TEXT("Surface benchmark results written to %s"), *OutputFile);
+		}
+		else
+		{
+			UE_LOG(LogColorPickerError, Error, TEXT("Failed to write surface benchmark results to %s"), *OutputFile);
+		}
+	}
+
+	FAutoConsoleCommandWithWorldAndArgs SurfaceBenchmarkCommand(
+		TEXT("ColorPicker.SurfaceBenchmark"),
+		TEXT("Compare native color picker surfaces against UMG color pickers in a grid, writing widget counts, draw elements and frame times. Usage: ColorPicker.SurfaceBenchmark [-Count=100] [-Frames=100] [-Class=<WidgetClass>] [-Output=<File>]"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&Run));
+}
+
+#endif // !UE_BUILD_SHIPPING
@@ -0,0 +1,605 @@
+// Copyright kevin791129
+
+#include "ColorSwatchLibrary.h"
+#include "ColorPicker.h"
+#include "ColorPickerBPLibrary.h"
+#include "ColorConversionKernels.h"
+#include "SRGBTransfer.h"
+#include "Async/MappedFileHandle.h"
+#include "HAL/PlatformFilemanager.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+namespace
+{
+	/** 'CPSW' in file byte order. */
+	constexpr uint32 FileMagic = 0x57535043;
+	constexpr uint16 FileVersion = 1;
+	/** Blocks start at multiples of this, so they can be read in place. */
+	constexpr uint64 BlockAlignment = 8;
+	constexpr uint32 EmptyHashSlot = MAX_uint32;
+
+	struct FFileHeader
+	{
+		uint32 Magic;
+		uint16 Version;
+		uint8 Storage;
+		uint8 Reserved;
+		uint32 NumSwatches;
+		uint32 NumNames;
+		uint32 NamePoolSize;
+		uint32 NameHashSize;
+		uint64 ColorsOffset;
+		uint64 NameIdsOffset;
+		uint64 NameOffsetsOffset;
+		uint64 NamePoolOffset;
+		uint64 NameHashOffset;
+		/** 0 if absent. */
+		uint64 HSVOffset;
+		/** 0 if absent. */
+		uint64 LabOffset;
+	};
+	static_assert(sizeof(FFileHeader) == 80, "Swatch library header layout changed.");
+
+	FORCEINLINE uint32 ColorSize(const EColorSwatchStorage Storage)
+	{
+		return Storage == EColorSwatchStorage::CSS_FLOAT16 ? sizeof(FFloat16Color) : 4;
+	}
+
+	/** FNV-1a, stable across platforms since it is stored in files. */
+	uint32 HashName(const ANSICHAR* Name, const int32 Length)
+	{
+		uint32 Hash = 2166136261u;
+		for (int32 Index = 0; Index < Length; ++Index)
+		{
+			Hash = (Hash ^ (uint8)Name[Index]) * 16777619u;
+		}
+		return Hash;
+	}
+
+	/**
+	 * HSV of a float16 stored color, in float precision like the library does with EColorPrecision::CP_FLOAT.
+	 */
+	void LinearToHSVReal(const FLinearColor& Color, float& OutH, float& OutS, float& OutV)
+	{
+		ColorMath::RGBToHSV(ColorMath::SRGB::EncodeReal(Color.R), ColorMath::SRGB::EncodeReal(Color.G), ColorMath::SRGB::EncodeReal(Color.B), OutH, OutS, OutV);
+	}
+
+	FORCEINLINE uint16 PackUnit(const float Value)
+	{
+		return (uint16)(FMath::Clamp(Value, 0.f, 1.f) * 65535.f + 0.5f);
+	}
+
+	FORCEINLINE uint64 AlignBlock(const uint64 Offset)
+	{
+		return Align(Offset, BlockAlignment);
+	}
+}
+
+#pragma region Library
+FColorSwatchLibrary::FColorSwatchLibrary() = default;
+
+FColorSwatchLibrary::~FColorSwatchLibrary()
+{
+	Close();
+}
+
+bool FColorSwatchLibrary::Open(const FString& Filename)
+{
+	Close();
+
+	MappedFile.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*Filename));
+	if (MappedFile.IsValid() && MappedFile->GetFileSize() >= (int64)sizeof(FFileHeader))
+	{
+		MappedRegion.Reset(MappedFile->MapRegion(0, MappedFile->GetFileSize()));
+		if (MappedRegion.IsValid())
+		{
+			if (Parse(MappedRegion->GetMappedPtr(), MappedRegion->GetMappedSize()))
+				return true;
+
+			UE_LOG(LogColorPickerError, Error, TEXT("%s is not a valid swatch library."), *Filename);
+			Close();
+			return false;
+		}
+	}
+	Close();
+
+	// Mapping is unsupported on some platforms and file systems.
+	TArray<uint8> FileData;
+	if (!FFileHelper::LoadFileToArray(FileData, *Filename))
+	{
+		UE_LOG(LogColorPickerError, Error, TEXT("Failed to read swatch library %s."), *Filename);
+		return false;
+	}
+
+	if (Open(MoveTemp(FileData)))
+		return true;
+
+	UE_LOG(LogColorPickerError, Error, TEXT("%s is not a valid swatch library."), *Filename);
+	return false;
+}
+
+bool FColorSwatchLibrary::Open(TArray<uint8>&& InData)
+{
+	Close();
+
+	OwnedData = MoveTemp(InData);
+	if (Parse(OwnedData.GetData(), OwnedData.Num()))
+		return true;
+
+	Close();
+	return false;
+}
+
+void FColorSwatchLibrary::Close()
+{
+	// Region has to be unmapped before its file is closed.
+	MappedRegion.Reset();
+	MappedFile.Reset();
+	OwnedData.Empty();
+
+	Data = nullptr;
+	DataSize = 0;
+	NumSwatches = 0;
+	NumNames = 0;
+	ColorBlock = nullptr;
+	NameIds = nullptr;
+	NameOffsets = nullptr;
+	NamePool = nullptr;
+	NamePoolSize = 0;
+	NameHash = nullptr;
+	NameHashMask = 0;
+	HSVBlock = nullptr;
+	LabBlock = nullptr;
+}
+
+bool FColorSwatchLibrary::Parse(const uint8* InData, const int64 InDataSize)
+{
+	if (!InData || InDataSize < (int64)sizeof(FFileHeader) || !IsAligned(InData, BlockAlignment))
+		return false;
+
+	FFileHeader Header;
+	FMemory::Memcpy(&Header, InData, sizeof(Header));
+	if (Header.Magic != FileMagic || Header.Version != FileVersion || Header.Storage > (uint8)EColorSwatchStorage::CSS_FLOAT16)
+		return false;
+
+	// Counts must fit int32 indices, a name table needs a swatch and the hash table needs free slots.
+	if (Header.NumSwatches > (uint32)MAX_int32 || Header.NumNames > Header.NumSwatches || (Header.NumNames == 0) != (Header.NumSwatches == 0))
+		return false;
+	if (Header.NumNames > 0 && (!FMath::IsPowerOfTwo(Header.NameHashSize) || Header.NameHashSize <= Header.NumNames))
+		return false;
+
+	const uint64 Size = (uint64)InDataSize;
+	auto IsValidBlock = [Size](const uint64 Offset, const uint64 BlockSize)
+	{
+		return Offset >= sizeof(FFileHeader) && Offset % BlockAlignment == 0 && Offset <= Size && BlockSize <= Size - Offset;
+	};
+
+	const EColorSwatchStorage InStorage = (EColorSwatchStorage)Header.Storage;
+	const uint64 NumSwatches64 = Header.NumSwatches;
+	if (!IsValidBlock(Header.ColorsOffset, NumSwatches64 * ColorSize(InStorage)) ||
+		!IsValidBlock(Header.NameIdsOffset, NumSwatches64 * sizeof(uint32)) ||
+		!IsValidBlock(Header.NameOffsetsOffset, ((uint64)Header.NumNames + 1) * sizeof(uint32)) ||
+		!IsValidBlock(Header.NamePoolOffset, Header.NamePoolSize) ||
+		!IsValidBlock(Header.NameHashOffset, (uint64)Header.NameHashSize * sizeof(uint32)))
+		return false;
+	if ((Header.HSVOffset != 0 && !IsValidBlock(Header.HSVOffset, NumSwatches64 * 3 * sizeof(uint16))) ||
+		(Header.LabOffset != 0 && !IsValidBlock(Header.LabOffset, NumSwatches64 * 3 * sizeof(uint16))))
+		return false;
+
+	// Only the table ends are checked here, names and ids are bounds checked when read so opening stays O(1).
+	const uint32* InNameOffsets = (const uint32*)(InData + Header.NameOffsetsOffset);
+	if (InNameOffsets[0] != 0 || InNameOffsets[Header.NumNames] != Header.NamePoolSize)
+		return false;
+
+	Data = InData;
+	DataSize = InDataSize;
+	NumSwatches = (int32)Header.NumSwatches;
+	NumNames = (int32)Header.NumNames;
+	Storage = InStorage;
+	ColorBlock = InData + Header.ColorsOffset;
+	NameIds = (const uint32*)(InData + Header.NameIdsOffset);
+	NameOffsets = InNameOffsets;
+	NamePool = (const ANSICHAR*)(InData + Header.NamePoolOffset);
+	NamePoolSize = Header.NamePoolSize;
+	NameHash = (const uint32*)(InData + Header.NameHashOffset);
+	NameHashMask = Header.NameHashSize > 0 ? Header.NameHashSize - 1 : 0;
+	HSVBlock = Header.HSVOffset != 0 ? (const uint16*)(InData + Header.HSVOffset) : nullptr;
+	LabBlock = Header.LabOffset != 0 ? (const uint16*)(InData + Header.LabOffset) : nullptr;
+	return true;
+}
+
+FLinearColor FColorSwatchLibrary::GetColor(const int32 Index) const
+{
+	check(Index >= 0 && Index < NumSwatches);
+
+	if (Storage == EColorSwatchStorage::CSS_FLOAT16)
+		return FLinearColor(((const FFloat16Color*)ColorBlock)[Index]);
+
+	return SRGBTransfer::FromFColor(GetSRGBColor(Index));
+}
+
+FColor FColorSwatchLibrary::GetSRGBColor(const int32 Index) const
+{
+	check(Index >= 0 && Index < NumSwatches);
+
+	if (Storage == EColorSwatchStorage::CSS_FLOAT16)
+		return SRGBTransfer::ToFColor(GetColor(Index));
+
+	const uint8* Channels = ColorBlock + Index * 4;
+	return FColor(Channels[0], Channels[1], Channels[2], Channels[3]);
+}
+
+const ANSICHAR* FColorSwatchLibrary::GetNameUTF8(const int32 Index, int32& OutLength) const
+{
+	check(Index >= 0 && Index < NumSwatches);
+
+	OutLength = 0;
+	const uint32 NameId = NameIds[Index];
+	if (NameId >= (uint32)NumNames)
+		return NamePool;
+
+	const uint32 Begin = NameOffsets[NameId];
+	const uint32 End = NameOffsets[NameId + 1];
+	if (Begin > End || End > NamePoolSize)
+		return NamePool;
+
+	OutLength = (int32)(End - Begin);
+	return NamePool + Begin;
+}
+
+FString FColorSwatchLibrary::GetName(const int32 Index) const
+{
+	int32 Length;
+	const ANSICHAR* Name = GetNameUTF8(Index, Length);
+	const FUTF8ToTCHAR Converted(Name, Length);
+	return FString(Converted.Length(), Converted.Get());
+}
+
+void FColorSwatchLibrary::GetHSV(const int32 Index, float& OutH, float& OutS, float& OutV) const
+{
+	check(Index >= 0 && Index < NumSwatches);
+
+	if (HSVBlock)
+	{
+		const uint16* HSV = HSVBlock + Index * 3;
+		OutH = HSV[0] * (360.f / 65535.f);
+		OutS = HSV[1] * (1.f / 65535.f);
+		OutV = HSV[2] * (1.f / 65535.f);
+		return;
+	}
+
+	// 8-bit colors convert exactly like the library does with 8-bit precision.
+	if (Storage == EColorSwatchStorage::CSS_FLOAT16)
+		LinearToHSVReal(GetColor(Index), OutH, OutS, OutV);
+	else
+		ColorConversionKernels::ColorToHSV(GetSRGBColor(Index), OutH, OutS, OutV);
+}
+
+FVector FColorSwatchLibrary::GetLab(const int32 Index) const
+{
+	check(Index >= 0 && Index < NumSwatches);
+
+	if (LabBlock)
+	{
+		const FFloat16* Lab = (const FFloat16*)(LabBlock + Index * 3);
+		return FVector(Lab[0].GetFloat(), Lab[1].GetFloat(), Lab[2].GetFloat());
+	}
+
+	return ColorConversionKernels::LinearToLab(GetColor(Index));
+}
+
+int32 FColorSwatchLibrary::FindByName(const FString& Name) const
+{
+	if (NumNames == 0)
+		return INDEX_NONE;
+
+	const FTCHARToUTF8 Converted(*Name, Name.Len());
+	uint32 Slot = HashName(Converted.Get(), Converted.Length()) & NameHashMask;
+
+	// Bounded by table size so damaged files cannot loop forever.
+	for (uint32 Probe = 0; Probe <= NameHashMask; ++Probe)
+	{
+		const uint32 SwatchIndex = NameHash[Slot];
+		if (SwatchIndex == EmptyHashSlot)
+			break;
+
+		if (SwatchIndex < (uint32)NumSwatches)
+		{
+			int32 Length;
+			const ANSICHAR* SwatchName = GetNameUTF8((int32)SwatchIndex, Length);
+			if (Length == Converted.Length() && FMemory::Memcmp(SwatchName, Converted.Get(), Length) == 0)
+				return (int32)SwatchIndex;
+		}
+		Slot = (Slot + 1) & NameHashMask;
+	}
+	return INDEX_NONE;
+}
+#pragma endregion
+
+#pragma region Writer
+FColorSwatchLibraryWriter::FColorSwatchLibraryWriter()
+{
+	Reset();
+}
+
+void FColorSwatchLibraryWriter::Reserve(const int32 NumSwatches)
+{
+	Colors.Reserve(NumSwatches);
+	SwatchNames.Reserve(NumSwatches);
+}
+
+void FColorSwatchLibraryWriter::Reset()
+{
+	Colors.Reset();
+	SwatchNames.Reset();
+	NameOffsets.Reset();
+	NameOffsets.Add(0);
+	NamePool.Reset();
+	NameToId.Reset();
+}
+
+int32 FColorSwatchLibraryWriter::Add(const FString& Name, const FLinearColor& Color)
+{
+	uint32 NameId;
+	if (const uint32* ExistingId = NameToId.Find(Name))
+	{
+		NameId = *ExistingId;
+	}
+	else
+	{
+		const FTCHARToUTF8 Converted(*Name, Name.Len());
+		NameId = (uint32)NameToId.Num();
+		NameToId.Add(Name, NameId);
+		NamePool.Append(Converted.Get(), Converted.Length());
+		NameOffsets.Add((uint32)NamePool.Num());
+	}
+
+	SwatchNames.Add(NameId);
+	return Colors.Add(Color);
+}
+
+void FColorSwatchLibraryWriter::Append(const FColorSwatchLibrary& Library)
+{
+	Reserve(Num() + Library.Num());
+	for (int32 Index = 0; Index < Library.Num(); ++Index)
+	{
+		Add(Library.GetName(Index), Library.GetColor(Index));
+	}
+}
+
+bool FColorSwatchLibraryWriter::ImportJson(const FString& JsonText, FString& OutError)
+{
+	TArray<TSharedPtr<FJsonValue>> Values;
+	const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonText);
+	if (!FJsonSerializer::Deserialize(Reader, Values))
+	{
+		OutError = FString::Printf(TEXT("Invalid JSON array: %s"), *Reader->GetErrorMessage());
+		return false;
+	}
+
+	Reserve(Num() + Values.Num());
+	for (int32 Index = 0; Index < Values.Num(); ++Index)
+	{
+		const TSharedPtr<FJsonObject>* Object;
+		FString Name, Hex;
+		FLinearColor Color;
+		if (!Values[Index]->TryGetObject(Object) || !(*Object)->TryGetStringField(TEXT("Name"), Name) ||
+			!(*Object)->TryGetStringField(TEXT("Color"), Hex) || !UColorPickerBPLibrary::ParseHex(Hex, Color))
+		{
+			OutError = FString::Printf(TEXT("Swatch %d needs a \"Name\" and a hex \"Color\"."), Index);
+			return false;
+		}
+
+		Add(Name, Color);
+	}
+	return true;
+}
+
+FString FColorSwatchLibraryWriter::ExportJson() const
+{
+	FString Json;
+	const TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Json);
+	Writer->WriteArrayStart();
+	for (int32 Index = 0; Index < Colors.Num(); ++Index)
+	{
+		const uint32 NameId = SwatchNames[Index];
+		const FUTF8ToTCHAR Name(NamePool.GetData() + NameOffsets[NameId], NameOffsets[NameId + 1] - NameOffsets[NameId]);
+		const FColor Color = SRGBTransfer::ToFColor(Colors[Index]);
+
+		Writer->WriteObjectStart();
+		Writer->WriteValue(TEXT("Name"), FString(Name.Length(), Name.Get()));
+		Writer->WriteValue(TEXT("Color"), FString::Printf(TEXT("#%02X%02X%02X%02X"), Color.R, Color.G, Color.B, Color.A));
+		Writer->WriteObjectEnd();
+	}
+	Writer->WriteArrayEnd();
+	Writer->Close();
+	return Json;
+}
+
+void FColorSwatchLibraryWriter::Write(const FColorSwatchWriteSettings& Settings, TArray<uint8>& OutData) const
+{
+	const uint32 NumSwatches = (uint32)Colors.Num();
+	const uint32 NumNames = (uint32)NameToId.Num();
+	const uint32 NameHashSize = NumNames > 0 ? FMath::RoundUpToPowerOfTwo(NumNames * 2) : 0;
+
+	FFileHeader Header;
+	FMemory::Memzero(Header);
+	Header.Magic = FileMagic;
+	Header.Version = FileVersion;
+	Header.Storage = (uint8)Settings.Storage;
+	Header.NumSwatches = NumSwatches;
+	Header.NumNames = NumNames;
+	Header.NamePoolSize = (uint32)NamePool.Num();
+	Header.NameHashSize = NameHashSize;
+
+	uint64 Offset = AlignBlock(sizeof(FFileHeader));
+	auto PlaceBlock = [&Offset](const uint64 BlockSize)
+	{
+		const uint64 BlockOffset = Offset;
+		Offset = AlignBlock(Offset + BlockSize);
+		return BlockOffset;
+	};
+	Header.ColorsOffset = PlaceBlock((uint64)NumSwatches * ColorSize(Settings.Storage));
+	Header.NameIdsOffset = PlaceBlock((uint64)NumSwatches * sizeof(uint32));
+	Header.NameOffsetsOffset = PlaceBlock(((uint64)NumNames + 1) * sizeof(uint32));
+	Header.NamePoolOffset = PlaceBlock(Header.NamePoolSize);
+	Header.NameHashOffset = PlaceBlock((uint64)NameHashSize * sizeof(uint32));
+	Header.HSVOffset = Settings.bIncludeHSV ? PlaceBlock((uint64)NumSwatches * 3 * sizeof(uint16)) : 0;
+	Header.LabOffset = Settings.bIncludeLab ? PlaceBlock((uint64)NumSwatches * 3 * sizeof(uint16)) : 0;
+
+	checkf(Offset <= (uint64)MAX_int32, TEXT("Swatch library too large."));
+	OutData.SetNumZeroed((int32)Offset);
+	uint8* Out = OutData.GetData();
+	FMemory::Memcpy(Out, &Header, sizeof(Header));
+	FMemory::Memcpy(Out + Header.NameIdsOffset, SwatchNames.GetData(), NumSwatches * sizeof(uint32));
+	FMemory::Memcpy(Out + Header.NameOffsetsOffset, NameOffsets.GetData(), ((uint64)NumNames + 1) * sizeof(uint32));
+	FMemory::Memcpy(Out + Header.NamePoolOffset, NamePool.GetData(), Header.NamePoolSize);
+
+	// Precomputed blocks are derived from stored colors, so they match what the reader computes without them.
+	uint16* HSVBlock = Settings.bIncludeHSV ? (uint16*)(Out + Header.HSVOffset) : nullptr;
+	FFloat16* LabBlock = Settings.bIncludeLab ? (FFloat16*)(Out + Header.LabOffset) : nullptr;
+	for (uint32 Index = 0; Index < NumSwatches; ++Index)
+	{
+		FLinearColor Color;
+		FColor SRGBColor;
+		if (Settings.Storage == EColorSwatchStorage::CSS_FLOAT16)
+		{
+			const FFloat16Color Stored(Colors[Index]);
+			FMemory::Memcpy(Out + Header.ColorsOffset + Index * sizeof(FFloat16Color), &Stored, sizeof(Stored));
+			Color = FLinearColor(Stored);
+			SRGBColor = SRGBTransfer::ToFColor(Color);
+		}
+		else
+		{
+			SRGBColor = SRGBTransfer::ToFColor(Colors[Index]);
+			uint8* Channels = Out + Header.ColorsOffset + Index * 4;
+			Channels[0] = SRGBColor.R;
+			Channels[1] = SRGBColor.G;
+			Channels[2] = SRGBColor.B;
+			Channels[3] = SRGBColor.A;
+			Color = SRGBTransfer::FromFColor(SRGBColor);
+		}
+
+		if (HSVBlock)
+		{
+			float H, S, V;
+			if (Settings.Storage == EColorSwatchStorage::CSS_FLOAT16)
+				LinearToHSVReal(Color, H, S, V);
+			else
+				ColorConversionKernels::ColorToHSV(SRGBColor, H, S, V);
+			HSVBlock[Index * 3 + 0] = PackUnit(H / 360.f);
+			HSVBlock[Index * 3 + 1] = PackUnit(S);
+			HSVBlock[Index * 3 + 2] = PackUnit(V);
+		}
+
+		if (LabBlock)
+		{
+			const FVector Lab = ColorConversionKernels::LinearToLab(Color);
+			LabBlock[Index * 3 + 0] = FFloat16(Lab.X);
+			LabBlock[Index * 3 + 1] = FFloat16(Lab.Y);
+			LabBlock[Index * 3 + 2] = FFloat16(Lab.Z);
+		}
+	}
+
+	// First swatch of every name, linear probing.
+	uint32* NameHash = (uint32*)(Out + Header.NameHashOffset);
+	FMemory::Memset(NameHash, 0xFF, (SIZE_T)NameHashSize * sizeof(uint32));
+	TBitArray<> bNameHashed(false, NumNames);
+	for (uint32 Index = 0; Index < NumSwatches; ++Index)
+	{
+		const uint32 NameId = SwatchNames[Index];
+		if (bNameHashed[NameId])
+			continue;
+
+		bNameHashed[NameId] = true;
+		uint32 Slot = HashName(NamePool.GetData() + NameOffsets[NameId], NameOffsets[NameId + 1] - NameOffsets[NameId]) & (NameHashSize - 1);
+		while (NameHash[Slot] != EmptyHashSlot)
+		{
+			Slot = (Slot + 1) & (NameHashSize - 1);
+		}
+		NameHash[Slot] = Index;
+	}
+}
+
+bool FColorSwatchLibraryWriter::Save(const FString& Filename, const FColorSwatchWriteSettings& Settings) const
+{
+	TArray<uint8> FileData;
+	Write(Settings, FileData);
+	return FFileHelper::SaveArrayToFile(FileData, *Filename);
+}
+#pragma endregion
+
+#if !UE_BUILD_SHIPPING
+namespace
+{
+	/**
+	 * Convert between JSON and binary swatch libraries, direction follows the input extension.
+	 * Usage: ColorPicker.ConvertSwatches <Input.json|Input.cpsw> <Output> [Float16] [HSV] [Lab]
+	 */
+	void ConvertSwatches(const TArray<FString>& Args)
+	{
+		if (Args.Num() < 2)
+		{
+			UE_LOG(LogColorPickerWarning, Warning, TEXT("Usage: ColorPicker.ConvertSwatches <Input.json|Input.cpsw> <Output> [Float16] [HSV] [Lab]"));
+			return;
+		}
+
+		const FString& Input = Args[0];
+		const FString& Output = Args[1];
+		FColorSwatchLibraryWriter Writer;
+
+		if (Input.EndsWith(TEXT(".json")))
+		{
+			FString JsonText;
+			FString Error;
+			if (!FFileHelper::LoadFileToString(JsonText, *Input) || !Writer.ImportJson(JsonText, Error))
+			{
+				UE_LOG(LogColorPickerError, Error, TEXT("Failed to import swatches from %s. %s"), *Input, *Error);
+				return;
+			}
+
+			FColorSwatchWriteSettings Settings;
+			for (int32 Index = 2; Index < Args.Num(); ++Index)
+			{
+				if (Args[Index] == TEXT("Float16"))
+					Settings.Storage = EColorSwatchStorage::CSS_FLOAT16;
+				else if (Args[Index] == TEXT("HSV"))
+					Settings.bIncludeHSV = true;
+				else if (Args[Index] == TEXT("Lab"))
+					Settings.bIncludeLab = true;
+			}
+
+			if (!Writer.Save(Output, Settings))
+			{
+				UE_LOG(LogColorPickerError, Error, TEXT("Failed to write swatch library %s."), *Output);
+				return;
+			}
+		}
+		else
+		{
+			FColorSwatchLibrary Library;
+			if (!Library.Open(Input))
+				return;
+
+			Writer.Append(Library);
+			if (!FFileHelper::SaveStringToFile(Writer.ExportJson(), *Output, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+			{
+				UE_LOG(LogColorPickerError, Error, TEXT("Failed to write swatches to %s."), *Output);
+				return;
+			}
+		}
+
+		UE_LOG(LogColorPicker, Log, TEXT("Converted %d swatches (%d unique names) from %s to %s."), Writer.Num(), Writer.NumUniqueNames(), *Input, *Output);
+	}
+
+	FAutoConsoleCommand ConvertSwatchesCommand(
+		TEXT("ColorPicker.ConvertSwatches"),
+		TEXT("Convert a JSON swatch library to a binary one, or back. Usage: ColorPicker.ConvertSwatches <Input.json|Input.cpsw> <Output> [Float16] [HSV] [Lab]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&ConvertSwatches));
+}
+#endif // !UE_BUILD_SHIPPING
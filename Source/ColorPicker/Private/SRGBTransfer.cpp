@@ -0,0 +1,10 @@
+// Copyright kevin791129
+
+#include "SRGBTransfer.h"
+
+namespace SRGBTransfer
+{
+	// Built from the engine conversion rather than the core reference so results follow the engine exactly.
+	const ColorMath::SRGB::FEncodeTable ColorEncodeTable([](const float Value) { return FLinearColor(Value, 0.0f, 0.0f, 0.0f).ToFColor(true).R; });
+	const ColorMath::SRGB::FEncodeTable AlphaEncodeTable([](const float Value) { return FLinearColor(0.0f, 0.0f, 0.0f, Value).ToFColor(true).A; });
+}
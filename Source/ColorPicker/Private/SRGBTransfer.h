@@ -0,0 +1,61 @@
+// Copyright kevin791129
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ColorMath/ColorMathSRGB.h"
+
+/**
+ * Table driven sRGB transfer functions, bit-identical to FLinearColor::ToFColor(true) and FLinearColor::FromSRGBColor without calling pow().
+ */
+namespace SRGBTransfer
+{
+	/** Color channel encode table, built from the sRGB path of FLinearColor::ToFColor. */
+	extern COLORPICKER_API const ColorMath::SRGB::FEncodeTable ColorEncodeTable;
+	/** Alpha channel encode table, built from the linear alpha path of FLinearColor::ToFColor. */
+	extern COLORPICKER_API const ColorMath::SRGB::FEncodeTable AlphaEncodeTable;
+
+	/**
+	 * Encode linear value to sRGB code.
+	 *
+	 * @param Value : Linear value, clamped to [0.0f, 1.0f].
+	 * @return sRGB code.
+	 */
+	FORCEINLINE uint8 Encode(const float Value)
+	{
+		return ColorEncodeTable.Encode(Value);
+	}
+
+	/**
+	 * Decode sRGB code to linear value.
+	 *
+	 * @param Value : sRGB code.
+	 * @return Linear value.
+	 */
+	FORCEINLINE float Decode(const uint8 Value)
+	{
+		return ColorMath::SRGB::Decode(Value);
+	}
+
+	/**
+	 * Same as FLinearColor::ToFColor(true).
+	 *
+	 * @param Color : Linear color.
+	 * @return sRGB color.
+	 */
+	FORCEINLINE FColor ToFColor(const FLinearColor& Color)
+	{
+		return FColor(Encode(Color.R), Encode(Color.G), Encode(Color.B), AlphaEncodeTable.Encode(Color.A));
+	}
+
+	/**
+	 * Same as FLinearColor::FromSRGBColor.
+	 *
+	 * @param Color : sRGB color.
+	 * @return Linear color.
+	 */
+	FORCEINLINE FLinearColor FromFColor(const FColor& Color)
+	{
+		return FLinearColor(Decode(Color.R), Decode(Color.G), Decode(Color.B), ColorMath::SRGB::DecodeLinear(Color.A));
+	}
+}
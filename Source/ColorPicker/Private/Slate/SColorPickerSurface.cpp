@@ -0,0 +1,292 @@
+// Copyright kevin791129
+
+#include "Slate/SColorPickerSurface.h"
+#include "ColorPickerBPLibrary.h"
+#include "ColorPickerStats.h"
+#include "InputCoreTypes.h"
+#include "Rendering/DrawElements.h"
+
+DECLARE_CYCLE_STAT(TEXT("Surface Paint"), STAT_ColorPickerSurfacePaint, STATGROUP_ColorPicker);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Surface Paints"), STAT_ColorPickerSurfacePaints, STATGROUP_ColorPicker);
+
+namespace
+{
+	/** Fully saturated hues at the start of each hue sector, sRGB and linear values agree for these. */
+	const FLinearColor HueSectorColors[] = {
+		FLinearColor(1.f, 0.f, 0.f), FLinearColor(1.f, 1.f, 0.f), FLinearColor(0.f, 1.f, 0.f),
+		FLinearColor(0.f, 1.f, 1.f), FLinearColor(0.f, 0.f, 1.f), FLinearColor(1.f, 0.f, 1.f), FLinearColor(1.f, 0.f, 0.f)
+	};
+
+	/**
+	 * Pure hue, the top right color of the saturation value picker.
+	 */
+	FLinearColor HueColor(const float Hue)
+	{
+		// Blending happens on sRGB vertex colors, so hue is interpolated in sRGB then decoded.
+		const float Sector = FMath::Clamp(Hue, 0.f, 360.f) / 60.f;
+		const int32 Index = FMath::Min((int32)Sector, 5);
+		const FLinearColor Encoded = FMath::Lerp(HueSectorColors[Index], HueSectorColors[Index + 1], Sector - (float)Index);
+		return FLinearColor::FromSRGBColor(Encoded.ToFColor(false));
+	}
+}
+
+void SColorPickerSurface::Construct(const FArguments& InArgs)
+{
+	DesiredSize = InArgs._DesiredSize;
+	HueStripWidth = InArgs._HueStripWidth;
+	Spacing = InArgs._Spacing;
+	HueIndicatorSize = InArgs._HueIndicatorSize;
+	SaturationValueIndicatorSize = InArgs._SaturationValueIndicatorSize;
+	HueIndicatorBrush = InArgs._HueIndicatorBrush;
+	SaturationValueIndicatorBrush = InArgs._SaturationValueIndicatorBrush;
+	Precision = InArgs._Precision;
+	OnColorChanged = InArgs._OnColorChanged;
+	OnColorChangeBegin = InArgs._OnColorChangeBegin;
+	OnColorChangeEnd = InArgs._OnColorChangeEnd;
+
+	SetColor(InArgs._Color);
+}
+
+#pragma region Properties
+void SColorPickerSurface::SetColor(const FLinearColor& NewColor)
+{
+	Color = NewColor;
+
+	float H, S, V;
+	UColorPickerBPLibrary::LinearColorToHSV(Color, H, S, V, Precision);
+
+	// Grays have no hue and black has no saturation, keep the indicators where they are.
+	if (S > 0.f && V > 0.f)
+		Hue = H;
+	if (V > 0.f)
+		Saturation = S;
+	Value = V;
+
+	Invalidate(EInvalidateWidgetReason::Paint);
+}
+
+void SColorPickerSurface::SetDesiredSize(const FVector2D& InDesiredSize)
+{
+	if (DesiredSize == InDesiredSize)
+		return;
+
+	DesiredSize = InDesiredSize;
+	Invalidate(EInvalidateWidgetReason::Layout);
+}
+
+void SColorPickerSurface::SetHueStripWidth(const float InHueStripWidth)
+{
+	HueStripWidth = InHueStripWidth;
+	Invalidate(EInvalidateWidgetReason::Paint);
+}
+
+void SColorPickerSurface::SetSpacing(const float InSpacing)
+{
+	Spacing = InSpacing;
+	Invalidate(EInvalidateWidgetReason::Paint);
+}
+
+void SColorPickerSurface::SetHueIndicatorSize(const FVector2D& InSize)
+{
+	HueIndicatorSize = InSize;
+	Invalidate(EInvalidateWidgetReason::Paint);
+}
+
+void SColorPickerSurface::SetSaturationValueIndicatorSize(const FVector2D& InSize)
+{
+	SaturationValueIndicatorSize = InSize;
+	Invalidate(EInvalidateWidgetReason::Paint);
+}
+
+void SColorPickerSurface::SetHueIndicatorBrush(const FSlateBrush* InBrush)
+{
+	HueIndicatorBrush = InBrush;
+	Invalidate(EInvalidateWidgetReason::Paint);
+}
+
+void SColorPickerSurface::SetSaturationValueIndicatorBrush(const FSlateBrush* InBrush)
+{
+	SaturationValueIndicatorBrush = InBrush;
+	Invalidate(EInvalidateWidgetReason::Paint);
+}
+#pragma endregion
+
+#pragma region Paint
+SColorPickerSurface::FLayout SColorPickerSurface::ComputeLayout(const FVector2D& LocalSize) const
+{
+	const float HueWidth = FMath::Clamp(HueStripWidth, 0.f, LocalSize.X);
+	const float SaturationValueWidth = FMath::Max(LocalSize.X - HueWidth - Spacing, 0.f);
+
+	FLayout Layout;
+	Layout.SaturationValue = FSlateRect(0.f, 0.f, SaturationValueWidth, LocalSize.Y);
+	Layout.Hue = FSlateRect(LocalSize.X - HueWidth, 0.f, LocalSize.X, LocalSize.Y);
+	return Layout;
+}
+
+FVector2D SColorPickerSurface::ComputeDesiredSize(float LayoutScaleMultiplier) const
+{
+	return DesiredSize;
+}
+
+int32 SColorPickerSurface::OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const
+{
+	COLORPICKER_SCOPE_CYCLE_COUNTER(STAT_ColorPickerSurfacePaint, SurfacePaint);
+	COLORPICKER_INC_COUNTER(STAT_ColorPickerSurfacePaints, SurfacePaints, 1);
+
+	const FLayout Layout = ComputeLayout(AllottedGeometry.GetLocalSize());
+	const ESlateDrawEffect DrawEffects = ShouldBeEnabled(bParentEnabled) ? ESlateDrawEffect::None : ESlateDrawEffect::DisabledEffect;
+	const FLinearColor WidgetTint = InWidgetStyle.GetColorAndOpacityTint();
+	const FSlateBrush* WhiteBrush = FCoreStyle::Get().GetBrush("GenericWhiteBox");
+
+	// Saturation value picker, pure hue faded to white leftwards and to black downwards.
+	const FVector2D SaturationValueSize = Layout.SaturationValue.GetSize();
+	if (SaturationValueSize.X > 0.f && SaturationValueSize.Y > 0.f)
+	{
+		const FPaintGeometry PaintGeometry = AllottedGeometry.ToPaintGeometry(Layout.SaturationValue.GetTopLeft(), SaturationValueSize);
+		FSlateDrawElement::MakeBox(OutDrawElements, LayerId, PaintGeometry, WhiteBrush, DrawEffects, HueColor(Hue) * WidgetTint);
+
+		TArray<FSlateGradientStop> Stops;
+		Stops.Emplace(FVector2D::ZeroVector, FLinearColor(1.f, 1.f, 1.f, WidgetTint.A));
+		Stops.Emplace(FVector2D(SaturationValueSize.X, 0.f), FLinearColor(1.f, 1.f, 1.f, 0.f));
+		// Vertical orientation lays stops out along X.
+		FSlateDrawElement::MakeGradient(OutDrawElements, LayerId, PaintGeometry, Stops, Orient_Vertical, DrawEffects);
+
+		Stops.Reset();
+		Stops.Emplace(FVector2D::ZeroVector, FLinearColor(0.f, 0.f, 0.f, 0.f));
+		Stops.Emplace(FVector2D(0.f, SaturationValueSize.Y), FLinearColor(0.f, 0.f, 0.f, WidgetTint.A));
+		FSlateDrawElement::MakeGradient(OutDrawElements, LayerId, PaintGeometry, MoveTemp(Stops), Orient_Horizontal, DrawEffects);
+	}
+
+	// Hue strip, one stop per hue sector.
+	const FVector2D HueSize = Layout.Hue.GetSize();
+	if (HueSize.X > 0.f && HueSize.Y > 0.f)
+	{
+		TArray<FSlateGradientStop> Stops;
+		Stops.Reserve(UE_ARRAY_COUNT(HueSectorColors));
+		for (int32 Index = 0; Index < UE_ARRAY_COUNT(HueSectorColors); ++Index)
+		{
+			Stops.Emplace(FVector2D(0.f, HueSize.Y * Index / 6.f), HueSectorColors[Index] * WidgetTint);
+		}
+		FSlateDrawElement::MakeGradient(OutDrawElements, LayerId, AllottedGeometry.ToPaintGeometry(Layout.Hue.GetTopLeft(), HueSize), MoveTemp(Stops), Orient_Horizontal, DrawEffects);
+	}
+
+	// Indicators are centered on the picked position, on the layer above.
+	const int32 IndicatorLayerId = LayerId + 1;
+	const FVector2D HueCenter(Layout.Hue.Left + HueSize.X * 0.5f, Layout.Hue.Top + Hue / 360.f * HueSize.Y);
+	const FPaintGeometry HueIndicatorGeometry = AllottedGeometry.ToPaintGeometry(HueCenter - HueIndicatorSize * 0.5f, HueIndicatorSize);
+	if (HueIndicatorBrush)
+	{
+		FSlateDrawElement::MakeBox(OutDrawElements, IndicatorLayerId, HueIndicatorGeometry, HueIndicatorBrush, DrawEffects, HueIndicatorBrush->GetTint(InWidgetStyle) * WidgetTint);
+	}
+	else
+	{
+		const TArray<FVector2D> Outline = {
+			FVector2D::ZeroVector, FVector2D(HueIndicatorSize.X, 0.f), HueIndicatorSize, FVector2D(0.f, HueIndicatorSize.Y), FVector2D::ZeroVector
+		};
+		FSlateDrawElement::MakeLines(OutDrawElements, IndicatorLayerId, HueIndicatorGeometry, Outline, DrawEffects, WidgetTint, true, 2.f);
+	}
+
+	if (SaturationValueIndicatorBrush)
+	{
+		const FVector2D SaturationValueCenter(Layout.SaturationValue.Left + Saturation * SaturationValueSize.X, Layout.SaturationValue.Top + (1.f - Value) * SaturationValueSize.Y);
+		FSlateDrawElement::MakeBox(OutDrawElements, IndicatorLayerId, AllottedGeometry.ToPaintGeometry(SaturationValueCenter - SaturationValueIndicatorSize * 0.5f, SaturationValueIndicatorSize),
+			SaturationValueIndicatorBrush, DrawEffects, SaturationValueIndicatorBrush->GetTint(InWidgetStyle) * WidgetTint);
+	}
+
+	return IndicatorLayerId;
+}
+#pragma endregion
+
+#pragma region Input
+FReply SColorPickerSurface::OnMouseButtonDown(const FGeometry& MyGeometry, const FPointerEvent& MouseEvent)
+{
+	if (MouseEvent.GetEffectingButton() != EKeys::LeftMouseButton)
+		return FReply::Unhandled();
+
+	const FVector2D LocalPosition = MyGeometry.AbsoluteToLocal(MouseEvent.GetScreenSpacePosition());
+	const FLayout Layout = ComputeLayout(MyGeometry.GetLocalSize());
+	if (Layout.Hue.ContainsPoint(LocalPosition))
+		DragTarget = EDragTarget::Hue;
+	else if (Layout.SaturationValue.ContainsPoint(LocalPosition))
+		DragTarget = EDragTarget::SaturationValue;
+	else
+		return FReply::Unhandled();
+
+	OnColorChangeBegin.ExecuteIfBound();
+	ApplyLocalPosition(MyGeometry, LocalPosition);
+
+	return FReply::Handled().CaptureMouse(SharedThis(this));
+}
+
+FReply SColorPickerSurface::OnMouseButtonUp(const FGeometry& MyGeometry, const FPointerEvent& MouseEvent)
+{
+	if (MouseEvent.GetEffectingButton() != EKeys::LeftMouseButton || !IsInteracting())
+		return FReply::Unhandled();
+
+	FinishInteraction();
+
+	return FReply::Handled().ReleaseMouseCapture();
+}
+
+FReply SColorPickerSurface::OnMouseMove(const FGeometry& MyGeometry, const FPointerEvent& MouseEvent)
+{
+	if (!IsInteracting())
+		return FReply::Unhandled();
+
+	ApplyLocalPosition(MyGeometry, MyGeometry.AbsoluteToLocal(MouseEvent.GetScreenSpacePosition()));
+
+	return FReply::Handled();
+}
+
+FCursorReply SColorPickerSurface::OnCursorQuery(const FGeometry& MyGeometry, const FPointerEvent& CursorEvent) const
+{
+	if (IsInteracting())
+		return FCursorReply::Cursor(EMouseCursor::None);
+	else
+		return FCursorReply::Unhandled();
+}
+
+void SColorPickerSurface::OnMouseCaptureLost(const FCaptureLostEvent& CaptureLostEvent)
+{
+	FinishInteraction();
+}
+
+void SColorPickerSurface::ApplyLocalPosition(const FGeometry& MyGeometry, const FVector2D& LocalPosition)
+{
+	const FLayout Layout = ComputeLayout(MyGeometry.GetLocalSize());
+	float NewHue = Hue;
+	float NewSaturation = Saturation;
+	float NewValue = Value;
+	if (DragTarget == EDragTarget::Hue)
+	{
+		const float Height = Layout.Hue.GetSize().Y;
+		NewHue = Height > 0.f ? FMath::Clamp((LocalPosition.Y - Layout.Hue.Top) / Height, 0.f, 1.f) * 360.f : 0.f;
+	}
+	else
+	{
+		const FVector2D Size = Layout.SaturationValue.GetSize();
+		NewSaturation = Size.X > 0.f ? FMath::Clamp((LocalPosition.X - Layout.SaturationValue.Left) / Size.X, 0.f, 1.f) : 0.f;
+		NewValue = Size.Y > 0.f ? 1.f - FMath::Clamp((LocalPosition.Y - Layout.SaturationValue.Top) / Size.Y, 0.f, 1.f) : 1.f;
+	}
+
+	if (NewHue == Hue && NewSaturation == Saturation && NewValue == Value)
+		return;
+
+	Hue = NewHue;
+	Saturation = NewSaturation;
+	Value = NewValue;
+	UColorPickerBPLibrary::HSVToLinearColor(Hue, Saturation, Value, Color, Precision);
+	Invalidate(EInvalidateWidgetReason::Paint);
+
+	OnColorChanged.ExecuteIfBound(Color);
+}
+
+void SColorPickerSurface::FinishInteraction()
+{
+	if (!IsInteracting())
+		return;
+
+	DragTarget = EDragTarget::None;
+	OnColorChangeEnd.ExecuteIfBound();
+}
+#pragma endregion
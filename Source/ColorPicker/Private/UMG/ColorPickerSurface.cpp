@@ -0,0 +1,99 @@
+// Copyright kevin791129
+
+#include "UMG/ColorPickerSurface.h"
+#include "Slate/SColorPickerSurface.h"
+#include "Styling/CoreStyle.h"
+
+#define LOCTEXT_NAMESPACE "UMG"
+
+UColorPickerSurface::UColorPickerSurface(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	HueIndicatorBrush.DrawAs = ESlateBrushDrawType::NoDrawType;
+	SaturationValueIndicatorBrush = *FCoreStyle::Get().GetBrush("ColorPicker.Selector");
+}
+
+#pragma region Color
+void UColorPickerSurface::SetPickerColor(FLinearColor NewColor, bool bBroadcastChange)
+{
+	Color = NewColor;
+	if (MySurface.IsValid())
+		MySurface->SetColor(Color);
+
+	if (bBroadcastChange)
+	{
+		BroadcastColorChanged();
+	}
+}
+
+void UColorPickerSurface::HandleColorChanged(const FLinearColor& NewColor)
+{
+	Color = NewColor;
+	BroadcastColorChanged();
+}
+
+void UColorPickerSurface::HandleColorChangeBegin()
+{
+	ColorChangeBeginDelegate.Broadcast();
+	OnColorChangeBeginNative.Broadcast();
+}
+
+void UColorPickerSurface::HandleColorChangeEnd()
+{
+	ColorChangeEndDelegate.Broadcast();
+	OnColorChangeEndNative.Broadcast();
+}
+
+void UColorPickerSurface::BroadcastColorChanged()
+{
+	ColorChangeDelegate.Broadcast(Color);
+	OnColorChangedNative.Broadcast(Color);
+}
+#pragma endregion
+
+#pragma region UWidget
+TSharedRef<SWidget> UColorPickerSurface::RebuildWidget()
+{
+	MySurface = SNew(SColorPickerSurface)
+		.OnColorChanged(FOnColorPickerSurfaceColorChanged::CreateUObject(this, &UColorPickerSurface::HandleColorChanged))
+		.OnColorChangeBegin(FSimpleDelegate::CreateUObject(this, &UColorPickerSurface::HandleColorChangeBegin))
+		.OnColorChangeEnd(FSimpleDelegate::CreateUObject(this, &UColorPickerSurface::HandleColorChangeEnd));
+
+	return MySurface.ToSharedRef();
+}
+
+void UColorPickerSurface::SynchronizeProperties()
+{
+	Super::SynchronizeProperties();
+
+	if (!MySurface.IsValid())
+		return;
+
+	MySurface->SetDesiredSize(DesiredSize);
+	MySurface->SetHueStripWidth(HueStripWidth);
+	MySurface->SetSpacing(Spacing);
+	MySurface->SetHueIndicatorSize(HueIndicatorSize);
+	MySurface->SetSaturationValueIndicatorSize(SaturationValueIndicatorSize);
+	// Brushes are members of this widget, which outlives its slate widget.
+	MySurface->SetHueIndicatorBrush(HueIndicatorBrush.DrawAs != ESlateBrushDrawType::NoDrawType ? &HueIndicatorBrush : nullptr);
+	MySurface->SetSaturationValueIndicatorBrush(SaturationValueIndicatorBrush.DrawAs != ESlateBrushDrawType::NoDrawType ? &SaturationValueIndicatorBrush : nullptr);
+	MySurface->SetPrecision(Precision);
+	MySurface->SetColor(Color);
+}
+
+void UColorPickerSurface::ReleaseSlateResources(bool bReleaseChildren)
+{
+	Super::ReleaseSlateResources(bReleaseChildren);
+
+	MySurface.Reset();
+}
+
+#if WITH_EDITOR
+const FText UColorPickerSurface::GetPaletteCategory()
+{
+	return LOCTEXT("ColorPicker", "Color Picker");
+}
+#endif
+#pragma endregion
+
+#undef LOCTEXT_NAMESPACE
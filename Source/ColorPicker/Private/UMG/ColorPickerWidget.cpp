@@ -3,60 +3,127 @@
 #include "UMG/ColorPickerWidget.h"
 #include "Components/CanvasPanelSlot.h"
 #include "ColorPickerBPLibrary.h"
+#include "SRGBTransfer.h"
+#include "ColorPicker.h"
+#include "ColorPickerResourceCache.h"
+#include "ColorPickerStats.h"
+#include "Materials/MaterialInstanceDynamic.h"
+#include "Engine/Texture2D.h"
+#include "HAL/ThreadSafeBool.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Material Parameter Writes"), STAT_ColorPickerMaterialParameterWrites, STATGROUP_ColorPicker);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Material Parameter Writes Skipped"), STAT_ColorPickerMaterialParameterWritesSkipped, STATGROUP_ColorPicker);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Mouse Move Events"), STAT_ColorPickerMouseMoveEvents, STATGROUP_ColorPicker);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Color Change Broadcasts"), STAT_ColorPickerBroadcasts, STATGROUP_ColorPicker);
+/** Pickers painted this frame, idle pickers under global invalidation or an invalidation box are not painted. */
+DECLARE_DWORD_COUNTER_STAT(TEXT("Picker Paints"), STAT_ColorPickerPaints, STATGROUP_ColorPicker);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Indicator Moves"), STAT_ColorPickerIndicatorMoves, STATGROUP_ColorPicker);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Paint Invalidations"), STAT_ColorPickerPaintInvalidations, STATGROUP_ColorPicker);
+DECLARE_CYCLE_STAT(TEXT("Mouse Move"), STAT_ColorPickerMouseMove, STATGROUP_ColorPicker);
+DECLARE_CYCLE_STAT(TEXT("Apply Pointer Position"), STAT_ColorPickerApplyPointerPosition, STATGROUP_ColorPicker);
+DECLARE_CYCLE_STAT(TEXT("Picker Conversion"), STAT_ColorPickerConversion, STATGROUP_ColorPicker);
+DECLARE_CYCLE_STAT(TEXT("Material Parameter Write"), STAT_ColorPickerMaterialParameterWrite, STATGROUP_ColorPicker);
+DECLARE_CYCLE_STAT(TEXT("Acquire Material Instances"), STAT_ColorPickerAcquireMaterialInstances, STATGROUP_ColorPicker);
+DECLARE_CYCLE_STAT(TEXT("Update Gradient Textures"), STAT_ColorPickerUpdateGradientTextures, STATGROUP_ColorPicker);
+/** Time spent in delegates bound by users of the picker, everything else under picker scopes is the picker's own cost. */
+DECLARE_CYCLE_STAT(TEXT("Listeners"), STAT_ColorPickerListeners, STATGROUP_ColorPicker);
+
+/**
+ * Pixels and region of a gradient texture upload, kept alive by the render thread until its copy is done.
+ */
+struct FGradientTextureStaging
+{
+	TArray<FColor> Pixels;
+	FUpdateTextureRegion2D Region;
+	/** Set while an upload reading Pixels is queued on the render thread. */
+	FThreadSafeBool bInFlight;
+};
 
-#pragma region Initialize
-void UColorPickerWidget::NativeOnInitialized()
+namespace
 {
-	Super::NativeOnInitialized();
+	const FName HueParameterName(TEXT("Hue"));
+	const FName IndicatorColorParameterName(TEXT("IndicatorColor"));
 
-	bool bResourceFound = false;
+	/** Material parameter writes within this tolerance of the last written value are skipped. */
+	constexpr float MaterialParameterTolerance = 1.e-5f;
 
-	SVMat = FindObject<UMaterialInstance>(ANY_PACKAGE, TEXT("MaterialInstanceConstant'/ColorPicker/Material/MI_SV_Picker.MI_SV_Picker'"));
-	if (SVMat)
+	/**
+	 * Repaint a widget whose brush resource changed without Slate knowing, such as a material parameter or texture upload.
+	 * Needed for cached paint under global invalidation, invalidation panels and retainer boxes, layout is left alone.
+	 */
+	void InvalidatePaint(UWidget* Widget)
 	{
-		SVMatDynamic = UMaterialInstanceDynamic::Create(SVMat, this);
-		if (SVMatDynamic)
-		{
-			ColorPicker_SV->SetBrushFromMaterial(SVMatDynamic);
-			bResourceFound = true;
-		}
+		const TSharedPtr<SWidget> SafeWidget = Widget ? Widget->GetCachedWidget() : nullptr;
+		if (!SafeWidget.IsValid())
+			return;
+
+		SafeWidget->Invalidate(EInvalidateWidgetReason::Paint);
+		COLORPICKER_INC_COUNTER(STAT_ColorPickerPaintInvalidations, PaintInvalidations, 1);
 	}
 
-	// Saturation and value material missing.
-	if (!bResourceFound)
+	/**
+	 * Move indicator with its render transform, which is applied after layout so the picker canvas is not arranged again.
+	 */
+	void SetIndicatorTranslation(UWidget* Indicator, const FVector2D& Translation)
 	{
-		UE_LOG(LogColorPickerError, Error, TEXT("Saturation and value material not found in plugin."));
+		if (Indicator->RenderTransform.Translation == Translation)
+			return;
+
+		Indicator->SetRenderTranslation(Translation);
+		COLORPICKER_INC_COUNTER(STAT_ColorPickerIndicatorMoves, IndicatorMoves, 1);
 	}
 
-	// Only if using default saturation and value indicator.
-	if (!SaturationValueIndicatorResourceObject)
+	/**
+	 * Upload gradient pixels to texture, creating a new transient texture if missing or size differs.
+	 *
+	 * @param Staging : Staging pixels and region of the texture, reused unless the render thread still reads them.
+	 * @return Texture holding gradient, null if it could not be created.
+	 */
+	UTexture2D* UploadGradientTexture(UTexture2D* Texture, const FColorGradientBuffer& Gradient, TSharedPtr<FGradientTextureStaging, ESPMode::ThreadSafe>& Staging)
 	{
-		bResourceFound = false;
-
-		SVIndicatorMat = FindObject<UMaterialInstance>(ANY_PACKAGE, TEXT("MaterialInstanceConstant'/ColorPicker/Material/MI_SV_Indicator.MI_SV_Indicator'"));
-		if (SVIndicatorMat)
+		const FIntPoint& Size = Gradient.GetSize();
+		if (!Texture || Texture->GetSizeX() != Size.X || Texture->GetSizeY() != Size.Y)
 		{
-			SVIndicatorMatDynamic = UMaterialInstanceDynamic::Create(SVIndicatorMat, this);
-			if (SVIndicatorMatDynamic)
-			{
-				Indicator_SV->SetBrushFromMaterial(SVIndicatorMatDynamic);
-				bUsingDefaultIndicator = true;
-				bResourceFound = true;
-
-				SVIndicatorMatDynamic->SetVectorParameterValue("BorderColor", BorderColor);
-				SVIndicatorMatDynamic->SetScalarParameterValue("BorderSize", BorderSize);
-				SVIndicatorMatDynamic->SetScalarParameterValue("bUseBorderColor", bUseBorderColor ? 1.f : 0.f);
-			}
-		}
+			// FColor memory layout is BGRA.
+			Texture = UTexture2D::CreateTransient(Size.X, Size.Y, PF_B8G8R8A8);
+			if (!Texture)
+				return nullptr;
 
-		// Saturation and value indicator material missing.
-		if (!bResourceFound)
-		{
-			UE_LOG(LogColorPickerError, Error, TEXT("Saturation and value indicator material not found in plugin."));
+			Texture->SRGB = true;
+			Texture->UpdateResource();
 		}
+
+		// Upload happens on render thread, which reads staging until cleanup runs. Staging still queued is left to the render thread and replaced.
+		if (!Staging.IsValid() || Staging->bInFlight)
+			Staging = MakeShared<FGradientTextureStaging, ESPMode::ThreadSafe>();
+
+		const TArray<FColor>& Pixels = Gradient.GetPixels();
+		Staging->Pixels.SetNumUninitialized(Pixels.Num(), false);
+		FMemory::Memcpy(Staging->Pixels.GetData(), Pixels.GetData(), Pixels.Num() * sizeof(FColor));
+		Staging->Region = FUpdateTextureRegion2D(0, 0, 0, 0, Size.X, Size.Y);
+		Staging->bInFlight = true;
+
+		Texture->UpdateTextureRegions(0, 1, &Staging->Region, Size.X * sizeof(FColor), sizeof(FColor), (uint8*)Staging->Pixels.GetData(),
+			[QueuedStaging = Staging](uint8* SrcData, const FUpdateTextureRegion2D* Regions)
+			{
+				QueuedStaging->bInFlight = false;
+			});
+
+		return Texture;
 	}
 }
 
+#pragma region Initialize
+void UColorPickerWidget::NativeOnInitialized()
+{
+	Super::NativeOnInitialized();
+
+	// Dynamic materials are acquired on construct, so pickers created but never shown cost nothing.
+	bUsingDefaultIndicator = !SaturationValueIndicatorResourceObject;
+
+	History.SetCapacity(HistoryCapacity, HistoryPathPoints);
+}
+
 void UColorPickerWidget::NativePreConstruct()
 {
 	Super::NativePreConstruct();
@@ -75,18 +142,23 @@ void UColorPickerWidget::NativePreConstruct()
 		SaturationValuePickerSlot->SetSize(FVector2D(SV_SizeX, SV_SizeY));
 	}
 
+	// Indicators stay at the picker origin and move by render translation only.
 	UCanvasPanelSlot* HueIndicatorSlot = Cast<UCanvasPanelSlot>(Indicator_H->Slot);
-	if (HueIndicatorSlot && HueIndicatorSize.X > 0.f && HueIndicatorSize.Y > 0.f)
+	if (HueIndicatorSlot)
 	{
-		HueIndicatorSlot->SetSize(HueIndicatorSize);
+		HueIndicatorSlot->SetPosition(FVector2D::ZeroVector);
+		if (HueIndicatorSize.X > 0.f && HueIndicatorSize.Y > 0.f)
+			HueIndicatorSlot->SetSize(HueIndicatorSize);
 	}
 	if (HueIndicatorResourceObject)
 		Indicator_H->SetBrushResourceObject(HueIndicatorResourceObject);
 
 	UCanvasPanelSlot* SaturationValueIndicatorSlot = Cast<UCanvasPanelSlot>(Indicator_SV->Slot);
-	if (SaturationValueIndicatorSlot && SaturationValueIndicatorSize.X > 0.f && SaturationValueIndicatorSize.Y > 0.f)
+	if (SaturationValueIndicatorSlot)
 	{
-		SaturationValueIndicatorSlot->SetSize(SaturationValueIndicatorSize);
+		SaturationValueIndicatorSlot->SetPosition(FVector2D::ZeroVector);
+		if (SaturationValueIndicatorSize.X > 0.f && SaturationValueIndicatorSize.Y > 0.f)
+			SaturationValueIndicatorSlot->SetSize(SaturationValueIndicatorSize);
 	}
 	if (SaturationValueIndicatorResourceObject)
 		Indicator_SV->SetBrushResourceObject(SaturationValueIndicatorResourceObject);
@@ -95,6 +167,32 @@ void UColorPickerWidget::NativePreConstruct()
 void UColorPickerWidget::NativeConstruct()
 {
 	Super::NativeConstruct();
+
+	AcquireMaterialInstances();
+}
+
+void UColorPickerWidget::NativeDestruct()
+{
+	ReleaseMaterialInstances();
+
+	Super::NativeDestruct();
+}
+
+int32 UColorPickerWidget::NativePaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const
+{
+	COLORPICKER_INC_COUNTER(STAT_ColorPickerPaints, PickerPaints, 1);
+#if !UE_BUILD_SHIPPING
+	++NumPaints;
+#endif
+
+	return Super::NativePaint(Args, AllottedGeometry, MyCullingRect, OutDrawElements, LayerId, InWidgetStyle, bParentEnabled);
+}
+
+void UColorPickerWidget::ReleaseSlateResources(bool bReleaseChildren)
+{
+	Super::ReleaseSlateResources(bReleaseChildren);
+
+	ReleaseMaterialInstances();
 }
 #pragma endregion
 
@@ -103,13 +201,15 @@ FReply UColorPickerWidget::NativeOnMouseButtonDown(const FGeometry& InGeometry,
 {
 	FReply Reply = FReply::Handled();
 
-	if (ColorPicker_H->IsHovered())
+	// Hit tested against cached geometry rather than hover state, so synthesized and replayed events are handled too.
+	const FVector2D ScreenSpacePosition = InMouseEvent.GetScreenSpacePosition();
+	if (ColorPicker_H->GetCachedGeometry().IsUnderLocation(ScreenSpacePosition))
 	{
 		bIsInteracting = true;
 		bHueInteraction = true;
 		Reply.CaptureMouse(TakeWidget()).LockMouseToWidget(ColorPicker_H->TakeWidget());
 	}
-	else if (ColorPicker_SV->IsHovered())
+	else if (ColorPicker_SV->GetCachedGeometry().IsUnderLocation(ScreenSpacePosition))
 	{
 		bIsInteracting = true;
 		bHueInteraction = false;
@@ -118,12 +218,25 @@ FReply UColorPickerWidget::NativeOnMouseButtonDown(const FGeometry& InGeometry,
 	
 	if (bIsInteracting)
 	{
+		LastBroadcastColor = SRGBTransfer::ToFColor(CurrentColor);
+		bHasUnbroadcastChange = false;
+		History.BeginChange(GetHistoryState());
+
 		// Notify listeners that user started changing color.
-		if (ColorChangeBeginDelegate.IsBound())
-			ColorChangeBeginDelegate.Broadcast();
+		{
+			COLORPICKER_SCOPE_CYCLE_COUNTER(STAT_ColorPickerListeners, Listeners);
+			if (ColorChangeBeginDelegate.IsBound())
+				ColorChangeBeginDelegate.Broadcast();
+			OnColorChangeBeginNative.Broadcast();
+		}
 
-		// Change current color by using 'NativeOnMouseMove'.
-		NativeOnMouseMove(InGeometry, InMouseEvent);
+		// Press is applied immediately even when coalescing input.
+		ApplyPointerPosition(ScreenSpacePosition);
+
+		if (bCoalesceInput && !CoalescedInputTimer.IsValid())
+		{
+			CoalescedInputTimer = TakeWidget()->RegisterActiveTimer(0.f, FWidgetActiveTimerDelegate::CreateUObject(this, &UColorPickerWidget::HandleCoalescedInputTimer));
+		}
 	}
 
 	return Reply;
@@ -131,46 +244,30 @@ FReply UColorPickerWidget::NativeOnMouseButtonDown(const FGeometry& InGeometry,
 
 FReply UColorPickerWidget::NativeOnMouseButtonUp(const FGeometry& InGeometry, const FPointerEvent& InMouseEvent)
 {
-	// Notify listeners that user finished changing color.
-	if (bIsInteracting && ColorChangeEndDelegate.IsBound())
-		ColorChangeEndDelegate.Broadcast();
-
-	bIsInteracting = false;
+	FinishInteraction();
 
 	return FReply::Handled().ReleaseMouseCapture().ReleaseMouseLock();
 }
 
 FReply UColorPickerWidget::NativeOnMouseMove(const FGeometry& InGeometry, const FPointerEvent& InMouseEvent)
 {
-	bool bColorChanged = false;
+	COLORPICKER_SCOPE_CYCLE_COUNTER(STAT_ColorPickerMouseMove, MouseMove);
+	COLORPICKER_INC_COUNTER(STAT_ColorPickerMouseMoveEvents, MouseMoveEvents, 1);
 
 	if (bIsInteracting)
 	{
-		FVector2D MouseLocationPosition = FVector2D::ZeroVector;
-		if (bHueInteraction /*&& ColorPicker_H->GetCachedGeometry().IsUnderLocation(InMouseEvent.GetScreenSpacePosition())*/)
+		if (bCoalesceInput)
 		{
-			MouseLocationPosition = ColorPicker_H->GetCachedGeometry().AbsoluteToLocal(InMouseEvent.GetScreenSpacePosition());
-			SetHueIndicatorPosition(FVector2D(0.f, MouseLocationPosition.Y));
-			bColorChanged = true;
+			// Only keep the latest position, applied by 'HandleCoalescedInputTimer'.
+			PendingPointerPosition = InMouseEvent.GetScreenSpacePosition();
+			bHasPendingPointerPosition = true;
 		}
-		else if(!bHueInteraction /*&& ColorPicker_SV->GetCachedGeometry().IsUnderLocation(InMouseEvent.GetScreenSpacePosition())*/)
+		else
 		{
-			MouseLocationPosition = ColorPicker_SV->GetCachedGeometry().AbsoluteToLocal(InMouseEvent.GetScreenSpacePosition());
-			SetSaturationValueIndicatorPosition(MouseLocationPosition);
-			bColorChanged = true;
+			ApplyPointerPosition(InMouseEvent.GetScreenSpacePosition());
 		}
 	}
 
-	// Update current color and notify listeners of the change.
-	if (bColorChanged)
-	{
-		UColorPickerBPLibrary::HSVToLinearColor(CurrentHue, CurrentSaturation, CurrentValue, CurrentColor);
-		UpdateSaturationValueIndicator();
-
-		if (ColorChangeDelegate.IsBound())
-			ColorChangeDelegate.Broadcast(CurrentColor);
-	}
-
 	return FReply::Handled();
 }
 
@@ -184,11 +281,7 @@ FCursorReply UColorPickerWidget::NativeOnCursorQuery(const FGeometry& InGeometry
 
 void UColorPickerWidget::NativeOnMouseCaptureLost(const FCaptureLostEvent& CaptureLostEvent)
 {
-	// Notify listeners that user finished changing color.
-	if (bIsInteracting && ColorChangeEndDelegate.IsBound())
-		ColorChangeEndDelegate.Broadcast();
-
-	bIsInteracting = false;
+	FinishInteraction();
 }
 #pragma endregion
 
@@ -197,15 +290,102 @@ void UColorPickerWidget::SetPickerColor(FLinearColor NewColor, bool bBroadcastCh
 	CurrentColor = NewColor;
 
 	float H, S, V;
-	UColorPickerBPLibrary::LinearColorToHSV(CurrentColor, H, S, V);
+	{
+		COLORPICKER_SCOPE_CYCLE_COUNTER(STAT_ColorPickerConversion, Conversion);
+		UColorPickerBPLibrary::LinearColorToHSV(CurrentColor, H, S, V, Precision);
+	}
 	SetHueIndicatorPosition(FVector2D(0.f, H / 360.f * H_SizeY));
 	SetSaturationValueIndicatorPosition(FVector2D(S * SV_SizeX, (1 - V) * SV_SizeY));
 	UpdateSaturationValueIndicator();
 
-	if (bBroadcastChange && ColorChangeDelegate.IsBound())
+	if (bBroadcastChange)
 	{
-		ColorChangeDelegate.Broadcast(CurrentColor);
+		BroadcastColorChanged();
+	}
+}
+
+void UColorPickerWidget::SetSnapPalette(const TArray<FLinearColor>& Colors)
+{
+	SnapPalette.Build(Colors);
+}
+
+FColorGradientRamp UColorPickerWidget::MakeGradientRamp(TArrayView<const UColorPickerWidget* const> Pickers, const EColorRampInterpolation Interpolation)
+{
+	TArray<FColorRampStop, TInlineAllocator<16>> Stops;
+	for (const UColorPickerWidget* Picker : Pickers)
+	{
+		if (Picker)
+			Stops.Add({ 0.f, Picker->GetPickerColor() });
 	}
+
+	const int32 LastIndex = Stops.Num() - 1;
+	for (int32 Index = 1; Index <= LastIndex; ++Index)
+	{
+		Stops[Index].Time = (float)Index / (float)LastIndex;
+	}
+
+	FColorGradientRamp Ramp(Interpolation);
+	Ramp.SetStops(Stops);
+	return Ramp;
+}
+
+TSharedRef<FColorPaletteExtractionTask, ESPMode::ThreadSafe> UColorPickerWidget::ExtractPickerColorAsync(TArray<FColor>&& Pixels, const FColorPaletteSettings& Settings, FOnColorPaletteProgress OnProgress)
+{
+	return FColorPaletteExtractionTask::Launch(MoveTemp(Pixels), Settings, FOnColorPaletteExtracted::CreateUObject(this, &UColorPickerWidget::HandlePaletteExtracted), MoveTemp(OnProgress));
+}
+
+void UColorPickerWidget::SetEyedropperImage(TArrayView<const FColor> Pixels, const FIntPoint& Size)
+{
+	Eyedropper.Build(Pixels, Size);
+}
+
+void UColorPickerWidget::SetEyedropperImage(TArrayView<const FLinearColor> Pixels, const FIntPoint& Size)
+{
+	Eyedropper.Build(Pixels, Size);
+}
+
+bool UColorPickerWidget::PickEyedropperColor(FIntPoint Pixel, int32 Radius, bool bBroadcastChange)
+{
+	FLinearColor Average;
+	if (!Eyedropper.Sample(Pixel, Radius, Average))
+		return false;
+
+	SetPickerColor(Average, bBroadcastChange);
+	return true;
+}
+
+bool UColorPickerWidget::Undo()
+{
+	FColorPickerHistory::FState State;
+	if (!History.Undo(State))
+		return false;
+
+	ApplyHistoryState(State);
+	BroadcastColorChanged();
+	return true;
+}
+
+bool UColorPickerWidget::Redo()
+{
+	FColorPickerHistory::FState State;
+	if (!History.Redo(State))
+		return false;
+
+	ApplyHistoryState(State);
+	BroadcastColorChanged();
+	return true;
+}
+
+bool UColorPickerWidget::ScrubLastChange(float Time, bool bBroadcastChange)
+{
+	const TArrayView<const FColorPickerHistory::FState> Path = History.GetUndoPath(0);
+	if (Path.Num() == 0 || bIsInteracting)
+		return false;
+
+	ApplyHistoryState(Path[FMath::RoundToInt(FMath::Clamp(Time, 0.f, 1.f) * (Path.Num() - 1))]);
+	if (bBroadcastChange)
+		BroadcastColorChanged();
+	return true;
 }
 
 #pragma region Helper Function
@@ -214,19 +394,14 @@ void UColorPickerWidget::SetHueIndicatorPosition(const FVector2D& Position)
 	const float X = FMath::Clamp(Position.X, 0.f, H_SizeX);
 	const float Y = FMath::Clamp(Position.Y, 0.f, H_SizeY);
 
-	UCanvasPanelSlot* HueIndicatorSlot = Cast<UCanvasPanelSlot>(Indicator_H->Slot);
-	if (HueIndicatorSlot)
-	{
-		HueIndicatorSlot->SetPosition(FVector2D(X, Y));
-	}
+	SetIndicatorTranslation(Indicator_H, FVector2D(X, Y));
 
 	CurrentHue = Y / H_SizeY * 360.f;
 
 	// Update hue value for the saturation value picker material.
-	if (SVMatDynamic)
-	{
-		SVMatDynamic->SetScalarParameterValue("Hue", Y / H_SizeY);
-	}
+	SetHueMaterialParameter(Y / H_SizeY);
+	if (GradientBackend == EColorPickerGradientBackend::CGB_CPU_TEXTURE && bMaterialInstancesAcquired)
+		RequestGradientTextureUpdate();
 }
 
 void UColorPickerWidget::SetSaturationValueIndicatorPosition(const FVector2D& Position)
@@ -234,25 +409,356 @@ void UColorPickerWidget::SetSaturationValueIndicatorPosition(const FVector2D& Po
 	const float X = FMath::Clamp(Position.X, 0.f, SV_SizeX);
 	const float Y = FMath::Clamp(Position.Y, 0.f, SV_SizeY);
 
-	UCanvasPanelSlot* SaturationValueIndicatorSlot = Cast<UCanvasPanelSlot>(Indicator_SV->Slot);
-	if (SaturationValueIndicatorSlot)
-	{
-		SaturationValueIndicatorSlot->SetPosition(FVector2D(X, Y));
-	}
+	SetIndicatorTranslation(Indicator_SV, FVector2D(X, Y));
 
 	CurrentSaturation = X / SV_SizeX;
 	CurrentValue = 1 - Y / SV_SizeY;
 }
 
+void UColorPickerWidget::ApplyPointerPosition(const FVector2D& ScreenSpacePosition)
+{
+	COLORPICKER_SCOPE_CYCLE_COUNTER(STAT_ColorPickerApplyPointerPosition, ApplyPointerPosition);
+
+	bool bColorChanged = false;
+
+	if (bIsInteracting)
+	{
+		FVector2D MouseLocationPosition = FVector2D::ZeroVector;
+		if (bHueInteraction /*&& ColorPicker_H->GetCachedGeometry().IsUnderLocation(ScreenSpacePosition)*/)
+		{
+			MouseLocationPosition = ColorPicker_H->GetCachedGeometry().AbsoluteToLocal(ScreenSpacePosition);
+			SetHueIndicatorPosition(FVector2D(0.f, MouseLocationPosition.Y));
+			bColorChanged = true;
+		}
+		else if(!bHueInteraction /*&& ColorPicker_SV->GetCachedGeometry().IsUnderLocation(ScreenSpacePosition)*/)
+		{
+			MouseLocationPosition = ColorPicker_SV->GetCachedGeometry().AbsoluteToLocal(ScreenSpacePosition);
+			SetSaturationValueIndicatorPosition(MouseLocationPosition);
+			bColorChanged = true;
+		}
+	}
+
+	// Update current color and notify listeners of the change.
+	if (bColorChanged)
+	{
+		{
+			COLORPICKER_SCOPE_CYCLE_COUNTER(STAT_ColorPickerConversion, Conversion);
+			UColorPickerBPLibrary::HSVToLinearColor(CurrentHue, CurrentSaturation, CurrentValue, CurrentColor, Precision);
+			SnapCurrentColor();
+		}
+		UpdateSaturationValueIndicator();
+		History.RecordChange(GetHistoryState());
+
+		NotifyColorChanged();
+	}
+}
+
+void UColorPickerWidget::SnapCurrentColor()
+{
+	if (!bSnapToPalette || SnapPalette.IsEmpty())
+		return;
+
+	CurrentColor = SnapPalette.GetColor(SnapPalette.FindNearest(CurrentColor));
+}
+
+void UColorPickerWidget::NotifyColorChanged()
+{
+	switch (BroadcastPolicy)
+	{
+	case EColorBroadcastPolicy::CBP_RATE_LIMITED:
+		if (FPlatformTime::Seconds() - LastBroadcastTime >= 1.0 / FMath::Max(BroadcastRate, 1.f))
+			BroadcastColorChanged();
+		else
+			bHasUnbroadcastChange = true;
+		break;
+	case EColorBroadcastPolicy::CBP_QUANTIZED_CHANGE:
+		if (SRGBTransfer::ToFColor(CurrentColor) != LastBroadcastColor)
+			BroadcastColorChanged();
+		break;
+	case EColorBroadcastPolicy::CBP_CHANGE_END:
+		bHasUnbroadcastChange = true;
+		break;
+	default:
+		BroadcastColorChanged();
+		break;
+	}
+}
+
+void UColorPickerWidget::ApplyHistoryState(const FColorPickerHistory::FState& State)
+{
+	float H, S, V, A;
+	State.Unpack(H, S, V, A);
+
+	// Restored from indicator state rather than color, so hue of grays is kept.
+	SetHueIndicatorPosition(FVector2D(0.f, H / 360.f * H_SizeY));
+	SetSaturationValueIndicatorPosition(FVector2D(S * SV_SizeX, (1 - V) * SV_SizeY));
+	{
+		COLORPICKER_SCOPE_CYCLE_COUNTER(STAT_ColorPickerConversion, Conversion);
+		UColorPickerBPLibrary::HSVToLinearColor(CurrentHue, CurrentSaturation, CurrentValue, CurrentColor, Precision);
+		CurrentColor.A = A;
+		SnapCurrentColor();
+	}
+	UpdateSaturationValueIndicator();
+}
+
+FColorPickerHistory::FState UColorPickerWidget::GetHistoryState() const
+{
+	return FColorPickerHistory::FState::Pack(CurrentHue, CurrentSaturation, CurrentValue, CurrentColor.A);
+}
+
+void UColorPickerWidget::BroadcastColorChanged()
+{
+	LastBroadcastTime = FPlatformTime::Seconds();
+	LastBroadcastColor = SRGBTransfer::ToFColor(CurrentColor);
+	bHasUnbroadcastChange = false;
+
+	COLORPICKER_SCOPE_CYCLE_COUNTER(STAT_ColorPickerListeners, Listeners);
+	COLORPICKER_INC_COUNTER(STAT_ColorPickerBroadcasts, Broadcasts, 1);
+	if (ColorChangeDelegate.IsBound())
+		ColorChangeDelegate.Broadcast(CurrentColor);
+	OnColorChangedNative.Broadcast(CurrentColor);
+}
+
+void UColorPickerWidget::FinishInteraction()
+{
+	// Apply coalesced input so the final color is exact.
+	FlushPendingInput();
+
+	if (!bIsInteracting)
+		return;
+
+	// Deliver the final color held back by broadcast policy.
+	if (bHasUnbroadcastChange)
+		BroadcastColorChanged();
+
+	bIsInteracting = false;
+
+	// Indicators followed the pointer, move them to the snapped color.
+	if (bSnapToPalette && !SnapPalette.IsEmpty())
+		SetPickerColor(CurrentColor);
+
+	History.EndChange(GetHistoryState());
+
+	// Notify listeners that user finished changing color.
+	COLORPICKER_SCOPE_CYCLE_COUNTER(STAT_ColorPickerListeners, Listeners);
+	if (ColorChangeEndDelegate.IsBound())
+		ColorChangeEndDelegate.Broadcast();
+	OnColorChangeEndNative.Broadcast();
+}
+
+void UColorPickerWidget::FlushPendingInput()
+{
+	if (!bHasPendingPointerPosition)
+		return;
+
+	bHasPendingPointerPosition = false;
+	ApplyPointerPosition(PendingPointerPosition);
+}
+
+EActiveTimerReturnType UColorPickerWidget::HandleCoalescedInputTimer(double InCurrentTime, float InDeltaTime)
+{
+	FlushPendingInput();
+
+	if (bGradientTexturesDirty && bMaterialInstancesAcquired)
+		UpdateGradientTextures();
+
+	if (bIsInteracting)
+		return EActiveTimerReturnType::Continue;
+
+	CoalescedInputTimer.Reset();
+	return EActiveTimerReturnType::Stop;
+}
+
+void UColorPickerWidget::HandlePaletteExtracted(const TArray<FColorPaletteEntry>& Palette)
+{
+	if (Palette.Num() == 0)
+		return;
+
+	SetPickerColor(Palette[0].Color, true);
+	OnPaletteExtractedNative.Broadcast(Palette);
+}
+
 void UColorPickerWidget::UpdateSaturationValueIndicator()
 {
 	if (!bUsingDefaultIndicator)
 		return;
 
 	// Update color for the saturation value indicator material.
-	if (SVIndicatorMatDynamic)
+	SetIndicatorColorMaterialParameter(CurrentColor);
+}
+
+void UColorPickerWidget::AcquireMaterialInstances()
+{
+	if (bMaterialInstancesAcquired)
+		return;
+
+	COLORPICKER_SCOPE_CYCLE_COUNTER(STAT_ColorPickerAcquireMaterialInstances, AcquireMaterialInstances);
+	bMaterialInstancesAcquired = true;
+	FColorPickerResourceCache& ResourceCache = FColorPickerResourceCache::Get();
+
+	// CPU texture backend replaces the saturation value material.
+	if (GradientBackend == EColorPickerGradientBackend::CGB_CPU_TEXTURE)
+	{
+		UpdateGradientTextures();
+	}
+	else
+	{
+		SVMat = ResourceCache.GetSaturationValueMaterial();
+		SVMatDynamic = ResourceCache.AcquireMaterialInstance(SVMat);
+	}
+
+	if (SVMatDynamic)
+	{
+		ColorPicker_SV->SetBrushFromMaterial(SVMatDynamic);
+
+		// Cache parameter index once, keeping the material's default value unless picker already set one.
+		if (!bHueParameterSet)
+			SVMatDynamic->GetScalarParameterValue(FMaterialParameterInfo(HueParameterName), LastHueParameter);
+		SVMatDynamic->InitializeScalarParameterAndGetIndex(HueParameterName, LastHueParameter, HueParameterIndex);
+	}
+
+	// Only if using default saturation and value indicator.
+	if (bUsingDefaultIndicator)
+	{
+		SVIndicatorMat = ResourceCache.GetSaturationValueIndicatorMaterial();
+		SVIndicatorMatDynamic = ResourceCache.AcquireMaterialInstance(SVIndicatorMat);
+		if (SVIndicatorMatDynamic)
+		{
+			Indicator_SV->SetBrushFromMaterial(SVIndicatorMatDynamic);
+
+			SVIndicatorMatDynamic->SetVectorParameterValue("BorderColor", BorderColor);
+			SVIndicatorMatDynamic->SetScalarParameterValue("BorderSize", BorderSize);
+			SVIndicatorMatDynamic->SetScalarParameterValue("bUseBorderColor", bUseBorderColor ? 1.f : 0.f);
+
+			if (!bIndicatorColorParameterSet)
+				SVIndicatorMatDynamic->GetVectorParameterValue(FMaterialParameterInfo(IndicatorColorParameterName), LastIndicatorColorParameter);
+			SVIndicatorMatDynamic->InitializeVectorParameterAndGetIndex(IndicatorColorParameterName, LastIndicatorColorParameter, IndicatorColorParameterIndex);
+		}
+	}
+}
+
+void UColorPickerWidget::ReleaseMaterialInstances()
+{
+	if (!bMaterialInstancesAcquired)
+		return;
+
+	bMaterialInstancesAcquired = false;
+
+	// Pooled instances are handed to other pickers, brushes must not keep pointing at them.
+	if (SVMatDynamic && ColorPicker_SV)
+		ColorPicker_SV->SetBrushResourceObject(nullptr);
+	if (SVIndicatorMatDynamic && Indicator_SV)
+		Indicator_SV->SetBrushResourceObject(nullptr);
+
+	// Cache may already be gone when widgets are destroyed after module shutdown.
+	if (FColorPickerResourceCache* ResourceCache = FColorPickerResourceCache::TryGet())
+	{
+		ResourceCache->ReleaseMaterialInstance(SVMatDynamic);
+		ResourceCache->ReleaseMaterialInstance(SVIndicatorMatDynamic);
+	}
+
+	SVMatDynamic = nullptr;
+	SVIndicatorMatDynamic = nullptr;
+	HueParameterIndex = INDEX_NONE;
+	IndicatorColorParameterIndex = INDEX_NONE;
+}
+
+void UColorPickerWidget::RequestGradientTextureUpdate()
+{
+	if (!bCoalesceInput)
+	{
+		UpdateGradientTextures();
+		return;
+	}
+
+	// Regenerated once per frame by 'HandleCoalescedInputTimer', however often hue changes in between.
+	bGradientTexturesDirty = true;
+	if (!CoalescedInputTimer.IsValid())
+	{
+		CoalescedInputTimer = TakeWidget()->RegisterActiveTimer(0.f, FWidgetActiveTimerDelegate::CreateUObject(this, &UColorPickerWidget::HandleCoalescedInputTimer));
+	}
+}
+
+void UColorPickerWidget::UpdateGradientTextures()
+{
+	COLORPICKER_SCOPE_CYCLE_COUNTER(STAT_ColorPickerUpdateGradientTextures, UpdateGradientTextures);
+
+	bGradientTexturesDirty = false;
+
+	const FIntPoint HueSize(FMath::Max(1, FMath::RoundToInt(H_SizeX)), FMath::Max(1, FMath::RoundToInt(H_SizeY)));
+	if (HueGradient.UpdateHueStrip(HueSize))
+	{
+		UTexture2D* Texture = UploadGradientTexture(HueGradientTexture, HueGradient, HueGradientStaging);
+		if (Texture && Texture != HueGradientTexture)
+			ColorPicker_H->SetBrushFromTexture(Texture);
+		else
+			InvalidatePaint(ColorPicker_H);
+		HueGradientTexture = Texture;
+	}
+
+	const FIntPoint SaturationValueSize(FMath::Max(1, FMath::RoundToInt(SV_SizeX)), FMath::Max(1, FMath::RoundToInt(SV_SizeY)));
+	if (SaturationValueGradient.UpdateSaturationValue(SaturationValueSize, CurrentHue))
+	{
+		UTexture2D* Texture = UploadGradientTexture(SaturationValueGradientTexture, SaturationValueGradient, SaturationValueGradientStaging);
+		if (Texture && Texture != SaturationValueGradientTexture)
+			ColorPicker_SV->SetBrushFromTexture(Texture);
+		else
+			InvalidatePaint(ColorPicker_SV);
+		SaturationValueGradientTexture = Texture;
+	}
+}
+
+void UColorPickerWidget::SetHueMaterialParameter(const float Hue)
+{
+	if (!SVMatDynamic)
+	{
+		// Written once material is acquired.
+		LastHueParameter = Hue;
+		bHueParameterSet = true;
+		return;
+	}
+
+	if (HueParameterIndex != INDEX_NONE && FMath::IsNearlyEqual(Hue, LastHueParameter, MaterialParameterTolerance))
+	{
+		COLORPICKER_INC_COUNTER(STAT_ColorPickerMaterialParameterWritesSkipped, MaterialParameterWritesSkipped, 1);
+		return;
+	}
+
+	COLORPICKER_SCOPE_CYCLE_COUNTER(STAT_ColorPickerMaterialParameterWrite, MaterialParameterWrite);
+	if (HueParameterIndex == INDEX_NONE || !SVMatDynamic->SetScalarParameterByIndex(HueParameterIndex, Hue))
+	{
+		SVMatDynamic->InitializeScalarParameterAndGetIndex(HueParameterName, Hue, HueParameterIndex);
+	}
+	InvalidatePaint(ColorPicker_SV);
+	LastHueParameter = Hue;
+	bHueParameterSet = true;
+	COLORPICKER_INC_COUNTER(STAT_ColorPickerMaterialParameterWrites, MaterialParameterWrites, 1);
+}
+
+void UColorPickerWidget::SetIndicatorColorMaterialParameter(const FLinearColor& Color)
+{
+	if (!SVIndicatorMatDynamic)
+	{
+		// Written once material is acquired.
+		LastIndicatorColorParameter = Color;
+		bIndicatorColorParameterSet = true;
+		return;
+	}
+
+	if (IndicatorColorParameterIndex != INDEX_NONE && Color.Equals(LastIndicatorColorParameter, MaterialParameterTolerance))
+	{
+		COLORPICKER_INC_COUNTER(STAT_ColorPickerMaterialParameterWritesSkipped, MaterialParameterWritesSkipped, 1);
+		return;
+	}
+
+	COLORPICKER_SCOPE_CYCLE_COUNTER(STAT_ColorPickerMaterialParameterWrite, MaterialParameterWrite);
+	if (IndicatorColorParameterIndex == INDEX_NONE || !SVIndicatorMatDynamic->SetVectorParameterByIndex(IndicatorColorParameterIndex, Color))
 	{
-		SVIndicatorMatDynamic->SetVectorParameterValue("IndicatorColor", CurrentColor);
+		SVIndicatorMatDynamic->InitializeVectorParameterAndGetIndex(IndicatorColorParameterName, Color, IndicatorColorParameterIndex);
 	}
+	InvalidatePaint(Indicator_SV);
+	LastIndicatorColorParameter = Color;
+	bIndicatorColorParameterSet = true;
+	COLORPICKER_INC_COUNTER(STAT_ColorPickerMaterialParameterWrites, MaterialParameterWrites, 1);
 }
 #pragma endregion
\ No newline at end of file
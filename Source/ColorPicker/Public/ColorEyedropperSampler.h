@@ -0,0 +1,71 @@
+// Copyright kevin791129
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Area averaging eyedropper over a captured image.
+ * A summed-area table of linear colors is built once per capture, after which the average of any square area is four table reads.
+ * Channels are stored as 16-bit linear fixed point, summed with wrapping 32-bit arithmetic. Rectangle sums stay exact as long as they fit
+ * in 32 bits, which bounds the sampling radius to 'MaxRadius'. The table takes 16 bytes per pixel.
+ */
+class COLORPICKER_API FColorEyedropperSampler
+{
+public:
+	/** Largest sampling radius, a (2 * MaxRadius + 1) square of full channels still sums within 32 bits. */
+	static constexpr int32 MaxRadius = 127;
+	/** Image rows, or table columns, per parallel task while building. */
+	static constexpr int32 LinesPerTask = 64;
+
+	/**
+	 * Build table from sRGB pixels, replacing any previous image.
+	 *
+	 * @param Pixels : Image pixels, row major.
+	 * @param InSize : Image size, Pixels must hold InSize.X * InSize.Y pixels.
+	 */
+	void Build(TArrayView<const FColor> Pixels, const FIntPoint& InSize);
+
+	/**
+	 * Build table from linear pixels, replacing any previous image. Channels are clamped to [0, 1].
+	 *
+	 * @param Pixels : Image pixels, row major.
+	 * @param InSize : Image size, Pixels must hold InSize.X * InSize.Y pixels.
+	 */
+	void Build(TArrayView<const FLinearColor> Pixels, const FIntPoint& InSize);
+
+	/**
+	 * Release table memory.
+	 */
+	void Reset();
+
+	bool IsEmpty() const { return Table.Num() == 0; }
+	const FIntPoint& GetSize() const { return Size; }
+
+	/**
+	 * Average color of a square area, clipped to the image.
+	 *
+	 * @param Center : Center pixel.
+	 * @param Radius : Pixels around center in each direction, 0 samples a single pixel. Clamped to [0, MaxRadius].
+	 * @param[out] OutColor : Average linear color including alpha, unchanged if nothing is sampled.
+	 * @return False if no image is built or the area lies outside the image.
+	 */
+	bool Sample(const FIntPoint& Center, const int32 Radius, FLinearColor& OutColor) const;
+
+private:
+	/** Channel sums, modulo 2^32. */
+	struct FSum
+	{
+		uint32 R;
+		uint32 G;
+		uint32 B;
+		uint32 A;
+	};
+
+	template<typename PixelType, typename PixelToFixedType>
+	void BuildTable(const PixelType* Pixels, const FIntPoint& InSize, PixelToFixedType PixelToFixed);
+
+	/** Summed-area table of (Size.X + 1) * (Size.Y + 1) entries, first row and column are zero. */
+	TArray<FSum> Table;
+	FIntPoint Size = FIntPoint::ZeroValue;
+};
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "CoreMinimal.h"
 #include "ColorFormat.generated.h"
 
 UENUM(BlueprintType, meta = (DisplayName = "Color Format"))
@@ -11,7 +12,52 @@ enum class EColorFormat : uint8
 	CF_RBG UMETA(DisplayName = "RGB"),
 	CF_HSV UMETA(DisplayName = "HSV (HSB)"),
 	CF_CMYK UMETA(DisplayName = "CMYK"),
-	CF_HSL UMETA(DisplayName = "HSL")
+	CF_HSL UMETA(DisplayName = "HSL"),
+	CF_LAB UMETA(DisplayName = "CIELAB"),
+	CF_OKLAB UMETA(DisplayName = "OKLab")
 };
 
+UENUM(BlueprintType, meta = (DisplayName = "Color Precision"))
+enum class EColorPrecision : uint8
+{
+	/** Quantize to 8-bit sRGB, results agree with hex and RGB conversions. */
+	CP_8BIT UMETA(DisplayName = "8-bit"),
+	/** Work directly on sRGB floats without quantization. */
+	CP_FLOAT UMETA(DisplayName = "Float")
+};
+
+UENUM(BlueprintType, meta = (DisplayName = "Color Difference"))
+enum class EColorDifference : uint8
+{
+	/** Euclidean distance in CIELAB, cheapest. A difference of about 2.3 is just noticeable. */
+	CD_CIE76 UMETA(DisplayName = "CIE76"),
+	/** Weights chroma and hue by chroma of the first color, not symmetric. */
+	CD_CIE94 UMETA(DisplayName = "CIE94"),
+	/** Current CIE recommendation, corrects blue hues and near neutral colors. */
+	CD_CIEDE2000 UMETA(DisplayName = "CIEDE2000")
+};
+
+/**
+ * Channels of a color in any EColorFormat, in the order of the format name. Unused channels are zero.
+ * RGB and hex use [0.0f, 255.0f] without quantization, other formats use the ranges of their UColorPickerBPLibrary conversions.
+ */
+USTRUCT(BlueprintType)
+struct FColorChannels
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Color")
+	float X = 0.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Color")
+	float Y = 0.f;
 
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Color")
+	float Z = 0.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Color")
+	float W = 0.f;
+
+	FColorChannels() = default;
+	FColorChannels(const float InX, const float InY, const float InZ, const float InW = 0.f) : X(InX), Y(InY), Z(InZ), W(InW) {}
+};
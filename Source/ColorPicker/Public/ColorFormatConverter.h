@@ -0,0 +1,281 @@
+// Copyright kevin791129
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ColorFormat.h"
+#include "ColorMath/ColorMath.h"
+#include "ColorMath/ColorMathSRGB.h"
+#include "ColorMath/ColorMathLab.h"
+
+/**
+ * Direct conversion between any two color formats, in float precision.
+ * RGB based formats (hex, RGB, HSV, CMYK, HSL) meet in unquantized sRGB, perceptual formats (Lab, OKLab) meet in linear RGB and the
+ * sRGB transfer is only applied when a conversion crosses between the two. Pairs with a closed form, such as HSV and HSL, skip RGB entirely.
+ * Results match converting to linear color and back with EColorPrecision::CP_FLOAT up to float rounding, except that direct hue model
+ * conversions keep the hue of grays.
+ */
+namespace ColorFormatConverter
+{
+	/** Number of EColorFormat values. */
+	static constexpr int32 NumFormats = (int32)EColorFormat::CF_OKLAB + 1;
+
+#pragma region Formats
+	/** Common space of RGB based formats, sRGB encoded floats in [0, 1]. */
+	typedef ColorMath::TRGBA<float> FSRGBPivot;
+	/** Common space of perceptual formats, linear RGB. Not clipped to the sRGB gamut. */
+	typedef ColorMath::TRGBA<float> FLinearPivot;
+
+	/**
+	 * Conversion of a format from and to its common space.
+	 */
+	template<EColorFormat Format>
+	struct TFormatTraits;
+
+	template<>
+	struct TFormatTraits<EColorFormat::CF_RBG>
+	{
+		static constexpr bool bLinearPivot = false;
+
+		static FORCEINLINE FSRGBPivot ToPivot(const FColorChannels& Value)
+		{
+			return FSRGBPivot{ Value.X / 255.f, Value.Y / 255.f, Value.Z / 255.f, 1.f };
+		}
+
+		static FORCEINLINE FColorChannels FromPivot(const FSRGBPivot& Color)
+		{
+			return FColorChannels(Color.R * 255.f, Color.G * 255.f, Color.B * 255.f);
+		}
+	};
+
+	/** Hex colors are handled as their RGB channels, strings go through the hex functions of UColorPickerBPLibrary. */
+	template<>
+	struct TFormatTraits<EColorFormat::CF_HEX> : TFormatTraits<EColorFormat::CF_RBG> {};
+
+	template<>
+	struct TFormatTraits<EColorFormat::CF_HSV>
+	{
+		static constexpr bool bLinearPivot = false;
+
+		static FORCEINLINE FSRGBPivot ToPivot(const FColorChannels& Value)
+		{
+			return ColorMath::HSVToRGB<float>(Value.X, Value.Y, Value.Z);
+		}
+
+		static FORCEINLINE FColorChannels FromPivot(const FSRGBPivot& Color)
+		{
+			FColorChannels Value;
+			ColorMath::RGBToHSV(Color.R, Color.G, Color.B, Value.X, Value.Y, Value.Z);
+			return Value;
+		}
+	};
+
+	template<>
+	struct TFormatTraits<EColorFormat::CF_CMYK>
+	{
+		static constexpr bool bLinearPivot = false;
+
+		static FORCEINLINE FSRGBPivot ToPivot(const FColorChannels& Value)
+		{
+			return ColorMath::CMYKToRGB<float>(Value.X, Value.Y, Value.Z, Value.W);
+		}
+
+		static FORCEINLINE FColorChannels FromPivot(const FSRGBPivot& Color)
+		{
+			FColorChannels Value;
+			ColorMath::RGBToCMYK(Color.R, Color.G, Color.B, Value.X, Value.Y, Value.Z, Value.W);
+			return Value;
+		}
+	};
+
+	template<>
+	struct TFormatTraits<EColorFormat::CF_HSL>
+	{
+		static constexpr bool bLinearPivot = false;
+
+		static FORCEINLINE FSRGBPivot ToPivot(const FColorChannels& Value)
+		{
+			return ColorMath::HSLToRGB<float>(Value.X, Value.Y, Value.Z);
+		}
+
+		static FORCEINLINE FColorChannels FromPivot(const FSRGBPivot& Color)
+		{
+			FColorChannels Value;
+			ColorMath::RGBToHSL(Color.R, Color.G, Color.B, Value.X, Value.Y, Value.Z);
+			return Value;
+		}
+	};
+
+	template<>
+	struct TFormatTraits<EColorFormat::CF_LAB>
+	{
+		static constexpr bool bLinearPivot = true;
+
+		static FORCEINLINE FLinearPivot ToPivot(const FColorChannels& Value)
+		{
+			return ColorMath::LabToLinearRGB(ColorMath::TLab<float>{ Value.X, Value.Y, Value.Z });
+		}
+
+		static FORCEINLINE FColorChannels FromPivot(const FLinearPivot& Color)
+		{
+			const ColorMath::TLab<float> Lab = ColorMath::LinearRGBToLab(Color.R, Color.G, Color.B);
+			return FColorChannels(Lab.L, Lab.A, Lab.B);
+		}
+	};
+
+	template<>
+	struct TFormatTraits<EColorFormat::CF_OKLAB>
+	{
+		static constexpr bool bLinearPivot = true;
+
+		static FORCEINLINE FLinearPivot ToPivot(const FColorChannels& Value)
+		{
+			return ColorMath::OKLabToLinearRGB(ColorMath::TLab<float>{ Value.X, Value.Y, Value.Z });
+		}
+
+		static FORCEINLINE FColorChannels FromPivot(const FLinearPivot& Color)
+		{
+			const ColorMath::TLab<float> Lab = ColorMath::LinearRGBToOKLab(Color.R, Color.G, Color.B);
+			return FColorChannels(Lab.L, Lab.A, Lab.B);
+		}
+	};
+#pragma endregion
+
+#pragma region Pivot Transfer
+	/**
+	 * Move a color between common spaces, specialized on whether source and destination are linear.
+	 */
+	template<bool bFromLinear, bool bToLinear>
+	struct TPivotTransfer
+	{
+		static FORCEINLINE ColorMath::TRGBA<float> Transfer(const ColorMath::TRGBA<float>& Color) { return Color; }
+	};
+
+	/** Leaving linear space clips to the sRGB gamut. */
+	template<>
+	struct TPivotTransfer<true, false>
+	{
+		static FORCEINLINE FSRGBPivot Transfer(const FLinearPivot& Color)
+		{
+			return FSRGBPivot{ ColorMath::SRGB::EncodeReal(Color.R), ColorMath::SRGB::EncodeReal(Color.G), ColorMath::SRGB::EncodeReal(Color.B), 1.f };
+		}
+	};
+
+	template<>
+	struct TPivotTransfer<false, true>
+	{
+		static FORCEINLINE FLinearPivot Transfer(const FSRGBPivot& Color)
+		{
+			return FLinearPivot{ ColorMath::SRGB::DecodeReal(Color.R), ColorMath::SRGB::DecodeReal(Color.G), ColorMath::SRGB::DecodeReal(Color.B), 1.f };
+		}
+	};
+#pragma endregion
+
+#pragma region Converters
+	/**
+	 * Converter from one format to another, through the common spaces unless specialized with a direct formula.
+	 */
+	template<EColorFormat From, EColorFormat To>
+	struct TConverter
+	{
+		static FORCEINLINE FColorChannels Convert(const FColorChannels& Value)
+		{
+			typedef TFormatTraits<From> FromTraits;
+			typedef TFormatTraits<To> ToTraits;
+			return ToTraits::FromPivot(TPivotTransfer<FromTraits::bLinearPivot, ToTraits::bLinearPivot>::Transfer(FromTraits::ToPivot(Value)));
+		}
+	};
+
+	template<EColorFormat Format>
+	struct TConverter<Format, Format>
+	{
+		static FORCEINLINE FColorChannels Convert(const FColorChannels& Value) { return Value; }
+	};
+
+	template<>
+	struct TConverter<EColorFormat::CF_HEX, EColorFormat::CF_RBG>
+	{
+		static FORCEINLINE FColorChannels Convert(const FColorChannels& Value) { return Value; }
+	};
+
+	template<>
+	struct TConverter<EColorFormat::CF_RBG, EColorFormat::CF_HEX>
+	{
+		static FORCEINLINE FColorChannels Convert(const FColorChannels& Value) { return Value; }
+	};
+
+	template<>
+	struct TConverter<EColorFormat::CF_HSV, EColorFormat::CF_HSL>
+	{
+		static FORCEINLINE FColorChannels Convert(const FColorChannels& Value)
+		{
+			FColorChannels Result;
+			ColorMath::HSVToHSL(Value.X, Value.Y, Value.Z, Result.X, Result.Y, Result.Z);
+			return Result;
+		}
+	};
+
+	template<>
+	struct TConverter<EColorFormat::CF_HSL, EColorFormat::CF_HSV>
+	{
+		static FORCEINLINE FColorChannels Convert(const FColorChannels& Value)
+		{
+			FColorChannels Result;
+			ColorMath::HSLToHSV(Value.X, Value.Y, Value.Z, Result.X, Result.Y, Result.Z);
+			return Result;
+		}
+	};
+
+	/**
+	 * Convert a color between formats chosen at compile time.
+	 *
+	 * @param Value : Color in From format.
+	 * @return Color in To format.
+	 */
+	template<EColorFormat From, EColorFormat To>
+	FORCEINLINE FColorChannels Convert(const FColorChannels& Value)
+	{
+		return TConverter<From, To>::Convert(Value);
+	}
+
+	/**
+	 * Convert colors between formats chosen at compile time.
+	 *
+	 * @param Values : Colors in From format.
+	 * @param[out] OutValues : Colors in To format, same length as Values. May be the same array as Values.
+	 */
+	template<EColorFormat From, EColorFormat To>
+	void ConvertBatch(TArrayView<const FColorChannels> Values, TArrayView<FColorChannels> OutValues)
+	{
+		check(OutValues.Num() == Values.Num());
+
+		for (int32 Index = 0; Index < Values.Num(); ++Index)
+		{
+			OutValues[Index] = TConverter<From, To>::Convert(Values[Index]);
+		}
+	}
+#pragma endregion
+
+#pragma region Runtime Dispatch
+	typedef FColorChannels (*FConvertFunction)(const FColorChannels& Value);
+	typedef void (*FConvertBatchFunction)(TArrayView<const FColorChannels> Values, TArrayView<FColorChannels> OutValues);
+
+	/**
+	 * Converter of a format pair chosen at runtime. Look it up once when formats change and call it per color.
+	 */
+	struct FConverter
+	{
+		FConvertFunction Convert;
+		FConvertBatchFunction ConvertBatch;
+	};
+
+	/**
+	 * Get converter of a format pair from the dispatch table.
+	 *
+	 * @param From : Source format.
+	 * @param To : Destination format.
+	 * @return Converter, same functions as 'Convert' and 'ConvertBatch' instantiated for the pair.
+	 */
+	COLORPICKER_API const FConverter& GetConverter(const EColorFormat From, const EColorFormat To);
+#pragma endregion
+}
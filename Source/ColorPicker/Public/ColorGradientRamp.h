@@ -0,0 +1,163 @@
+// Copyright kevin791129
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Color space gradient ramp stops are interpolated in.
+ */
+enum class EColorRampInterpolation : uint8
+{
+	/** Linear RGB, physically even blending. */
+	CRI_LINEAR,
+	/** sRGB encoded RGB, as image editors blend. */
+	CRI_SRGB,
+	/** HSV (HSB) along the shorter hue arc. */
+	CRI_HSV,
+	/** HSL along the shorter hue arc. */
+	CRI_HSL,
+	/** OKLab, perceptually even blending. */
+	CRI_OKLAB
+};
+
+/**
+ * Gradient ramp stop.
+ */
+struct FColorRampStop
+{
+	/** Ramp time, range: [0, 1]. */
+	float Time;
+	/** Linear color. */
+	FLinearColor Color;
+};
+
+/**
+ * Multi-stop color gradient sampled through a lookup table.
+ * The table is baked lazily on the first sample after stops, interpolation or resolution change, so sampling costs two table reads and a
+ * lerp regardless of stop count or color space. Alpha is always interpolated linearly. Only linear RGB interpolation keeps channels outside
+ * [0, 1] between stops, other spaces clamp them.
+ * Sampling is safe from multiple threads once baked, call 'Bake' after changes when sampling from several threads.
+ */
+class COLORPICKER_API FColorGradientRamp
+{
+public:
+	/** Default table entries, evenly spaced over [0, 1]. */
+	static constexpr int32 DefaultResolution = 256;
+	/** Samples per parallel task in batch sampling. */
+	static constexpr int32 BatchChunkSize = 4096;
+
+	explicit FColorGradientRamp(const EColorRampInterpolation InInterpolation = EColorRampInterpolation::CRI_LINEAR, const int32 InResolution = DefaultResolution);
+
+	/**
+	 * Replace all stops.
+	 *
+	 * @param InStops : Stops in any order, times are clamped to [0, 1]. Stops at the same time keep their order, giving a hard edge.
+	 */
+	void SetStops(TArrayView<const FColorRampStop> InStops);
+
+	/**
+	 * Insert a stop, after existing stops at the same time.
+	 *
+	 * @param Time : Ramp time, clamped to [0, 1].
+	 * @param Color : Linear color.
+	 */
+	void AddStop(const float Time, const FLinearColor& Color);
+
+	/**
+	 * Remove all stops.
+	 */
+	void ClearStops();
+
+	/** Stops sorted by time. */
+	const TArray<FColorRampStop>& GetStops() const { return Stops; }
+
+	void SetInterpolation(const EColorRampInterpolation InInterpolation);
+	EColorRampInterpolation GetInterpolation() const { return Interpolation; }
+
+	/**
+	 * Set table entries, more entries follow sharp stops more closely.
+	 *
+	 * @param InResolution : Table entries, clamped to at least 2.
+	 */
+	void SetResolution(const int32 InResolution);
+	int32 GetResolution() const { return Resolution; }
+
+	/**
+	 * Bake table now if stops changed since it was last baked.
+	 */
+	void Bake() const;
+
+	/**
+	 * Interpolate stops directly without the table, reference for sampling.
+	 *
+	 * @param Time : Ramp time, clamped to [0, 1].
+	 * @return Linear color, transparent black if there are no stops.
+	 */
+	FLinearColor Evaluate(const float Time) const;
+
+	/**
+	 * Sample ramp, lerping between the two nearest table entries.
+	 *
+	 * @param Time : Ramp time, clamped to [0, 1]. NaN samples the first stop.
+	 * @return Linear color, transparent black if there are no stops.
+	 */
+	FLinearColor Sample(const float Time) const
+	{
+		Bake();
+		return SampleBaked(Time);
+	}
+
+	/**
+	 * Sample ramp at many times in parallel.
+	 *
+	 * @param Times : Ramp times.
+	 * @param[out] OutColors : Linear colors, same size as Times.
+	 */
+	void SampleBatch(TArrayView<const float> Times, TArrayView<FLinearColor> OutColors) const;
+
+	/**
+	 * Sample ramp at many times in parallel as sRGB colors, such as vertex colors. Takes the nearest table entry.
+	 *
+	 * @param Times : Ramp times.
+	 * @param[out] OutColors : sRGB colors, same size as Times.
+	 */
+	void SampleBatch(TArrayView<const float> Times, TArrayView<FColor> OutColors) const;
+
+private:
+	/**
+	 * Sample baked table.
+	 */
+	FORCEINLINE FLinearColor SampleBaked(const float Time) const
+	{
+		// Comparisons are false for NaN, which clamps to 0.
+		const float Clamped = Time > 0.f ? (Time < 1.f ? Time : 1.f) : 0.f;
+		const float Position = Clamped * (float)(Resolution - 1);
+		const int32 Index = FMath::Min((int32)Position, Resolution - 2);
+		const float Alpha = Position - (float)Index;
+		const FLinearColor& From = Table[Index];
+		const FLinearColor& To = Table[Index + 1];
+		return From + (To - From) * Alpha;
+	}
+
+	FORCEINLINE const FColor& SampleBakedNearest(const float Time) const
+	{
+		const float Clamped = Time > 0.f ? (Time < 1.f ? Time : 1.f) : 0.f;
+		return ColorTable[(int32)(Clamped * (float)(Resolution - 1) + 0.5f)];
+	}
+
+	/**
+	 * Mark table as out of date.
+	 */
+	void Invalidate() { bTableDirty = true; }
+
+	TArray<FColorRampStop> Stops;
+	EColorRampInterpolation Interpolation;
+	int32 Resolution;
+
+	/** Linear colors at evenly spaced times, always holds Resolution entries once baked. */
+	mutable TArray<FLinearColor> Table;
+	/** Table encoded to sRGB. */
+	mutable TArray<FColor> ColorTable;
+	mutable bool bTableDirty = true;
+};
@@ -0,0 +1,70 @@
+// Copyright kevin791129
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * CPU rasterizer for the picker gradients, producing the same 8-bit sRGB colors as UColorPickerBPLibrary::HSVToLinearColor before linearization.
+ * Pixels are sampled at their centers, hue runs top to bottom in the hue strip, saturation left to right and value bottom to top in the saturation value square.
+ */
+namespace ColorGradientRasterizer
+{
+	/** Rows filled by one parallel task. */
+	static constexpr int32 RowsPerTile = 32;
+
+	/**
+	 * Fill hue strip, every row has a single fully saturated hue.
+	 *
+	 * @param[out] OutPixels : Row major pixels, must hold Width * Height colors.
+	 * @param Width, Height : Strip size in pixels.
+	 */
+	COLORPICKER_API void FillHueStrip(FColor* OutPixels, const int32 Width, const int32 Height);
+
+	/**
+	 * Fill saturation value square for a hue.
+	 *
+	 * @param[out] OutPixels : Row major pixels, must hold Width * Height colors.
+	 * @param Width, Height : Square size in pixels.
+	 * @param Hue : Hue, range: [0, 360].
+	 */
+	COLORPICKER_API void FillSaturationValue(FColor* OutPixels, const int32 Width, const int32 Height, const float Hue);
+}
+
+/**
+ * Gradient pixel buffer regenerated only when its size or hue changes.
+ */
+class COLORPICKER_API FColorGradientBuffer
+{
+public:
+	/**
+	 * Make buffer hold a hue strip of size.
+	 *
+	 * @return True if pixels were regenerated.
+	 */
+	bool UpdateHueStrip(const FIntPoint& InSize);
+
+	/**
+	 * Make buffer hold a saturation value square of size for hue.
+	 *
+	 * @return True if pixels were regenerated.
+	 */
+	bool UpdateSaturationValue(const FIntPoint& InSize, const float InHue);
+
+	const TArray<FColor>& GetPixels() const { return Pixels; }
+	const FIntPoint& GetSize() const { return Size; }
+
+private:
+	/** Which gradient the buffer holds. */
+	enum class EGradient : uint8
+	{
+		None,
+		HueStrip,
+		SaturationValue
+	};
+
+	TArray<FColor> Pixels;
+	FIntPoint Size = FIntPoint::ZeroValue;
+	float Hue = 0.f;
+	EGradient Gradient = EGradient::None;
+};
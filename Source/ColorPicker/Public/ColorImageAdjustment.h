@@ -0,0 +1,169 @@
+// Copyright kevin791129
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ColorPaletteExtractor.h"
+#include "HAL/ThreadSafeBool.h"
+
+/**
+ * Color adjustment operation.
+ */
+enum class EColorAdjustmentOp : uint8
+{
+	/** Rotate hue by Amount degrees. */
+	CAO_HUE_SHIFT,
+	/** Scale HSV saturation by Amount, clamped to [0, 1]. */
+	CAO_SATURATION_SCALE,
+	/** Scale HSV value by Amount, clamped to [0, 1]. */
+	CAO_VALUE_SCALE,
+	/** Scale HSL lightness by Amount, clamped to [0, 1]. */
+	CAO_LIGHTNESS_SCALE,
+	/** Limit total CMYK ink coverage to Amount, range: [0, 4]. Cyan, magenta and yellow are reduced evenly, black is kept below the limit. */
+	CAO_INK_LIMIT
+};
+
+/**
+ * Single adjustment applied to every pixel.
+ */
+struct FColorAdjustment
+{
+	EColorAdjustmentOp Op;
+	/** Degrees for hue shift, factor for scales, coverage for ink limit. Scales and limits are clamped to be positive. */
+	float Amount;
+
+	static FColorAdjustment HueShift(const float Degrees) { return { EColorAdjustmentOp::CAO_HUE_SHIFT, Degrees }; }
+	static FColorAdjustment SaturationScale(const float Scale) { return { EColorAdjustmentOp::CAO_SATURATION_SCALE, Scale }; }
+	static FColorAdjustment ValueScale(const float Scale) { return { EColorAdjustmentOp::CAO_VALUE_SCALE, Scale }; }
+	static FColorAdjustment LightnessScale(const float Scale) { return { EColorAdjustmentOp::CAO_LIGHTNESS_SCALE, Scale }; }
+	static FColorAdjustment InkLimit(const float Coverage) { return { EColorAdjustmentOp::CAO_INK_LIMIT, Coverage }; }
+};
+
+/**
+ * Ordered list of color adjustments applied to pixel buffers in a single pass.
+ * Adjustments work on sRGB encoded channels like the picker. Consecutive adjustments in the same color space are folded into one stage
+ * when added, so every pixel is converted once per stage, and pixels are read and written once without intermediate buffers.
+ * Pixels are processed four at a time with vector math, in parallel over tiles.
+ */
+class COLORPICKER_API FColorImageAdjustment
+{
+public:
+	/** Pixels adjusted by one parallel task, the unit of progress and cancellation. */
+	static constexpr int32 PixelsPerTile = 16 * 1024;
+
+	FColorImageAdjustment() = default;
+	explicit FColorImageAdjustment(TArrayView<const FColorAdjustment> Adjustments);
+
+	/**
+	 * Append an adjustment, applied after those added before.
+	 */
+	void Add(const FColorAdjustment& Adjustment);
+
+	/**
+	 * Remove all adjustments.
+	 */
+	void Reset() { Stages.Reset(); }
+
+	/** If there are no adjustments, pixels are then only copied. */
+	bool IsIdentity() const { return Stages.Num() == 0; }
+
+	/** Number of color space conversions per pixel after folding. */
+	int32 NumStages() const { return Stages.Num(); }
+
+	/**
+	 * Adjust pixels, source and destination may be the same buffer.
+	 *
+	 * @param Source : Pixels to adjust, alpha is kept.
+	 * @param[out] Dest : Adjusted pixels, same number as Source.
+	 * @param Progress : Optional progress and cancellation, pixels of tiles not yet adjusted when cancelled are left unchanged.
+	 * @return False if cancelled.
+	 */
+	bool Apply(TArrayView<const FColor> Source, TArrayView<FColor> Dest, FColorPaletteProgress* Progress = nullptr) const;
+
+	/**
+	 * Adjust linear pixels, channels are sRGB encoded, adjusted and decoded, so values are clamped to [0, 1].
+	 */
+	bool Apply(TArrayView<const FLinearColor> Source, TArrayView<FLinearColor> Dest, FColorPaletteProgress* Progress = nullptr) const;
+
+	/** Color space a stage converts to. */
+	enum class EStageSpace : uint8
+	{
+		HSV,
+		HSL,
+		CMYK
+	};
+
+	/** Channel mapping x to min(x * Scale, Max), closed under composition. */
+	struct FChannelScale
+	{
+		float Scale = 1.f;
+		float Max = 1.f;
+	};
+
+	/** Folded adjustments sharing one color space conversion. */
+	struct FStage
+	{
+		EStageSpace Space;
+		/** Hue offset in [0, 360), for HSV and HSL stages. */
+		float HueOffset = 0.f;
+		/** HSV or HSL saturation. */
+		FChannelScale Saturation;
+		/** HSV value or HSL lightness. */
+		FChannelScale Brightness;
+		/** Total ink coverage limit, for CMYK stages. */
+		float InkLimit = 4.f;
+	};
+
+	const TArray<FStage>& GetStages() const { return Stages; }
+
+private:
+	TArray<FStage> Stages;
+};
+
+DECLARE_DELEGATE_OneParam(FOnColorImageAdjusted, TArray<FColor>&);
+
+/**
+ * Image adjustment running on the thread pool. Delegates are executed on the game thread, progress is reported at most every 'ProgressInterval' seconds.
+ */
+class COLORPICKER_API FColorImageAdjustmentTask : public TSharedFromThis<FColorImageAdjustmentTask, ESPMode::ThreadSafe>
+{
+public:
+	/** Seconds between progress reports. */
+	static constexpr float ProgressInterval = 0.1f;
+
+	/**
+	 * Start adjustment, must be called on the game thread. Pixels are adjusted in place.
+	 *
+	 * @param Pixels : Image pixels, owned by the task until adjustment finishes.
+	 * @param Adjustment : Adjustments, copied.
+	 * @param OnAdjusted : Executed with adjusted pixels when done, which may be moved out. Not executed if cancelled.
+	 * @param OnProgress : Optional, executed with progress in range [0, 1] while running.
+	 * @return Running task.
+	 */
+	static TSharedRef<FColorImageAdjustmentTask, ESPMode::ThreadSafe> Launch(TArray<FColor>&& Pixels, const FColorImageAdjustment& Adjustment, FOnColorImageAdjusted OnAdjusted, FOnColorPaletteProgress OnProgress = FOnColorPaletteProgress());
+
+	/**
+	 * Stop adjustment, no delegate is executed after this returns.
+	 */
+	void Cancel();
+
+	float GetProgress() const { return Progress.GetProgress(); }
+	bool IsDone() const { return bDone; }
+
+private:
+	FColorImageAdjustmentTask(TArray<FColor>&& InPixels, const FColorImageAdjustment& InAdjustment, FOnColorImageAdjusted InOnAdjusted, FOnColorPaletteProgress InOnProgress);
+
+	/**
+	 * Game thread ticker reporting progress and result.
+	 */
+	bool Tick(float DeltaTime);
+
+	TArray<FColor> Pixels;
+	FColorImageAdjustment Adjustment;
+	FOnColorImageAdjusted OnAdjusted;
+	FOnColorPaletteProgress OnProgress;
+
+	FColorPaletteProgress Progress;
+	FThreadSafeBool bDone;
+	FDelegateHandle TickerHandle;
+};
@@ -0,0 +1,299 @@
+// Copyright kevin791129
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+
+/**
+ * Engine independent color math core, header-only so it can be built without an engine install.
+ * RGB channel types are either uint8_t (range [0, 255]) or floating point (range [0, 1]), real types are float or double.
+ * With uint8_t channels and float reals every function reproduces the 8-bit conversions of UColorPickerBPLibrary bit for bit.
+ */
+namespace ColorMath
+{
+	/**
+	 * Channel type description.
+	 */
+	template<typename ChannelType>
+	struct TChannelTraits
+	{
+		/** Value of a full channel. */
+		static constexpr ChannelType Max = ChannelType(1);
+
+		/** Convert real value already scaled by Max to channel value. */
+		template<typename RealType>
+		static inline ChannelType FromReal(const RealType Value) { return ChannelType(Value); }
+	};
+
+	template<>
+	struct TChannelTraits<uint8_t>
+	{
+		static constexpr uint8_t Max = 255;
+
+		/** Truncates, same as constructing an FColor from floats. */
+		template<typename RealType>
+		static inline uint8_t FromReal(const RealType Value) { return (uint8_t)Value; }
+	};
+
+	/**
+	 * RGB color with alpha.
+	 */
+	template<typename ChannelType>
+	struct TRGBA
+	{
+		ChannelType R;
+		ChannelType G;
+		ChannelType B;
+		ChannelType A;
+	};
+
+	/** RGB value indices for each hue sector, shared by HSV and HSL conversions. */
+	static constexpr uint32_t HueSectorSwizzle[6][3] = {
+		{0, 3, 1},
+		{2, 0, 1},
+		{1, 0, 3},
+		{1, 2, 0},
+		{3, 1, 0},
+		{0, 1, 2},
+	};
+
+	/** Clamp with engine semantics, NaN clamps to Max. */
+	template<typename T>
+	inline T Clamp(const T X, const T Min, const T Max)
+	{
+		return X < Min ? Min : X < Max ? X : Max;
+	}
+
+	template<typename T>
+	inline T Min3(const T A, const T B, const T C)
+	{
+		return A < B ? (A < C ? A : C) : (B < C ? B : C);
+	}
+
+	template<typename T>
+	inline T Max3(const T A, const T B, const T C)
+	{
+		return A > B ? (A > C ? A : C) : (B > C ? B : C);
+	}
+
+	//~ Begin RGB To
+	/**
+	 * Hue from RGB channels.
+	 *
+	 * @return Hue, range: [0, 360).
+	 */
+	template<typename RealType, typename ChannelType>
+	inline RealType RGBToHue(const ChannelType R, const ChannelType G, const ChannelType B, const RealType RGBMin, const RealType RGBMax, const RealType RGBRange)
+	{
+		if (RGBMax == RGBMin)
+			return RealType(0);
+
+		if (RGBMax == (RealType)R)
+		{
+			// Red hue lies in [300, 420], wrapping is a single exact subtraction.
+			const RealType Hue = (((RealType)G - (RealType)B) / RGBRange) * RealType(60) + RealType(360);
+			return Hue >= RealType(360) ? Hue - RealType(360) : Hue;
+		}
+		if (RGBMax == (RealType)G)
+			return (((RealType)B - (RealType)R) / RGBRange) * RealType(60) + RealType(120);
+		if (RGBMax == (RealType)B)
+			return (((RealType)R - (RealType)G) / RGBRange) * RealType(60) + RealType(240);
+
+		return RealType(0);
+	}
+
+	/**
+	 * RGB to HSV (HSB).
+	 *
+	 * @param R, G, B : RGB channels.
+	 * @param[out] OutH : Hue, range: [0, 360).
+	 * @param[out] OutS : Saturation, range: [0, 1].
+	 * @param[out] OutV : Value, range: [0, 1].
+	 */
+	template<typename RealType, typename ChannelType>
+	inline void RGBToHSV(const ChannelType R, const ChannelType G, const ChannelType B, RealType& OutH, RealType& OutS, RealType& OutV)
+	{
+		const RealType RGBMin = (RealType)Min3(R, G, B);
+		const RealType RGBMax = (RealType)Max3(R, G, B);
+		const RealType RGBRange = RGBMax - RGBMin;
+
+		OutH = RGBToHue(R, G, B, RGBMin, RGBMax, RGBRange);
+		OutS = RGBMax == RealType(0) ? RealType(0) : RGBRange / RGBMax;
+		OutV = RGBMax / (RealType)TChannelTraits<ChannelType>::Max;
+	}
+
+	/**
+	 * RGB to CMYK. Black input gives NaN for C, M and Y, same as the library.
+	 *
+	 * @param R, G, B : RGB channels.
+	 * @param[out] OutC, OutM, OutY, OutK : CMYK values, range: [0, 1].
+	 */
+	template<typename RealType, typename ChannelType>
+	inline void RGBToCMYK(const ChannelType R, const ChannelType G, const ChannelType B, RealType& OutC, RealType& OutM, RealType& OutY, RealType& OutK)
+	{
+		const RealType Max = (RealType)Max3(R, G, B);
+
+		OutC = (Max - (RealType)R) / Max;
+		OutM = (Max - (RealType)G) / Max;
+		OutY = (Max - (RealType)B) / Max;
+		OutK = RealType(1) - Max / (RealType)TChannelTraits<ChannelType>::Max;
+	}
+
+	/**
+	 * RGB to HSL. White gives NaN for S, same as the library.
+	 *
+	 * @param R, G, B : RGB channels.
+	 * @param[out] OutH : Hue, range: [0, 360).
+	 * @param[out] OutS : Saturation, range: [0, 1].
+	 * @param[out] OutL : Lightness, range: [0, 1].
+	 */
+	template<typename RealType, typename ChannelType>
+	inline void RGBToHSL(const ChannelType R, const ChannelType G, const ChannelType B, RealType& OutH, RealType& OutS, RealType& OutL)
+	{
+		const RealType Full = (RealType)TChannelTraits<ChannelType>::Max;
+		const RealType RGBMin = (RealType)Min3(R, G, B);
+		const RealType RGBMax = (RealType)Max3(R, G, B);
+		const RealType RGBRange = RGBMax - RGBMin;
+		const RealType RGBSum = RGBMax + RGBMin;
+
+		OutH = RGBToHue(R, G, B, RGBMin, RGBMax, RGBRange);
+		OutS = RGBMax == RealType(0) ? RealType(0) : RGBRange / (Full - std::abs(RGBSum - Full));
+		OutL = RGBSum / (Full * RealType(2));
+	}
+	//~ End RGB To
+
+	//~ Begin To RGB
+	/**
+	 * Pick RGB channels for a hue sector.
+	 */
+	template<typename ChannelType, typename RealType>
+	inline TRGBA<ChannelType> SwizzleHueSector(const RealType HDiv60_Floor, const RealType RGBValues[4])
+	{
+		const uint32_t SwizzleIndex = ((uint32_t)HDiv60_Floor) % 6;
+
+		return TRGBA<ChannelType>{
+			TChannelTraits<ChannelType>::FromReal(RGBValues[HueSectorSwizzle[SwizzleIndex][0]]),
+			TChannelTraits<ChannelType>::FromReal(RGBValues[HueSectorSwizzle[SwizzleIndex][1]]),
+			TChannelTraits<ChannelType>::FromReal(RGBValues[HueSectorSwizzle[SwizzleIndex][2]]),
+			TChannelTraits<ChannelType>::Max
+		};
+	}
+
+	/**
+	 * HSV (HSB) to RGB. Invalid input values will be clamped.
+	 *
+	 * @param H : Hue, range: [0, 360).
+	 * @param S : Saturation, range: [0, 1].
+	 * @param V : Value, range: [0, 1].
+	 * @return RGB color with full alpha.
+	 */
+	template<typename ChannelType, typename RealType>
+	inline TRGBA<ChannelType> HSVToRGB(const RealType H, const RealType S, const RealType V)
+	{
+		const RealType Full = (RealType)TChannelTraits<ChannelType>::Max;
+		const RealType HClamp = Clamp(H, RealType(0), RealType(360));
+		const RealType SClamp = Clamp(S, RealType(0), RealType(1));
+		const RealType VClamp = Clamp(V, RealType(0), RealType(1));
+		const RealType HDiv60 = HClamp / RealType(60);
+		const RealType HDiv60_Floor = std::floor(HDiv60);
+		const RealType HDiv60_Fraction = HDiv60 - HDiv60_Floor;
+		const RealType RGBValues[4] = {
+			VClamp * Full,
+			VClamp * (RealType(1) - SClamp) * Full,
+			VClamp * (RealType(1) - (HDiv60_Fraction * SClamp)) * Full,
+			VClamp * (RealType(1) - ((RealType(1) - HDiv60_Fraction) * SClamp)) * Full
+		};
+
+		return SwizzleHueSector<ChannelType>(HDiv60_Floor, RGBValues);
+	}
+
+	/**
+	 * CMYK to RGB. Invalid input values will be clamped.
+	 *
+	 * @param C, M, Y, K : CMYK values, range: [0, 1].
+	 * @return RGB color with full alpha.
+	 */
+	template<typename ChannelType, typename RealType>
+	inline TRGBA<ChannelType> CMYKToRGB(const RealType C, const RealType M, const RealType Y, const RealType K)
+	{
+		const RealType Full = (RealType)TChannelTraits<ChannelType>::Max;
+		const RealType KInverse = RealType(1) - Clamp(K, RealType(0), RealType(1));
+
+		return TRGBA<ChannelType>{
+			TChannelTraits<ChannelType>::FromReal(Full * (RealType(1) - Clamp(C, RealType(0), RealType(1))) * KInverse),
+			TChannelTraits<ChannelType>::FromReal(Full * (RealType(1) - Clamp(M, RealType(0), RealType(1))) * KInverse),
+			TChannelTraits<ChannelType>::FromReal(Full * (RealType(1) - Clamp(Y, RealType(0), RealType(1))) * KInverse),
+			TChannelTraits<ChannelType>::Max
+		};
+	}
+
+	/**
+	 * HSL to RGB. Invalid input values will be clamped.
+	 *
+	 * @param H : Hue, range: [0, 360).
+	 * @param S : Saturation, range: [0, 1].
+	 * @param L : Lightness, range: [0, 1].
+	 * @return RGB color with full alpha.
+	 */
+	template<typename ChannelType, typename RealType>
+	inline TRGBA<ChannelType> HSLToRGB(const RealType H, const RealType S, const RealType L)
+	{
+		const RealType Full = (RealType)TChannelTraits<ChannelType>::Max;
+		const RealType HClamp = Clamp(H, RealType(0), RealType(360));
+		const RealType SClamp = Clamp(S, RealType(0), RealType(1));
+		const RealType LClamp = Clamp(L, RealType(0), RealType(1));
+		const RealType CHalf = (RealType(1) - std::abs(RealType(2) * LClamp - RealType(1))) * SClamp / RealType(2);
+		const RealType HDiv60 = HClamp / RealType(60);
+		const RealType HDiv60_Floor = std::floor(HDiv60);
+		const RealType HDiv60_Fraction_Double = (HDiv60 - HDiv60_Floor) * RealType(2);
+		const RealType RGBValues[4] = {
+			(LClamp + CHalf) * Full,
+			(LClamp - CHalf) * Full,
+			(LClamp + CHalf * (RealType(1) - HDiv60_Fraction_Double)) * Full,
+			(LClamp + CHalf * (HDiv60_Fraction_Double - RealType(1))) * Full
+		};
+
+		return SwizzleHueSector<ChannelType>(HDiv60_Floor, RGBValues);
+	}
+	//~ End To RGB
+
+	//~ Begin Hue Models
+	/**
+	 * HSV (HSB) to HSL without an RGB stage. Invalid input values will be clamped, hue is kept even for grays.
+	 *
+	 * @param H, S, V : HSV color.
+	 * @param[out] OutH, OutS, OutL : HSL color.
+	 */
+	template<typename RealType>
+	inline void HSVToHSL(const RealType H, const RealType S, const RealType V, RealType& OutH, RealType& OutS, RealType& OutL)
+	{
+		const RealType SClamp = Clamp(S, RealType(0), RealType(1));
+		const RealType VClamp = Clamp(V, RealType(0), RealType(1));
+		const RealType L = VClamp * (RealType(1) - SClamp * RealType(0.5));
+		const RealType LDistance = L < RealType(1) - L ? L : RealType(1) - L;
+
+		OutH = Clamp(H, RealType(0), RealType(360));
+		OutS = LDistance > RealType(0) ? (VClamp - L) / LDistance : RealType(0);
+		OutL = L;
+	}
+
+	/**
+	 * HSL to HSV (HSB) without an RGB stage. Invalid input values will be clamped, hue is kept even for grays.
+	 *
+	 * @param H, S, L : HSL color.
+	 * @param[out] OutH, OutS, OutV : HSV color.
+	 */
+	template<typename RealType>
+	inline void HSLToHSV(const RealType H, const RealType S, const RealType L, RealType& OutH, RealType& OutS, RealType& OutV)
+	{
+		const RealType SClamp = Clamp(S, RealType(0), RealType(1));
+		const RealType LClamp = Clamp(L, RealType(0), RealType(1));
+		const RealType V = LClamp + SClamp * (LClamp < RealType(1) - LClamp ? LClamp : RealType(1) - LClamp);
+
+		OutH = Clamp(H, RealType(0), RealType(360));
+		OutS = V > RealType(0) ? RealType(2) * (RealType(1) - LClamp / V) : RealType(0);
+		OutV = V;
+	}
+	//~ End Hue Models
+}
@@ -0,0 +1,267 @@
+// Copyright kevin791129
+
+#pragma once
+
+#include <cstdint>
+#include "ColorMath/ColorMath.h"
+
+/**
+ * Engine independent fixed-point conversions between 8-bit RGB and packed HSV8 / HSL8, for pipelines whose data is already 8-bit.
+ * Only integer adds, multiplies, shifts, selects and table reads, with no floating point and no divisions, so loops over arrays vectorize.
+ * Quotients are rounded to nearest with ties up through reciprocal tables built at compile time, all intermediates fit 32 bits.
+ *
+ * Hue is stored in HueSteps (1536) units per turn, 256 per 60 degree sector, 'HueToByte' packs it into 256 units per turn.
+ * Saturation, value and lightness range from 0 to 255.
+ * Error bounds, checked exhaustively over all 2^24 RGB colors and all 1536 x 256 x 256 HSV8 / HSL8 values against the float ColorMath
+ * functions:
+ * - RGB to HSV8 / HSL8: hue within 0.5 units (0.12 degrees), saturation, value and lightness within 0.5, i.e. correctly rounded.
+ * - HSV8 / HSL8 to RGB: correctly rounded, channels within 1 of the float conversion, which truncates.
+ * - RGB to HSV8 to RGB: channels within 1 of the original color, exact for grays and fully saturated colors.
+ * - RGB to HSL8 to RGB: channels within 2 of the original color, exact for grays.
+ */
+namespace ColorMath
+{
+	namespace Fixed
+	{
+		/** Hue units per 60 degree sector. */
+		static constexpr uint32_t HueSectorSteps = 256;
+		/** Hue units per turn. */
+		static constexpr uint32_t HueSteps = HueSectorSteps * 6;
+
+		/**
+		 * Packed HSV (HSB) color, 4 bytes.
+		 */
+		struct FHSV8
+		{
+			/** Hue, range: [0, HueSteps). */
+			uint16_t H;
+			/** Saturation, range: [0, 255]. */
+			uint8_t S;
+			/** Value, range: [0, 255]. */
+			uint8_t V;
+		};
+
+		/**
+		 * Packed HSL color, 4 bytes.
+		 */
+		struct FHSL8
+		{
+			/** Hue, range: [0, HueSteps). */
+			uint16_t H;
+			/** Saturation, range: [0, 255]. */
+			uint8_t S;
+			/** Lightness, range: [0, 255]. */
+			uint8_t L;
+		};
+
+		//~ Begin Arithmetic
+		/** Fraction bits of the reciprocal tables. */
+		static constexpr uint32_t ReciprocalShift = 23;
+
+		/**
+		 * Reciprocals Numerator / D for D in [1, 255] with ReciprocalShift fraction bits, rounded up. Entry 0 is 0.
+		 */
+		struct FReciprocalTable
+		{
+			uint32_t Values[256];
+		};
+
+		constexpr FReciprocalTable MakeReciprocalTable(const uint32_t Numerator)
+		{
+			FReciprocalTable Table = {};
+			for (uint32_t Divisor = 1; Divisor < 256; ++Divisor)
+			{
+				Table.Values[Divisor] = (uint32_t)((((uint64_t)Numerator << ReciprocalShift) + Divisor - 1) / Divisor);
+			}
+			return Table;
+		}
+
+		/** 255 / D, for saturation. */
+		static constexpr FReciprocalTable Reciprocal255 = MakeReciprocalTable(255);
+		/** HueSectorSteps / D, for hue. */
+		static constexpr FReciprocalTable ReciprocalHue = MakeReciprocalTable(HueSectorSteps);
+
+		/**
+		 * Round X * Numerator / D to nearest, ties up, with a reciprocal from a table of Numerator.
+		 * Exact for X <= D <= 255: the reciprocal overshoots by less than X / 2^23, below the 1 / 510 gap between a quotient and a
+		 * rounding boundary it does not lie on. Zero if D is 0.
+		 */
+		inline uint32_t MulDivRound(const uint32_t X, const uint32_t Reciprocal)
+		{
+			return (X * Reciprocal + (1u << (ReciprocalShift - 1))) >> ReciprocalShift;
+		}
+
+		/**
+		 * Floor of X / 255, exact for X < 2^16.
+		 */
+		inline uint32_t Divide255(const uint32_t X)
+		{
+			return (X * 32897u) >> 23;
+		}
+
+		/**
+		 * Round X / 65280 (255 * 256) to nearest, ties up, exact for X < 2^24.
+		 */
+		inline uint32_t Divide65280Round(const uint32_t X)
+		{
+			// floor(floor(A / 256) / 255) == floor(A / 65280).
+			return Divide255((X + 32640) >> 8);
+		}
+		//~ End Arithmetic
+
+		//~ Begin Hue
+		/**
+		 * Hue from RGB channels, same sector choice as the float conversion.
+		 *
+		 * @return Hue, range: [0, HueSteps).
+		 */
+		inline uint16_t RGBToHue(const uint8_t R, const uint8_t G, const uint8_t B, const uint32_t RGBMax, const uint32_t RGBRange)
+		{
+			const bool bRedMax = RGBMax == R;
+			const bool bGreenMax = !bRedMax && RGBMax == G;
+			const int32_t Difference = bRedMax ? (int32_t)G - (int32_t)B : bGreenMax ? (int32_t)B - (int32_t)R : (int32_t)R - (int32_t)G;
+			const int32_t SectorBase = bRedMax ? 0 : bGreenMax ? (int32_t)(2 * HueSectorSteps) : (int32_t)(4 * HueSectorSteps);
+
+			// Rounded on the magnitude so hues mirror around sector centers. Grays have 0 range and a 0 reciprocal.
+			const int32_t Magnitude = (int32_t)MulDivRound((uint32_t)(Difference < 0 ? -Difference : Difference), ReciprocalHue.Values[RGBRange]);
+			const int32_t Hue = SectorBase + (Difference < 0 ? -Magnitude : Magnitude);
+			return (uint16_t)(Hue < 0 ? Hue + (int32_t)HueSteps : Hue);
+		}
+
+		/**
+		 * Hue in 256 units per turn, for packing hue into a single byte. Rounded, 255.5 and above wrap to 0.
+		 *
+		 * @param H : Hue, range: [0, HueSteps).
+		 */
+		inline uint8_t HueToByte(const uint16_t H)
+		{
+			// Floor of (H + 3) / 6, 43691 / 2^18 exceeds 1 / 6 by less than 1 / (6 * HueSteps).
+			return (uint8_t)((((uint32_t)H + 3) * 43691u) >> 18);
+		}
+
+		/**
+		 * Hue from 256 units per turn.
+		 *
+		 * @return Hue, range: [0, HueSteps).
+		 */
+		inline uint16_t ByteToHue(const uint8_t Byte)
+		{
+			return (uint16_t)(Byte * 6);
+		}
+
+		/**
+		 * Position of a channel between its largest and smallest value along the hue circle, a clamped triangle wave of hue.
+		 * Replaces picking sector values through 'HueSectorSwizzle' with min and max so loops vectorize.
+		 *
+		 * @param H : Hue, range: [0, HueSteps).
+		 * @param Offset : Sectors from the channel's largest value, 5 for red, 3 for green and 1 for blue.
+		 * @return 0 where the channel is largest, HueSectorSteps where it is smallest.
+		 */
+		inline int32_t HueChannelRamp(const uint32_t H, const uint32_t Offset)
+		{
+			const uint32_t Shifted = H + Offset * HueSectorSteps;
+			const int32_t Position = (int32_t)(Shifted >= HueSteps ? Shifted - HueSteps : Shifted);
+			const int32_t Distance = Position < 4 * (int32_t)HueSectorSteps - Position ? Position : 4 * (int32_t)HueSectorSteps - Position;
+			return Clamp(Distance, 0, (int32_t)HueSectorSteps);
+		}
+
+		/**
+		 * Hue clamped to a turn, hue outside a turn is treated as 0.
+		 */
+		inline uint32_t ClampHue(const uint16_t H)
+		{
+			return H < HueSteps ? H : 0;
+		}
+		//~ End Hue
+
+		//~ Begin RGB To
+		/**
+		 * RGB to HSV8.
+		 *
+		 * @param R, G, B : RGB channels.
+		 * @return HSV8 color, black and grays have hue and saturation 0.
+		 */
+		inline FHSV8 RGBToHSV8(const uint8_t R, const uint8_t G, const uint8_t B)
+		{
+			const uint32_t RGBMin = Min3(R, G, B);
+			const uint32_t RGBMax = Max3(R, G, B);
+			const uint32_t RGBRange = RGBMax - RGBMin;
+
+			return FHSV8{
+				RGBToHue(R, G, B, RGBMax, RGBRange),
+				(uint8_t)MulDivRound(RGBRange, Reciprocal255.Values[RGBMax]),
+				(uint8_t)RGBMax
+			};
+		}
+
+		/**
+		 * RGB to HSL8.
+		 *
+		 * @param R, G, B : RGB channels.
+		 * @return HSL8 color, black, white and grays have hue and saturation 0.
+		 */
+		inline FHSL8 RGBToHSL8(const uint8_t R, const uint8_t G, const uint8_t B)
+		{
+			const uint32_t RGBMin = Min3(R, G, B);
+			const uint32_t RGBMax = Max3(R, G, B);
+			const uint32_t RGBRange = RGBMax - RGBMin;
+			const uint32_t RGBSum = RGBMax + RGBMin;
+			// 255 - |Sum - 255|, at least Range and 0 only for black and white.
+			const uint32_t SaturationDivisor = RGBSum < 255 ? RGBSum : 510 - RGBSum;
+
+			return FHSL8{
+				RGBToHue(R, G, B, RGBMax, RGBRange),
+				(uint8_t)MulDivRound(RGBRange, Reciprocal255.Values[SaturationDivisor]),
+				(uint8_t)((RGBSum + 1) >> 1)
+			};
+		}
+		//~ End RGB To
+
+		//~ Begin To RGB
+		/**
+		 * HSV8 to RGB. Hue outside a turn is treated as 0.
+		 *
+		 * @param Color : HSV8 color.
+		 * @return RGB color with full alpha.
+		 */
+		inline TRGBA<uint8_t> HSV8ToRGB(const FHSV8& Color)
+		{
+			const uint32_t H = ClampHue(Color.H);
+			const uint32_t S = Color.S;
+			const uint32_t V = Color.V;
+			// V (1 - Ramp S), same values as the float conversion: V, V(1 - S), V(1 - F S), V(1 - (1 - F) S).
+			return TRGBA<uint8_t>{
+				(uint8_t)Divide65280Round(V * (255 * HueSectorSteps - (uint32_t)HueChannelRamp(H, 5) * S)),
+				(uint8_t)Divide65280Round(V * (255 * HueSectorSteps - (uint32_t)HueChannelRamp(H, 3) * S)),
+				(uint8_t)Divide65280Round(V * (255 * HueSectorSteps - (uint32_t)HueChannelRamp(H, 1) * S)),
+				255
+			};
+		}
+
+		/**
+		 * HSL8 to RGB. Hue outside a turn is treated as 0.
+		 *
+		 * @param Color : HSL8 color.
+		 * @return RGB color with full alpha.
+		 */
+		inline TRGBA<uint8_t> HSL8ToRGB(const FHSL8& Color)
+		{
+			const uint32_t H = ClampHue(Color.H);
+			const int32_t L = Color.L;
+			// Chroma in channel units times 255, 255 - |2L - 255| is twice the distance to black or white.
+			const int32_t LDistance = L < 255 - L ? L : 255 - L;
+			const int32_t C = 2 * LDistance * Color.S;
+			const int32_t Base = L * 255 * (int32_t)HueSectorSteps;
+			const int32_t HalfSector = (int32_t)HueSectorSteps / 2;
+			// L + C/2 (1 - 2 Ramp), same values as the float conversion: L + C/2, L - C/2, L + C/2 (1 - 2F), L + C/2 (2F - 1).
+			// Every value lies in [0, 255].
+			return TRGBA<uint8_t>{
+				(uint8_t)Divide65280Round((uint32_t)(Base + C * (HalfSector - HueChannelRamp(H, 5)))),
+				(uint8_t)Divide65280Round((uint32_t)(Base + C * (HalfSector - HueChannelRamp(H, 3)))),
+				(uint8_t)Divide65280Round((uint32_t)(Base + C * (HalfSector - HueChannelRamp(H, 1)))),
+				255
+			};
+		}
+		//~ End To RGB
+	}
+}
@@ -0,0 +1,113 @@
+// Copyright kevin791129
+
+#pragma once
+
+#include <cstdint>
+#include "ColorMath/ColorMath.h"
+
+/**
+ * Engine independent hex color formatting and parsing.
+ */
+namespace ColorMath
+{
+	namespace Hex
+	{
+		/**
+		 * Hex digit value.
+		 *
+		 * @param Char : Hex digit character.
+		 * @return Digit value or -1 if not a hex digit.
+		 */
+		template<typename CharType>
+		inline int32_t DigitValue(const CharType Char)
+		{
+			return (Char >= '0' && Char <= '9') ? int32_t(Char - '0') :
+				(Char >= 'A' && Char <= 'F') ? int32_t(Char - 'A' + 10) :
+				(Char >= 'a' && Char <= 'f') ? int32_t(Char - 'a' + 10) :
+				-1;
+		}
+
+		/**
+		 * Write a channel as 2 upper case hex digits.
+		 *
+		 * @param Value : Channel value.
+		 * @param[out] Out : Output buffer, must hold 2 characters.
+		 * @return Pointer after the written characters.
+		 */
+		template<typename CharType>
+		inline CharType* EncodeChannel(const uint8_t Value, CharType* Out)
+		{
+			static constexpr char Digits[] = "0123456789ABCDEF";
+			Out[0] = (CharType)Digits[Value >> 4];
+			Out[1] = (CharType)Digits[Value & 0xF];
+			return Out + 2;
+		}
+
+		/**
+		 * Write color as RRGGBB, same digits as FColor::ToHex without alpha. No terminator is written.
+		 *
+		 * @param Color : Color to format.
+		 * @param[out] Out : Output buffer, must hold 6 characters.
+		 * @return Pointer after the written characters.
+		 */
+		template<typename CharType>
+		inline CharType* EncodeRGB(const TRGBA<uint8_t>& Color, CharType* Out)
+		{
+			Out = EncodeChannel(Color.R, Out);
+			Out = EncodeChannel(Color.G, Out);
+			return EncodeChannel(Color.B, Out);
+		}
+
+		/**
+		 * Parse hex color with FColor::FromHex semantics, supported formats: RGB, RRGGBB, RRGGBBAA, #RGB, #RRGGBB, #RRGGBBAA.
+		 * Invalid digits parse as 0 and unsupported lengths give transparent black, but are reported as failure.
+		 *
+		 * @param Str : Hex string, does not need to be terminated.
+		 * @param Len : Number of characters in Str.
+		 * @param[out] OutColor : Parsed color.
+		 * @return True if Str was a well formed hex color.
+		 */
+		template<typename CharType>
+		inline bool Parse(const CharType* Str, const int32_t Len, TRGBA<uint8_t>& OutColor)
+		{
+			const int32_t StartIndex = (Len > 0 && Str[0] == '#') ? 1 : 0;
+			const int32_t DigitCount = Len - StartIndex;
+			Str += StartIndex;
+
+			if (DigitCount != 3 && DigitCount != 6 && DigitCount != 8)
+			{
+				OutColor = TRGBA<uint8_t>{ 0, 0, 0, 0 };
+				return false;
+			}
+
+			bool bValid = true;
+			uint8_t Digits[8];
+			for (int32_t Index = 0; Index < DigitCount; ++Index)
+			{
+				const int32_t Digit = DigitValue(Str[Index]);
+				bValid &= Digit >= 0;
+				Digits[Index] = Digit >= 0 ? (uint8_t)Digit : 0;
+			}
+
+			if (DigitCount == 3)
+			{
+				OutColor = TRGBA<uint8_t>{
+					(uint8_t)((Digits[0] << 4) + Digits[0]),
+					(uint8_t)((Digits[1] << 4) + Digits[1]),
+					(uint8_t)((Digits[2] << 4) + Digits[2]),
+					255
+				};
+			}
+			else
+			{
+				OutColor = TRGBA<uint8_t>{
+					(uint8_t)((Digits[0] << 4) + Digits[1]),
+					(uint8_t)((Digits[2] << 4) + Digits[3]),
+					(uint8_t)((Digits[4] << 4) + Digits[5]),
+					DigitCount == 8 ? (uint8_t)((Digits[6] << 4) + Digits[7]) : (uint8_t)255
+				};
+			}
+			return bValid;
+		}
+	}
+}
@@ -0,0 +1,249 @@
+// Copyright kevin791129
+
+#pragma once
+
+#include "ColorMath.h"
+
+/**
+ * Perceptual color spaces and color differences.
+ * Inputs and outputs of the Lab conversions are linear sRGB (Rec. 709 primaries, D65 white), the same space as FLinearColor.
+ * CIELAB uses D65 white with L range [0, 100], OKLab follows Björn Ottosson's definition with L range [0, 1].
+ */
+namespace ColorMath
+{
+	/**
+	 * Perceptual color.
+	 */
+	template<typename RealType>
+	struct TLab
+	{
+		RealType L;
+		RealType A;
+		RealType B;
+	};
+
+	//~ Begin CIELAB
+	namespace CIELAB
+	{
+		/** D65 reference white. */
+		static constexpr double WhiteX = 0.95047;
+		static constexpr double WhiteY = 1.0;
+		static constexpr double WhiteZ = 1.08883;
+
+		/** (6 / 29)^3 and its companions of the piecewise cube root. */
+		static constexpr double Epsilon = 216.0 / 24389.0;
+		static constexpr double Kappa = 24389.0 / 27.0;
+
+		template<typename RealType>
+		inline RealType F(const RealType T)
+		{
+			return T > RealType(Epsilon) ? std::cbrt(T) : (RealType(Kappa) * T + RealType(16)) / RealType(116);
+		}
+
+		template<typename RealType>
+		inline RealType FInverse(const RealType T)
+		{
+			const RealType T3 = T * T * T;
+			return T3 > RealType(Epsilon) ? T3 : (RealType(116) * T - RealType(16)) / RealType(Kappa);
+		}
+	}
+
+	/**
+	 * Linear sRGB to CIELAB.
+	 *
+	 * @param R, G, B : Linear channels, range: [0, 1].
+	 * @return Lab, L range: [0, 100].
+	 */
+	template<typename RealType>
+	inline TLab<RealType> LinearRGBToLab(const RealType R, const RealType G, const RealType B)
+	{
+		const RealType X = RealType(0.4124564) * R + RealType(0.3575761) * G + RealType(0.1804375) * B;
+		const RealType Y = RealType(0.2126729) * R + RealType(0.7151522) * G + RealType(0.0721750) * B;
+		const RealType Z = RealType(0.0193339) * R + RealType(0.1191920) * G + RealType(0.9503041) * B;
+
+		const RealType FX = CIELAB::F(X / RealType(CIELAB::WhiteX));
+		const RealType FY = CIELAB::F(Y / RealType(CIELAB::WhiteY));
+		const RealType FZ = CIELAB::F(Z / RealType(CIELAB::WhiteZ));
+
+		return TLab<RealType>{ RealType(116) * FY - RealType(16), RealType(500) * (FX - FY), RealType(200) * (FY - FZ) };
+	}
+
+	/**
+	 * CIELAB to linear sRGB, colors outside the sRGB gamut give channels outside [0, 1].
+	 *
+	 * @param Lab : Lab, L range: [0, 100].
+	 * @return Linear color with full alpha.
+	 */
+	template<typename RealType>
+	inline TRGBA<RealType> LabToLinearRGB(const TLab<RealType>& Lab)
+	{
+		const RealType FY = (Lab.L + RealType(16)) / RealType(116);
+		const RealType X = CIELAB::FInverse(FY + Lab.A / RealType(500)) * RealType(CIELAB::WhiteX);
+		const RealType Y = CIELAB::FInverse(FY) * RealType(CIELAB::WhiteY);
+		const RealType Z = CIELAB::FInverse(FY - Lab.B / RealType(200)) * RealType(CIELAB::WhiteZ);
+
+		return TRGBA<RealType>{
+			RealType(3.2404542) * X - RealType(1.5371385) * Y - RealType(0.4985314) * Z,
+			RealType(-0.9692660) * X + RealType(1.8760108) * Y + RealType(0.0415560) * Z,
+			RealType(0.0556434) * X - RealType(0.2040259) * Y + RealType(1.0572252) * Z,
+			RealType(1)
+		};
+	}
+	//~ End CIELAB
+
+	//~ Begin OKLab
+	/**
+	 * Linear sRGB to OKLab.
+	 *
+	 * @param R, G, B : Linear channels, range: [0, 1].
+	 * @return OKLab, L range: [0, 1].
+	 */
+	template<typename RealType>
+	inline TLab<RealType> LinearRGBToOKLab(const RealType R, const RealType G, const RealType B)
+	{
+		const RealType L = std::cbrt(RealType(0.4122214708) * R + RealType(0.5363325363) * G + RealType(0.0514459929) * B);
+		const RealType M = std::cbrt(RealType(0.2119034982) * R + RealType(0.6806995451) * G + RealType(0.1073969566) * B);
+		const RealType S = std::cbrt(RealType(0.0883024619) * R + RealType(0.2817188376) * G + RealType(0.6299787005) * B);
+
+		return TLab<RealType>{
+			RealType(0.2104542553) * L + RealType(0.7936177850) * M - RealType(0.0040720468) * S,
+			RealType(1.9779984951) * L - RealType(2.4285922050) * M + RealType(0.4505937099) * S,
+			RealType(0.0259040371) * L + RealType(0.7827717662) * M - RealType(0.8086757660) * S
+		};
+	}
+
+	/**
+	 * OKLab to linear sRGB, colors outside the sRGB gamut give channels outside [0, 1].
+	 *
+	 * @param Lab : OKLab, L range: [0, 1].
+	 * @return Linear color with full alpha.
+	 */
+	template<typename RealType>
+	inline TRGBA<RealType> OKLabToLinearRGB(const TLab<RealType>& Lab)
+	{
+		const RealType L = Lab.L + RealType(0.3963377774) * Lab.A + RealType(0.2158037573) * Lab.B;
+		const RealType M = Lab.L - RealType(0.1055613458) * Lab.A - RealType(0.0638541728) * Lab.B;
+		const RealType S = Lab.L - RealType(0.0894841775) * Lab.A - RealType(1.2914855480) * Lab.B;
+		const RealType L3 = L * L * L;
+		const RealType M3 = M * M * M;
+		const RealType S3 = S * S * S;
+
+		return TRGBA<RealType>{
+			RealType(4.0767416621) * L3 - RealType(3.3077115913) * M3 + RealType(0.2309699292) * S3,
+			RealType(-1.2684380046) * L3 + RealType(2.6097574011) * M3 - RealType(0.3413193965) * S3,
+			RealType(-0.0041960863) * L3 - RealType(0.7034186147) * M3 + RealType(1.7076147010) * S3,
+			RealType(1)
+		};
+	}
+	//~ End OKLab
+
+	//~ Begin Color Difference
+	/**
+	 * CIE76 color difference, euclidean distance in Lab.
+	 */
+	template<typename RealType>
+	inline RealType DeltaE76(const TLab<RealType>& Lab1, const TLab<RealType>& Lab2)
+	{
+		const RealType DL = Lab1.L - Lab2.L;
+		const RealType DA = Lab1.A - Lab2.A;
+		const RealType DB = Lab1.B - Lab2.B;
+		return std::sqrt(DL * DL + DA * DA + DB * DB);
+	}
+
+	/**
+	 * CIE94 color difference with graphic arts weights. Not symmetric, Lab1 is the reference color.
+	 */
+	template<typename RealType>
+	inline RealType DeltaE94(const TLab<RealType>& Lab1, const TLab<RealType>& Lab2)
+	{
+		const RealType C1 = std::sqrt(Lab1.A * Lab1.A + Lab1.B * Lab1.B);
+		const RealType C2 = std::sqrt(Lab2.A * Lab2.A + Lab2.B * Lab2.B);
+		const RealType DL = Lab1.L - Lab2.L;
+		const RealType DC = C1 - C2;
+		const RealType DA = Lab1.A - Lab2.A;
+		const RealType DB = Lab1.B - Lab2.B;
+		const RealType DH2 = DA * DA + DB * DB - DC * DC;
+		const RealType SC = RealType(1) + RealType(0.045) * C1;
+		const RealType SH = RealType(1) + RealType(0.015) * C1;
+
+		const RealType DCTerm = DC / SC;
+		return std::sqrt(DL * DL + DCTerm * DCTerm + (DH2 > RealType(0) ? DH2 : RealType(0)) / (SH * SH));
+	}
+
+	/** Hue differences within this many degrees of half a turn are treated as exactly half a turn by 'DeltaE2000'. */
+	static constexpr double HueTieTolerance = 1.e-4;
+
+	/**
+	 * CIEDE2000 color difference with unit weights, following Sharma, Wu and Dalal (2005).
+	 */
+	template<typename RealType>
+	inline RealType DeltaE2000(const TLab<RealType>& Lab1, const TLab<RealType>& Lab2)
+	{
+		const RealType Pi = RealType(3.14159265358979323846);
+		const RealType DegToRad = Pi / RealType(180);
+		const RealType RadToDeg = RealType(180) / Pi;
+		const RealType Pow25_7 = RealType(6103515625.0);
+
+		const RealType C1 = std::sqrt(Lab1.A * Lab1.A + Lab1.B * Lab1.B);
+		const RealType C2 = std::sqrt(Lab2.A * Lab2.A + Lab2.B * Lab2.B);
+		const RealType CMean = (C1 + C2) * RealType(0.5);
+		const RealType CMean7 = CMean * CMean * CMean * CMean * CMean * CMean * CMean;
+		const RealType G = RealType(0.5) * (RealType(1) - std::sqrt(CMean7 / (CMean7 + Pow25_7)));
+
+		const RealType A1 = (RealType(1) + G) * Lab1.A;
+		const RealType A2 = (RealType(1) + G) * Lab2.A;
+		const RealType C1Prime = std::sqrt(A1 * A1 + Lab1.B * Lab1.B);
+		const RealType C2Prime = std::sqrt(A2 * A2 + Lab2.B * Lab2.B);
+
+		// Hue is zero for neutral colors, atan2 of two zeros already gives zero.
+		RealType H1Prime = std::atan2(Lab1.B, A1) * RadToDeg;
+		RealType H2Prime = std::atan2(Lab2.B, A2) * RadToDeg;
+		if (H1Prime < RealType(0))
+			H1Prime += RealType(360);
+		if (H2Prime < RealType(0))
+			H2Prime += RealType(360);
+
+		const RealType CProduct = C1Prime * C2Prime;
+		const RealType HDifference = H2Prime - H1Prime;
+		const RealType HSum = H1Prime + H2Prime;
+
+		// Hues exactly half a turn apart are not wrapped. Both hues are rounded independently, so differences within HueTieTolerance
+		// of half a turn count as ties, otherwise float rounding picks either side.
+		const RealType HalfTurn = RealType(180) + RealType(HueTieTolerance);
+		RealType DHPrime = RealType(0);
+		RealType HMean = HSum;
+		if (CProduct != RealType(0))
+		{
+			DHPrime = HDifference > HalfTurn ? HDifference - RealType(360) : HDifference < -HalfTurn ? HDifference + RealType(360) : HDifference;
+			HMean = std::abs(HDifference) <= HalfTurn ? HSum * RealType(0.5) : HSum < RealType(360) ? (HSum + RealType(360)) * RealType(0.5) : (HSum - RealType(360)) * RealType(0.5);
+		}
+
+		const RealType DLPrime = Lab2.L - Lab1.L;
+		const RealType DCPrime = C2Prime - C1Prime;
+		const RealType DHPrimeBig = RealType(2) * std::sqrt(CProduct) * std::sin(DHPrime * RealType(0.5) * DegToRad);
+
+		const RealType LMean = (Lab1.L + Lab2.L) * RealType(0.5);
+		const RealType CPrimeMean = (C1Prime + C2Prime) * RealType(0.5);
+		const RealType T = RealType(1)
+			- RealType(0.17) * std::cos((HMean - RealType(30)) * DegToRad)
+			+ RealType(0.24) * std::cos(RealType(2) * HMean * DegToRad)
+			+ RealType(0.32) * std::cos((RealType(3) * HMean + RealType(6)) * DegToRad)
+			- RealType(0.20) * std::cos((RealType(4) * HMean - RealType(63)) * DegToRad);
+
+		const RealType HExponent = (HMean - RealType(275)) / RealType(25);
+		const RealType DTheta = RealType(30) * std::exp(-HExponent * HExponent);
+		const RealType CPrimeMean7 = CPrimeMean * CPrimeMean * CPrimeMean * CPrimeMean * CPrimeMean * CPrimeMean * CPrimeMean;
+		const RealType RC = RealType(2) * std::sqrt(CPrimeMean7 / (CPrimeMean7 + Pow25_7));
+		const RealType LOffset2 = (LMean - RealType(50)) * (LMean - RealType(50));
+		const RealType SL = RealType(1) + RealType(0.015) * LOffset2 / std::sqrt(RealType(20) + LOffset2);
+		const RealType SC = RealType(1) + RealType(0.045) * CPrimeMean;
+		const RealType SH = RealType(1) + RealType(0.015) * CPrimeMean * T;
+		const RealType RT = -std::sin(RealType(2) * DTheta * DegToRad) * RC;
+
+		const RealType LTerm = DLPrime / SL;
+		const RealType CTerm = DCPrime / SC;
+		const RealType HTerm = DHPrimeBig / SH;
+		return std::sqrt(LTerm * LTerm + CTerm * CTerm + HTerm * HTerm + RT * CTerm * HTerm);
+	}
+	//~ End Color Difference
+}
@@ -0,0 +1,158 @@
+// Copyright kevin791129
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/ThreadSafeBool.h"
+#include "HAL/ThreadSafeCounter.h"
+
+/**
+ * Dominant color of an image.
+ */
+struct FColorPaletteEntry
+{
+	/** Average color of pixels in cluster. */
+	FLinearColor Color;
+	/** Fraction of sampled pixels in cluster, range: [0, 1]. */
+	float Weight;
+};
+
+/**
+ * Palette extraction settings.
+ */
+struct FColorPaletteSettings
+{
+	/** Number of dominant colors to find, clamped to [1, FColorPaletteExtractor::MaxColors]. */
+	int32 NumColors = 8;
+	/** Sample every Stride-th pixel, 1 samples all pixels. Prefer a stride not dividing image width to avoid sampling the same columns. */
+	int32 Stride = 1;
+	/** Maximum clustering iterations. */
+	int32 MaxIterations = 16;
+	/** Clustering stops once no cluster center moves more than this in sRGB space, range: [0, 1]. */
+	float ConvergenceThreshold = 1.e-3f;
+	/** Worker accumulator count, 0 uses every task graph worker plus the calling thread. */
+	int32 NumThreads = 0;
+	/** Seed of cluster initialization, same settings and pixels always give the same palette. */
+	int32 Seed = 0;
+};
+
+/**
+ * Progress and cancellation shared with a running extraction, safe to use from any thread.
+ */
+class COLORPICKER_API FColorPaletteProgress
+{
+public:
+	/**
+	 * Get completed fraction of work.
+	 *
+	 * @return Progress, range: [0, 1].
+	 */
+	float GetProgress() const;
+
+	/**
+	 * Request extraction to stop, it then returns an empty palette.
+	 */
+	void Cancel() { bCancelled = true; }
+
+	bool IsCancelled() const { return bCancelled; }
+
+	/**
+	 * Start tracking new work, called by extractor.
+	 */
+	void Reset(const int32 InTotalWork);
+
+	/**
+	 * Report completed work, called by extractor.
+	 */
+	void AddCompletedWork(const int32 Work) { CompletedWork.Add(Work); }
+
+private:
+	FThreadSafeCounter CompletedWork;
+	FThreadSafeCounter TotalWork;
+	FThreadSafeBool bCancelled;
+};
+
+/**
+ * Dominant color extraction from image pixels.
+ * Pixels are binned into a 15-bit sRGB histogram with one histogram per worker, the weighted bins are clustered with k-means++ and the
+ * final colors are exact averages of the pixels in each cluster.
+ */
+class COLORPICKER_API FColorPaletteExtractor
+{
+public:
+	/** Maximum number of colors in a palette. */
+	static constexpr int32 MaxColors = 64;
+	/** Histogram bits per channel. */
+	static constexpr int32 HistogramBits = 5;
+
+	/**
+	 * Extract dominant colors from sRGB pixels.
+	 *
+	 * @param Pixels : Image pixels in any order, alpha is ignored.
+	 * @param Settings : Extraction settings.
+	 * @param Progress : Optional progress and cancellation.
+	 * @return Dominant colors sorted by weight, heaviest first. Empty if there are no pixels or extraction was cancelled.
+	 */
+	static TArray<FColorPaletteEntry> Extract(TArrayView<const FColor> Pixels, const FColorPaletteSettings& Settings, FColorPaletteProgress* Progress = nullptr);
+
+	/**
+	 * Extract dominant colors from linear pixels, clustered after sRGB encoding.
+	 *
+	 * @param Pixels : Image pixels in any order, alpha is ignored.
+	 * @param Settings : Extraction settings.
+	 * @param Progress : Optional progress and cancellation.
+	 * @return Dominant colors sorted by weight, heaviest first. Empty if there are no pixels or extraction was cancelled.
+	 */
+	static TArray<FColorPaletteEntry> Extract(TArrayView<const FLinearColor> Pixels, const FColorPaletteSettings& Settings, FColorPaletteProgress* Progress = nullptr);
+};
+
+DECLARE_DELEGATE_OneParam(FOnColorPaletteProgress, float);
+DECLARE_DELEGATE_OneParam(FOnColorPaletteExtracted, const TArray<FColorPaletteEntry>&);
+
+/**
+ * Palette extraction running on the thread pool. Delegates are executed on the game thread, progress is reported at most every 'ProgressInterval' seconds.
+ */
+class COLORPICKER_API FColorPaletteExtractionTask : public TSharedFromThis<FColorPaletteExtractionTask, ESPMode::ThreadSafe>
+{
+public:
+	/** Seconds between progress reports. */
+	static constexpr float ProgressInterval = 0.1f;
+
+	/**
+	 * Start extraction, must be called on the game thread.
+	 *
+	 * @param Pixels : Image pixels, owned by the task until extraction finishes.
+	 * @param Settings : Extraction settings.
+	 * @param OnExtracted : Executed with palette when done, not executed if cancelled.
+	 * @param OnProgress : Optional, executed with progress in range [0, 1] while running.
+	 * @return Running task.
+	 */
+	static TSharedRef<FColorPaletteExtractionTask, ESPMode::ThreadSafe> Launch(TArray<FColor>&& Pixels, const FColorPaletteSettings& Settings, FOnColorPaletteExtracted OnExtracted, FOnColorPaletteProgress OnProgress = FOnColorPaletteProgress());
+
+	/**
+	 * Stop extraction, no delegate is executed after this returns.
+	 */
+	void Cancel();
+
+	float GetProgress() const { return Progress.GetProgress(); }
+	bool IsDone() const { return bDone; }
+
+private:
+	FColorPaletteExtractionTask(TArray<FColor>&& InPixels, const FColorPaletteSettings& InSettings, FOnColorPaletteExtracted InOnExtracted, FOnColorPaletteProgress InOnProgress);
+
+	/**
+	 * Game thread ticker reporting progress and result.
+	 */
+	bool Tick(float DeltaTime);
+
+	TArray<FColor> Pixels;
+	FColorPaletteSettings Settings;
+	FOnColorPaletteExtracted OnExtracted;
+	FOnColorPaletteProgress OnProgress;
+
+	FColorPaletteProgress Progress;
+	/** Written by worker before bDone is set. */
+	TArray<FColorPaletteEntry> Palette;
+	FThreadSafeBool bDone;
+	FDelegateHandle TickerHandle;
+};
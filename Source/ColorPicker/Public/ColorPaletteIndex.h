@@ -0,0 +1,104 @@
+// Copyright kevin791129
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Palette with a k-d tree for nearest color queries.
+ * Distances are euclidean in sRGB encoded space, which is closer to perceived difference than linear space.
+ * Ties are resolved to the lowest palette index, so results always match a brute force scan.
+ */
+class COLORPICKER_API FColorPaletteIndex
+{
+public:
+	/** Tree ranges of at most this many colors are scanned linearly. */
+	static constexpr int32 LeafSize = 8;
+	/** Queries per parallel task in batch queries. */
+	static constexpr int32 BatchChunkSize = 1024;
+
+	FColorPaletteIndex() = default;
+	explicit FColorPaletteIndex(TArrayView<const FLinearColor> InColors) { Build(InColors); }
+
+	/**
+	 * Replace palette and rebuild index.
+	 *
+	 * @param InColors : Palette colors, duplicates are allowed.
+	 */
+	void Build(TArrayView<const FLinearColor> InColors);
+
+	int32 Num() const { return Colors.Num(); }
+	bool IsEmpty() const { return Colors.Num() == 0; }
+
+	/**
+	 * Get palette color.
+	 *
+	 * @param Index : Palette index, as returned by queries.
+	 */
+	const FLinearColor& GetColor(const int32 Index) const { return Colors[Index]; }
+
+	/**
+	 * Find nearest palette color.
+	 *
+	 * @param Color : Query color.
+	 * @return Palette index, INDEX_NONE if palette is empty.
+	 */
+	int32 FindNearest(const FLinearColor& Color) const;
+
+	/**
+	 * Find K nearest palette colors.
+	 *
+	 * @param Color : Query color.
+	 * @param K : Number of colors, clamped to palette size.
+	 * @param[out] OutIndices : Palette indices, nearest first.
+	 */
+	void FindKNearest(const FLinearColor& Color, const int32 K, TArray<int32>& OutIndices) const;
+
+	/**
+	 * Find nearest palette color of every query color in parallel.
+	 *
+	 * @param Queries : Query colors.
+	 * @param[out] OutIndices : Palette index of each query, same size as Queries.
+	 */
+	void FindNearestBatch(TArrayView<const FLinearColor> Queries, TArrayView<int32> OutIndices) const;
+
+	/**
+	 * Find nearest palette color by scanning every color, reference for the index.
+	 *
+	 * @param Color : Query color.
+	 * @return Palette index, INDEX_NONE if palette is empty.
+	 */
+	int32 FindNearestBruteForce(const FLinearColor& Color) const;
+
+private:
+	/** Palette color in tree order. */
+	struct FEntry
+	{
+		/** sRGB encoded color. */
+		FVector Point;
+		int32 PaletteIndex;
+		/** Split axis if entry is the median of a non-leaf range. */
+		int32 SplitAxis;
+	};
+
+	/** Current best candidates of a query. */
+	struct FCandidate
+	{
+		float DistanceSquared;
+		int32 PaletteIndex;
+
+		bool operator<(const FCandidate& Other) const
+		{
+			return DistanceSquared < Other.DistanceSquared || (DistanceSquared == Other.DistanceSquared && PaletteIndex < Other.PaletteIndex);
+		}
+	};
+
+	void BuildRange(const int32 Begin, const int32 End);
+	void SearchNearest(const int32 Begin, const int32 End, const FVector& Query, FCandidate& Best) const;
+	void SearchKNearest(const int32 Begin, const int32 End, const FVector& Query, const int32 K, TArray<FCandidate, TInlineAllocator<16>>& Best) const;
+
+	/** Palette colors in original order. */
+	TArray<FLinearColor> Colors;
+	/** Implicit balanced tree, median of every range is the node splitting it. */
+	TArray<FEntry> Entries;
+};
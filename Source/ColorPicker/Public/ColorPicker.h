@@ -3,11 +3,14 @@
 #pragma once
 
 #include "Modules/ModuleManager.h"
+#include "Stats/Stats.h"
 
 DECLARE_LOG_CATEGORY_EXTERN(LogColorPicker, Log, All);
 DECLARE_LOG_CATEGORY_EXTERN(LogColorPickerWarning, Warning, All);
 DECLARE_LOG_CATEGORY_EXTERN(LogColorPickerError, Error, All);
 
+DECLARE_STATS_GROUP(TEXT("ColorPicker"), STATGROUP_ColorPicker, STATCAT_Advanced);
+
 class FColorPickerModule : public IModuleInterface
 {
 public:
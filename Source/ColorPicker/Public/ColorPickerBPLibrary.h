@@ -3,6 +3,9 @@
 #pragma once
 
 #include "Kismet/BlueprintFunctionLibrary.h"
+#include "Containers/StringView.h"
+#include "ColorFormat.h"
+#include "ColorMath/ColorMathFixed.h"
 #include "ColorPickerBPLibrary.generated.h"
 
 UCLASS()
@@ -38,9 +41,10 @@ class UColorPickerBPLibrary : public UBlueprintFunctionLibrary
 	 * @param[out] OutH : Hue, range: [0.0f, 360.0f).
 	 * @param[out] OutS : Saturation, range: [0.0f, 1.0f].
 	 * @param[out] OutV : Value, range: [0.0f, 1.0f].
+	 * @param Precision : Quantize to 8-bit sRGB first (default) or convert sRGB floats directly.
 	 */
 	UFUNCTION(BlueprintPure, meta = (DisplayName = "Linear Color to HSV", Keywords = "Color Conversion LinearColor HSV"), Category = "Color Picker|Conversion")
-		static void LinearColorToHSV(const FLinearColor& Color, float& OutH, float& OutS, float& OutV);
+		static void LinearColorToHSV(const FLinearColor& Color, float& OutH, float& OutS, float& OutV, const EColorPrecision Precision = EColorPrecision::CP_8BIT);
 
 	/**
 	 * Converts linear color to CMYK color.
@@ -50,9 +54,10 @@ class UColorPickerBPLibrary : public UBlueprintFunctionLibrary
 	 * @param[out] OutM : Magenta, range: [0.0f, 1.0f].
 	 * @param[out] OutY : Yellow, range: [0.0f, 1.0f].
 	 * @param[out] OutK : Black, range: [0.0f, 1.0f].
+	 * @param Precision : Quantize to 8-bit sRGB first (default) or convert sRGB floats directly.
 	 */
 	UFUNCTION(BlueprintPure, meta = (DisplayName = "Linear Color to CMYK", Keywords = "Color Conversion LinearColor CMYK"), Category = "Color Picker|Conversion")
-		static void LinearColorToCMYK(const FLinearColor& Color, float& OutC, float& OutM, float& OutY, float& OutK);
+		static void LinearColorToCMYK(const FLinearColor& Color, float& OutC, float& OutM, float& OutY, float& OutK, const EColorPrecision Precision = EColorPrecision::CP_8BIT);
 
 	/**
 	 * Converts linear color to HSL color.
@@ -61,9 +66,10 @@ class UColorPickerBPLibrary : public UBlueprintFunctionLibrary
 	 * @param[out] OutH : Hue, range: [0.0f, 360.0f).
 	 * @param[out] OutS : Saturation, range: [0.0f, 1.0f].
 	 * @param[out] OutL : Lightness, range: [0.0f, 1.0f].
+	 * @param Precision : Quantize to 8-bit sRGB first (default) or convert sRGB floats directly.
 	 */
 	UFUNCTION(BlueprintPure, meta = (DisplayName = "Linear Color to HSL", Keywords = "Color Conversion LinearColor HSL"), Category = "Color Picker|Conversion")
-		static void LinearColorToHSL(const FLinearColor& Color, float& OutH, float& OutS, float& OutL);
+		static void LinearColorToHSL(const FLinearColor& Color, float& OutH, float& OutS, float& OutL, const EColorPrecision Precision = EColorPrecision::CP_8BIT);
 
 	/**
 	 * Converts hex color to linear color.
@@ -92,9 +98,10 @@ class UColorPickerBPLibrary : public UBlueprintFunctionLibrary
 	 * @param S : Saturation, range: [0.0f, 1.0f].
 	 * @param V : Value, range: [0.0f, 1.0f].
 	 * @param[out] OutColor : Linear color with alpha 1.0f.
+	 * @param Precision : Quantize result to 8-bit sRGB (default) or decode sRGB floats directly.
 	 */
 	UFUNCTION(BlueprintPure, meta = (DisplayName = "HSV to Linear Color", Keywords = "Color Conversion LinearColor HSV"), Category = "Color Picker|Conversion")
-		static void HSVToLinearColor(const float H, const float S, const float V, FLinearColor& OutColor);
+		static void HSVToLinearColor(const float H, const float S, const float V, FLinearColor& OutColor, const EColorPrecision Precision = EColorPrecision::CP_8BIT);
 
 	/**
 	 * Converts CMYK color to linear color.
@@ -104,9 +111,10 @@ class UColorPickerBPLibrary : public UBlueprintFunctionLibrary
 	 * @param Y : Yellow, range: [0.0f, 1.0f].
 	 * @param K : Black, range: [0.0f, 1.0f].
 	 * @param[out] OutColor : Linear color with alpha 1.0f.
+	 * @param Precision : Quantize result to 8-bit sRGB (default) or decode sRGB floats directly.
 	 */
 	UFUNCTION(BlueprintPure, meta = (DisplayName = "CMYK to Linear Color", Keywords = "Color Conversion LinearColor CMYK"), Category = "Color Picker|Conversion")
-		static void CMYKToLinearColor(const float C, const float M, const float Y, const float K, FLinearColor& OutColor);
+		static void CMYKToLinearColor(const float C, const float M, const float Y, const float K, FLinearColor& OutColor, const EColorPrecision Precision = EColorPrecision::CP_8BIT);
 
 	/**
 	 * Converts HSL color to linear color. Invalid input values will be clamped.
@@ -115,8 +123,312 @@ class UColorPickerBPLibrary : public UBlueprintFunctionLibrary
 	 * @param S : Saturation, range: [0.0f, 1.0f].
 	 * @param L : Lightness, range: [0.0f, 1.0f].
 	 * @param[out] OutColor : Linear color with alpha 1.0f.
+	 * @param Precision : Quantize result to 8-bit sRGB (default) or decode sRGB floats directly.
 	 */
 	UFUNCTION(BlueprintPure, meta = (DisplayName = "HSL to Linear Color", Keywords = "Color Conversion LinearColor HSL"), Category = "Color Picker|Conversion")
-		static void HSLToLinearColor(const float H, const float S, const float L, FLinearColor& OutColor);
+		static void HSLToLinearColor(const float H, const float S, const float L, FLinearColor& OutColor, const EColorPrecision Precision = EColorPrecision::CP_8BIT);
+
+	/**
+	 * Converts linear color to CIELAB color, D65 white.
+	 *
+	 * @param Color : Convert color.
+	 * @param[out] OutL : Lightness, range: [0.0f, 100.0f].
+	 * @param[out] OutA : Green to red, about [-128.0f, 128.0f] for sRGB colors.
+	 * @param[out] OutB : Blue to yellow, about [-128.0f, 128.0f] for sRGB colors.
+	 */
+	UFUNCTION(BlueprintPure, meta = (DisplayName = "Linear Color to Lab", Keywords = "Color Conversion LinearColor Lab CIELAB"), Category = "Color Picker|Conversion")
+		static void LinearColorToLab(const FLinearColor& Color, float& OutL, float& OutA, float& OutB);
+
+	/**
+	 * Converts linear color to OKLab color.
+	 *
+	 * @param Color : Convert color.
+	 * @param[out] OutL : Lightness, range: [0.0f, 1.0f].
+	 * @param[out] OutA : Green to red, about [-0.4f, 0.4f] for sRGB colors.
+	 * @param[out] OutB : Blue to yellow, about [-0.4f, 0.4f] for sRGB colors.
+	 */
+	UFUNCTION(BlueprintPure, meta = (DisplayName = "Linear Color to OKLab", Keywords = "Color Conversion LinearColor OKLab"), Category = "Color Picker|Conversion")
+		static void LinearColorToOKLab(const FLinearColor& Color, float& OutL, float& OutA, float& OutB);
+
+	/**
+	 * Converts CIELAB color to linear color. Colors outside the sRGB gamut will be clipped.
+	 *
+	 * @param L : Lightness, range: [0.0f, 100.0f].
+	 * @param A : Green to red.
+	 * @param B : Blue to yellow.
+	 * @param[out] OutColor : Linear color with alpha 1.0f.
+	 */
+	UFUNCTION(BlueprintPure, meta = (DisplayName = "Lab to Linear Color", Keywords = "Color Conversion LinearColor Lab CIELAB"), Category = "Color Picker|Conversion")
+		static void LabToLinearColor(const float L, const float A, const float B, FLinearColor& OutColor);
+
+	/**
+	 * Converts OKLab color to linear color. Colors outside the sRGB gamut will be clipped.
+	 *
+	 * @param L : Lightness, range: [0.0f, 1.0f].
+	 * @param A : Green to red.
+	 * @param B : Blue to yellow.
+	 * @param[out] OutColor : Linear color with alpha 1.0f.
+	 */
+	UFUNCTION(BlueprintPure, meta = (DisplayName = "OKLab to Linear Color", Keywords = "Color Conversion LinearColor OKLab"), Category = "Color Picker|Conversion")
+		static void OKLabToLinearColor(const float L, const float A, const float B, FLinearColor& OutColor);
+
+	/**
+	 * Converts color between any two formats in float precision. Pairs with a direct formula, such as HSV and HSL, skip RGB entirely,
+	 * and no pair is quantized or passes through the sRGB transfer unless it converts between RGB based and perceptual formats.
+	 *
+	 * @param Value : Color in From format, hex colors are given as RGB channels.
+	 * @param From : Source format.
+	 * @param To : Destination format.
+	 * @return Color in To format.
+	 */
+	UFUNCTION(BlueprintPure, meta = (DisplayName = "Convert Color Format", Keywords = "Color Conversion Format"), Category = "Color Picker|Conversion")
+		static FColorChannels ConvertColorFormat(const FColorChannels& Value, const EColorFormat From, const EColorFormat To);
+#pragma endregion
+
+#pragma region Color Difference
+	/**
+	 * Perceptual difference between two colors, computed in CIELAB.
+	 *
+	 * @param A : First color, the reference color for CIE94.
+	 * @param B : Second color.
+	 * @param Method : Difference formula.
+	 * @return Difference, 0.0f for equal colors. About 1.0f is just noticeable with CIEDE2000.
+	 */
+	UFUNCTION(BlueprintPure, meta = (DisplayName = "Color Difference", Keywords = "Color Difference Delta E Lab Distance"), Category = "Color Picker|Difference")
+		static float ColorDifference(const FLinearColor& A, const FLinearColor& B, const EColorDifference Method = EColorDifference::CD_CIEDE2000);
+
+	/**
+	 * Differences of color pairs, Lab colors as returned by 'LinearColorToLabBatch'.
+	 * Results agree with 'ColorDifference' to float rounding. CD_CIE76 on OKLab colors gives the OKLab distance.
+	 *
+	 * @param Method : Difference formula.
+	 * @param Lab1 : First colors of the pairs, the reference colors for CIE94.
+	 * @param Lab2 : Second colors of the pairs, same length as Lab1.
+	 * @param[out] OutDifferences : Difference of each pair, same length as Lab1.
+	 */
+	static void DeltaEBatch(const EColorDifference Method, TArrayView<const FVector> Lab1, TArrayView<const FVector> Lab2, TArrayView<float> OutDifferences);
+
+	/**
+	 * Differences between one color and many, Lab colors as returned by 'LinearColorToLabBatch'.
+	 *
+	 * @param Method : Difference formula.
+	 * @param Reference : Color compared against, the reference color for CIE94.
+	 * @param Lab : Compared colors.
+	 * @param[out] OutDifferences : Difference of each color from Reference, same length as Lab.
+	 */
+	static void DeltaEBatch(const EColorDifference Method, const FVector& Reference, TArrayView<const FVector> Lab, TArrayView<float> OutDifferences);
+#pragma endregion
+
+#pragma region Batch Color Conversion
+	/**
+	 * Converts linear colors to RGB colors, results match 'LinearColorToRGB'.
+	 *
+	 * @param Colors : Convert colors.
+	 * @param[out] OutColors : RGB colors with alpha, same length as Colors.
+	 */
+	static void LinearColorToRGBBatch(TArrayView<const FLinearColor> Colors, TArrayView<FColor> OutColors);
+
+	/**
+	 * Converts linear colors to HSV (HSB) color streams, results match 'LinearColorToHSV'.
+	 *
+	 * @param Colors : Convert colors.
+	 * @param[out] OutH : Hue stream, same length as Colors, range: [0.0f, 360.0f).
+	 * @param[out] OutS : Saturation stream, same length as Colors, range: [0.0f, 1.0f].
+	 * @param[out] OutV : Value stream, same length as Colors, range: [0.0f, 1.0f].
+	 */
+	static void LinearColorToHSVBatch(TArrayView<const FLinearColor> Colors, TArrayView<float> OutH, TArrayView<float> OutS, TArrayView<float> OutV);
+
+	/**
+	 * Converts linear colors to HSV (HSB) colors in place, hue, saturation and value are packed into R, G and B. Alpha is kept.
+	 *
+	 * @param[in, out] Colors : Convert colors.
+	 */
+	static void LinearColorToHSVBatch(TArrayView<FLinearColor> Colors);
+
+	/**
+	 * Converts linear colors to CMYK color streams, results match 'LinearColorToCMYK'.
+	 *
+	 * @param Colors : Convert colors.
+	 * @param[out] OutC : Cyan stream, same length as Colors, range: [0.0f, 1.0f].
+	 * @param[out] OutM : Magenta stream, same length as Colors, range: [0.0f, 1.0f].
+	 * @param[out] OutY : Yellow stream, same length as Colors, range: [0.0f, 1.0f].
+	 * @param[out] OutK : Black stream, same length as Colors, range: [0.0f, 1.0f].
+	 */
+	static void LinearColorToCMYKBatch(TArrayView<const FLinearColor> Colors, TArrayView<float> OutC, TArrayView<float> OutM, TArrayView<float> OutY, TArrayView<float> OutK);
+
+	/**
+	 * Converts linear colors to HSL color streams, results match 'LinearColorToHSL'.
+	 *
+	 * @param Colors : Convert colors.
+	 * @param[out] OutH : Hue stream, same length as Colors, range: [0.0f, 360.0f).
+	 * @param[out] OutS : Saturation stream, same length as Colors, range: [0.0f, 1.0f].
+	 * @param[out] OutL : Lightness stream, same length as Colors, range: [0.0f, 1.0f].
+	 */
+	static void LinearColorToHSLBatch(TArrayView<const FLinearColor> Colors, TArrayView<float> OutH, TArrayView<float> OutS, TArrayView<float> OutL);
+
+	/**
+	 * Converts linear colors to HSL colors in place, hue, saturation and lightness are packed into R, G and B. Alpha is kept.
+	 *
+	 * @param[in, out] Colors : Convert colors.
+	 */
+	static void LinearColorToHSLBatch(TArrayView<FLinearColor> Colors);
+
+	/**
+	 * Converts RGB colors to linear colors, results match 'RGBToLinearColor'.
+	 *
+	 * @param Colors : RGB colors, alpha is ignored.
+	 * @param[out] OutColors : Linear colors with alpha 1.0f, same length as Colors.
+	 */
+	static void RGBToLinearColorBatch(TArrayView<const FColor> Colors, TArrayView<FLinearColor> OutColors);
+
+	/**
+	 * Converts HSV (HSB) color streams to linear colors, results match 'HSVToLinearColor'. Invalid input values will be clamped.
+	 *
+	 * @param H : Hue stream, range: [0.0f, 360.0f).
+	 * @param S : Saturation stream, same length as H, range: [0.0f, 1.0f].
+	 * @param V : Value stream, same length as H, range: [0.0f, 1.0f].
+	 * @param[out] OutColors : Linear colors with alpha 1.0f, same length as H.
+	 */
+	static void HSVToLinearColorBatch(TArrayView<const float> H, TArrayView<const float> S, TArrayView<const float> V, TArrayView<FLinearColor> OutColors);
+
+	/**
+	 * Converts HSV (HSB) colors packed into R, G and B back to linear colors in place. Alpha is kept.
+	 *
+	 * @param[in, out] Colors : Convert colors.
+	 */
+	static void HSVToLinearColorBatch(TArrayView<FLinearColor> Colors);
+
+	/**
+	 * Converts CMYK color streams to linear colors, results match 'CMYKToLinearColor'.
+	 *
+	 * @param C : Cyan stream, range: [0.0f, 1.0f].
+	 * @param M : Magenta stream, same length as C, range: [0.0f, 1.0f].
+	 * @param Y : Yellow stream, same length as C, range: [0.0f, 1.0f].
+	 * @param K : Black stream, same length as C, range: [0.0f, 1.0f].
+	 * @param[out] OutColors : Linear colors with alpha 1.0f, same length as C.
+	 */
+	static void CMYKToLinearColorBatch(TArrayView<const float> C, TArrayView<const float> M, TArrayView<const float> Y, TArrayView<const float> K, TArrayView<FLinearColor> OutColors);
+
+	/**
+	 * Converts HSL color streams to linear colors, results match 'HSLToLinearColor'. Invalid input values will be clamped.
+	 *
+	 * @param H : Hue stream, range: [0.0f, 360.0f).
+	 * @param S : Saturation stream, same length as H, range: [0.0f, 1.0f].
+	 * @param L : Lightness stream, same length as H, range: [0.0f, 1.0f].
+	 * @param[out] OutColors : Linear colors with alpha 1.0f, same length as H.
+	 */
+	static void HSLToLinearColorBatch(TArrayView<const float> H, TArrayView<const float> S, TArrayView<const float> L, TArrayView<FLinearColor> OutColors);
+
+	/**
+	 * Converts HSL colors packed into R, G and B back to linear colors in place. Alpha is kept.
+	 *
+	 * @param[in, out] Colors : Convert colors.
+	 */
+	static void HSLToLinearColorBatch(TArrayView<FLinearColor> Colors);
+
+	/**
+	 * Converts linear colors to CIELAB colors packed into X (L), Y (a) and Z (b), results match 'LinearColorToLab'.
+	 *
+	 * @param Colors : Convert colors.
+	 * @param[out] OutLab : Lab colors, same length as Colors.
+	 */
+	static void LinearColorToLabBatch(TArrayView<const FLinearColor> Colors, TArrayView<FVector> OutLab);
+
+	/**
+	 * Converts linear colors to OKLab colors packed into X (L), Y (a) and Z (b), results match 'LinearColorToOKLab'.
+	 *
+	 * @param Colors : Convert colors.
+	 * @param[out] OutLab : OKLab colors, same length as Colors.
+	 */
+	static void LinearColorToOKLabBatch(TArrayView<const FLinearColor> Colors, TArrayView<FVector> OutLab);
+#pragma endregion
+
+#pragma region Fixed-Point Color Conversion
+	/**
+	 * Converts RGB colors to packed HSV8 colors with integer math only, hue in ColorMath::Fixed::HueSteps units per turn.
+	 * Correctly rounded, converting back is within 1 of the original channels. See ColorMath/ColorMathFixed.h for error bounds.
+	 *
+	 * @param Colors : RGB colors, alpha is ignored.
+	 * @param[out] OutHSV : HSV8 colors, same length as Colors.
+	 */
+	static void RGBToHSV8Batch(TArrayView<const FColor> Colors, TArrayView<ColorMath::Fixed::FHSV8> OutHSV);
+
+	/**
+	 * Converts packed HSV8 colors to RGB colors with integer math only.
+	 *
+	 * @param HSV : HSV8 colors, hue outside a turn is treated as 0.
+	 * @param[out] OutColors : RGB colors with full alpha, same length as HSV.
+	 */
+	static void HSV8ToRGBBatch(TArrayView<const ColorMath::Fixed::FHSV8> HSV, TArrayView<FColor> OutColors);
+
+	/**
+	 * Converts RGB colors to packed HSL8 colors with integer math only, hue in ColorMath::Fixed::HueSteps units per turn.
+	 * Correctly rounded, converting back is within 2 of the original channels. See ColorMath/ColorMathFixed.h for error bounds.
+	 *
+	 * @param Colors : RGB colors, alpha is ignored.
+	 * @param[out] OutHSL : HSL8 colors, same length as Colors.
+	 */
+	static void RGBToHSL8Batch(TArrayView<const FColor> Colors, TArrayView<ColorMath::Fixed::FHSL8> OutHSL);
+
+	/**
+	 * Converts packed HSL8 colors to RGB colors with integer math only.
+	 *
+	 * @param HSL : HSL8 colors, hue outside a turn is treated as 0.
+	 * @param[out] OutColors : RGB colors with full alpha, same length as HSL.
+	 */
+	static void HSL8ToRGBBatch(TArrayView<const ColorMath::Fixed::FHSL8> HSL, TArrayView<FColor> OutColors);
+#pragma endregion
+
+#pragma region Hex
+	/** Characters in a hex color written by the buffer encoders, format #RRGGBB. */
+	static constexpr int32 HexLength = 7;
+	/** Buffer size needed by the buffer encoders, including null terminator. */
+	static constexpr int32 HexBufferSize = HexLength + 1;
+
+	/**
+	 * Converts linear color to hex color without allocating, same digits as 'LinearColorToHex'.
+	 *
+	 * @param Color : Convert color.
+	 * @param[out] OutBuffer : Buffer of at least HexBufferSize characters, receives null terminated #RRGGBB.
+	 * @return Number of characters written, excluding null terminator.
+	 */
+	static int32 LinearColorToHex(const FLinearColor& Color, TCHAR* OutBuffer);
+	static int32 LinearColorToHex(const FLinearColor& Color, ANSICHAR* OutBuffer);
+
+	/**
+	 * Appends hex color to string, no allocation if OutHex has enough slack.
+	 *
+	 * @param Color : Convert color.
+	 * @param[in, out] OutHex : String to append #RRGGBB to.
+	 */
+	static void AppendLinearColorToHex(const FLinearColor& Color, FString& OutHex);
+
+	/**
+	 * Parses hex color, same results as 'HexToLinearColor' for well formed input.
+	 *
+	 * @param Hex : Hex color, supported formats: RGB, RRGGBB, RRGGBBAA, #RGB, #RRGGBB, #RRGGBBAA.
+	 * @param[out] OutColor : Linear color, unchanged if parsing fails.
+	 * @return False if Hex has an unsupported length or invalid digits.
+	 */
+	static bool ParseHex(FStringView Hex, FLinearColor& OutColor);
+
+	/**
+	 * Formats a palette as hex colors into a single string, allocated once.
+	 *
+	 * @param Colors : Palette colors.
+	 * @param[out] OutHex : Hex colors in palette order, each followed by Separator.
+	 * @param Separator : Character written after each hex color.
+	 */
+	static void PaletteToHex(TArrayView<const FLinearColor> Colors, FString& OutHex, TCHAR Separator = TEXT('\n'));
+
+	/**
+	 * Parses a palette of hex colors separated by Separator. Whitespace around entries and empty entries are ignored.
+	 *
+	 * @param Hex : Hex colors.
+	 * @param[out] OutColors : Parsed colors, appended in order up to the first malformed entry.
+	 * @param Separator : Character between hex colors.
+	 * @return False if any entry is malformed.
+	 */
+	static bool HexToPalette(FStringView Hex, TArray<FLinearColor>& OutColors, TCHAR Separator = TEXT('\n'));
 #pragma endregion
 };
@@ -0,0 +1,134 @@
+// Copyright kevin791129
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Bounded undo and redo history of picker changes.
+ * Every change from begin to end is one entry holding the states before and after it. Entries live in a fixed capacity ring buffer,
+ * the oldest entry is dropped once full. Optionally each entry keeps a decimated path of the states in between for scrubbing playback.
+ * All memory is allocated by 'SetCapacity', recording, undo and redo never allocate and are O(1), apart from the path copy when a change ends.
+ */
+class COLORPICKER_API FColorPickerHistory
+{
+public:
+	/**
+	 * Picker state packed into 8 bytes, hue is kept so gray colors restore to the same indicator positions.
+	 */
+	struct FState
+	{
+		uint16 Hue;
+		uint16 Saturation;
+		uint16 Value;
+		uint16 Alpha;
+
+		/**
+		 * @param H : Hue, range: [0.0f, 360.0f].
+		 * @param S : Saturation, range: [0.0f, 1.0f].
+		 * @param V : Value, range: [0.0f, 1.0f].
+		 * @param A : Alpha, range: [0.0f, 1.0f].
+		 */
+		static FState Pack(const float H, const float S, const float V, const float A);
+		void Unpack(float& OutH, float& OutS, float& OutV, float& OutA) const;
+
+		bool operator==(const FState& Other) const { return Hue == Other.Hue && Saturation == Other.Saturation && Value == Other.Value && Alpha == Other.Alpha; }
+		bool operator!=(const FState& Other) const { return !(*this == Other); }
+	};
+
+	explicit FColorPickerHistory(const int32 InCapacity = 64, const int32 InMaxPathPoints = 0) { SetCapacity(InCapacity, InMaxPathPoints); }
+
+	/**
+	 * Allocate history, clearing all entries.
+	 *
+	 * @param InCapacity : Maximum number of entries, at least 1.
+	 * @param InMaxPathPoints : Path points kept per entry, 0 disables paths. Paths of longer changes are decimated evenly, otherwise at least 2.
+	 */
+	void SetCapacity(const int32 InCapacity, const int32 InMaxPathPoints);
+
+	/**
+	 * Remove all entries.
+	 */
+	void Clear();
+
+	/**
+	 * Start recording a change.
+	 *
+	 * @param State : State before change.
+	 */
+	void BeginChange(const FState& State);
+
+	/**
+	 * Record an intermediate state of the change being recorded, only used for paths.
+	 */
+	void RecordChange(const FState& State);
+
+	/**
+	 * Finish recording a change, adding an entry unless state is unchanged. Adding an entry removes all redo entries.
+	 *
+	 * @param State : State after change.
+	 * @return True if an entry was added.
+	 */
+	bool EndChange(const FState& State);
+
+	bool IsChanging() const { return bChanging; }
+	bool CanUndo() const { return Cursor > 0; }
+	bool CanRedo() const { return Cursor < Num; }
+	int32 NumUndo() const { return Cursor; }
+	int32 NumRedo() const { return Num - Cursor; }
+
+	/**
+	 * Step back one entry.
+	 *
+	 * @param[out] OutState : State before the undone change.
+	 * @return False if there is nothing to undo or a change is being recorded.
+	 */
+	bool Undo(FState& OutState);
+
+	/**
+	 * Step forward one entry.
+	 *
+	 * @param[out] OutState : State after the redone change.
+	 * @return False if there is nothing to redo or a change is being recorded.
+	 */
+	bool Redo(FState& OutState);
+
+	/**
+	 * Get path of an undoable entry, from its state before to its state after.
+	 *
+	 * @param Depth : 0 for the entry 'Undo' reverts next, 1 for the one before and so on.
+	 * @return Path states, empty if paths are disabled or Depth is out of range.
+	 */
+	TArrayView<const FState> GetUndoPath(const int32 Depth) const;
+
+private:
+	struct FEntry
+	{
+		FState Before;
+		FState After;
+		int32 NumPathPoints;
+	};
+
+	FORCEINLINE int32 SlotIndex(const int32 Position) const { return (Start + Position) % Entries.Num(); }
+	void AddPathPoint(const FState& State);
+
+	TArray<FEntry> Entries;
+	/** Path points of every entry, MaxPathPoints per slot. */
+	TArray<FState> Paths;
+	int32 MaxPathPoints = 0;
+
+	/** Slot of the oldest entry. */
+	int32 Start = 0;
+	/** Number of entries, undoable and redoable. */
+	int32 Num = 0;
+	/** Number of undoable entries, entries at and after it are redoable. */
+	int32 Cursor = 0;
+
+	bool bChanging = false;
+	FState ChangeBefore;
+	/** Path of change being recorded, every 'PathStride'-th state is kept. */
+	TArray<FState> PathScratch;
+	int32 NumScratchPoints = 0;
+	int32 PathStride = 1;
+	int32 NumRecorded = 0;
+};
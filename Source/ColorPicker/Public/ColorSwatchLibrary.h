@@ -0,0 +1,228 @@
+// Copyright kevin791129
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+/**
+ * How swatch colors are stored in a binary swatch library.
+ */
+enum class EColorSwatchStorage : uint8
+{
+	/** 8-bit sRGB channels and linear alpha, 4 bytes per swatch. Lossless for colors authored as hex. */
+	CSS_RGBA8,
+	/** Half float linear channels, 8 bytes per swatch. Keeps HDR and out of gamut colors. */
+	CSS_FLOAT16
+};
+
+/**
+ * Settings of a written binary swatch library.
+ */
+struct FColorSwatchWriteSettings
+{
+	EColorSwatchStorage Storage = EColorSwatchStorage::CSS_RGBA8;
+	/** Store HSV of every swatch, 6 bytes per swatch, otherwise it is computed when read. */
+	bool bIncludeHSV = false;
+	/** Store CIELAB of every swatch as half floats, 6 bytes per swatch, otherwise it is computed when read. */
+	bool bIncludeLab = false;
+};
+
+/**
+ * Read only binary swatch library, a large set of named colors.
+ * The file is memory mapped and nothing is decoded when opened, so opening costs the same for any number of swatches and only
+ * pages actually read become resident. Colors, names and precomputed blocks are decoded per access.
+ *
+ * File layout, little endian, every block aligned to 8 bytes:
+ * - Header, magic 'CPSW' and version followed by block offsets.
+ * - Colors, RGBA8 or float16 RGBA per swatch.
+ * - Name id per swatch. Names are interned, swatches with equal names share one name entry.
+ * - Name offsets, one past the last name included, into the name pool of UTF-8 bytes without terminators.
+ * - Name hash, open addressing table of the first swatch of every name, sized to a power of two at least twice the name count.
+ * - Optional HSV block, 16-bit unsigned normalized hue, saturation and value per swatch.
+ * - Optional Lab block, half float L, a and b per swatch.
+ */
+class COLORPICKER_API FColorSwatchLibrary
+{
+public:
+	FColorSwatchLibrary();
+	~FColorSwatchLibrary();
+
+	FColorSwatchLibrary(const FColorSwatchLibrary&) = delete;
+	FColorSwatchLibrary& operator=(const FColorSwatchLibrary&) = delete;
+
+	/**
+	 * Open a library file, closing any open library. The file is read into memory instead where mapping is unsupported.
+	 *
+	 * @param Filename : Library file.
+	 * @return False if the file cannot be read or is not a valid library.
+	 */
+	bool Open(const FString& Filename);
+
+	/**
+	 * Open a library held in memory, closing any open library.
+	 *
+	 * @param InData : Library file contents, moved into library.
+	 * @return False if data is not a valid library.
+	 */
+	bool Open(TArray<uint8>&& InData);
+
+	/**
+	 * Close library and unmap file.
+	 */
+	void Close();
+
+	bool IsOpen() const { return Data != nullptr; }
+	int32 Num() const { return NumSwatches; }
+	int32 NumUniqueNames() const { return NumNames; }
+	EColorSwatchStorage GetStorage() const { return Storage; }
+	bool HasHSV() const { return HSVBlock != nullptr; }
+	bool HasLab() const { return LabBlock != nullptr; }
+
+	/** Size of library data, mapped or in memory. */
+	int64 GetDataSize() const { return DataSize; }
+
+	/**
+	 * Get linear color of a swatch.
+	 */
+	FLinearColor GetColor(const int32 Index) const;
+
+	/**
+	 * Get 8-bit sRGB color of a swatch, without decoding for RGBA8 storage.
+	 */
+	FColor GetSRGBColor(const int32 Index) const;
+
+	/**
+	 * Get name of a swatch, allocates a string.
+	 */
+	FString GetName(const int32 Index) const;
+
+	/**
+	 * Get name of a swatch without allocating.
+	 *
+	 * @param[out] OutLength : Name length in bytes.
+	 * @return UTF-8 name, not null terminated, pointing into library data.
+	 */
+	const ANSICHAR* GetNameUTF8(const int32 Index, int32& OutLength) const;
+
+	/**
+	 * Get HSV of a swatch, from the HSV block if present, otherwise converted from its color.
+	 *
+	 * @param[out] OutH : Hue, range: [0.0f, 360.0f].
+	 * @param[out] OutS : Saturation, range: [0.0f, 1.0f].
+	 * @param[out] OutV : Value, range: [0.0f, 1.0f].
+	 */
+	void GetHSV(const int32 Index, float& OutH, float& OutS, float& OutV) const;
+
+	/**
+	 * Get CIELAB of a swatch, from the Lab block if present, otherwise converted from its color.
+	 *
+	 * @return L, a and b in X, Y and Z.
+	 */
+	FVector GetLab(const int32 Index) const;
+
+	/**
+	 * Find first swatch with a name, case sensitive.
+	 *
+	 * @return Swatch index, INDEX_NONE if not found.
+	 */
+	int32 FindByName(const FString& Name) const;
+
+private:
+	/**
+	 * Validate header and set block pointers.
+	 */
+	bool Parse(const uint8* InData, const int64 InDataSize);
+
+	const uint8* Data = nullptr;
+	int64 DataSize = 0;
+
+	int32 NumSwatches = 0;
+	int32 NumNames = 0;
+	EColorSwatchStorage Storage = EColorSwatchStorage::CSS_RGBA8;
+
+	const uint8* ColorBlock = nullptr;
+	const uint32* NameIds = nullptr;
+	const uint32* NameOffsets = nullptr;
+	const ANSICHAR* NamePool = nullptr;
+	uint32 NamePoolSize = 0;
+	const uint32* NameHash = nullptr;
+	uint32 NameHashMask = 0;
+	const uint16* HSVBlock = nullptr;
+	const uint16* LabBlock = nullptr;
+
+	/** Mapped file, if opened from a file that could be mapped. */
+	TUniquePtr<IMappedFileHandle> MappedFile;
+	TUniquePtr<IMappedFileRegion> MappedRegion;
+	/** Library contents, if opened from memory or mapping is unsupported. */
+	TArray<uint8> OwnedData;
+};
+
+/**
+ * Builds binary swatch libraries, and converts them from and to the JSON text format.
+ * JSON libraries are an array of objects with a "Name" string and a "Color" hex string (#RRGGBB or #RRGGBBAA, sRGB).
+ */
+class COLORPICKER_API FColorSwatchLibraryWriter
+{
+public:
+	FColorSwatchLibraryWriter();
+
+	void Reserve(const int32 NumSwatches);
+	void Reset();
+
+	int32 Num() const { return Colors.Num(); }
+	int32 NumUniqueNames() const { return NameToId.Num(); }
+
+	/**
+	 * Add a swatch, names are interned.
+	 *
+	 * @return Swatch index.
+	 */
+	int32 Add(const FString& Name, const FLinearColor& Color);
+
+	/**
+	 * Add every swatch of an open binary library.
+	 */
+	void Append(const FColorSwatchLibrary& Library);
+
+	/**
+	 * Add swatches of a JSON library.
+	 *
+	 * @param JsonText : JSON library.
+	 * @param[out] OutError : Reason of failure.
+	 * @return False if text is not a valid JSON library, swatches before the failing one are kept.
+	 */
+	bool ImportJson(const FString& JsonText, FString& OutError);
+
+	/**
+	 * Write swatches as a JSON library, colors as #RRGGBBAA.
+	 */
+	FString ExportJson() const;
+
+	/**
+	 * Write swatches as a binary library.
+	 *
+	 * @param Settings : Storage and precomputed blocks.
+	 * @param[out] OutData : Library file contents.
+	 */
+	void Write(const FColorSwatchWriteSettings& Settings, TArray<uint8>& OutData) const;
+
+	/**
+	 * Write swatches to a binary library file.
+	 *
+	 * @return False if the file cannot be written.
+	 */
+	bool Save(const FString& Filename, const FColorSwatchWriteSettings& Settings) const;
+
+private:
+	TArray<FLinearColor> Colors;
+	/** Name id of every swatch. */
+	TArray<uint32> SwatchNames;
+	/** Offsets of unique names into NamePool, one past the last name included. */
+	TArray<uint32> NameOffsets;
+	/** Unique names, UTF-8 without terminators. */
+	TArray<ANSICHAR> NamePool;
+	TMap<FString, uint32> NameToId;
+};
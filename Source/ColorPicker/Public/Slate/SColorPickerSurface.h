@@ -0,0 +1,135 @@
+// Copyright kevin791129
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ColorFormat.h"
+#include "Styling/CoreStyle.h"
+#include "Widgets/SLeafWidget.h"
+
+DECLARE_DELEGATE_OneParam(FOnColorPickerSurfaceColorChanged, const FLinearColor&);
+
+/**
+ * Single leaf widget drawing a saturation value picker and a hue strip, the Slate counterpart of UColorPickerWidget.
+ * Gradients and indicators are painted directly as six draw elements on two layers. Only the indicator brush samples a texture, so
+ * many pickers batch into a few draws. Gradients are vertex colors blended in sRGB, which reproduces the HSV gradients exactly.
+ * Hit testing is done against the layout rectangles, without child widgets or hover state.
+ * The saturation value picker fills the width left of the hue strip, top right is full saturation and value, hue grows downwards.
+ */
+class COLORPICKER_API SColorPickerSurface : public SLeafWidget
+{
+public:
+	SLATE_BEGIN_ARGS(SColorPickerSurface)
+		: _Color(FLinearColor::Red)
+		, _DesiredSize(FVector2D(450.f, 300.f))
+		, _HueStripWidth(30.f)
+		, _Spacing(20.f)
+		, _HueIndicatorSize(FVector2D(30.f, 20.f))
+		, _SaturationValueIndicatorSize(FVector2D(18.f))
+		, _HueIndicatorBrush(nullptr)
+		, _SaturationValueIndicatorBrush(FCoreStyle::Get().GetBrush("ColorPicker.Selector"))
+		, _Precision(EColorPrecision::CP_8BIT)
+		{}
+		/** Initial color. */
+		SLATE_ARGUMENT(FLinearColor, Color)
+		SLATE_ARGUMENT(FVector2D, DesiredSize)
+		SLATE_ARGUMENT(float, HueStripWidth)
+		/** Gap between saturation value picker and hue strip. */
+		SLATE_ARGUMENT(float, Spacing)
+		SLATE_ARGUMENT(FVector2D, HueIndicatorSize)
+		SLATE_ARGUMENT(FVector2D, SaturationValueIndicatorSize)
+		/** Hue indicator image, an outline is drawn if null. */
+		SLATE_ARGUMENT(const FSlateBrush*, HueIndicatorBrush)
+		SLATE_ARGUMENT(const FSlateBrush*, SaturationValueIndicatorBrush)
+		/** Conversion precision between color and indicator positions, same as the UMG picker. */
+		SLATE_ARGUMENT(EColorPrecision, Precision)
+		/** When user moves an indicator. */
+		SLATE_EVENT(FOnColorPickerSurfaceColorChanged, OnColorChanged)
+		/** When user presses on either picker. */
+		SLATE_EVENT(FSimpleDelegate, OnColorChangeBegin)
+		/** When user releases or capture is lost. */
+		SLATE_EVENT(FSimpleDelegate, OnColorChangeEnd)
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs);
+
+	/**
+	 * Set color and move indicators, hue is kept for grays. Does not execute 'OnColorChanged'.
+	 */
+	void SetColor(const FLinearColor& NewColor);
+	const FLinearColor& GetColor() const { return Color; }
+
+	float GetHue() const { return Hue; }
+	float GetSaturation() const { return Saturation; }
+	float GetValue() const { return Value; }
+
+	void SetDesiredSize(const FVector2D& InDesiredSize);
+	void SetHueStripWidth(const float InHueStripWidth);
+	void SetSpacing(const float InSpacing);
+	void SetHueIndicatorSize(const FVector2D& InSize);
+	void SetSaturationValueIndicatorSize(const FVector2D& InSize);
+	void SetHueIndicatorBrush(const FSlateBrush* InBrush);
+	void SetSaturationValueIndicatorBrush(const FSlateBrush* InBrush);
+	void SetPrecision(const EColorPrecision InPrecision) { Precision = InPrecision; }
+
+	bool IsInteracting() const { return DragTarget != EDragTarget::None; }
+
+	// SWidget interface
+	virtual int32 OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override;
+	virtual FReply OnMouseButtonDown(const FGeometry& MyGeometry, const FPointerEvent& MouseEvent) override;
+	virtual FReply OnMouseButtonUp(const FGeometry& MyGeometry, const FPointerEvent& MouseEvent) override;
+	virtual FReply OnMouseMove(const FGeometry& MyGeometry, const FPointerEvent& MouseEvent) override;
+	virtual FCursorReply OnCursorQuery(const FGeometry& MyGeometry, const FPointerEvent& CursorEvent) const override;
+	virtual void OnMouseCaptureLost(const FCaptureLostEvent& CaptureLostEvent) override;
+
+protected:
+	virtual FVector2D ComputeDesiredSize(float LayoutScaleMultiplier) const override;
+
+private:
+	enum class EDragTarget : uint8
+	{
+		None,
+		Hue,
+		SaturationValue
+	};
+
+	/** Picker rectangles in local space. */
+	struct FLayout
+	{
+		FSlateRect SaturationValue;
+		FSlateRect Hue;
+	};
+
+	FLayout ComputeLayout(const FVector2D& LocalSize) const;
+
+	/**
+	 * Move dragged indicator to a local position, clamped to its picker, then update color and notify.
+	 */
+	void ApplyLocalPosition(const FGeometry& MyGeometry, const FVector2D& LocalPosition);
+
+	/**
+	 * Stop dragging and notify, if dragging.
+	 */
+	void FinishInteraction();
+
+	FLinearColor Color;
+	/** Indicator state, kept separately from color so hue and saturation survive grays. */
+	float Hue = 0.f;
+	float Saturation = 1.f;
+	float Value = 1.f;
+
+	FVector2D DesiredSize;
+	float HueStripWidth;
+	float Spacing;
+	FVector2D HueIndicatorSize;
+	FVector2D SaturationValueIndicatorSize;
+	const FSlateBrush* HueIndicatorBrush;
+	const FSlateBrush* SaturationValueIndicatorBrush;
+	EColorPrecision Precision;
+
+	FOnColorPickerSurfaceColorChanged OnColorChanged;
+	FSimpleDelegate OnColorChangeBegin;
+	FSimpleDelegate OnColorChangeEnd;
+
+	EDragTarget DragTarget = EDragTarget::None;
+};
@@ -0,0 +1,116 @@
+// Copyright kevin791129
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/Widget.h"
+#include "Styling/SlateBrush.h"
+#include "ColorFormat.h"
+#include "UMG/ColorPickerWidget.h"
+#include "ColorPickerSurface.generated.h"
+
+class SColorPickerSurface;
+
+/**
+ * Thin UMG wrapper of SColorPickerSurface, a color picker drawn by a single native widget.
+ * Cheaper than UColorPickerWidget when many pickers are on screen, without its materials, history, snapping or broadcast policies.
+ */
+UCLASS()
+class COLORPICKER_API UColorPickerSurface : public UWidget
+{
+	GENERATED_BODY()
+
+public:
+	UColorPickerSurface(const FObjectInitializer& ObjectInitializer);
+
+	/**
+	 * Set the current color of color picker and move indicators accordlingly.
+	 *
+	 * @param NewColor : New color to be displayed by color picker.
+	 * @param bBroadcastChange : Whether to broadcast 'OnPickerColorChanged' delegate, default not to.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Color Picker Surface")
+		void SetPickerColor(FLinearColor NewColor, bool bBroadcastChange = false);
+
+	/**
+	 * Get the color currently displayed by color picker.
+	 *
+	 * @return Current color.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Color Picker Surface")
+		const FLinearColor& GetPickerColor() const { return Color; }
+
+	//~ Begin UWidget Function Override
+	virtual void SynchronizeProperties() override;
+	virtual void ReleaseSlateResources(bool bReleaseChildren) override;
+#if WITH_EDITOR
+	virtual const FText GetPaletteCategory() override;
+#endif
+	//~ End UWidget Function Override
+
+protected:
+	//~ Begin UWidget Function Override
+	virtual TSharedRef<SWidget> RebuildWidget() override;
+	//~ End UWidget Function Override
+
+private:
+	void HandleColorChanged(const FLinearColor& NewColor);
+	void HandleColorChangeBegin();
+	void HandleColorChangeEnd();
+
+	/**
+	 * Broadcast current color to dynamic and native listeners.
+	 */
+	void BroadcastColorChanged();
+
+public:
+	/** When user interacts with picker and selects new color. */
+	UPROPERTY(BlueprintAssignable, meta = (DisplayName = "On Color Changed"))
+		FOnPickerColorChanged ColorChangeDelegate;
+	/** When user starts interacting with picker. */
+	UPROPERTY(BlueprintAssignable, meta = (DisplayName = "On Color Change Start"))
+		FOnPickerColorChangeBegin ColorChangeBeginDelegate;
+	/** When user finishes interacting with picker. */
+	UPROPERTY(BlueprintAssignable, meta = (DisplayName = "On Color Change Finish"))
+		FOnPickerColorChangeEnd ColorChangeEndDelegate;
+
+	/** Native versions of the delegates above, broadcast at the same time without reflection. */
+	FOnPickerColorChangedNative OnColorChangedNative;
+	FOnPickerColorChangeBeginNative OnColorChangeBeginNative;
+	FOnPickerColorChangeEndNative OnColorChangeEndNative;
+
+protected:
+	/** Current color. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Color Picker Surface|Color")
+		FLinearColor Color = FLinearColor::Red;
+	/** Conversion precision between current color and indicator positions. */
+	UPROPERTY(EditAnywhere, Category = "Color Picker Surface|Color")
+		EColorPrecision Precision = EColorPrecision::CP_8BIT;
+
+	/** Size requested from the parent, pickers stretch to the size given. */
+	UPROPERTY(EditAnywhere, Category = "Color Picker Surface|Layout")
+		FVector2D DesiredSize = FVector2D(450.f, 300.f);
+	/** Hue strip width, saturation and value picker takes the rest. */
+	UPROPERTY(EditAnywhere, Category = "Color Picker Surface|Layout", meta = (ClampMin = 0.0f))
+		float HueStripWidth = 30.f;
+	/** Gap between saturation value picker and hue strip. */
+	UPROPERTY(EditAnywhere, Category = "Color Picker Surface|Layout", meta = (ClampMin = 0.0f))
+		float Spacing = 20.f;
+
+	/** Hue indicator image, an outline is drawn if draw type is none. */
+	UPROPERTY(EditAnywhere, Category = "Color Picker Surface|Hue|Indicator", meta = (DisplayName = "Inicator Brush"))
+		FSlateBrush HueIndicatorBrush;
+	/** Hue indicator size. */
+	UPROPERTY(EditAnywhere, Category = "Color Picker Surface|Hue|Indicator", meta = (DisplayName = "Inicator Size"))
+		FVector2D HueIndicatorSize = FVector2D(30.f, 20.f);
+
+	/** Saturation and value indicator image. */
+	UPROPERTY(EditAnywhere, Category = "Color Picker Surface|Satuation Value|Indicator", meta = (DisplayName = "Inicator Brush"))
+		FSlateBrush SaturationValueIndicatorBrush;
+	/** Saturation and value indicator size. */
+	UPROPERTY(EditAnywhere, Category = "Color Picker Surface|Satuation Value|Indicator", meta = (DisplayName = "Inicator Size"))
+		FVector2D SaturationValueIndicatorSize = FVector2D(18.f);
+
+private:
+	TSharedPtr<SColorPickerSurface> MySurface;
+};
@@ -7,20 +7,63 @@
 #include "Components/CanvasPanel.h"
 #include "Components/Image.h"
 #include "Layout/Margin.h"
+#include "ColorFormat.h"
+#include "ColorGradientRasterizer.h"
+#include "ColorGradientRamp.h"
+#include "ColorPaletteExtractor.h"
+#include "ColorPaletteIndex.h"
+#include "ColorEyedropperSampler.h"
+#include "ColorPickerHistory.h"
 #include "ColorPickerWidget.generated.h"
 
+class UTexture2D;
+struct FGradientTextureStaging;
+
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnPickerColorChanged, const FLinearColor&, Color);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnPickerColorChangeBegin);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnPickerColorChangeEnd);
 
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnPickerColorChangedNative, const FLinearColor&);
+DECLARE_MULTICAST_DELEGATE(FOnPickerColorChangeBeginNative);
+DECLARE_MULTICAST_DELEGATE(FOnPickerColorChangeEndNative);
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnPickerPaletteExtractedNative, const TArray<FColorPaletteEntry>&);
+
+UENUM(BlueprintType, meta = (DisplayName = "Color Broadcast Policy"))
+enum class EColorBroadcastPolicy : uint8
+{
+	/** Broadcast on every pointer move. */
+	CBP_EVERY_MOVE UMETA(DisplayName = "Every Move"),
+	/** Broadcast at most 'BroadcastRate' times per second, last color is broadcast when change ends. */
+	CBP_RATE_LIMITED UMETA(DisplayName = "Rate Limited"),
+	/** Broadcast only when the 8-bit sRGB color changes. */
+	CBP_QUANTIZED_CHANGE UMETA(DisplayName = "Quantized Change"),
+	/** Broadcast once when change ends, if color changed. */
+	CBP_CHANGE_END UMETA(DisplayName = "Change End")
+};
+
+UENUM(BlueprintType, meta = (DisplayName = "Color Picker Gradient Backend"))
+enum class EColorPickerGradientBackend : uint8
+{
+	/** Gradients drawn by plugin materials on the GPU. */
+	CGB_MATERIAL UMETA(DisplayName = "Material"),
+	/** Gradients rasterized on the CPU and uploaded to transient textures, regenerated only when hue or size changes. */
+	CGB_CPU_TEXTURE UMETA(DisplayName = "CPU Texture")
+};
+
 /**
  * Color picker widget comprised of a hue picker and a saturation and value picker.
+ * Works with global invalidation, invalidation boxes and retainer boxes: nothing ticks or is volatile, indicators move by render translation
+ * without arranging the canvas, and gradient or indicator material changes invalidate only the paint of their image. Idle pickers are not
+ * painted at all when cached, see the 'Picker Paints' stat.
  */
-UCLASS()
+UCLASS(meta = (DisableNativeTick))
 class COLORPICKER_API UColorPickerWidget : public UUserWidget
 {
 	GENERATED_BODY()
 
+	/** Development harness replaying pointer streams through the input handlers, see 'ColorPicker.InputReplay'. */
+	friend class FColorPickerInputReplay;
+
 public:
 	/**
 	 * Set the current color of color picker and move indicators accordlingly. 
@@ -39,11 +82,115 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Color Picker Widget")
 		const FLinearColor& GetPickerColor() const { return CurrentColor; }
 
+	/**
+	 * Set palette that picked colors snap to when 'bSnapToPalette' is enabled.
+	 *
+	 * @param Colors : Palette colors, empty disables snapping.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Color Picker Widget")
+		void SetSnapPalette(const TArray<FLinearColor>& Colors);
+
+	/**
+	 * Build gradient ramp from the current colors of pickers, evenly spaced in order.
+	 *
+	 * @param Pickers : Pickers from start to end of ramp, null pickers are skipped. A single picker gives a constant ramp.
+	 * @param Interpolation : Color space stops are interpolated in.
+	 * @return Ramp, baked on first sample.
+	 */
+	static FColorGradientRamp MakeGradientRamp(TArrayView<const UColorPickerWidget* const> Pickers, const EColorRampInterpolation Interpolation = EColorRampInterpolation::CRI_OKLAB);
+
+	/**
+	 * Extract dominant colors from image pixels in the background, then set picker to the most dominant color and broadcast the change.
+	 *
+	 * @param Pixels : Image pixels, moved into the task.
+	 * @param Settings : Extraction settings.
+	 * @param OnProgress : Optional progress in range [0, 1], executed on game thread.
+	 * @return Running task, cancelling it leaves picker unchanged.
+	 */
+	TSharedRef<FColorPaletteExtractionTask, ESPMode::ThreadSafe> ExtractPickerColorAsync(TArray<FColor>&& Pixels, const FColorPaletteSettings& Settings, FOnColorPaletteProgress OnProgress = FOnColorPaletteProgress());
+
+	/**
+	 * Set image sampled by 'PickEyedropperColor', such as a captured frame. Pixels are not kept after this returns.
+	 *
+	 * @param Pixels : Image pixels, row major.
+	 * @param Size : Image size.
+	 */
+	void SetEyedropperImage(TArrayView<const FColor> Pixels, const FIntPoint& Size);
+	void SetEyedropperImage(TArrayView<const FLinearColor> Pixels, const FIntPoint& Size);
+
+	/**
+	 * Release eyedropper image.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Color Picker Widget")
+		void ClearEyedropperImage() { Eyedropper.Reset(); }
+
+	/**
+	 * Set picker color to the average linear color of a square area of the eyedropper image, cost does not depend on area size.
+	 *
+	 * @param Pixel : Center pixel in eyedropper image.
+	 * @param Radius : Pixels around center in each direction, 0 picks a single pixel. Clamped to [0, 127].
+	 * @param bBroadcastChange : Whether to broadcast 'OnPickerColorChanged' delegate.
+	 * @return False if no eyedropper image is set or the area lies outside it, picker is then unchanged.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Color Picker Widget")
+		bool PickEyedropperColor(FIntPoint Pixel, int32 Radius = 2, bool bBroadcastChange = true);
+
+	/**
+	 * Revert the last color change made by dragging, then broadcast the restored color.
+	 *
+	 * @return False if there is nothing to undo or user is interacting with picker.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Color Picker Widget|History")
+		bool Undo();
+
+	/**
+	 * Reapply the last undone color change, then broadcast the restored color.
+	 *
+	 * @return False if there is nothing to redo or user is interacting with picker.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Color Picker Widget|History")
+		bool Redo();
+
+	/** If 'Undo' would succeed. */
+	UFUNCTION(BlueprintCallable, Category = "Color Picker Widget|History")
+		bool CanUndo() const { return History.CanUndo() && !bIsInteracting; }
+
+	/** If 'Redo' would succeed. */
+	UFUNCTION(BlueprintCallable, Category = "Color Picker Widget|History")
+		bool CanRedo() const { return History.CanRedo() && !bIsInteracting; }
+
+	/**
+	 * Remove all undo and redo entries.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Color Picker Widget|History")
+		void ClearHistory() { History.Clear(); }
+
+	/**
+	 * Move picker along the recorded path of the change 'Undo' reverts next, history is unchanged. Requires 'HistoryPathPoints'.
+	 *
+	 * @param Time : Position along path, 0 for the color before change and 1 for the color after.
+	 * @param bBroadcastChange : Whether to broadcast 'OnPickerColorChanged' delegate.
+	 * @return False if there is no recorded path or user is interacting with picker.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Color Picker Widget|History")
+		bool ScrubLastChange(float Time, bool bBroadcastChange = false);
+
+	/**
+	 * Get undo and redo history of picker.
+	 */
+	const FColorPickerHistory& GetHistory() const { return History; }
+
+	//~ Begin UWidget Function Override
+	virtual void ReleaseSlateResources(bool bReleaseChildren) override;
+	//~ End UWidget Function Override
+
 protected:
 	//~ Begin UUserWidget Function Override
 	virtual void NativeOnInitialized() override;
 	virtual void NativePreConstruct() override;
 	virtual void NativeConstruct() override;
+	virtual void NativeDestruct() override;
+	virtual int32 NativePaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override;
 
 	virtual FReply NativeOnMouseButtonDown(const FGeometry& InGeometry, const FPointerEvent& InMouseEvent) override;
 	virtual FReply NativeOnMouseButtonUp(const FGeometry& InGeometry, const FPointerEvent& InMouseEvent) override;
@@ -77,6 +224,104 @@ private:
 	 */
 	UFUNCTION()
 		void UpdateSaturationValueIndicator();
+
+	/**
+	 * Acquire dynamic materials from the shared pool and apply current parameters, does nothing if already acquired.
+	 */
+	UFUNCTION()
+		void AcquireMaterialInstances();
+
+	/**
+	 * Return dynamic materials to the shared pool and clear brushes using them, parameters written are kept and reapplied on next acquire.
+	 */
+	UFUNCTION()
+		void ReleaseMaterialInstances();
+
+	/**
+	 * Update gradient textures now, or on the next frame if coalescing input.
+	 */
+	UFUNCTION()
+		void RequestGradientTextureUpdate();
+
+	/**
+	 * Rasterize gradients for current hue and picker sizes and upload changed ones, only with CPU texture backend.
+	 */
+	UFUNCTION()
+		void UpdateGradientTextures();
+
+	/**
+	 * Write hue to saturation value picker material, skipped if unchanged.
+	 *
+	 * @param Hue : Hue parameter, range: [0.0f, 1.0f].
+	 */
+	UFUNCTION()
+		void SetHueMaterialParameter(const float Hue);
+
+	/**
+	 * Write indicator color to saturation value indicator material, skipped if unchanged.
+	 *
+	 * @param Color : Indicator color.
+	 */
+	UFUNCTION()
+		void SetIndicatorColorMaterialParameter(const FLinearColor& Color);
+
+	/**
+	 * Move the interacting indicator under pointer, update current color and notify listeners.
+	 *
+	 * @param ScreenSpacePosition : Pointer position in screen space.
+	 */
+	UFUNCTION()
+		void ApplyPointerPosition(const FVector2D& ScreenSpacePosition);
+
+	/**
+	 * Replace current color with nearest snap palette color, if snapping.
+	 */
+	UFUNCTION()
+		void SnapCurrentColor();
+
+	/**
+	 * Notify listeners of a color change caused by interaction, following 'BroadcastPolicy'.
+	 */
+	UFUNCTION()
+		void NotifyColorChanged();
+
+	/**
+	 * Move indicators to a history state and update current color from it.
+	 */
+	void ApplyHistoryState(const FColorPickerHistory::FState& State);
+
+	/**
+	 * Pack current indicator state for history.
+	 */
+	FColorPickerHistory::FState GetHistoryState() const;
+
+	/**
+	 * Broadcast current color to dynamic and native listeners.
+	 */
+	UFUNCTION()
+		void BroadcastColorChanged();
+
+	/**
+	 * Apply pending input, broadcast any color held back by 'BroadcastPolicy' and notify listeners that interaction ended.
+	 */
+	UFUNCTION()
+		void FinishInteraction();
+
+	/**
+	 * Apply pending coalesced pointer position, if any.
+	 */
+	UFUNCTION()
+		void FlushPendingInput();
+
+	/**
+	 * Active timer applying coalesced input once per frame while interacting.
+	 */
+	EActiveTimerReturnType HandleCoalescedInputTimer(double InCurrentTime, float InDeltaTime);
+
+	/**
+	 * Publish extracted palette, most dominant color becomes picker color.
+	 */
+	void HandlePaletteExtracted(const TArray<FColorPaletteEntry>& Palette);
 #pragma endregion
 
 public:
@@ -90,6 +335,13 @@ public:
 	UPROPERTY(BlueprintAssignable, meta = (DisplayName = "On Color Change Finish"))
 		FOnPickerColorChangeEnd ColorChangeEndDelegate;
 
+	/** Native versions of the delegates above, broadcast at the same time without reflection. */
+	FOnPickerColorChangedNative OnColorChangedNative;
+	FOnPickerColorChangeBeginNative OnColorChangeBeginNative;
+	FOnPickerColorChangeEndNative OnColorChangeEndNative;
+	/** When a palette started by 'ExtractPickerColorAsync' is extracted, after picker color is set. */
+	FOnPickerPaletteExtractedNative OnPaletteExtractedNative;
+
 protected:
 	/**
 	 * UI elements.
@@ -156,6 +408,36 @@ protected:
 	/** Indicator border color. */
 	UPROPERTY(EditInstanceOnly, Category = "Color Picker Widget|Satuation Value|Indicator")
 		FLinearColor BorderColor = FLinearColor::White;
+
+	/** Coalesce mouse moves while interacting, applying only the latest pointer position once per frame. Pending input is flushed when interaction ends. */
+	UPROPERTY(EditInstanceOnly, Category = "Color Picker Widget|Input")
+		bool bCoalesceInput = false;
+
+	/** When 'On Color Changed' is broadcast during interaction. */
+	UPROPERTY(EditInstanceOnly, Category = "Color Picker Widget|Input")
+		EColorBroadcastPolicy BroadcastPolicy = EColorBroadcastPolicy::CBP_EVERY_MOVE;
+	/** Maximum broadcasts per second with rate limited policy. */
+	UPROPERTY(EditInstanceOnly, Category = "Color Picker Widget|Input", meta = (ClampMin = 1.0f, EditCondition = "BroadcastPolicy == EColorBroadcastPolicy::CBP_RATE_LIMITED"))
+		float BroadcastRate = 30.f;
+
+	/** Snap picked colors to the nearest color of the palette set by 'SetSnapPalette'. Indicators follow the pointer while dragging and move to the snapped color when interaction ends. */
+	UPROPERTY(EditInstanceOnly, Category = "Color Picker Widget|Color")
+		bool bSnapToPalette = false;
+
+	/** Conversion precision between current color and indicator positions. Float keeps indicators stable when the same color is set repeatedly. */
+	UPROPERTY(EditInstanceOnly, Category = "Color Picker Widget|Color")
+		EColorPrecision Precision = EColorPrecision::CP_8BIT;
+
+	/** How hue and saturation value gradients are drawn. CPU texture does not depend on plugin materials, so it also works without a GPU. */
+	UPROPERTY(EditInstanceOnly, Category = "Color Picker Widget|Rendering")
+		EColorPickerGradientBackend GradientBackend = EColorPickerGradientBackend::CGB_MATERIAL;
+
+	/** Number of drag changes kept for undo, oldest changes are dropped. Memory is allocated once when widget initializes. */
+	UPROPERTY(EditInstanceOnly, Category = "Color Picker Widget|History", meta = (ClampMin = 1))
+		int32 HistoryCapacity = 64;
+	/** Colors kept along the path of each drag for 'ScrubLastChange', long drags are decimated evenly. 0 disables paths. */
+	UPROPERTY(EditInstanceOnly, Category = "Color Picker Widget|History", meta = (ClampMin = 0))
+		int32 HistoryPathPoints = 0;
 #pragma endregion
 
 	/** Color picker current displayed color. */
@@ -179,6 +461,32 @@ private:
 	UPROPERTY()
 		bool bHueInteraction;
 
+	/** Latest pointer position in screen space not yet applied when coalescing input. */
+	FVector2D PendingPointerPosition;
+	/** If PendingPointerPosition holds input not yet applied. */
+	bool bHasPendingPointerPosition = false;
+	/** Active timer applying coalesced input, only registered while interacting. */
+	TSharedPtr<FActiveTimerHandle> CoalescedInputTimer;
+
+	/** Time of last color change broadcast. */
+	double LastBroadcastTime = 0.0;
+	/** Quantized color at last broadcast, or at interaction start. */
+	FColor LastBroadcastColor;
+	/** If color changed during interaction without being broadcast. */
+	bool bHasUnbroadcastChange = false;
+
+	/** If dynamic materials are acquired, between construct and destruct of the picker. */
+	bool bMaterialInstancesAcquired = false;
+
+	/** Palette picked colors snap to. */
+	FColorPaletteIndex SnapPalette;
+
+	/** Area sampler over the eyedropper image. */
+	FColorEyedropperSampler Eyedropper;
+
+	/** Undo and redo history, one entry per drag. */
+	FColorPickerHistory History;
+
 	/** Saturation and value image material to create dynamic material. */
 	UPROPERTY()
 		UMaterialInstance* SVMat;
@@ -195,4 +503,37 @@ private:
 	/** If using default saturation and value indicator. */
 	UPROPERTY()
 		bool bUsingDefaultIndicator;
+
+	/** Hue strip texture with CPU texture backend. */
+	UPROPERTY()
+		UTexture2D* HueGradientTexture;
+	/** Saturation and value texture with CPU texture backend. */
+	UPROPERTY()
+		UTexture2D* SaturationValueGradientTexture;
+	/** CPU gradient pixels, kept to skip regeneration when hue and size are unchanged. */
+	FColorGradientBuffer HueGradient;
+	FColorGradientBuffer SaturationValueGradient;
+	/** Upload staging of gradient textures, reused across uploads. */
+	TSharedPtr<FGradientTextureStaging, ESPMode::ThreadSafe> HueGradientStaging;
+	TSharedPtr<FGradientTextureStaging, ESPMode::ThreadSafe> SaturationValueGradientStaging;
+	/** If hue changed since gradient textures were last updated, only when coalescing input. */
+	bool bGradientTexturesDirty = false;
+
+	/** Cached parameter index of 'Hue' in SVMatDynamic. */
+	int32 HueParameterIndex = INDEX_NONE;
+	/** Last 'Hue' value written to SVMatDynamic, or to be written once acquired. */
+	float LastHueParameter = 0.f;
+	/** If LastHueParameter was set by picker rather than read from material defaults. */
+	bool bHueParameterSet = false;
+	/** Cached parameter index of 'IndicatorColor' in SVIndicatorMatDynamic. */
+	int32 IndicatorColorParameterIndex = INDEX_NONE;
+	/** Last 'IndicatorColor' value written to SVIndicatorMatDynamic, or to be written once acquired. */
+	FLinearColor LastIndicatorColorParameter = FLinearColor::Transparent;
+	/** If LastIndicatorColorParameter was set by picker rather than read from material defaults. */
+	bool bIndicatorColorParameterSet = false;
+
+#if !UE_BUILD_SHIPPING
+	/** Times the picker was painted, read by the input replay harness to check cached paint. */
+	mutable int32 NumPaints = 0;
+#endif
 };
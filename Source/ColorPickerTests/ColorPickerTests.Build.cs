@@ -0,0 +1,29 @@
+// Copyright kevin791129
+
+using System.IO;
+using UnrealBuildTool;
+
+public class ColorPickerTests : ModuleRules
+{
+	public ColorPickerTests(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		// Tests check internal kernels and tables of the runtime module against the engine.
+		PrivateIncludePaths.Add(Path.Combine(ModuleDirectory, "..", "ColorPicker", "Private"));
+
+		PrivateDependencyModuleNames.AddRange(
+			new string[]
+			{
+				"ColorPicker",
+				"Core",
+				"CoreUObject",
+				"Engine",
+				"Json",
+				"Slate",
+				"SlateCore",
+				"UMG"
+			}
+			);
+	}
+}
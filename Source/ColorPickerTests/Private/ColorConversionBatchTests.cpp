@@ -0,0 +1,171 @@
+// Copyright kevin791129
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+#include "ColorPickerBPLibrary.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace ColorConversionBatchTests
+{
+	/** Mismatches reported in full before the rest are only counted. */
+	constexpr int32 MaxReportedErrors = 16;
+
+	float BitsToFloat(const uint32 Bits)
+	{
+		float Value;
+		FMemory::Memcpy(&Value, &Bits, sizeof(Value));
+		return Value;
+	}
+
+	/**
+	 * Channel values both clamps have to agree on: NaN, infinities, both sides of every clamp bound and hue sector edges.
+	 * Channels take every combination in order, so each value lands in every vector lane and in the scalar remainder.
+	 */
+	const float Values[] = {
+		BitsToFloat(0x7FC00000) /* NaN */, BitsToFloat(0x7F800000) /* +Inf */, BitsToFloat(0xFF800000) /* -Inf */,
+		-10.f, -0.f, 0.f, 0.25f, 0.5f, 1.f, 1.5f, 59.9f, 60.f, 180.f, 359.9f, 360.f, 720.f
+	};
+
+	constexpr int32 NumValues = UE_ARRAY_COUNT(Values);
+
+	/**
+	 * Channel streams holding every combination of values, one extra entry so batches end in a scalar remainder.
+	 */
+	void MakeStreams(const int32 NumChannels, TArray<float> (&OutStreams)[4])
+	{
+		int32 Num = 1;
+		for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+		{
+			Num *= NumValues;
+		}
+
+		for (int32 Index = 0; Index <= Num; ++Index)
+		{
+			int32 Combination = Index % Num;
+			for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+			{
+				OutStreams[Channel].Add(Values[Combination % NumValues]);
+				Combination /= NumValues;
+			}
+		}
+	}
+
+	/**
+	 * Compare batch results bit for bit against the single color conversion.
+	 *
+	 * @return Number of mismatches.
+	 */
+	template<typename ScalarFunctionType>
+	int32 CheckResults(FAutomationTestBase& Test, const TCHAR* Name, const TArray<float> (&Streams)[4], const int32 NumChannels, const TArray<FLinearColor>& Results, ScalarFunctionType ScalarFunction)
+	{
+		int32 NumErrors = 0;
+		for (int32 Index = 0; Index < Results.Num(); ++Index)
+		{
+			const FLinearColor Expected = ScalarFunction(Index);
+			if (FMemory::Memcmp(&Results[Index], &Expected, sizeof(FLinearColor)) == 0)
+				continue;
+
+			if (NumErrors++ < MaxReportedErrors)
+			{
+				FString Input;
+				for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+				{
+					Input += FString::Printf(TEXT("%s%g"), Channel > 0 ? TEXT(", ") : TEXT(""), Streams[Channel][Index]);
+				}
+				Test.AddError(FString::Printf(TEXT("%s of (%s) at index %d gave %s, single color conversion gives %s."),
+					Name, *Input, Index, *Results[Index].ToString(), *Expected.ToString()));
+			}
+		}
+
+		if (NumErrors > MaxReportedErrors)
+			Test.AddError(FString::Printf(TEXT("%s: %d results differ from single color conversion."), Name, NumErrors));
+		return NumErrors;
+	}
+
+	/**
+	 * Three channel streams to linear colors, as streams and packed in place with alpha kept.
+	 */
+	template<typename BatchFunctionType, typename InPlaceFunctionType, typename ScalarFunctionType>
+	int32 CheckThreeChannel(FAutomationTestBase& Test, const TCHAR* Name, BatchFunctionType BatchFunction, InPlaceFunctionType InPlaceFunction, ScalarFunctionType ScalarFunction)
+	{
+		TArray<float> Streams[4];
+		MakeStreams(3, Streams);
+		const int32 Num = Streams[0].Num();
+
+		auto Scalar = [&Streams, &ScalarFunction](const int32 Index)
+		{
+			FLinearColor Color;
+			ScalarFunction(Streams[0][Index], Streams[1][Index], Streams[2][Index], Color, EColorPrecision::CP_8BIT);
+			return Color;
+		};
+
+		TArray<FLinearColor> Results;
+		Results.SetNumZeroed(Num);
+		BatchFunction(Streams[0], Streams[1], Streams[2], Results);
+		int32 NumErrors = CheckResults(Test, Name, Streams, 3, Results, Scalar);
+
+		for (int32 Index = 0; Index < Num; ++Index)
+		{
+			Results[Index] = FLinearColor(Streams[0][Index], Streams[1][Index], Streams[2][Index], 0.5f);
+		}
+		InPlaceFunction(Results);
+		NumErrors += CheckResults(Test, *FString::Printf(TEXT("%s in place"), Name), Streams, 3, Results, [&Scalar](const int32 Index)
+		{
+			FLinearColor Color = Scalar(Index);
+			Color.A = 0.5f;
+			return Color;
+		});
+		return NumErrors;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FColorConversionBatchHSVTest, "ColorPicker.ColorConversion.Batch.HSV",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FColorConversionBatchHSVTest::RunTest(const FString& Parameters)
+{
+	using namespace ColorConversionBatchTests;
+
+	return CheckThreeChannel(*this, TEXT("HSVToLinearColorBatch"),
+		[](TArrayView<const float> H, TArrayView<const float> S, TArrayView<const float> V, TArrayView<FLinearColor> OutColors) { UColorPickerBPLibrary::HSVToLinearColorBatch(H, S, V, OutColors); },
+		[](TArrayView<FLinearColor> Colors) { UColorPickerBPLibrary::HSVToLinearColorBatch(Colors); },
+		&UColorPickerBPLibrary::HSVToLinearColor) == 0;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FColorConversionBatchHSLTest, "ColorPicker.ColorConversion.Batch.HSL",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FColorConversionBatchHSLTest::RunTest(const FString& Parameters)
+{
+	using namespace ColorConversionBatchTests;
+
+	return CheckThreeChannel(*this, TEXT("HSLToLinearColorBatch"),
+		[](TArrayView<const float> H, TArrayView<const float> S, TArrayView<const float> L, TArrayView<FLinearColor> OutColors) { UColorPickerBPLibrary::HSLToLinearColorBatch(H, S, L, OutColors); },
+		[](TArrayView<FLinearColor> Colors) { UColorPickerBPLibrary::HSLToLinearColorBatch(Colors); },
+		&UColorPickerBPLibrary::HSLToLinearColor) == 0;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FColorConversionBatchCMYKTest, "ColorPicker.ColorConversion.Batch.CMYK",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FColorConversionBatchCMYKTest::RunTest(const FString& Parameters)
+{
+	using namespace ColorConversionBatchTests;
+
+	TArray<float> Streams[4];
+	MakeStreams(4, Streams);
+
+	TArray<FLinearColor> Results;
+	Results.SetNumZeroed(Streams[0].Num());
+	UColorPickerBPLibrary::CMYKToLinearColorBatch(Streams[0], Streams[1], Streams[2], Streams[3], Results);
+
+	return CheckResults(*this, TEXT("CMYKToLinearColorBatch"), Streams, 4, Results, [&Streams](const int32 Index)
+	{
+		FLinearColor Color;
+		UColorPickerBPLibrary::CMYKToLinearColor(Streams[0][Index], Streams[1][Index], Streams[2][Index], Streams[3][Index], Color);
+		return Color;
+	}) == 0;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
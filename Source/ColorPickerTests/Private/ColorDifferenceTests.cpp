@@ -0,0 +1,176 @@
+// Copyright kevin791129
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+#include "ColorPickerBPLibrary.h"
+#include "ColorDifferenceKernels.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace ColorDifferenceTests
+{
+	/** Published results are rounded to 4 decimals, float math adds less than 1e-5 on top. */
+	constexpr float Tolerance = 1.e-4f;
+
+	struct FReferencePair
+	{
+		FVector Lab1;
+		FVector Lab2;
+		float DeltaE;
+	};
+
+	/** CIEDE2000 test data of Sharma, Wu and Dalal (2005), table 1. Pairs 9 to 16 straddle hue wrapping, pair 10 and 14 are exact ties. */
+	const FReferencePair ReferencePairs[] = {
+		{ FVector(50.0000f, 2.6772f, -79.7751f), FVector(50.0000f, 0.0000f, -82.7485f), 2.0425f },
+		{ FVector(50.0000f, 3.1571f, -77.2803f), FVector(50.0000f, 0.0000f, -82.7485f), 2.8615f },
+		{ FVector(50.0000f, 2.8361f, -74.0200f), FVector(50.0000f, 0.0000f, -82.7485f), 3.4412f },
+		{ FVector(50.0000f, -1.3802f, -84.2814f), FVector(50.0000f, 0.0000f, -82.7485f), 1.0000f },
+		{ FVector(50.0000f, -1.1848f, -84.8006f), FVector(50.0000f, 0.0000f, -82.7485f), 1.0000f },
+		{ FVector(50.0000f, -0.9009f, -85.5211f), FVector(50.0000f, 0.0000f, -82.7485f), 1.0000f },
+		{ FVector(50.0000f, 0.0000f, 0.0000f), FVector(50.0000f, -1.0000f, 2.0000f), 2.3669f },
+		{ FVector(50.0000f, -1.0000f, 2.0000f), FVector(50.0000f, 0.0000f, 0.0000f), 2.3669f },
+		{ FVector(50.0000f, 2.4900f, -0.0010f), FVector(50.0000f, -2.4900f, 0.0009f), 7.1792f },
+		{ FVector(50.0000f, 2.4900f, -0.0010f), FVector(50.0000f, -2.4900f, 0.0010f), 7.1792f },
+		{ FVector(50.0000f, 2.4900f, -0.0010f), FVector(50.0000f, -2.4900f, 0.0011f), 7.2195f },
+		{ FVector(50.0000f, 2.4900f, -0.0010f), FVector(50.0000f, -2.4900f, 0.0012f), 7.2195f },
+		{ FVector(50.0000f, -0.0010f, 2.4900f), FVector(50.0000f, 0.0009f, -2.4900f), 4.8045f },
+		{ FVector(50.0000f, -0.0010f, 2.4900f), FVector(50.0000f, 0.0010f, -2.4900f), 4.8045f },
+		{ FVector(50.0000f, -0.0010f, 2.4900f), FVector(50.0000f, 0.0011f, -2.4900f), 4.7461f },
+		{ FVector(50.0000f, 2.5000f, 0.0000f), FVector(50.0000f, 0.0000f, -2.5000f), 4.3065f },
+		{ FVector(50.0000f, 2.5000f, 0.0000f), FVector(73.0000f, 25.0000f, -18.0000f), 27.1492f },
+		{ FVector(50.0000f, 2.5000f, 0.0000f), FVector(61.0000f, -5.0000f, 29.0000f), 22.8977f },
+		{ FVector(50.0000f, 2.5000f, 0.0000f), FVector(56.0000f, -27.0000f, -3.0000f), 31.9030f },
+		{ FVector(50.0000f, 2.5000f, 0.0000f), FVector(58.0000f, 24.0000f, 15.0000f), 19.4535f },
+		{ FVector(50.0000f, 2.5000f, 0.0000f), FVector(50.0000f, 3.1736f, 0.5854f), 1.0000f },
+		{ FVector(50.0000f, 2.5000f, 0.0000f), FVector(50.0000f, 3.2972f, 0.0000f), 1.0000f },
+		{ FVector(50.0000f, 2.5000f, 0.0000f), FVector(50.0000f, 1.8634f, 0.5757f), 1.0000f },
+		{ FVector(50.0000f, 2.5000f, 0.0000f), FVector(50.0000f, 3.2592f, 0.3350f), 1.0000f },
+		{ FVector(60.2574f, -34.0099f, 36.2677f), FVector(60.4626f, -34.1751f, 39.4387f), 1.2644f },
+		{ FVector(63.0109f, -31.0961f, -5.8663f), FVector(62.8187f, -29.7946f, -4.0864f), 1.2630f },
+		{ FVector(61.2901f, 3.7196f, -5.3901f), FVector(61.4292f, 2.2480f, -4.9620f), 1.8731f },
+		{ FVector(35.0831f, -44.1164f, 3.7933f), FVector(35.0232f, -40.0716f, 1.5901f), 1.8645f },
+		{ FVector(22.7233f, 20.0904f, -46.6940f), FVector(23.0331f, 14.9730f, -42.5619f), 2.0373f },
+		{ FVector(36.4612f, 47.8580f, 18.3852f), FVector(36.2715f, 50.5065f, 21.2231f), 1.4146f },
+		{ FVector(90.8027f, -2.0831f, 1.4410f), FVector(91.1528f, -1.6435f, 0.0447f), 1.4441f },
+		{ FVector(90.9257f, -0.5406f, -0.9208f), FVector(88.6381f, -0.8985f, -0.7239f), 1.5381f },
+		{ FVector(6.7747f, -0.2908f, -2.4247f), FVector(5.8714f, -0.0985f, -2.2286f), 0.6377f },
+		{ FVector(2.0776f, 0.0795f, -1.1350f), FVector(0.9033f, -0.0636f, -0.5514f), 0.9082f },
+	};
+
+	constexpr int32 NumReferencePairs = UE_ARRAY_COUNT(ReferencePairs);
+
+	/**
+	 * CIEDE2000 computed in double.
+	 */
+	float ReferenceDeltaE2000(const FVector& Lab1, const FVector& Lab2)
+	{
+		return (float)ColorMath::DeltaE2000(ColorMath::TLab<double>{ Lab1.X, Lab1.Y, Lab1.Z }, ColorMath::TLab<double>{ Lab2.X, Lab2.Y, Lab2.Z });
+	}
+
+	/**
+	 * Linear color of a Lab color without gamut clipping, several reference colors lie outside sRGB.
+	 */
+	FLinearColor LabToUnclippedLinear(const FVector& Lab)
+	{
+		const ColorMath::TRGBA<float> Color = ColorMath::LabToLinearRGB(ColorConversionKernels::ToLab(Lab));
+		return FLinearColor(Color.R, Color.G, Color.B);
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FColorDifferenceScalarTest, "ColorPicker.ColorDifference.CIEDE2000.Scalar",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FColorDifferenceScalarTest::RunTest(const FString& Parameters)
+{
+	using namespace ColorDifferenceTests;
+
+	bool bSuccess = true;
+	for (int32 Index = 0; Index < NumReferencePairs; ++Index)
+	{
+		const FReferencePair& Pair = ReferencePairs[Index];
+		bSuccess &= TestEqual(FString::Printf(TEXT("Pair %d in double"), Index + 1), ReferenceDeltaE2000(Pair.Lab1, Pair.Lab2), Pair.DeltaE, Tolerance);
+		bSuccess &= TestEqual(FString::Printf(TEXT("Pair %d"), Index + 1), ColorDifferenceKernels::DeltaE2000(Pair.Lab1, Pair.Lab2), Pair.DeltaE, Tolerance);
+		// CIEDE2000 is symmetric.
+		bSuccess &= TestEqual(FString::Printf(TEXT("Pair %d swapped"), Index + 1), ColorDifferenceKernels::DeltaE2000(Pair.Lab2, Pair.Lab1), Pair.DeltaE, Tolerance);
+	}
+	return bSuccess;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FColorDifferenceLinearColorTest, "ColorPicker.ColorDifference.CIEDE2000.LinearColor",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FColorDifferenceLinearColorTest::RunTest(const FString& Parameters)
+{
+	using namespace ColorDifferenceTests;
+
+	// Converting to linear color and back moves published results by up to 1.3e-4, so results are checked against the double
+	// formula on the Lab colors ColorDifference converts to, after checking those are the reference colors.
+	bool bSuccess = true;
+	for (int32 Index = 0; Index < NumReferencePairs; ++Index)
+	{
+		const FReferencePair& Pair = ReferencePairs[Index];
+		const FLinearColor Color1 = LabToUnclippedLinear(Pair.Lab1);
+		const FLinearColor Color2 = LabToUnclippedLinear(Pair.Lab2);
+
+		FVector Lab1, Lab2;
+		UColorPickerBPLibrary::LinearColorToLab(Color1, Lab1.X, Lab1.Y, Lab1.Z);
+		UColorPickerBPLibrary::LinearColorToLab(Color2, Lab2.X, Lab2.Y, Lab2.Z);
+		bSuccess &= TestTrue(FString::Printf(TEXT("Pair %d round trips through linear color"), Index + 1),
+			Lab1.Equals(Pair.Lab1, 1.e-3f) && Lab2.Equals(Pair.Lab2, 1.e-3f));
+
+		bSuccess &= TestEqual(FString::Printf(TEXT("Pair %d"), Index + 1), UColorPickerBPLibrary::ColorDifference(Color1, Color2),
+			ReferenceDeltaE2000(Lab1, Lab2), Tolerance);
+	}
+	return bSuccess;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FColorDifferenceBatchTest, "ColorPicker.ColorDifference.CIEDE2000.Batch",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FColorDifferenceBatchTest::RunTest(const FString& Parameters)
+{
+	using namespace ColorDifferenceTests;
+
+	TArray<FVector> Lab1, Lab2;
+	for (const FReferencePair& Pair : ReferencePairs)
+	{
+		Lab1.Add(Pair.Lab1);
+		Lab2.Add(Pair.Lab2);
+	}
+
+	// Starting at every offset within a vector puts each pair in every lane and in the scalar remainder.
+	bool bSuccess = true;
+	TArray<float> Differences;
+	for (int32 Offset = 0; Offset < ColorDifferenceKernels::VectorWidth; ++Offset)
+	{
+		const int32 Num = NumReferencePairs - Offset;
+		Differences.SetNumZeroed(Num);
+		UColorPickerBPLibrary::DeltaEBatch(EColorDifference::CD_CIEDE2000, TArrayView<const FVector>(Lab1).Slice(Offset, Num),
+			TArrayView<const FVector>(Lab2).Slice(Offset, Num), Differences);
+
+		for (int32 Index = 0; Index < Num; ++Index)
+		{
+			bSuccess &= TestEqual(FString::Printf(TEXT("Pair %d at batch index %d"), Offset + Index + 1, Index), Differences[Index],
+				ReferencePairs[Offset + Index].DeltaE, Tolerance);
+		}
+	}
+
+	// One-to-many, second color repeated to fill vector lanes and the remainder.
+	const int32 NumCopies = 2 * ColorDifferenceKernels::VectorWidth - 1;
+	TArray<FVector> Compared;
+	for (int32 Index = 0; Index < NumReferencePairs; ++Index)
+	{
+		const FReferencePair& Pair = ReferencePairs[Index];
+		Compared.Init(Pair.Lab2, NumCopies);
+		Differences.SetNumZeroed(NumCopies);
+		UColorPickerBPLibrary::DeltaEBatch(EColorDifference::CD_CIEDE2000, Pair.Lab1, Compared, Differences);
+
+		for (int32 Copy = 0; Copy < NumCopies; ++Copy)
+		{
+			bSuccess &= TestEqual(FString::Printf(TEXT("Pair %d against reference at index %d"), Index + 1, Copy), Differences[Copy], Pair.DeltaE, Tolerance);
+		}
+	}
+	return bSuccess;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
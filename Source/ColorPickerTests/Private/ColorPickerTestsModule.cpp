@@ -0,0 +1,8 @@
+// Copyright kevin791129
+
+#include "Modules/ModuleManager.h"
+
+/**
+ * Automation tests of the ColorPicker plugin, run with Automation RunTests ColorPicker or from the session frontend.
+ */
+IMPLEMENT_MODULE(FDefaultModuleImpl, ColorPickerTests)
@@ -0,0 +1,194 @@
+// Copyright kevin791129
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+#include "Math/RandomStream.h"
+#include "ColorEyedropperSampler.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace EyedropperSamplerTests
+{
+	/** Mismatches reported in full before the rest are only counted. */
+	constexpr int32 MaxReportedErrors = 16;
+
+	/** Channels are stored as 16-bit fixed point, each rounded by at most half a step. */
+	constexpr float Tolerance = 1.e-5f;
+
+	/** Larger than 'FColorEyedropperSampler::LinesPerTask' in both directions so tables are built by several tasks. */
+	const FIntPoint ImageSize(300, 280);
+
+	/** Radii sampled, beyond 'FColorEyedropperSampler::MaxRadius' and negative radii are clamped. */
+	const int32 Radii[] = { 0, 1, 2, 7, 64, FColorEyedropperSampler::MaxRadius, FColorEyedropperSampler::MaxRadius + 50, -3 };
+
+	FLinearColor ToLinear(const FColor& Pixel)
+	{
+		return FLinearColor::FromSRGBColor(Pixel);
+	}
+
+	FLinearColor ToLinear(const FLinearColor& Pixel)
+	{
+		return FLinearColor(FMath::Clamp(Pixel.R, 0.f, 1.f), FMath::Clamp(Pixel.G, 0.f, 1.f), FMath::Clamp(Pixel.B, 0.f, 1.f), FMath::Clamp(Pixel.A, 0.f, 1.f));
+	}
+
+	/**
+	 * Average linear color of a square area clipped to the image, summed pixel by pixel in double.
+	 *
+	 * @return False if the clipped area is empty.
+	 */
+	template<typename PixelType>
+	bool BruteForceAverage(const TArray<PixelType>& Pixels, const FIntPoint& Size, const FIntPoint& Center, const int32 Radius, FLinearColor& OutColor)
+	{
+		const int32 ClampedRadius = FMath::Clamp(Radius, 0, FColorEyedropperSampler::MaxRadius);
+		double Sum[4] = { 0.0, 0.0, 0.0, 0.0 };
+		int32 Count = 0;
+		for (int32 Y = Center.Y - ClampedRadius; Y <= Center.Y + ClampedRadius; ++Y)
+		{
+			for (int32 X = Center.X - ClampedRadius; X <= Center.X + ClampedRadius; ++X)
+			{
+				if (X < 0 || Y < 0 || X >= Size.X || Y >= Size.Y)
+					continue;
+
+				const FLinearColor Pixel = ToLinear(Pixels[Y * Size.X + X]);
+				Sum[0] += Pixel.R;
+				Sum[1] += Pixel.G;
+				Sum[2] += Pixel.B;
+				Sum[3] += Pixel.A;
+				++Count;
+			}
+		}
+
+		if (Count == 0)
+			return false;
+
+		OutColor = FLinearColor((float)(Sum[0] / Count), (float)(Sum[1] / Count), (float)(Sum[2] / Count), (float)(Sum[3] / Count));
+		return true;
+	}
+
+	/**
+	 * Centers at every corner and edge, inside, partially outside and fully outside the image, plus random ones.
+	 */
+	TArray<FIntPoint> MakeCenters(const FIntPoint& Size, FRandomStream& Random)
+	{
+		TArray<FIntPoint> Centers = {
+			FIntPoint(0, 0), FIntPoint(Size.X - 1, 0), FIntPoint(0, Size.Y - 1), FIntPoint(Size.X - 1, Size.Y - 1),
+			FIntPoint(Size.X / 2, 0), FIntPoint(0, Size.Y / 2), FIntPoint(Size.X / 2, Size.Y / 2),
+			FIntPoint(-2, Size.Y / 2), FIntPoint(Size.X + 1, 3), FIntPoint(-200, -200), FIntPoint(Size.X + 200, Size.Y / 2)
+		};
+		for (int32 Index = 0; Index < 8; ++Index)
+		{
+			Centers.Add(FIntPoint(Random.RandRange(0, Size.X - 1), Random.RandRange(0, Size.Y - 1)));
+		}
+		return Centers;
+	}
+
+	/**
+	 * Compare sampler against brute force averages for every center and radius.
+	 *
+	 * @return Number of mismatches.
+	 */
+	template<typename PixelType>
+	int32 CheckSamples(FAutomationTestBase& Test, const TCHAR* Name, const TArray<PixelType>& Pixels, const FIntPoint& Size, FRandomStream& Random)
+	{
+		FColorEyedropperSampler Sampler;
+		Sampler.Build(Pixels, Size);
+
+		int32 NumErrors = 0;
+		for (const FIntPoint& Center : MakeCenters(Size, Random))
+		{
+			for (const int32 Radius : Radii)
+			{
+				FLinearColor Expected = FLinearColor::Transparent;
+				const bool bExpected = BruteForceAverage(Pixels, Size, Center, Radius, Expected);
+
+				// Left unchanged when nothing is sampled.
+				const FLinearColor Unsampled(-1.f, -1.f, -1.f, -1.f);
+				FLinearColor Actual = Unsampled;
+				const bool bSampled = Sampler.Sample(Center, Radius, Actual);
+
+				const bool bMatches = bSampled == bExpected && (bSampled ? Actual.Equals(Expected, Tolerance) : Actual == Unsampled);
+				if (!bMatches && NumErrors++ < MaxReportedErrors)
+				{
+					Test.AddError(FString::Printf(TEXT("%s: sampling (%d, %d) with radius %d gave %s (%s), brute force gives %s (%s)."),
+						Name, Center.X, Center.Y, Radius, bSampled ? TEXT("sampled") : TEXT("not sampled"), *Actual.ToString(),
+						bExpected ? TEXT("sampled") : TEXT("not sampled"), *Expected.ToString()));
+				}
+			}
+		}
+
+		if (NumErrors > MaxReportedErrors)
+			Test.AddError(FString::Printf(TEXT("%s: %d samples differ from brute force."), Name, NumErrors));
+		return NumErrors;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEyedropperSamplerColorTest, "ColorPicker.EyedropperSampler.Color",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FEyedropperSamplerColorTest::RunTest(const FString& Parameters)
+{
+	using namespace EyedropperSamplerTests;
+
+	FRandomStream Random(0x5EED);
+	TArray<FColor> Pixels;
+	Pixels.SetNumUninitialized(ImageSize.X * ImageSize.Y);
+	for (FColor& Pixel : Pixels)
+	{
+		Pixel = FColor((uint8)Random.RandRange(0, 255), (uint8)Random.RandRange(0, 255), (uint8)Random.RandRange(0, 255), (uint8)Random.RandRange(0, 255));
+	}
+	int32 NumErrors = CheckSamples(*this, TEXT("Random colors"), Pixels, ImageSize, Random);
+
+	// Image smaller than the sampled area in both directions.
+	const FIntPoint SmallSize(5, 3);
+	TArray<FColor> SmallPixels(Pixels.GetData(), SmallSize.X * SmallSize.Y);
+	NumErrors += CheckSamples(*this, TEXT("Small image"), SmallPixels, SmallSize, Random);
+
+	// Full channels over the largest area are the largest sums the 32-bit table has to hold.
+	const FIntPoint WhiteSize(2 * FColorEyedropperSampler::MaxRadius + 1, 2 * FColorEyedropperSampler::MaxRadius + 1);
+	TArray<FColor> WhitePixels;
+	WhitePixels.Init(FColor::White, WhiteSize.X * WhiteSize.Y);
+	FColorEyedropperSampler Sampler;
+	Sampler.Build(WhitePixels, WhiteSize);
+	FLinearColor White;
+	if (!Sampler.Sample(WhiteSize / 2, FColorEyedropperSampler::MaxRadius, White) || !White.Equals(FLinearColor::White, Tolerance))
+	{
+		AddError(FString::Printf(TEXT("Sampling white image with radius %d gave %s."), FColorEyedropperSampler::MaxRadius, *White.ToString()));
+		++NumErrors;
+	}
+
+	return NumErrors == 0;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEyedropperSamplerLinearColorTest, "ColorPicker.EyedropperSampler.LinearColor",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FEyedropperSamplerLinearColorTest::RunTest(const FString& Parameters)
+{
+	using namespace EyedropperSamplerTests;
+
+	// Channels beyond [0, 1] cover clamping while building.
+	FRandomStream Random(0xC0FFEE);
+	TArray<FLinearColor> Pixels;
+	Pixels.SetNumUninitialized(ImageSize.X * ImageSize.Y);
+	for (FLinearColor& Pixel : Pixels)
+	{
+		Pixel = FLinearColor(Random.FRandRange(-0.25f, 1.25f), Random.FRandRange(-0.25f, 1.25f), Random.FRandRange(-0.25f, 1.25f), Random.FRandRange(-0.25f, 1.25f));
+	}
+	int32 NumErrors = CheckSamples(*this, TEXT("Random linear colors"), Pixels, ImageSize, Random);
+
+	const FIntPoint SmallSize(3, 5);
+	TArray<FLinearColor> SmallPixels(Pixels.GetData(), SmallSize.X * SmallSize.Y);
+	NumErrors += CheckSamples(*this, TEXT("Small image"), SmallPixels, SmallSize, Random);
+
+	FColorEyedropperSampler Sampler;
+	FLinearColor Color = FLinearColor::Red;
+	if (Sampler.Sample(FIntPoint::ZeroValue, 0, Color) || Color != FLinearColor::Red)
+	{
+		AddError(TEXT("Sampling before building succeeded or changed the color."));
+		++NumErrors;
+	}
+
+	return NumErrors == 0;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
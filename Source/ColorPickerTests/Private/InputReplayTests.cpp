@@ -0,0 +1,263 @@
+// Copyright kevin791129
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+#include "Debugging/SlateDebugging.h"
+#include "Engine/Engine.h"
+#include "Framework/Application/SlateApplication.h"
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
+#include "ColorPickerInputReplay.h"
+
+#if WITH_DEV_AUTOMATION_TESTS && !UE_BUILD_SHIPPING
+
+namespace InputReplayTests
+{
+	/** Timed iterations per stream, the final state of each is checked. */
+	constexpr int32 Iterations = 3;
+
+	/** Prefix of synthetic stream test commands, stream file commands are file paths. */
+	const TCHAR* SyntheticPrefix = TEXT("Synthetic:");
+
+	/** Frames painted idle and while dragging in the invalidation test. */
+	constexpr int32 NumFrames = 30;
+
+	/**
+	 * Stream files recorded from field reports, checked in next to the project.
+	 */
+	FString GetStreamDirectory()
+	{
+		return FPaths::Combine(FPaths::ProjectDir(), TEXT("Tests"), TEXT("ColorPicker"), TEXT("InputStreams"));
+	}
+
+	/**
+	 * Game or play in editor world if there is one, the editor world otherwise.
+	 */
+	UWorld* FindWorld()
+	{
+		if (!GEngine)
+			return nullptr;
+
+		UWorld* EditorWorld = nullptr;
+		for (const FWorldContext& Context : GEngine->GetWorldContexts())
+		{
+			if ((Context.WorldType == EWorldType::Game || Context.WorldType == EWorldType::PIE) && Context.World())
+				return Context.World();
+			if (Context.WorldType == EWorldType::Editor)
+				EditorWorld = Context.World();
+		}
+		return EditorWorld;
+	}
+}
+
+IMPLEMENT_COMPLEX_AUTOMATION_TEST(FColorPickerInputReplayTest, "ColorPicker.InputReplay",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+void FColorPickerInputReplayTest::GetTests(TArray<FString>& OutBeautifiedNames, TArray<FString>& OutTestCommands) const
+{
+	using namespace InputReplayTests;
+
+	for (const FString& Name : FColorPickerInputReplay::GetSyntheticStreamNames())
+	{
+		OutBeautifiedNames.Add(TEXT("Synthetic.") + Name);
+		OutTestCommands.Add(SyntheticPrefix + Name);
+	}
+
+	TArray<FString> StreamFiles;
+	IFileManager::Get().FindFiles(StreamFiles, *FPaths::Combine(GetStreamDirectory(), TEXT("*.json")), true, false);
+	for (const FString& StreamFile : StreamFiles)
+	{
+		OutBeautifiedNames.Add(TEXT("File.") + FPaths::GetBaseFilename(StreamFile));
+		OutTestCommands.Add(FPaths::Combine(GetStreamDirectory(), StreamFile));
+	}
+}
+
+bool FColorPickerInputReplayTest::RunTest(const FString& Parameters)
+{
+	using namespace InputReplayTests;
+
+	FColorPickerInputReplay::FStream Stream;
+	const bool bSynthetic = Parameters.StartsWith(SyntheticPrefix);
+	if (!bSynthetic && !FColorPickerInputReplay::LoadStream(Parameters, Stream))
+	{
+		AddError(FString::Printf(TEXT("Could not load input stream %s."), *Parameters));
+		return false;
+	}
+
+	FString Error;
+	UColorPickerWidget* Widget = FColorPickerInputReplay::CreatePicker(FindWorld(), FColorPickerInputReplay::DefaultWidgetClass, Error);
+	if (!Widget)
+	{
+		AddError(Error);
+		return false;
+	}
+
+	// Synthetic streams are generated from the layout at the default size.
+	FColorPickerInputReplay Harness(Widget, Stream.Size);
+	if (bSynthetic && !Harness.MakeSyntheticStream(Parameters.RightChop(FCString::Strlen(SyntheticPrefix)), Stream))
+	{
+		AddError(FString::Printf(TEXT("Unknown synthetic stream %s."), *Parameters));
+		return false;
+	}
+
+	// Coalesced input registers an active timer, which needs the slate application.
+	if (Stream.bCoalesceInput && !FSlateApplication::IsInitialized())
+	{
+		AddWarning(FString::Printf(TEXT("Skipped %s, coalesced input needs the slate application."), *Stream.Name));
+		return true;
+	}
+
+	const FColorPickerInputReplay::FReplayResult Result = Harness.Replay(Stream, Iterations);
+	if (!Stream.bHasExpected)
+		AddInfo(FString::Printf(TEXT("%s has no expected final state, only timing is reported."), *Stream.Name));
+
+	bool bSuccess = true;
+	for (int32 Iteration = 0; Stream.bHasExpected && Iteration < Result.FinalStates.Num(); ++Iteration)
+	{
+		const FColorPickerInputReplay::FPickerState& State = Result.FinalStates[Iteration];
+		const FString Mismatch = FColorPickerInputReplay::FindMismatch(Stream, State);
+		if (Mismatch.IsEmpty())
+			continue;
+
+		AddError(FString::Printf(TEXT("%s iteration %d %s."), *Stream.Name, Iteration, *Mismatch));
+		TestEqual(FString::Printf(TEXT("Iteration %d hue"), Iteration), State.Hue, Stream.ExpectedHue, Stream.Tolerance * 360.f);
+		TestEqual(FString::Printf(TEXT("Iteration %d saturation"), Iteration), State.Saturation, Stream.ExpectedSaturation, Stream.Tolerance);
+		TestEqual(FString::Printf(TEXT("Iteration %d value"), Iteration), State.Value, Stream.ExpectedValue, Stream.Tolerance);
+		TestEqual(FString::Printf(TEXT("Iteration %d color"), Iteration), FColorPickerInputReplay::ToHex(State.Color), FColorPickerInputReplay::ToHex(Stream.ExpectedColor));
+		bSuccess = false;
+	}
+
+	AddInfo(FColorPickerInputReplay::DescribeTiming(Stream, Result));
+	return bSuccess;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FColorPickerInvalidationTest, "ColorPicker.Invalidation",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FColorPickerInvalidationTest::RunTest(const FString& Parameters)
+{
+	using namespace InputReplayTests;
+	using EEventType = FColorPickerInputReplay::EEventType;
+
+	FString Error;
+	UColorPickerWidget* Widget = FColorPickerInputReplay::CreatePicker(FindWorld(), FColorPickerInputReplay::DefaultWidgetClass, Error);
+	if (!Widget)
+	{
+		AddError(Error);
+		return false;
+	}
+
+	FColorPickerInputReplay Harness(Widget, FColorPickerInputReplay::FStream().Size, true);
+	if (!Harness.IsPaintCached())
+	{
+		AddWarning(TEXT("Skipped, invalidation panels are disabled."));
+		return true;
+	}
+
+#if WITH_SLATE_DEBUGGING
+	const FColorPickerInputReplay::FPickerWidgets Parts = Harness.GetPickerWidgets();
+	TArray<TPair<FString, const SWidget*>> NamedParts = {
+		{ TEXT("hue image"), Parts.HueImage },
+		{ TEXT("saturation value image"), Parts.SaturationValueImage },
+		{ TEXT("hue indicator"), Parts.HueIndicator },
+		{ TEXT("saturation value indicator"), Parts.SaturationValueIndicator }
+	};
+	for (int32 Index = 0; Index < Parts.Canvases.Num(); ++Index)
+	{
+		NamedParts.Add({ FString::Printf(TEXT("canvas %d"), Index), Parts.Canvases[Index] });
+	}
+
+	TMap<const SWidget*, int32> NumWidgetPaints;
+	TMap<const SWidget*, int32> NumWidgetLayouts;
+	auto CountOf = [](const TMap<const SWidget*, int32>& Counts, const SWidget* Part)
+	{
+		const int32* Count = Counts.Find(Part);
+		return Count ? *Count : 0;
+	};
+	const FDelegateHandle PaintHandle = FSlateDebugging::EndWidgetPaint.AddLambda([&NumWidgetPaints](const SWidget* Painted, const FSlateWindowElementList& OutDrawElements, int32 LayerId)
+	{
+		++NumWidgetPaints.FindOrAdd(Painted);
+	});
+	const FDelegateHandle InvalidateHandle = FSlateDebugging::WidgetInvalidateEvent.AddLambda([&NumWidgetLayouts](const FSlateDebuggingInvalidateArgs& Args)
+	{
+		if (EnumHasAnyFlags(Args.InvalidateReason, EInvalidateWidgetReason::Layout))
+			++NumWidgetLayouts.FindOrAdd(Args.WidgetInvalidated);
+	});
+#endif
+
+	// Harness paints once when created, the next frame paints from the cache.
+	Harness.Paint();
+	int32 NumPaints = Harness.GetNumPaints();
+	int32 NumPrepasses = Harness.GetNumPrepasses();
+	int32 NumArranges = Harness.GetNumArranges();
+#if WITH_SLATE_DEBUGGING
+	NumWidgetPaints.Reset();
+	NumWidgetLayouts.Reset();
+#endif
+	for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+	{
+		Harness.Paint();
+	}
+	// Idle frames do no picker work at all, the invalidation panel neither prepasses nor arranges the picker.
+	bool bSuccess = TestEqual(TEXT("Idle picker paints"), Harness.GetNumPaints() - NumPaints, 0);
+	bSuccess &= TestEqual(TEXT("Idle picker prepasses"), Harness.GetNumPrepasses() - NumPrepasses, 0);
+	bSuccess &= TestEqual(TEXT("Idle picker arranges"), Harness.GetNumArranges() - NumArranges, 0);
+#if WITH_SLATE_DEBUGGING
+	for (const TPair<FString, const SWidget*>& Part : NamedParts)
+	{
+		bSuccess &= TestEqual(FString::Printf(TEXT("Idle %s paints"), *Part.Key), CountOf(NumWidgetPaints, Part.Value), 0);
+		bSuccess &= TestEqual(FString::Printf(TEXT("Idle %s layout invalidations"), *Part.Key), CountOf(NumWidgetLayouts, Part.Value), 0);
+	}
+	bSuccess &= TestEqual(TEXT("Idle widgets with layout invalidations"), NumWidgetLayouts.Num(), 0);
+#endif
+
+	// Diagonal drag inside the saturation value picker, so every move changes the color and moves the indicator.
+	const FVector2D Start(10.f, 10.f);
+	Harness.Dispatch({ EEventType::Down, Harness.SaturationValueToWidget(Start) });
+	Harness.Paint();
+	NumPaints = Harness.GetNumPaints();
+	NumPrepasses = Harness.GetNumPrepasses();
+	NumArranges = Harness.GetNumArranges();
+#if WITH_SLATE_DEBUGGING
+	NumWidgetPaints.Reset();
+	NumWidgetLayouts.Reset();
+#endif
+	for (int32 Frame = 1; Frame <= NumFrames; ++Frame)
+	{
+#if WITH_SLATE_DEBUGGING
+		const int32 NumIndicatorPaints = CountOf(NumWidgetPaints, Parts.SaturationValueIndicator);
+#endif
+		Harness.Dispatch({ EEventType::Move, Harness.SaturationValueToWidget(Start + FVector2D((float)Frame)) });
+		Harness.Paint();
+#if WITH_SLATE_DEBUGGING
+		bSuccess &= TestEqual(FString::Printf(TEXT("Saturation value indicator paints in drag frame %d"), Frame),
+			CountOf(NumWidgetPaints, Parts.SaturationValueIndicator) - NumIndicatorPaints, 1);
+#endif
+	}
+
+	// Only the moved indicator is painted again, the picker and its other parts keep their cached paint.
+	// Indicators move by render translation, so nothing is laid out again.
+	bSuccess &= TestEqual(TEXT("Dragging picker paints"), Harness.GetNumPaints() - NumPaints, 0);
+	AddInfo(FString::Printf(TEXT("%d drag frames: %d picker prepasses, %d picker arranges."),
+		NumFrames, Harness.GetNumPrepasses() - NumPrepasses, Harness.GetNumArranges() - NumArranges));
+#if WITH_SLATE_DEBUGGING
+	for (const TPair<FString, const SWidget*>& Part : NamedParts)
+	{
+		if (Part.Value != Parts.SaturationValueIndicator)
+			bSuccess &= TestEqual(FString::Printf(TEXT("Dragging %s paints"), *Part.Key), CountOf(NumWidgetPaints, Part.Value), 0);
+		bSuccess &= TestEqual(FString::Printf(TEXT("Dragging %s layout invalidations"), *Part.Key), CountOf(NumWidgetLayouts, Part.Value), 0);
+	}
+#endif
+	Harness.Dispatch({ EEventType::Up, Harness.SaturationValueToWidget(Start + FVector2D((float)NumFrames)) });
+	Harness.Paint();
+
+#if WITH_SLATE_DEBUGGING
+	FSlateDebugging::EndWidgetPaint.Remove(PaintHandle);
+	FSlateDebugging::WidgetInvalidateEvent.Remove(InvalidateHandle);
+#else
+	AddInfo(TEXT("Paints and layout invalidations of picker parts are only checked with slate debugging."));
+#endif
+	return bSuccess;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS && !UE_BUILD_SHIPPING
@@ -0,0 +1,113 @@
+// Copyright kevin791129
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+#include "SRGBTransfer.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace SRGBTransferTests
+{
+	/** Mismatches reported in full before the rest are only counted. */
+	constexpr int32 MaxReportedErrors = 16;
+
+	float BitsToFloat(const uint32 Bits)
+	{
+		float Value;
+		FMemory::Memcpy(&Value, &Bits, sizeof(Value));
+		return Value;
+	}
+
+	uint32 FloatToBits(const float Value)
+	{
+		uint32 Bits;
+		FMemory::Memcpy(&Bits, &Value, sizeof(Bits));
+		return Bits;
+	}
+
+	/**
+	 * Add value and its neighboring floats, clamped to the non-negative floats up to 1.0f.
+	 */
+	void AddNeighborhood(TArray<float>& Values, const float Value)
+	{
+		const uint32 Bits = FloatToBits(Value);
+		for (int64 Offset = -1; Offset <= 1; ++Offset)
+		{
+			Values.Add(BitsToFloat((uint32)FMath::Clamp<int64>(Bits + Offset, 0, 0x3F800000)));
+		}
+	}
+
+	/**
+	 * Every float where either encode table can change code: both sides of every code threshold and of every bucket boundary,
+	 * plus values the clamp handles.
+	 */
+	TArray<float> MakeEncodeValues()
+	{
+		TArray<float> Values;
+		for (const ColorMath::SRGB::FEncodeTable* Table : { &SRGBTransfer::ColorEncodeTable, &SRGBTransfer::AlphaEncodeTable })
+		{
+			for (int32 Code = 1; Code < 256; ++Code)
+			{
+				AddNeighborhood(Values, Table->Thresholds[Code]);
+			}
+		}
+		for (uint32 Bucket = 0; Bucket < ColorMath::SRGB::EncodeBucketCount; ++Bucket)
+		{
+			AddNeighborhood(Values, BitsToFloat(Bucket << ColorMath::SRGB::EncodeBucketShift));
+		}
+
+		Values.Append({ -0.0f, -KINDA_SMALL_NUMBER, -1.0f, 1.0f + KINDA_SMALL_NUMBER, 2.0f, 1.0e10f, -1.0e10f,
+			TNumericLimits<float>::Max(), TNumericLimits<float>::Lowest(), FMath::Sqrt(-1.0f) /* NaN */ });
+		return Values;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSRGBTransferEncodeTest, "ColorPicker.SRGBTransfer.Encode",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FSRGBTransferEncodeTest::RunTest(const FString& Parameters)
+{
+	using namespace SRGBTransferTests;
+
+	const TArray<float> Values = MakeEncodeValues();
+	int32 NumErrors = 0;
+	for (const float Value : Values)
+	{
+		// Same value in color and alpha channels covers both tables.
+		const FLinearColor Color(Value, Value, Value, Value);
+		const FColor Expected = Color.ToFColor(true);
+		const FColor Actual = SRGBTransfer::ToFColor(Color);
+		if (Actual != Expected && NumErrors++ < MaxReportedErrors)
+		{
+			AddError(FString::Printf(TEXT("Encoding %.9g (0x%08X) gave %s, engine gives %s."),
+				Value, FloatToBits(Value), *Actual.ToString(), *Expected.ToString()));
+		}
+	}
+
+	if (NumErrors > MaxReportedErrors)
+		AddError(FString::Printf(TEXT("%d of %d encoded values differ from the engine."), NumErrors, Values.Num()));
+	return NumErrors == 0;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSRGBTransferDecodeTest, "ColorPicker.SRGBTransfer.Decode",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FSRGBTransferDecodeTest::RunTest(const FString& Parameters)
+{
+	int32 NumErrors = 0;
+	for (int32 Code = 0; Code < 256; ++Code)
+	{
+		const FColor Color((uint8)Code, (uint8)Code, (uint8)Code, (uint8)Code);
+		const FLinearColor Expected = FLinearColor::FromSRGBColor(Color);
+		const FLinearColor Actual = SRGBTransfer::FromFColor(Color);
+		// Exact float comparison, the tables must match bit for bit.
+		if (Actual.R != Expected.R || Actual.G != Expected.G || Actual.B != Expected.B || Actual.A != Expected.A)
+		{
+			++NumErrors;
+			AddError(FString::Printf(TEXT("Decoding %d gave %s, engine gives %s."), Code, *Actual.ToString(), *Expected.ToString()));
+		}
+	}
+	return NumErrors == 0;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS